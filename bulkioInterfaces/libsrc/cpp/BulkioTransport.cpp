@@ -31,7 +31,8 @@ namespace bulkio {
         redhawk::UsesTransport(port),
         _port(port),
         _objref(PortType::_duplicate(objref)),
-        _stats(port->getName())
+        _stats(port->getName()),
+        _sharedMemoryHint(false)
     {
         // Manually set the bit size because the statistics ctor only takes a
         // byte count
@@ -37,9 +37,12 @@ namespace bulkio {
                            bulkio::sri::Compare sriCmp,
                            SriListener *newStreamCB):
     redhawk::NegotiableProvidesPortBase(port_name),
+    queueBytes(0),
+    nextSequence(0),
     sri_cmp(sriCmp),
     newStreamCallback(),
     maxQueue(100),
+    maxQueueBytes(0),
     breakBlock(false),
     blocking(false),
     stats(new linkStatistics(port_name))
@@ -92,6 +95,7 @@ namespace bulkio {
       delete packetQueue.front();
       packetQueue.pop_front();
     }
+    streamQueues.clear();
 
     // clean up allocated containers
     if ( stats ) delete stats;
@@ -160,6 +164,29 @@ namespace bulkio {
     maxQueue = newDepth;
   }
 
+  template <typename PortType>
+  size_t InPort<PortType>::getCurrentQueueBytes()
+  {
+    SCOPED_LOCK lock(dataBufferLock);
+    return queueBytes;
+  }
+
+  template <typename PortType>
+  size_t InPort<PortType>::getMaxQueueBytes()
+  {
+    SCOPED_LOCK lock(dataBufferLock);
+    return maxQueueBytes;
+  }
+
+  template <typename PortType>
+  void InPort<PortType>::setMaxQueueBytes(size_t maxBytes)
+  {
+    SCOPED_LOCK lock(dataBufferLock);
+    maxQueueBytes = maxBytes;
+    // Blocked writers may now have room
+    queueAvailable.notify_all();
+  }
+
   template <typename PortType>
   void InPort<PortType>::setNewStreamListener(SriListener* newListener) {
       if (newListener) {
@@ -204,10 +231,9 @@ namespace bulkio {
       createStream(streamID, sri);
     } else {
       int eos_count = 0;
-      for (typename PacketQueue::iterator ii = this->packetQueue.begin(); ii != this->packetQueue.end(); ++ii) {
-          if (((*ii)->streamID == streamID) and ((*ii)->EOS)) {
-              eos_count++;
-          }
+      StreamQueue* stream_queue = _findStreamQueue(streamID);
+      if (stream_queue) {
+          eos_count = stream_queue->eos;
       }
       // Finished accessing the packet queue, release the lock
       data_lock.unlock();
@@ -265,6 +291,22 @@ namespace bulkio {
             return data;
         }
 
+        template <typename T>
+        inline size_t get_byte_length(const redhawk::shared_buffer<T>& data)
+        {
+            return data.size() * sizeof(T);
+        }
+
+        inline size_t get_byte_length(const redhawk::shared_bitbuffer& data)
+        {
+            return (data.size() + 7) / 8;
+        }
+
+        inline size_t get_byte_length(const std::string& data)
+        {
+            return data.size();
+        }
+
     }
 
   template <typename PortType>
@@ -326,16 +368,26 @@ namespace bulkio {
     }
 
     const size_t length = _getElementLength(data);
+    const size_t bytes = get_byte_length(data);
     {
       bool flushToReport = false;
+      bool discarded = false;
       SCOPED_LOCK lock(dataBufferLock);
       LOG_DEBUG(_portLog, "bulkio::InPort port blocking:" << blocking);
       if (blocking) {
-        while (packetQueue.size() >= maxQueue) {
+        while (_isQueueFull(bytes)) {
           queueAvailable.wait(lock);
         }
       } else {
-        if (packetQueue.size() >= maxQueue) { // reached maximum queue depth - flush the queue
+        if ((packetQueue.size() < maxQueue) && _isQueueFull(bytes)) {
+          // Over the byte limit; try to make room by discarding this stream's
+          // oldest data before resorting to a purge of the whole queue
+          discarded = _discardOldest(streamID, bytes, sriChanged, flushToReport);
+          if (discarded) {
+            LOG_DEBUG( _portLog, "bulkio::InPort pushPacket DISCARDED OLDEST PACKETS FOR STREAM " << streamID << " (BYTES " << queueBytes << ")" );
+          }
+        }
+        if (_isQueueFull(bytes)) { // reached maximum queue depth - flush the queue
           LOG_DEBUG( _portLog, "bulkio::InPort pushPacket PURGE INPUT QUEUE (SIZE" << packetQueue.size() << ")" );
 
           // Need to hold the SRI mutex while flushing the queue because it may
@@ -346,33 +398,31 @@ namespace bulkio {
           //
           // throw away first same stream id if EOS==False, update sriChanged with saved state
           //
-          for (typename PacketQueue::reverse_iterator riter = packetQueue.rbegin(); riter != packetQueue.rend(); ++riter) {
-              Packet* saved_packet = *riter;
-              if ( streamID == saved_packet->streamID ) {
-                  if ( saved_packet->EOS == false  ) {
-                      sriChanged = saved_packet->sriChanged;
-                      currentHs[streamID].second = false;
-                      packetQueue.erase( --riter.base());
-                      delete saved_packet;
-                      flushToReport = true;
-                  }
-                  // no need to search further
-                  break;
-              }
+          StreamQueue* stream_queue = _findStreamQueue(streamID);
+          if (stream_queue && !stream_queue->packets.empty()) {
+            typename PacketQueue::iterator last = _locatePacket(stream_queue->packets.back(), packetQueue.begin());
+            if ((last != packetQueue.end()) && ((*last)->EOS == false)) {
+                Packet* saved_packet = *last;
+                sriChanged = saved_packet->sriChanged;
+                currentHs[streamID].second = false;
+                delete _dequeuePacket(last);
+                flushToReport = true;
+            }
           }
         }
       }
 
       LOG_TRACE(_portLog, "bulkio::InPort pushPacket NEW PACKET (QUEUE" << packetQueue.size()+1 << ")");
-      stats->update(length, (float)(packetQueue.size()+1)/(float)maxQueue, EOS, streamID, flushToReport);
+      stats->update(length, (float)(packetQueue.size()+1)/(float)maxQueue, EOS, streamID, flushToReport || discarded);
+      const boost::shared_ptr<const std::string>& sharedStreamID = _getStreamQueue(streamID)->streamID;
       Packet *tmpIn;
       if (is_copy_required(data)) {
-          tmpIn = new Packet(copy_data(data), T, EOS, sri, sriChanged, flushToReport);
+          tmpIn = new Packet(copy_data(data), T, EOS, sri, sriChanged, flushToReport, sharedStreamID);
       } else {
-          tmpIn = new Packet(data, T, EOS, sri, sriChanged, flushToReport);
+          tmpIn = new Packet(data, T, EOS, sri, sriChanged, flushToReport, sharedStreamID);
       }
-      packetQueue.push_back(tmpIn);
-	
+      _enqueuePacket(tmpIn);
+
       if (EOS) {
           SCOPED_LOCK lock(sriUpdateLock);
           SriTable::iterator target = currentHs.find(streamID);
@@ -468,7 +518,202 @@ namespace bulkio {
 
     // swap the queues..
     packetQueue.swap(last_packets);
+    _rebuildStreamQueues();
+
+  }
+
+  namespace {
+    struct packet_sequence_less {
+      template <class Packet>
+      bool operator()(const Packet* packet, uint64_t sequence) const
+      {
+        return packet->sequence < sequence;
+      }
+    };
+
+    template <class T>
+    inline typename std::deque<T>::iterator do_erase(std::deque<T>& container, typename std::deque<T>::iterator pos)
+    {
+      if (pos == container.begin()) {
+        // PERFORMANCE NOTE:
+        // In a 1-item deque, erase will end up calling pop_back(); however,
+        // this can lead to greatly reduced performance (observed as 1/4 the
+        // data rate on some systems). In the case where the deque alternates
+        // between 0 and 1 packets (i.e., data is consumed as fast as it is
+        // produced), alternating calls to push_back() and pop_back() will
+        // always cause allocation and deallocation. Explicitly calling
+        // pop_front() if it's the first element prevents this worst case
+        // scenario.
+        container.pop_front();
+        return container.begin();
+      } else {
+        return container.erase(pos);
+      }
+    }
+  }
 
+  template <typename PortType>
+  void InPort<PortType>::_enqueuePacket(Packet* packet)
+  {
+    packet->sequence = nextSequence++;
+    packetQueue.push_back(packet);
+    queueBytes += get_byte_length(packet->buffer);
+
+    // Only the first packet of a stream creates its entry
+    StreamQueue* stream_queue = _getStreamQueue(packet->streamID);
+    stream_queue->packets.push_back(packet->sequence);
+    if (packet->EOS) {
+      stream_queue->eos++;
+    }
+    stream_queue->dataAvailable.notify_all();
+  }
+
+  template <typename PortType>
+  typename InPort<PortType>::Packet* InPort<PortType>::_dequeuePacket(typename PacketQueue::iterator iter)
+  {
+    Packet* packet = *iter;
+    bulkio::do_erase(packetQueue, iter);
+    queueBytes -= get_byte_length(packet->buffer);
+
+    typename StreamQueueMap::iterator stream_queue = streamQueues.find(packet->streamID);
+    if (stream_queue != streamQueues.end()) {
+      StreamQueue* state = stream_queue->second.get();
+      // Packets are almost always removed from the front of their stream,
+      // except when the queue is flushed
+      if (!state->packets.empty() && (state->packets.front() == packet->sequence)) {
+        state->packets.pop_front();
+      } else if (!state->packets.empty() && (state->packets.back() == packet->sequence)) {
+        state->packets.pop_back();
+      } else {
+        std::deque<uint64_t>::iterator entry = std::lower_bound(state->packets.begin(), state->packets.end(), packet->sequence);
+        if ((entry != state->packets.end()) && (*entry == packet->sequence)) {
+          state->packets.erase(entry);
+        }
+      }
+      if (packet->EOS) {
+        state->eos--;
+        // The stream is finished; forget it unless there is more data for a
+        // new instance of the stream, or readers are waiting on it
+        if (state->packets.empty() && (state->waiters == 0)) {
+          streamQueues.erase(stream_queue);
+        }
+      }
+    }
+    return packet;
+  }
+
+  template <typename PortType>
+  typename InPort<PortType>::PacketQueue::iterator InPort<PortType>::_findPacket(const std::string& streamID, size_t start)
+  {
+    StreamQueue* stream_queue = _findStreamQueue(streamID);
+    if (!stream_queue || stream_queue->packets.empty() || (start >= packetQueue.size())) {
+      return packetQueue.end();
+    }
+    return _locatePacket(stream_queue->packets.front(), packetQueue.begin() + start);
+  }
+
+  template <typename PortType>
+  typename InPort<PortType>::PacketQueue::iterator InPort<PortType>::_locatePacket(uint64_t sequence, typename PacketQueue::iterator start)
+  {
+    // The queue is always in sequence order; the common case is that the
+    // packet is the first one searched, otherwise fall back to a binary search
+    if ((start != packetQueue.end()) && ((*start)->sequence == sequence)) {
+      return start;
+    }
+    typename PacketQueue::iterator iter = std::lower_bound(start, packetQueue.end(), sequence, packet_sequence_less());
+    if ((iter != packetQueue.end()) && ((*iter)->sequence == sequence)) {
+      return iter;
+    }
+    return packetQueue.end();
+  }
+
+  template <typename PortType>
+  typename InPort<PortType>::StreamQueue* InPort<PortType>::_findStreamQueue(const std::string& streamID)
+  {
+    typename StreamQueueMap::iterator stream_queue = streamQueues.find(streamID);
+    if (stream_queue == streamQueues.end()) {
+      return 0;
+    }
+    return stream_queue->second.get();
+  }
+
+  template <typename PortType>
+  typename InPort<PortType>::StreamQueue* InPort<PortType>::_getStreamQueue(const std::string& streamID)
+  {
+    boost::shared_ptr<StreamQueue>& stream_queue = streamQueues[streamID];
+    if (!stream_queue) {
+      stream_queue.reset(new StreamQueue(streamID));
+    }
+    return stream_queue.get();
+  }
+
+  template <typename PortType>
+  void InPort<PortType>::_rebuildStreamQueues()
+  {
+    // Existing entries are kept (readers may be waiting on their condition);
+    // only the counts are recomputed
+    for (typename StreamQueueMap::iterator stream_queue = streamQueues.begin(); stream_queue != streamQueues.end(); ++stream_queue) {
+      stream_queue->second->packets.clear();
+      stream_queue->second->eos = 0;
+    }
+    // Buffers may have moved between packets, so recount the bytes as well
+    queueBytes = 0;
+    for (typename PacketQueue::iterator iter = packetQueue.begin(); iter != packetQueue.end(); ++iter) {
+      StreamQueue* stream_queue = _getStreamQueue((*iter)->streamID);
+      stream_queue->packets.push_back((*iter)->sequence);
+      if ((*iter)->EOS) {
+        stream_queue->eos++;
+      }
+      queueBytes += get_byte_length((*iter)->buffer);
+    }
+  }
+
+  template <typename PortType>
+  bool InPort<PortType>::_isQueueFull(size_t bytes)
+  {
+    if (packetQueue.size() >= maxQueue) {
+      return true;
+    }
+    // A packet larger than the byte limit is still allowed into an empty
+    // queue, otherwise it could never be delivered
+    return (maxQueueBytes > 0) && !packetQueue.empty() && ((queueBytes + bytes) > maxQueueBytes);
+  }
+
+  template <typename PortType>
+  bool InPort<PortType>::_discardOldest(const std::string& streamID, size_t bytes, bool& sriChanged, bool& inputQueueFlushed)
+  {
+    bool discarded = false;
+    bool discardedSriChange = false;
+    typename PacketQueue::iterator oldest = _findPacket(streamID);
+    while ((oldest != packetQueue.end()) && _isQueueFull(bytes)) {
+      Packet* packet = *oldest;
+      if (packet->EOS) {
+        // Never discard the end of a stream; the data that follows is for a
+        // new instance of the stream
+        break;
+      }
+      discardedSriChange = discardedSriChange || packet->sriChanged;
+      // The stream's next packet can only be after this one; remember the
+      // offset, since erasing from the deque invalidates iterators
+      const size_t offset = oldest - packetQueue.begin();
+      delete _dequeuePacket(oldest);
+      discarded = true;
+      oldest = _findPacket(streamID, offset);
+    }
+
+    if (discarded) {
+      if (oldest != packetQueue.end()) {
+        // Pass the flush and SRI change on to the stream's next packet
+        Packet* next = *oldest;
+        next->inputQueueFlushed = true;
+        next->sriChanged = next->sriChanged || discardedSriChange;
+      } else {
+        inputQueueFlushed = true;
+        sriChanged = sriChanged || discardedSriChange;
+      }
+      queueAvailable.notify_all();
+    }
+    return discarded;
   }
 
 
@@ -513,6 +758,12 @@ namespace bulkio {
     TRACE_ENTER( _portLog, "InPort::block"  );
     breakBlock = true;
     dataAvailable.notify_all();
+    {
+      SCOPED_LOCK lock(dataBufferLock);
+      for (typename StreamQueueMap::iterator stream_queue = streamQueues.begin(); stream_queue != streamQueues.end(); ++stream_queue) {
+        stream_queue->second->dataAvailable.notify_all();
+      }
+    }
     packetWaiters.interrupt();
     TRACE_EXIT( _portLog, "InPort::block"  );
   }
@@ -635,28 +886,55 @@ namespace bulkio {
       uint64_t secs = (unsigned long)(trunc(timeout));
       uint64_t msecs = (unsigned long)((timeout - secs) * 1e6);
       boost::system_time to_time  = boost::get_system_time() + boost::posix_time::seconds(secs) + boost::posix_time::microseconds(msecs);
+
+      // Readers of a specific stream wait on that stream's condition, so that
+      // they are not woken up by packets for other streams
+      CONDITION* condition = &dataAvailable;
+      boost::shared_ptr<StreamQueue> stream_queue;
+      bool created = false;
+      if (!packet && !streamID.empty() && (timeout != 0.0)) {
+        boost::shared_ptr<StreamQueue>& entry = streamQueues[streamID];
+        if (!entry) {
+          entry.reset(new StreamQueue(streamID));
+          created = true;
+        }
+        stream_queue = entry;
+        stream_queue->waiters++;
+        condition = &stream_queue->dataAvailable;
+      }
+
       while (!packet) {
         if (timeout == 0.0) {
-          TRACE_EXIT(_portLog, "InPort::nextPacket");
-          return NULL;
+          break;
         } else if (timeout > 0){
-          if (!dataAvailable.timed_wait(lock, to_time)) {
-            TRACE_EXIT(_portLog, "InPort::nextPacket");
-            return NULL;
+          if (!condition->timed_wait(lock, to_time)) {
+            break;
           }
         } else {
             to_time  = boost::get_system_time() + boost::posix_time::seconds(1);
-            while ((not breakBlock) and (not dataAvailable.timed_wait(lock, to_time))) {
+            while ((not breakBlock) and (not condition->timed_wait(lock, to_time))) {
                 to_time  = boost::get_system_time() + boost::posix_time::seconds(1);
             }
         }
         if (breakBlock) {
-          TRACE_EXIT(_portLog, "InPort::nextPacket");
-          return NULL;
+          break;
         }
         packet = fetchPacket(streamID);
       }
-      
+
+      if (stream_queue) {
+        // Only remove the entry if this wait created it for a stream with no
+        // data yet, or if the wait ended the stream; otherwise it is kept
+        // until the stream's end-of-stream is read
+        stream_queue->waiters--;
+        typename StreamQueueMap::iterator entry = streamQueues.find(streamID);
+        if ((entry != streamQueues.end()) && (entry->second == stream_queue) &&
+            (stream_queue->waiters == 0) && stream_queue->packets.empty() &&
+            (created || (packet && packet->EOS))) {
+          streamQueues.erase(entry);
+        }
+      }
+
       if (!packet) {
         TRACE_EXIT(_portLog, "InPort::nextPacket");
         return NULL;
@@ -683,28 +961,6 @@ namespace bulkio {
   }
 
 
-  namespace {
-    template <class T>
-    inline typename std::deque<T>::iterator do_erase(std::deque<T>& container, typename std::deque<T>::iterator pos)
-    {
-      if (pos == container.begin()) {
-        // PERFORMANCE NOTE:
-        // In a 1-item deque, erase will end up calling pop_back(); however,
-        // this can lead to greatly reduced performance (observed as 1/4 the
-        // data rate on some systems). In the case where the deque alternates
-        // between 0 and 1 packets (i.e., data is consumed as fast as it is
-        // produced), alternating calls to push_back() and pop_back() will
-        // always cause allocation and deallocation. Explicitly calling
-        // pop_front() if it's the first element prevents this worst case
-        // scenario.
-        container.pop_front();
-        return container.begin();
-      } else {
-        return container.erase(pos);
-      }
-    }
-  }
-
   template <typename PortType>
   void InPort<PortType>::createStream(const std::string& streamID,
                                           const bulkio::StreamDescriptor& sri)
@@ -733,37 +989,31 @@ namespace bulkio {
       if (packetQueue.empty()) {
         return 0;
       }
-      Packet* packet = packetQueue.front();
-      packetQueue.pop_front();
-      return packet;
+      return _dequeuePacket(packetQueue.begin());
     }
 
-    for (typename PacketQueue::iterator ii = packetQueue.begin(); ii != packetQueue.end(); ++ii) {
-      if ((*ii)->streamID == streamID) {
-        Packet* packet = *ii;
-        bulkio::do_erase(packetQueue, ii);
-        return packet;
-      }
+    typename PacketQueue::iterator iter = _findPacket(streamID);
+    if (iter == packetQueue.end()) {
+      return 0;
     }
-    return 0;
+    return _dequeuePacket(iter);
   }
 
   template <typename PortType>
   void InPort<PortType>::discardPacketsForStream(const std::string& streamID)
   {
     SCOPED_LOCK lock(dataBufferLock);
-    for (typename PacketQueue::iterator ii = packetQueue.begin(); ii != packetQueue.end();) {
-      if ((*ii)->streamID == streamID) {
-        bool eos = (*ii)->EOS;
-        delete *ii;
-        ii = bulkio::do_erase(packetQueue, ii);
-        queueAvailable.notify_one();
-        if (eos) {
-          break;
-        }
-      } else {
-        ++ii;
+    typename PacketQueue::iterator iter = _findPacket(streamID);
+    while (iter != packetQueue.end()) {
+      const size_t offset = iter - packetQueue.begin();
+      Packet* packet = _dequeuePacket(iter);
+      bool eos = packet->EOS;
+      delete packet;
+      queueAvailable.notify_one();
+      if (eos) {
+        break;
       }
+      iter = _findPacket(streamID, offset);
     }
   }
 
@@ -802,11 +1052,19 @@ namespace bulkio {
     size_t samples = 0;
     size_t item_size = 1;
     SCOPED_LOCK lock(dataBufferLock);
-    for (typename PacketQueue::iterator iter = packetQueue.begin(); iter != packetQueue.end(); ++iter) {
-      Packet* packet = *iter;
-      if (packet->streamID != streamID) {
-        continue;
+    StreamQueue* stream_queue = _findStreamQueue(streamID);
+    if (!stream_queue) {
+      return 0;
+    }
+    // Visit only this stream's packets; each one is after the previous one in
+    // the queue, so the search can resume from there
+    typename PacketQueue::iterator position = packetQueue.begin();
+    for (std::deque<uint64_t>::iterator ii = stream_queue->packets.begin(); ii != stream_queue->packets.end(); ++ii) {
+      position = _locatePacket(*ii, position);
+      if (position == packetQueue.end()) {
+        break;
       }
+      Packet* packet = *position;
       if ((packet->sriChanged) || (packet->inputQueueFlushed)) {
         if (!firstPacket) break;
       }
@@ -189,6 +189,10 @@ namespace bulkio {
     // grab SRI context 
     StreamType stream = _getStream(streamID);
 
+    // Track whether any connection would rather have the stream's data in
+    // shared memory, so that the stream can adapt its future allocations
+    bool hintShared = false;
+
     if (active) {
         for (TransportIterator connection = _connections.begin(); connection != _connections.end(); ++connection) {
             PortTransportType* transport = connection.transport();
@@ -207,6 +211,9 @@ namespace bulkio {
             try {
                 transport->pushSRI(streamID, stream.sri(), stream.modcount());
                 transport->pushPacket(data, T, EOS, streamID, stream.sri());
+                if (transport->takeSharedMemoryHint()) {
+                    hintShared = true;
+                }
             } catch (const redhawk::FatalTransportError& err) {
                 LOG_ERROR(_portLog, "PUSH-PACKET FAILED " << err.what()
                           << " PORT/CONNECTION: " << name << "/" << connection_id);
@@ -220,6 +227,8 @@ namespace bulkio {
     // if we have end of stream removed old sri
     if (EOS) {
       streams.erase(streamID);
+    } else if (hintShared) {
+      stream.preferSharedMemory();
     }
   }
 
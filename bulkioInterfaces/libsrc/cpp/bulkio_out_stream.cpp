@@ -17,7 +17,16 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
+#include <vector>
+#include <deque>
+
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/weak_ptr.hpp>
+
 #include <ossie/prop_helpers.h>
+#include <ossie/affinity.h>
 
 #include "bulkio_out_stream.h"
 #include "bulkio_out_port.h"
@@ -38,6 +47,116 @@ namespace {
   struct is_complex<std::complex<T> > {
     static const bool value = true;
   };
+
+  template <typename T>
+  inline T load_acquire(const volatile T& value)
+  {
+#ifdef __ATOMIC_ACQUIRE
+    return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+#else
+    T result = value;
+    __sync_synchronize();
+    return result;
+#endif
+  }
+
+  template <typename T>
+  inline void store_release(volatile T& target, T value)
+  {
+#ifdef __ATOMIC_RELEASE
+    __atomic_store_n(&target, value, __ATOMIC_RELEASE);
+#else
+    __sync_synchronize();
+    target = value;
+#endif
+  }
+
+  // Counters that are only modified by one thread, but may be read from
+  // others
+  inline void increment(volatile size_t& counter, size_t count=1)
+  {
+    store_release(counter, load_acquire(counter) + count);
+  }
+
+  // Traits class to select a shared memory allocator for a stream's buffers;
+  // the hybrid allocator falls back to process-local memory if the shared
+  // memory heap is exhausted
+  template <typename Buffer>
+  struct shared_allocator {
+    typedef redhawk::shm::HybridAllocator<typename Buffer::value_type> type;
+  };
+
+  template <>
+  struct shared_allocator<redhawk::bitbuffer> {
+    typedef redhawk::shm::HybridAllocator<redhawk::bitbuffer::data_type> type;
+  };
+
+  // Fixed-capacity ring for exactly one producer thread and one consumer
+  // thread; neither side takes a lock
+  template <typename T>
+  class spsc_ring {
+  public:
+    explicit spsc_ring(size_t capacity) :
+      _slots(capacity + 1),
+      _head(0),
+      _tail(0)
+    {
+    }
+
+    size_t capacity() const
+    {
+      return _slots.size() - 1;
+    }
+
+    size_t size() const
+    {
+      size_t head = load_acquire(_head);
+      size_t tail = load_acquire(_tail);
+      return (tail + _slots.size() - head) % _slots.size();
+    }
+
+    bool empty() const
+    {
+      return load_acquire(_head) == load_acquire(_tail);
+    }
+
+    // Producer only: returns false if the ring is full
+    bool push(const T& item)
+    {
+      size_t tail = _tail;
+      size_t next = (tail + 1) % _slots.size();
+      if (next == load_acquire(_head)) {
+        return false;
+      }
+      _slots[tail] = item;
+      store_release(_tail, next);
+      return true;
+    }
+
+    // Consumer only: returns the oldest item, or null if the ring is empty;
+    // the item stays in the ring until pop()
+    T* front()
+    {
+      size_t head = _head;
+      if (head == load_acquire(_tail)) {
+        return 0;
+      }
+      return &_slots[head];
+    }
+
+    void pop()
+    {
+      size_t head = _head;
+      // Release the item's resources (e.g., buffer references) now
+      _slots[head] = T();
+      store_release(_head, (head + 1) % _slots.size());
+    }
+
+  private:
+    std::vector<T> _slots;
+    volatile size_t _head;
+    volatile size_t _tail;
+  };
 }
 
 template <class PortType>
@@ -167,6 +286,11 @@ public:
         return _modcount;
     }
 
+    virtual void setPreferSharedMemory()
+    {
+        // By default, do nothing
+    }
+
 protected:
     virtual void _modifyingStreamMetadata()
     {
@@ -337,16 +461,24 @@ int OutputStream<PortType>::modcount() const
     return impl().modcount();
 }
 
+template <class PortType>
+void OutputStream<PortType>::preferSharedMemory()
+{
+    impl().setPreferSharedMemory();
+}
+
 
 using bulkio::BufferedOutputStream;
 
 template <class PortType>
-class BufferedOutputStream<PortType>::Impl : public Base::Impl {
+class BufferedOutputStream<PortType>::Impl : public Base::Impl,
+                                             public boost::enable_shared_from_this<typename BufferedOutputStream<PortType>::Impl> {
 public:
     typedef typename Base::Impl ImplBase;
 
     typedef typename BufferTraits<PortType>::BufferType BufferType;
     typedef typename BufferTraits<PortType>::MutableBufferType MutableBufferType;
+    typedef typename shared_allocator<MutableBufferType>::type SharedAllocator;
 
     using ImplBase::_sri;
     using ImplBase::_streamID;
@@ -354,8 +486,21 @@ public:
     Impl(const BULKIO::StreamSRI& sri, OutPortType* port) :
         ImplBase::Impl(sri, port),
         _bufferSize(0),
-        _bufferOffset(0)
+        _bufferOffset(0),
+        _preferShared(false),
+        _policy(bulkio::OVERFLOW_BLOCK),
+        _overflowCount(0),
+        _sender(0),
+        _senderRunning(false),
+        _senderWaiting(false),
+        _writerWaiting(false)
     {
+        _resetStatistics();
+    }
+
+    virtual ~Impl()
+    {
+        _stopSender();
     }
 
     void write(const BufferType& data, const BULKIO::PrecisionUTCTime& time)
@@ -363,7 +508,20 @@ public:
         // If buffering is disabled, or the buffer is empty and the input data is
         // large enough for a full buffer, send it immediately
         if ((_bufferSize == 0) || (_bufferOffset == 0 && (data.size() >= _bufferSize))) {
-            ImplBase::write(data, time);
+            if (_ring) {
+                // The caller may reuse transient data as soon as this returns
+                if (data.transient()) {
+                    _enqueue(Packet(_copy(data), time, false));
+                } else {
+                    _enqueue(Packet(data, time, false));
+                }
+            } else if (_prefersShared() && !data.get_memory().is_process_shared()) {
+                // Make a single shared memory copy here rather than having
+                // each connection make its own
+                ImplBase::write(_copy(data), time);
+            } else {
+                ImplBase::write(data, time);
+            }
         } else {
             _doBuffer(data, time);
         }
@@ -374,6 +532,13 @@ public:
         return _bufferSize;
     }
 
+    virtual void setPreferSharedMemory()
+    {
+        // Called from whichever thread is sending (the writer, or the sender
+        // thread in asynchronous mode)
+        store_release(_preferShared, true);
+    }
+
     void setBufferSize(size_t samples)
     {
         // Avoid needless thrashing
@@ -394,11 +559,10 @@ public:
 
     void flush()
     {
-        if (_bufferOffset == 0) {
-            return;
+        if (_bufferOffset > 0) {
+            _flush(false);
         }
-
-        _flush(false);
+        _drain();
     }
 
     virtual void close()
@@ -406,12 +570,297 @@ public:
         if (_bufferOffset > 0) {
             // Add the end-of-stream marker to the buffered data and its timestamp
             _flush(true);
+        } else if (_ring) {
+            // Queue the end-of-stream behind any other packets
+            _enqueue(Packet(BufferType(), bulkio::time::utils::notSet(), true));
         } else {
             ImplBase::close();
         }
+
+        // Wait for the end-of-stream to go out, then stop the sender
+        _drain();
+        _stopSender();
+        _ring.reset();
+    }
+
+    size_t asyncDepth() const
+    {
+        if (_ring) {
+            return _ring->capacity();
+        }
+        return 0;
+    }
+
+    void setAsync(size_t depth, bulkio::OverflowPolicy policy)
+    {
+        if ((depth == asyncDepth()) && (policy == _policy)) {
+            return;
+        }
+
+        // Send everything queued with the old configuration
+        _drain();
+        _stopSender();
+        _ring.reset();
+        _policy = policy;
+        if (depth > 0) {
+            _ring.reset(new spsc_ring<Packet>(depth));
+            _senderRunning = true;
+            // The sender only holds a weak reference, so that the stream can
+            // still be destroyed when it is no longer used
+            boost::weak_ptr<Impl> ref = this->shared_from_this();
+            _sender = new boost::thread(&Impl::_runSender, this, ref);
+        }
+    }
+
+    bulkio::OverflowPolicy overflowPolicy() const
+    {
+        return _policy;
+    }
+
+    bulkio::AsyncStatistics asyncStatistics() const
+    {
+        bulkio::AsyncStatistics stats;
+        stats.capacity = asyncDepth();
+        stats.queueDepth = load_acquire(_overflowCount);
+        if (_ring) {
+            stats.queueDepth += _ring->size();
+        }
+        stats.packetsQueued = load_acquire(_stats.packetsQueued);
+        stats.packetsSent = load_acquire(_stats.packetsSent);
+        stats.packetsDropped = load_acquire(_stats.packetsDropped);
+        stats.samplesDropped = load_acquire(_stats.samplesDropped);
+        stats.blocked = load_acquire(_stats.blocked);
+        stats.grown = load_acquire(_stats.grown);
+        return stats;
     }
 
 private:
+    struct Packet {
+        Packet() :
+            eos(false)
+        {
+        }
+
+        Packet(const BufferType& data, const BULKIO::PrecisionUTCTime& time, bool eos) :
+            data(data),
+            time(time),
+            eos(eos)
+        {
+        }
+
+        BufferType data;
+        BULKIO::PrecisionUTCTime time;
+        bool eos;
+    };
+
+    struct Counters {
+        volatile size_t packetsQueued;
+        volatile size_t packetsSent;
+        volatile size_t packetsDropped;
+        volatile size_t samplesDropped;
+        volatile size_t blocked;
+        volatile size_t grown;
+    };
+
+    void _resetStatistics()
+    {
+        _stats.packetsQueued = 0;
+        _stats.packetsSent = 0;
+        _stats.packetsDropped = 0;
+        _stats.samplesDropped = 0;
+        _stats.blocked = 0;
+        _stats.grown = 0;
+    }
+
+    void _dispatch(const BufferType& data, const BULKIO::PrecisionUTCTime& time, bool eos)
+    {
+        if (_ring) {
+            _enqueue(Packet(data, time, eos));
+        } else {
+            this->_send(data, time, eos);
+        }
+    }
+
+    // Writer thread: adds a packet to the queue, applying the overflow
+    // policy if it is full
+    void _enqueue(const Packet& packet)
+    {
+        // Once packets have overflowed, all new packets go to the overflow
+        // queue until it is empty, to preserve ordering
+        if ((load_acquire(_overflowCount) == 0) && _ring->push(packet)) {
+            increment(_stats.packetsQueued);
+            _wakeSender();
+            return;
+        }
+
+        if (_policy == bulkio::OVERFLOW_GROW) {
+            boost::mutex::scoped_lock lock(_asyncMutex);
+            _overflow.push_back(packet);
+            store_release(_overflowCount, _overflow.size());
+            increment(_stats.packetsQueued);
+            increment(_stats.grown);
+            _asyncCond.notify_all();
+            return;
+        } else if ((_policy == bulkio::OVERFLOW_DROP) && !packet.eos) {
+            increment(_stats.packetsDropped);
+            increment(_stats.samplesDropped, packet.data.size());
+            return;
+        }
+
+        // Block until the sender makes room
+        increment(_stats.blocked);
+        boost::mutex::scoped_lock lock(_asyncMutex);
+        store_release(_writerWaiting, true);
+        __sync_synchronize();
+        while (!_ring->push(packet)) {
+            _asyncCond.wait(lock);
+        }
+        store_release(_writerWaiting, false);
+        increment(_stats.packetsQueued);
+        _asyncCond.notify_all();
+    }
+
+    // Writer thread: waits until every queued packet has been sent
+    void _drain()
+    {
+        if (!_ring) {
+            return;
+        }
+        boost::mutex::scoped_lock lock(_asyncMutex);
+        store_release(_writerWaiting, true);
+        __sync_synchronize();
+        while (!_ring->empty() || (load_acquire(_overflowCount) > 0)) {
+            _asyncCond.wait(lock);
+        }
+        store_release(_writerWaiting, false);
+    }
+
+    void _wakeSender()
+    {
+        // Pairs with the barrier in _runSender, so that either the sender
+        // sees the new packet or the writer sees that the sender is waiting
+        __sync_synchronize();
+        if (load_acquire(_senderWaiting)) {
+            boost::mutex::scoped_lock lock(_asyncMutex);
+            _asyncCond.notify_all();
+        }
+    }
+
+    void _wakeWriter()
+    {
+        __sync_synchronize();
+        if (load_acquire(_writerWaiting)) {
+            boost::mutex::scoped_lock lock(_asyncMutex);
+            _asyncCond.notify_all();
+        }
+    }
+
+    void _stopSender()
+    {
+        if (!_sender) {
+            return;
+        }
+        {
+            boost::mutex::scoped_lock lock(_asyncMutex);
+            _senderRunning = false;
+            _asyncCond.notify_all();
+        }
+        if (_sender->get_id() == boost::this_thread::get_id()) {
+            // The sender released the last reference to the stream, and
+            // cannot join itself; it exits as soon as the destructor returns,
+            // without touching the stream again (see _releaseStream())
+            _sender->detach();
+        } else {
+            _sender->join();
+        }
+        delete _sender;
+        _sender = 0;
+    }
+
+    // Background sender thread main function
+    void _runSender(boost::weak_ptr<Impl> ref)
+    {
+        redhawk::affinity::apply_thread_affinity(redhawk::affinity::TRANSPORT_THREAD);
+
+        while (true) {
+            Packet* packet = _ring->front();
+            if (packet) {
+                // Sending an end-of-stream makes the port drop its reference
+                // to the stream, so hold one until the packet is done
+                boost::shared_ptr<Impl> self;
+                if (packet->eos) {
+                    self = ref.lock();
+                }
+                _sendQueued(*packet);
+                _ring->pop();
+                _wakeWriter();
+                if (_releaseStream(self, ref)) {
+                    return;
+                }
+                continue;
+            }
+
+            if (load_acquire(_overflowCount) > 0) {
+                // The ring is empty, so the overflow holds the oldest packets
+                Packet next;
+                {
+                    boost::mutex::scoped_lock lock(_asyncMutex);
+                    next = _overflow.front();
+                }
+                boost::shared_ptr<Impl> self;
+                if (next.eos) {
+                    self = ref.lock();
+                }
+                _sendQueued(next);
+                {
+                    boost::mutex::scoped_lock lock(_asyncMutex);
+                    _overflow.pop_front();
+                    store_release(_overflowCount, _overflow.size());
+                }
+                _wakeWriter();
+                if (_releaseStream(self, ref)) {
+                    return;
+                }
+                continue;
+            }
+
+            boost::mutex::scoped_lock lock(_asyncMutex);
+            store_release(_senderWaiting, true);
+            __sync_synchronize();
+            while (_senderRunning && _ring->empty() && (load_acquire(_overflowCount) == 0)) {
+                _asyncCond.wait(lock);
+            }
+            store_release(_senderWaiting, false);
+            if (!_senderRunning && _ring->empty() && (load_acquire(_overflowCount) == 0)) {
+                return;
+            }
+        }
+    }
+
+    // Sender thread: drops the reference taken while sending, and returns
+    // true if the stream no longer exists. If this was the last reference,
+    // the stream is destroyed on this thread, so the caller must return
+    // without touching any members.
+    static bool _releaseStream(boost::shared_ptr<Impl>& self, const boost::weak_ptr<Impl>& ref)
+    {
+        if (!self) {
+            return false;
+        }
+        self.reset();
+        return ref.expired();
+    }
+
+    void _sendQueued(const Packet& packet)
+    {
+        try {
+            this->_send(packet.data, packet.time, packet.eos);
+        } catch (...) {
+            // Transport errors are reported by the port; there is no caller
+            // to propagate anything else to
+        }
+        increment(_stats.packetsSent);
+    }
+
     virtual void _modifyingStreamMetadata()
     {
         // Flush any data queued with the old SRI
@@ -422,13 +871,31 @@ private:
     {
         // Push out all buffered data, which must be less than the full allocated
         // size otherwise it would have already been sent
-        this->_send(_buffer.slice(0, _bufferOffset), _bufferTime, eos);
+        _dispatch(_buffer.slice(0, _bufferOffset), _bufferTime, eos);
 
         // Allocate a new buffer and reset the offset index
-        _buffer = MutableBufferType(_bufferSize);
+        if (_prefersShared()) {
+            _buffer = MutableBufferType(_bufferSize, SharedAllocator());
+        } else {
+            _buffer = MutableBufferType(_bufferSize);
+        }
         _bufferOffset = 0;
     }
 
+    bool _prefersShared() const
+    {
+        return load_acquire(_preferShared);
+    }
+
+    MutableBufferType _copy(const BufferType& data)
+    {
+        if (_prefersShared()) {
+            return data.copy(SharedAllocator());
+        } else {
+            return data.copy();
+        }
+    }
+
     void _doBuffer(const BufferType& data, const BULKIO::PrecisionUTCTime& time)
     {
         // If this is the first data being queued, use its timestamp for the start
@@ -458,6 +925,25 @@ private:
     BULKIO::PrecisionUTCTime _bufferTime;
     size_t _bufferSize;
     size_t _bufferOffset;
+
+    // Set by the port when a connection has been copying this stream's data
+    // into shared memory; new buffers are then allocated there directly.
+    // Only accessed through load_acquire()/store_release().
+    volatile bool _preferShared;
+
+    // Asynchronous mode: the writer thread produces into the ring (or the
+    // overflow queue, with OVERFLOW_GROW), and the sender thread consumes
+    boost::scoped_ptr<spsc_ring<Packet> > _ring;
+    bulkio::OverflowPolicy _policy;
+    std::deque<Packet> _overflow;
+    volatile size_t _overflowCount;
+    boost::thread* _sender;
+    bool _senderRunning;
+    volatile bool _senderWaiting;
+    volatile bool _writerWaiting;
+    boost::mutex _asyncMutex;
+    boost::condition_variable _asyncCond;
+    Counters _stats;
 };
 
 template <class PortType>
@@ -496,6 +982,30 @@ void BufferedOutputStream<PortType>::write(const BufferType& data, const BULKIO:
     impl().write(data, time);
 }
 
+template <class PortType>
+size_t BufferedOutputStream<PortType>::asyncDepth() const
+{
+    return impl().asyncDepth();
+}
+
+template <class PortType>
+void BufferedOutputStream<PortType>::setAsync(size_t depth, bulkio::OverflowPolicy policy)
+{
+    impl().setAsync(depth, policy);
+}
+
+template <class PortType>
+bulkio::OverflowPolicy BufferedOutputStream<PortType>::overflowPolicy() const
+{
+    return impl().overflowPolicy();
+}
+
+template <class PortType>
+bulkio::AsyncStatistics BufferedOutputStream<PortType>::asyncStatistics() const
+{
+    return impl().asyncStatistics();
+}
+
 template <class PortType>
 typename BufferedOutputStream<PortType>::Impl& BufferedOutputStream<PortType>::impl()
 {
@@ -53,6 +53,18 @@ namespace bulkio {
 
         BULKIO::PortStatistics getStatistics();
 
+        //
+        // Returns true, and clears the hint, if the last packet pushed would
+        // have been transferred more efficiently had its stream allocated it
+        // in shared memory (e.g., because the transport has been copying it)
+        //
+        bool takeSharedMemoryHint()
+        {
+            bool hint = _sharedMemoryHint;
+            _sharedMemoryHint = false;
+            return hint;
+        }
+
     protected:
         typedef OutPort<PortType> OutPortType;
         typedef typename PortType::_ptr_type PtrType;
@@ -85,6 +97,15 @@ namespace bulkio {
         //
         size_t _dataLength(const BufferType& data);
 
+        //
+        // Marks the packet being pushed as one that the stream should have
+        // allocated in shared memory; picked up by the port after the push
+        //
+        void _hintSharedMemory()
+        {
+            _sharedMemoryHint = true;
+        }
+
         OutPortType* _port;
         VarType _objref;
         typedef std::map<std::string,int> VersionMap;
@@ -92,6 +113,7 @@ namespace bulkio {
 
     private:
         linkStatistics _stats;
+        bool _sharedMemoryHint;
     };
 
     template <class PortType>
@@ -21,8 +21,11 @@
 #define __bulkio_in_port_h
 
 #include <queue>
+#include <deque>
 #include <list>
+#include <map>
 #include <vector>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
 
@@ -203,6 +206,25 @@ namespace bulkio {
      */
     void setMaxQueueDepth(int newDepth);
 
+    /*
+     * getCurrentQueueBytes - returns the number of bytes of data in the queue
+     */
+    size_t getCurrentQueueBytes();
+
+    /*
+     * getMaxQueueBytes - returns the maximum number of bytes of data allowed in the queue; 0 means there is no
+     *                    limit other than the queue depth
+     */
+    size_t getMaxQueueBytes();
+
+    /*
+     * setMaxQueueBytes - limits the amount of data on the queue, in addition to the number of vectors. When a
+     *                    new packet would exceed the limit, the oldest packets from the same stream are discarded
+     *                    first; the whole queue is purged only if that is not enough. A blocking stream waits for
+     *                    space instead. Set to 0 to disable the limit (the default).
+     */
+    void setMaxQueueBytes(size_t maxBytes);
+
     //
     // Allow the component to control the flow of data from the port to the component.  Block will restrict the flow of data back into the
     // component.  Call in component's stop method
@@ -319,7 +341,25 @@ namespace bulkio {
         SRI(SRI),
         sriChanged(sriChanged),
         inputQueueFlushed(inputQueueFlushed),
-        streamID(SRI.streamID())
+        sharedStreamID(new std::string(SRI.streamID())),
+        streamID(*sharedStreamID),
+        sequence(0)
+      {
+      }
+
+      // Shares the port's interned copy of the stream ID, which avoids
+      // converting it from the CORBA string in the SRI, or copying it, for
+      // every packet
+      Packet(const BufferType& buffer, const BULKIO::PrecisionUTCTime& T, bool EOS, const StreamDescriptor& SRI, bool sriChanged, bool inputQueueFlushed, const boost::shared_ptr<const std::string>& streamID) :
+        buffer(buffer),
+        T(T),
+        EOS(EOS),
+        SRI(SRI),
+        sriChanged(sriChanged),
+        inputQueueFlushed(inputQueueFlushed),
+        sharedStreamID(streamID),
+        streamID(*sharedStreamID),
+        sequence(0)
       {
       }
 
@@ -329,7 +369,10 @@ namespace bulkio {
       StreamDescriptor SRI;
       bool sriChanged;
       bool inputQueueFlushed;
-      std::string streamID;
+      boost::shared_ptr<const std::string> sharedStreamID;
+      const std::string& streamID;
+      // Arrival order within the queue, assigned by _enqueuePacket
+      uint64_t sequence;
     };
 
     //
@@ -337,6 +380,35 @@ namespace bulkio {
     //
     typedef std::deque<Packet*> PacketQueue;
     PacketQueue packetQueue;
+    size_t queueBytes;
+    uint64_t nextSequence;
+
+    //
+    // Per-stream state for the packets in packetQueue. Each stream ID has its
+    // own condition so that readers of a stream are only woken up by packets
+    // for that stream, and the sequence numbers of its queued packets in
+    // arrival order, so that the stream's packets can be found without
+    // searching the queue. It also holds the interned stream ID that the
+    // stream's packets share. A stream's entry is kept until its end-of-stream
+    // is removed from the queue, so that pushing and reading packets does not
+    // allocate a new entry.
+    //
+    struct StreamQueue {
+      explicit StreamQueue(const std::string& streamID) :
+        streamID(new std::string(streamID)),
+        eos(0),
+        waiters(0)
+      {
+      }
+
+      boost::shared_ptr<const std::string> streamID;
+      std::deque<uint64_t> packets;
+      size_t eos;
+      CONDITION dataAvailable;
+      int waiters;
+    };
+    typedef std::map<std::string,boost::shared_ptr<StreamQueue> > StreamQueueMap;
+    StreamQueueMap streamQueues;
 
     //
     // SRI compare method used by pushSRI method to determine how to match incoming SRI objects and streamsID
@@ -361,6 +433,7 @@ namespace bulkio {
     CONDITION dataAvailable;
     CONDITION queueAvailable;
     size_t maxQueue;
+    size_t maxQueueBytes;
 
     //
     // synchronizes access to the currentHs member
@@ -447,6 +520,47 @@ namespace bulkio {
     // sriUpdateLock
     void _flushQueue();
 
+    // Adds a packet to the end of the queue and updates its stream's state;
+    // must hold dataBufferLock
+    void _enqueuePacket(Packet* packet);
+
+    // Removes a packet from the queue and updates its stream's state,
+    // returning the packet; must hold dataBufferLock
+    Packet* _dequeuePacket(typename PacketQueue::iterator iter);
+
+    // Returns the oldest queued packet for the given stream ID, or the end of
+    // the queue if there is none. If the caller knows that the packet cannot
+    // be before the start'th packet in the queue, the search begins there.
+    // Must hold dataBufferLock
+    typename PacketQueue::iterator _findPacket(const std::string& streamID, size_t start=0);
+
+    // Returns the queued packet with the given sequence number, searching
+    // from start onward, or the end of the queue if there is none; must hold
+    // dataBufferLock
+    typename PacketQueue::iterator _locatePacket(uint64_t sequence, typename PacketQueue::iterator start);
+
+    // Returns the state for the given stream ID, or null if the stream is not
+    // tracked; must hold dataBufferLock
+    StreamQueue* _findStreamQueue(const std::string& streamID);
+
+    // Returns the state for the given stream ID, creating it if the stream
+    // is not tracked; must hold dataBufferLock
+    StreamQueue* _getStreamQueue(const std::string& streamID);
+
+    // Recounts the per-stream state from the queue; must hold dataBufferLock
+    void _rebuildStreamQueues();
+
+    // Returns true if a packet of the given size cannot be queued without
+    // exceeding the queue depth or byte limit; must hold dataBufferLock
+    bool _isQueueFull(size_t bytes);
+
+    // Discards the oldest packets for a stream until a packet of the given
+    // size fits within the byte limit, stopping at end-of-stream. SRI change
+    // and flush state is moved to the stream's next packet, or returned in
+    // sriChanged and inputQueueFlushed if none remain. Returns true if any
+    // packets were discarded; must hold dataBufferLock
+    bool _discardOldest(const std::string& streamID, size_t bytes, bool& sriChanged, bool& inputQueueFlushed);
+
     // Checks whether the packet should be queued or discarded; also handles
     // notifying disabled streams of end-of-stream if the packet is being
     // discarded
@@ -338,6 +338,11 @@ namespace bulkio {
 
         int modcount() const;
 
+        // Hint from the port that future data should be allocated in shared
+        // memory, because at least one connection is copying it there; holds
+        // until the stream ends
+        void preferSharedMemory();
+
         typedef const Impl& (OutputStream::*unspecified_bool_type)() const;
         /// @endcond
     public:
@@ -370,6 +375,43 @@ namespace bulkio {
     };
 
 
+    /**
+     * @brief  Action taken when an asynchronous output stream's queue is full.
+     * @see  BufferedOutputStream::setAsync()
+     */
+    enum OverflowPolicy {
+        /// Wait for the background sender to make room.
+        OVERFLOW_BLOCK,
+        /// Discard the packet being queued (end-of-stream is never dropped).
+        OVERFLOW_DROP,
+        /// Queue the packet beyond the configured depth.
+        OVERFLOW_GROW
+    };
+
+    /**
+     * @brief  Counters for an asynchronous output stream.
+     * @see  BufferedOutputStream::asyncStatistics()
+     */
+    struct AsyncStatistics {
+        /// Number of packets waiting to be sent.
+        size_t queueDepth;
+        /// Configured queue depth.
+        size_t capacity;
+        /// Total packets queued.
+        size_t packetsQueued;
+        /// Total packets sent by the background sender.
+        size_t packetsSent;
+        /// Packets discarded under OVERFLOW_DROP.
+        size_t packetsDropped;
+        /// Samples in the discarded packets.
+        size_t samplesDropped;
+        /// Number of times a write had to wait for room (OVERFLOW_BLOCK).
+        size_t blocked;
+        /// Packets queued beyond the configured depth (OVERFLOW_GROW).
+        size_t grown;
+    };
+
+
     /**
      * @brief BulkIO output stream class with data buffering.
      * @headerfile  bulkio_out_stream.h <bulkio/bulkio_out_stream.h>
@@ -406,6 +448,19 @@ namespace bulkio {
      * methods may be discarded. Furthermore, when write sizes do not align
      * exactly with the buffer size, the output time stamp may be interpolated.
      * If precise time stamps are required, buffering should not be used.
+     *
+     * @par  Asynchronous Mode
+     *
+     * By default, packets are pushed on the calling thread, so a slow
+     * consumer delays the writer. Calling setAsync() with a non-zero depth
+     * instead places each packet in a fixed-size queue that is drained by a
+     * background thread owned by the stream, allowing processing and
+     * transport to overlap. What happens when the queue is full is determined
+     * by the OverflowPolicy.
+     *
+     * Packets are always sent in order, and with the SRI that was in effect
+     * when they were written: any change to the SRI, as well as flush() and
+     * close(), waits until the queue is empty.
      */
     template <class PortType>
     class BufferedOutputStream : public OutputStream<PortType> {
@@ -459,6 +514,8 @@ namespace bulkio {
          * @pre  Stream is valid.
          *
          * Any data in the internal buffer is sent to the port to be pushed.
+         * In asynchronous mode, this also waits until all queued packets have
+         * been sent.
          */
         void flush();
 
@@ -478,6 +535,39 @@ namespace bulkio {
          */
         void write(const BufferType& data, const BULKIO::PrecisionUTCTime& time);
 
+        /**
+         * @brief  Gets the asynchronous queue depth.
+         * @returns  Maximum number of queued packets, or 0 if asynchronous
+         *           mode is disabled.
+         * @pre  Stream is valid.
+         */
+        size_t asyncDepth() const;
+
+        /**
+         * @brief  Enables or disables asynchronous mode.
+         * @param depth   Maximum number of queued packets; 0 disables
+         *                asynchronous mode.
+         * @param policy  Action to take when the queue is full.
+         * @pre  Stream is valid.
+         *
+         * Changing the depth or policy, or disabling asynchronous mode,
+         * first waits for all queued packets to be sent. Data in the internal
+         * buffer is not affected.
+         */
+        void setAsync(size_t depth, OverflowPolicy policy=OVERFLOW_BLOCK);
+
+        /**
+         * @brief  Gets the asynchronous queue overflow policy.
+         * @pre  Stream is valid.
+         */
+        OverflowPolicy overflowPolicy() const;
+
+        /**
+         * @brief  Gets the asynchronous queue counters.
+         * @pre  Stream is valid.
+         */
+        AsyncStatistics asyncStatistics() const;
+
     protected:
         /// @cond IMPL
         typedef OutputStream<PortType> Base;
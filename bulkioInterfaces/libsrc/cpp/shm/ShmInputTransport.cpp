@@ -25,6 +25,7 @@
 #include <boost/thread.hpp>
 
 #include <ossie/shm/Heap.h>
+#include <ossie/affinity.h>
 
 #include <BulkioTransport.h>
 #include <bulkio_in_port.h>
@@ -95,6 +96,8 @@ namespace bulkio {
 
         void _run()
         {
+            redhawk::affinity::apply_thread_affinity(redhawk::affinity::TRANSPORT_THREAD);
+
             // Give the FIFO up to a second to sychronize with the other
             // side. This method is being run on a thread that gets started
             // when the transport is negotiated, so the uses side may take a
@@ -22,8 +22,10 @@
 #include "FifoIPC.h"
 #include "MessageBuffer.h"
 
+#include <map>
 #include <numeric>
 
+#include <ossie/shm/Allocator.h>
 #include <ossie/shm/Heap.h>
 
 #include <bulkio_in_port.h>
@@ -73,14 +75,19 @@ namespace bulkio {
         typedef typename BufferType::value_type ElementType;
         typedef typename CorbaTraits<PortType>::TransportType TransportType;
 
-        ShmOutputTransport(OutPort<PortType>* parent, PtrType port) :
+        ShmOutputTransport(OutPort<PortType>* parent, PtrType port, const std::string& connectionId) :
             OutputTransport<PortType>(parent, port),
-            _fifo()
+            _fifo(),
+            // Tag copies made for this connection so that heap accounting
+            // (e.g., "shminfo --live") can attribute them; the tag is interned
+            // once, and released with the connection
+            _allocationTag(redhawk::shm::internAllocationTag(parent->getName() + "/" + connectionId))
         {
         }
 
         ~ShmOutputTransport()
         {
+            redhawk::shm::releaseAllocationTag(_allocationTag);
         }
 
         virtual std::string transportType() const
@@ -111,6 +118,7 @@ namespace bulkio {
         {
             OutputTransport<PortType>::disconnect();
             _fifo.disconnect();
+            _streamCopies.clear();
         }
 
     protected:
@@ -166,6 +174,7 @@ namespace bulkio {
                     // failure, as opposed to throwing an exception)
                     size_t count = data.size();
                     size_t bytes = count * sizeof(ElementType);
+                    redhawk::shm::ScopedAllocationTag tag(_allocationTag);
                     ElementType* ptr = static_cast<ElementType*>(redhawk::shm::allocate(bytes));
                     if (ptr) {
                         // Make a copy of the data into the new shared memory,
@@ -193,6 +202,11 @@ namespace bulkio {
 
             ShmStatPoint stat(body_size == 0, !copy.empty());
             _recordExtendedStatistics(stat);
+            if (EOS) {
+                _streamCopies.erase(streamID);
+            } else if (stat.copied) {
+                _countCopy(streamID);
+            }
         }
 
         virtual redhawk::PropertyMap _getExtendedStatistics()
@@ -220,6 +234,27 @@ namespace bulkio {
             }
         }
 
+        void _countCopy(const std::string& streamID)
+        {
+            CopyCountMap::iterator copies = _streamCopies.find(streamID);
+            if (copies == _streamCopies.end()) {
+                // Streams that never end would otherwise accumulate forever;
+                // losing the counts only delays the hint
+                if (_streamCopies.size() >= MAX_TRACKED_STREAMS) {
+                    _streamCopies.clear();
+                }
+                copies = _streamCopies.insert(std::make_pair(streamID, 0)).first;
+            }
+
+            // Once a stream has needed enough copies, tell the port; the
+            // stream keeps the preference until it ends, so the count is no
+            // longer needed
+            if (++(copies->second) >= COPY_THRESHOLD) {
+                _streamCopies.erase(copies);
+                this->_hintSharedMemory();
+            }
+        }
+
         bool _transferBuffer(MessageBuffer& header, const void* base, size_t offset)
         {
             redhawk::shm::MemoryRef ref = redhawk::shm::Heap::getRef(base);
@@ -270,8 +305,16 @@ namespace bulkio {
         }
 
         FifoEndpoint _fifo;
+        const uint32_t _allocationTag;
 
         std::deque<ShmStatPoint> _extendedStats;
+
+        // Number of packets per stream that had to be copied into shared
+        // memory, for feedback to the stream's allocation policy
+        static const size_t COPY_THRESHOLD = 2;
+        static const size_t MAX_TRACKED_STREAMS = 64;
+        typedef std::map<std::string,size_t> CopyCountMap;
+        CopyCountMap _streamCopies;
     };
 
     template <typename PortType>
@@ -324,7 +367,7 @@ namespace bulkio {
             return 0;
         }
 
-        return new ShmOutputTransport<PortType>(this->_port, object);
+        return new ShmOutputTransport<PortType>(this->_port, object, connectionId);
     }
 
     template <typename PortType>
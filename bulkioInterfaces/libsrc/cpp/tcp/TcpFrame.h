@@ -0,0 +1,119 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef __bulkio_tcpframe_h
+#define __bulkio_tcpframe_h
+
+#include <cstring>
+#include <stdint.h>
+
+#include <ossie/BULKIO/bulkioDataTypes.h>
+
+namespace bulkio {
+
+    //
+    // Every message on a TCP transport connection starts with a fixed-size
+    // header, followed by the stream ID and then either the CDR-encoded SRI
+    // (for SRI frames) or the raw sample data (for packet frames). Sample
+    // data and header fields are sent in the native byte order, which is
+    // checked when the connection is negotiated.
+    //
+    enum TcpFrameType {
+        TCP_FRAME_SRI = 1,
+        TCP_FRAME_PACKET = 2
+    };
+
+    enum TcpFrameFlags {
+        TCP_FLAG_EOS = 1
+    };
+
+    // Upper bounds on the variable-length parts of a frame; the receiver
+    // treats a larger value as a protocol error rather than allocating it
+    const uint32_t TCP_MAX_ID_LENGTH = 4096;
+    const uint32_t TCP_MAX_SRI_LENGTH = 16 * 1024 * 1024;
+    const uint64_t TCP_MAX_DATA_LENGTH = 1024 * 1024 * 1024;
+
+    struct TcpFrameHeader {
+        // Size of the header on the wire: four 32-bit fields, the 64-bit data
+        // length, and the time stamp's two 16-bit and three double fields,
+        // with no padding
+        static const size_t ENCODED_SIZE = 52;
+
+        uint32_t type;
+        uint32_t flags;
+        uint32_t idLength;
+        uint32_t sriLength;
+        uint64_t dataLength;
+        BULKIO::PrecisionUTCTime T;
+
+        // The header is written field by field so that the layout does not
+        // depend on the compiler's structure padding
+        void encode(unsigned char* buffer) const
+        {
+            _put(buffer, type);
+            _put(buffer, flags);
+            _put(buffer, idLength);
+            _put(buffer, sriLength);
+            _put(buffer, dataLength);
+            _put(buffer, T.tcmode);
+            _put(buffer, T.tcstatus);
+            _put(buffer, T.toff);
+            _put(buffer, T.twsec);
+            _put(buffer, T.tfsec);
+        }
+
+        void decode(const unsigned char* buffer)
+        {
+            _get(buffer, type);
+            _get(buffer, flags);
+            _get(buffer, idLength);
+            _get(buffer, sriLength);
+            _get(buffer, dataLength);
+            _get(buffer, T.tcmode);
+            _get(buffer, T.tcstatus);
+            _get(buffer, T.toff);
+            _get(buffer, T.twsec);
+            _get(buffer, T.tfsec);
+        }
+
+    private:
+        template <typename Field>
+        static void _put(unsigned char*& buffer, const Field& value)
+        {
+            memcpy(buffer, &value, sizeof(Field));
+            buffer += sizeof(Field);
+        }
+
+        template <typename Field>
+        static void _get(const unsigned char*& buffer, Field& value)
+        {
+            memcpy(&value, buffer, sizeof(Field));
+            buffer += sizeof(Field);
+        }
+    };
+
+    inline const char* tcpByteOrder()
+    {
+        const uint16_t value = 1;
+        return (*reinterpret_cast<const uint8_t*>(&value) == 1) ? "little" : "big";
+    }
+}
+
+#endif // __bulkio_tcpframe_h
@@ -0,0 +1,351 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "TcpInputTransport.h"
+#include "TcpSocket.h"
+#include "TcpFrame.h"
+
+#include <vector>
+
+#include <limits.h>
+#include <unistd.h>
+
+#include <boost/thread.hpp>
+
+#include <ossie/affinity.h>
+#include <ossie/ossieSupport.h>
+
+#include <BulkioTransport.h>
+#include <bulkio_in_port.h>
+
+#include "bulkio_p.h"
+
+namespace bulkio {
+
+    template <class PortType>
+    class TcpInputTransport : public InputTransport<PortType>
+    {
+    public:
+        typedef typename NativeTraits<PortType>::NativeType NativeType;
+        typedef typename BufferTraits<PortType>::BufferType BufferType;
+
+        TcpInputTransport(InPort<PortType>* port, const std::string& transportId, const std::string& host) :
+            InputTransport<PortType>(port, transportId),
+            _running(false),
+            _listener(),
+            _socket(),
+            _token(ossie::generateUUID())
+        {
+            _listenPort = _listener.listen(host);
+        }
+
+        ~TcpInputTransport()
+        {
+            _socket.close();
+            _listener.close();
+        }
+
+        std::string transportType() const
+        {
+            return "tcp";
+        }
+
+        void startTransport()
+        {
+            _running = true;
+            _thread = boost::thread(&TcpInputTransport::_run, this);
+        }
+
+        void stopTransport()
+        {
+            {
+                boost::mutex::scoped_lock lock(_mutex);
+                if (!_running) {
+                    return;
+                }
+
+                _running = false;
+
+                // Wake up the receive thread if it is blocked on a read
+                _socket.shutdown();
+            }
+            _thread.join();
+        }
+
+        unsigned short getListenPort() const
+        {
+            return _listenPort;
+        }
+
+        // The uses side must send this token first after connecting, so that
+        // a connection from any other peer is rejected
+        const std::string& getToken() const
+        {
+            return _token;
+        }
+
+    protected:
+        bool _isRunning()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            return _running;
+        }
+
+        void _run()
+        {
+            redhawk::affinity::apply_thread_affinity(redhawk::affinity::TRANSPORT_THREAD);
+
+            // The thread is started when the transport is negotiated, so the
+            // uses side may take a moment to receive the result and connect
+            if (!_waitForConnection(10000)) {
+                return;
+            }
+
+            try {
+                while (_isRunning()) {
+                    if (!_receiveFrame()) {
+                        return;
+                    }
+                }
+            } catch (const std::exception& exc) {
+                if (_isRunning()) {
+                    RH_NL_ERROR("TcpTransport", "Error receiving on BulkIO input transport: " << exc.what());
+                }
+            }
+        }
+
+        bool _waitForConnection(int timeout)
+        {
+            // Poll in short intervals so that a transport that is stopped
+            // before the uses side connects exits promptly
+            const int interval = 100;
+            for (int elapsed = 0; elapsed < timeout; elapsed += interval) {
+                if (!_isRunning()) {
+                    return false;
+                }
+                TcpSocket connection;
+                try {
+                    if (!_listener.accept(connection, interval)) {
+                        continue;
+                    }
+                    if (!_checkToken(connection)) {
+                        RH_NL_WARN("TcpTransport", "Rejected connection from " << connection.peerAddress()
+                                   << " on BulkIO input transport");
+                        continue;
+                    }
+                } catch (const std::exception& exc) {
+                    RH_NL_WARN("TcpTransport", "Rejected connection from " << connection.peerAddress()
+                               << " on BulkIO input transport: " << exc.what());
+                    continue;
+                }
+
+                // The socket is replaced with the connection under the lock,
+                // because stopTransport() may shut it down at any time
+                boost::mutex::scoped_lock lock(_mutex);
+                if (!_running) {
+                    return false;
+                }
+                _socket.swap(connection);
+                _listener.close();
+                return true;
+            }
+            RH_NL_ERROR("TcpTransport", "Timed out waiting for connection on BulkIO input transport");
+            return false;
+        }
+
+        bool _checkToken(TcpSocket& connection)
+        {
+            // Do not let a peer that connects but sends nothing hold up the
+            // expected connection
+            const int timeout = 1000;
+            if (!connection.waitReadable(timeout)) {
+                return false;
+            }
+            connection.setReadTimeout(timeout);
+            std::string token(_token.size(), '\0');
+            if (connection.read(&token[0], token.size()) != token.size()) {
+                return false;
+            }
+            connection.setReadTimeout(0);
+            return (token == _token);
+        }
+
+        bool _receiveFrame()
+        {
+            unsigned char buffer[TcpFrameHeader::ENCODED_SIZE];
+            if (_socket.read(buffer, sizeof(buffer)) != sizeof(buffer)) {
+                // Connection closed
+                return false;
+            }
+            TcpFrameHeader header;
+            header.decode(buffer);
+
+            // Check the header before allocating anything based on it; there
+            // is no way to resynchronize with the stream after a bad frame
+            _checkHeader(header);
+
+            std::string streamID(header.idLength, '\0');
+            if (header.idLength > 0) {
+                if (_socket.read(&streamID[0], header.idLength) != header.idLength) {
+                    return false;
+                }
+            }
+
+            if (header.type == TCP_FRAME_SRI) {
+                return _receiveSRI(header);
+            } else {
+                return _receivePacket(header, streamID);
+            }
+        }
+
+        void _checkHeader(const TcpFrameHeader& header)
+        {
+            if (header.idLength > TCP_MAX_ID_LENGTH) {
+                throw std::runtime_error("stream ID length exceeds limit");
+            }
+            switch (header.type) {
+            case TCP_FRAME_SRI:
+                if ((header.sriLength == 0) || (header.sriLength > TCP_MAX_SRI_LENGTH)) {
+                    throw std::runtime_error("invalid SRI length");
+                }
+                if (header.dataLength != 0) {
+                    throw std::runtime_error("SRI frame has data");
+                }
+                break;
+            case TCP_FRAME_PACKET:
+                if (header.dataLength > TCP_MAX_DATA_LENGTH) {
+                    throw std::runtime_error("data length exceeds limit");
+                }
+                if ((header.dataLength % sizeof(NativeType)) != 0) {
+                    throw std::runtime_error("data length is not a whole number of samples");
+                }
+                if (header.sriLength != 0) {
+                    throw std::runtime_error("packet frame has SRI");
+                }
+                break;
+            default:
+                throw std::runtime_error("invalid frame type");
+            }
+        }
+
+        bool _receiveSRI(const TcpFrameHeader& header)
+        {
+            _sriBuffer.resize(header.sriLength);
+            if (_socket.read(&_sriBuffer[0], _sriBuffer.size()) != _sriBuffer.size()) {
+                return false;
+            }
+
+            cdrMemoryStream stream(&_sriBuffer[0], _sriBuffer.size());
+            BULKIO::StreamSRI sri;
+            sri <<= stream;
+            this->_port->pushSRI(sri);
+            return true;
+        }
+
+        bool _receivePacket(const TcpFrameHeader& header, const std::string& streamID)
+        {
+            BufferType buffer;
+            if (header.dataLength > 0) {
+                // Read directly into a new buffer, which is then handed off to
+                // the port without further copies
+                redhawk::buffer<NativeType> temp(header.dataLength / sizeof(NativeType));
+                if (_socket.read(temp.data(), header.dataLength) != header.dataLength) {
+                    return false;
+                }
+                buffer = temp;
+            }
+
+            this->_queuePacket(buffer, header.T, (header.flags & TCP_FLAG_EOS), streamID);
+            return true;
+        }
+
+        volatile bool _running;
+        boost::mutex _mutex;
+        boost::thread _thread;
+        TcpSocket _listener;
+        TcpSocket _socket;
+        std::string _token;
+        unsigned short _listenPort;
+        std::vector<char> _sriBuffer;
+    };
+
+    template <class PortType>
+    TcpInputManager<PortType>::TcpInputManager(InPort<PortType>* port) :
+        InputManager<PortType>(port)
+    {
+        // Allow the advertised address to be overridden for hosts where the
+        // host name does not resolve to the desired interface
+        const char* host_env = getenv("BULKIO_TCP_HOST");
+        if (host_env) {
+            _hostname = host_env;
+        } else {
+            char host[HOST_NAME_MAX+1];
+            gethostname(host, sizeof(host));
+            _hostname = host;
+        }
+    }
+
+    template <class PortType>
+    std::string TcpInputManager<PortType>::transportType()
+    {
+        return "tcp";
+    }
+
+    template <class PortType>
+    CF::Properties TcpInputManager<PortType>::transportProperties()
+    {
+        return CF::Properties();
+    }
+
+    template <class PortType>
+    InputTransport<PortType>* TcpInputManager<PortType>::createInputTransport(const std::string& transportId,
+                                                                              const redhawk::PropertyMap& properties)
+    {
+        const std::string byte_order = properties.get("byte_order", "").toString();
+        if (byte_order != tcpByteOrder()) {
+            throw redhawk::FatalTransportError("byte order '" + byte_order + "' is not supported");
+        }
+        try {
+            return new TcpInputTransport<PortType>(this->_port, transportId, _hostname);
+        } catch (const std::exception& exc) {
+            throw redhawk::FatalTransportError(std::string("failed to create TCP socket: ") + exc.what());
+        }
+    }
+
+    template <class PortType>
+    redhawk::PropertyMap TcpInputManager<PortType>::getNegotiationProperties(redhawk::ProvidesTransport* providesTransport)
+    {
+        InputTransportType* transport = dynamic_cast<InputTransportType*>(providesTransport);
+        if (!transport) {
+            throw std::logic_error("invalid provides transport instance");
+        }
+        redhawk::PropertyMap properties;
+        properties["host"] = _hostname;
+        properties["port"] = static_cast<CORBA::ULong>(transport->getListenPort());
+        properties["token"] = transport->getToken();
+        return properties;
+    }
+
+#define INSTANTIATE_NUMERIC_TEMPLATE(x)         \
+    template class TcpInputTransport<x>;        \
+    template class TcpInputManager<x>;
+
+    FOREACH_NUMERIC_PORT_TYPE(INSTANTIATE_NUMERIC_TEMPLATE);
+}
@@ -0,0 +1,235 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "TcpOutputTransport.h"
+#include "TcpSocket.h"
+#include "TcpFrame.h"
+
+#include <bulkio_in_port.h>
+#include <bulkio_out_port.h>
+
+#include "bulkio_p.h"
+
+namespace bulkio {
+
+    template <typename PortType>
+    class TcpOutputTransport : public OutputTransport<PortType>
+    {
+    public:
+        typedef typename PortType::_ptr_type PtrType;
+        typedef typename OutputTransport<PortType>::BufferType BufferType;
+        typedef typename BufferType::value_type ElementType;
+
+        TcpOutputTransport(OutPort<PortType>* parent, PtrType port) :
+            OutputTransport<PortType>(parent, port),
+            _socket(),
+            _remotePort(0)
+        {
+        }
+
+        ~TcpOutputTransport()
+        {
+        }
+
+        virtual std::string transportType() const
+        {
+            return "tcp";
+        }
+
+        virtual CF::Properties transportInfo() const
+        {
+            redhawk::PropertyMap info;
+            info["host"] = _remoteHost;
+            info["port"] = static_cast<CORBA::ULong>(_remotePort);
+            return info;
+        }
+
+        void finishConnect(const std::string& host, unsigned short port, const std::string& token)
+        {
+            // Fail negotiation in a bounded time if the provides side is not
+            // reachable, so that the port can fall back to another transport
+            const int timeout = 5000;
+            _socket.connect(host, port, timeout);
+            _remoteHost = host;
+            _remotePort = port;
+
+            // Identify this connection to the provides side
+            struct iovec iov;
+            iov.iov_base = const_cast<char*>(token.data());
+            iov.iov_len = token.size();
+            _socket.writev(&iov, 1);
+        }
+
+        virtual void disconnect()
+        {
+            OutputTransport<PortType>::disconnect();
+            _socket.shutdown();
+            _socket.close();
+        }
+
+    protected:
+        virtual void _pushSRI(const BULKIO::StreamSRI& sri)
+        {
+            // SRI is sent in-band so that it is always ordered with respect to
+            // the data; CDR encoding handles the keywords and byte order
+            cdrMemoryStream stream;
+            sri >>= stream;
+
+            TcpFrameHeader header;
+            memset(&header, 0, sizeof(header));
+            header.type = TCP_FRAME_SRI;
+            header.idLength = strlen(sri.streamID);
+            header.sriLength = stream.bufSize();
+            unsigned char buffer[TcpFrameHeader::ENCODED_SIZE];
+            header.encode(buffer);
+
+            struct iovec iov[3];
+            iov[0].iov_base = buffer;
+            iov[0].iov_len = sizeof(buffer);
+            iov[1].iov_base = const_cast<char*>(static_cast<const char*>(sri.streamID));
+            iov[1].iov_len = header.idLength;
+            iov[2].iov_base = stream.bufPtr();
+            iov[2].iov_len = header.sriLength;
+            _send(iov, 3);
+        }
+
+        virtual void _pushPacket(const BufferType& data,
+                                 const BULKIO::PrecisionUTCTime& T,
+                                 bool EOS,
+                                 const std::string& streamID)
+        {
+            TcpFrameHeader header;
+            memset(&header, 0, sizeof(header));
+            header.type = TCP_FRAME_PACKET;
+            header.flags = EOS ? TCP_FLAG_EOS : 0;
+            header.idLength = streamID.size();
+            header.dataLength = data.size() * sizeof(ElementType);
+            header.T = T;
+            if (header.dataLength > TCP_MAX_DATA_LENGTH) {
+                throw redhawk::TransportError("packet exceeds maximum TCP frame size");
+            }
+            unsigned char buffer[TcpFrameHeader::ENCODED_SIZE];
+            header.encode(buffer);
+
+            // The sample data is written directly from the buffer, with no
+            // intermediate copy, and no response is expected
+            struct iovec iov[3];
+            iov[0].iov_base = buffer;
+            iov[0].iov_len = sizeof(buffer);
+            iov[1].iov_base = const_cast<char*>(streamID.data());
+            iov[1].iov_len = header.idLength;
+            iov[2].iov_base = const_cast<ElementType*>(data.data());
+            iov[2].iov_len = header.dataLength;
+            _send(iov, (header.dataLength > 0) ? 3 : 2);
+        }
+
+    private:
+        void _send(struct iovec* iov, int count)
+        {
+            try {
+                _socket.writev(iov, count);
+            } catch (const std::exception& exc) {
+                throw redhawk::FatalTransportError(exc.what());
+            }
+        }
+
+        TcpSocket _socket;
+        std::string _remoteHost;
+        unsigned short _remotePort;
+    };
+
+    template <typename PortType>
+    TcpOutputManager<PortType>::TcpOutputManager(OutPort<PortType>* port) :
+        OutputManager<PortType>(port)
+    {
+    }
+
+    template <typename PortType>
+    std::string TcpOutputManager<PortType>::transportType()
+    {
+        return "tcp";
+    }
+
+    template <typename PortType>
+    CF::Properties TcpOutputManager<PortType>::transportProperties()
+    {
+        return CF::Properties();
+    }
+
+    template <typename PortType>
+    OutputTransport<PortType>*
+    TcpOutputManager<PortType>::createOutputTransport(PtrType object,
+                                                      const std::string& connectionId,
+                                                      const redhawk::PropertyMap& properties)
+    {
+        // The provides side opens a listening socket for each connection, so
+        // the transport is only used when explicitly enabled
+        const char* tcp_env = getenv("BULKIO_TCP");
+        if (!tcp_env || (strcmp(tcp_env, "enable") != 0)) {
+            return 0;
+        }
+
+        return new TcpOutputTransport<PortType>(this->_port, object);
+    }
+
+    template <typename PortType>
+    redhawk::PropertyMap TcpOutputManager<PortType>::getNegotiationProperties(redhawk::UsesTransport* transport)
+    {
+        TransportType* tcp_transport = dynamic_cast<TransportType*>(transport);
+        if (!tcp_transport) {
+            throw std::logic_error("invalid transport type");
+        }
+
+        // Sample data is sent as-is, so both sides must agree on byte order
+        redhawk::PropertyMap properties;
+        properties["byte_order"] = std::string(tcpByteOrder());
+        return properties;
+    }
+
+    template <typename PortType>
+    void TcpOutputManager<PortType>::setNegotiationResult(redhawk::UsesTransport* transport,
+                                                          const redhawk::PropertyMap& properties)
+    {
+        TransportType* tcp_transport = dynamic_cast<TransportType*>(transport);
+        if (!tcp_transport) {
+            throw std::logic_error("invalid transport type");
+        }
+
+        if (!properties.contains("host") || !properties.contains("port") || !properties.contains("token")) {
+            throw redhawk::FatalTransportError("invalid properties for TCP connection");
+        }
+
+        std::string host = properties["host"].toString();
+        unsigned short port = properties["port"].toULong();
+        std::string token = properties["token"].toString();
+        RH_NL_DEBUG("TcpTransport", "Connecting to provides port at " << host << ":" << port);
+        try {
+            tcp_transport->finishConnect(host, port, token);
+        } catch (const std::exception& exc) {
+            throw redhawk::FatalTransportError(exc.what());
+        }
+    }
+
+#define INSTANTIATE_TEMPLATE(x)                 \
+    template class TcpOutputTransport<x>;       \
+    template class TcpOutputManager<x>;
+
+    FOREACH_NUMERIC_PORT_TYPE(INSTANTIATE_TEMPLATE);
+}
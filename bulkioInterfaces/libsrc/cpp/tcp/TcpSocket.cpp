@@ -0,0 +1,305 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "TcpSocket.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+
+namespace bulkio {
+
+    namespace {
+        static std::string getErrorMessage()
+        {
+            char temp[1024];
+            char* msg = strerror_r(errno, temp, sizeof(temp));
+            return msg;
+        }
+    }
+
+    TcpSocket::TcpSocket() :
+        _fd(-1)
+    {
+    }
+
+    TcpSocket::~TcpSocket()
+    {
+        close();
+    }
+
+    unsigned short TcpSocket::listen(const std::string& host)
+    {
+        // Bind to the advertised interface only, rather than all interfaces
+        struct addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+
+        struct addrinfo* result = 0;
+        int status = ::getaddrinfo(host.c_str(), "0", &hints, &result);
+        if (status) {
+            throw std::runtime_error("getaddrinfo " + host + ": " + gai_strerror(status));
+        }
+
+        struct sockaddr_in address;
+        memcpy(&address, result->ai_addr, sizeof(address));
+        freeaddrinfo(result);
+
+        _fd = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (_fd < 0) {
+            throw std::runtime_error("socket: " + getErrorMessage());
+        }
+
+        if (::bind(_fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address))) {
+            throw std::runtime_error("bind " + host + ": " + getErrorMessage());
+        }
+
+        // Only one connection is expected, but allow a few more so that a
+        // stray connection does not block the expected one
+        if (::listen(_fd, 4)) {
+            throw std::runtime_error("listen: " + getErrorMessage());
+        }
+
+        socklen_t length = sizeof(address);
+        if (::getsockname(_fd, reinterpret_cast<struct sockaddr*>(&address), &length)) {
+            throw std::runtime_error("getsockname: " + getErrorMessage());
+        }
+        return ntohs(address.sin_port);
+    }
+
+    bool TcpSocket::accept(TcpSocket& connection, int timeout)
+    {
+        if (!waitReadable(timeout)) {
+            return false;
+        }
+
+        int fd = ::accept(_fd, 0, 0);
+        if (fd < 0) {
+            throw std::runtime_error("accept: " + getErrorMessage());
+        }
+        connection.close();
+        connection._fd = fd;
+        return true;
+    }
+
+    void TcpSocket::connect(const std::string& host, unsigned short port, int timeout)
+    {
+        std::ostringstream service;
+        service << port;
+
+        struct addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+
+        struct addrinfo* result = 0;
+        int status = ::getaddrinfo(host.c_str(), service.str().c_str(), &hints, &result);
+        if (status) {
+            throw std::runtime_error("getaddrinfo " + host + ": " + gai_strerror(status));
+        }
+
+        std::string message = "no addresses";
+        for (struct addrinfo* info = result; info; info = info->ai_next) {
+            int fd = ::socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+            if (fd < 0) {
+                message = getErrorMessage();
+                continue;
+            }
+            if (_connect(fd, info->ai_addr, info->ai_addrlen, timeout, message)) {
+                _fd = fd;
+                break;
+            }
+            ::close(fd);
+        }
+        freeaddrinfo(result);
+
+        if (_fd < 0) {
+            throw std::runtime_error("connect " + host + ":" + service.str() + ": " + message);
+        }
+
+        // Every frame is written with a single gather call, so there is no
+        // benefit to delaying small writes
+        int enable = 1;
+        setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+    }
+
+    bool TcpSocket::_connect(int fd, const struct sockaddr* address, socklen_t length, int timeout, std::string& message)
+    {
+        // Connect in non-blocking mode so that an unreachable or filtered
+        // host fails after the timeout, instead of the system's TCP timeout
+        int flags = fcntl(fd, F_GETFL, 0);
+        fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+        if (::connect(fd, address, length) != 0) {
+            if (errno != EINPROGRESS) {
+                message = getErrorMessage();
+                return false;
+            }
+
+            struct pollfd pfd;
+            pfd.fd = fd;
+            pfd.events = POLLOUT;
+            int status;
+            do {
+                status = ::poll(&pfd, 1, timeout);
+            } while ((status < 0) && (errno == EINTR));
+            if (status == 0) {
+                message = "timed out";
+                return false;
+            } else if (status < 0) {
+                message = getErrorMessage();
+                return false;
+            }
+
+            int error = 0;
+            socklen_t error_length = sizeof(error);
+            if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_length) || error) {
+                errno = error ? error : errno;
+                message = getErrorMessage();
+                return false;
+            }
+        }
+
+        fcntl(fd, F_SETFL, flags);
+        return true;
+    }
+
+    std::string TcpSocket::peerAddress() const
+    {
+        struct sockaddr_in address;
+        socklen_t length = sizeof(address);
+        if (::getpeername(_fd, reinterpret_cast<struct sockaddr*>(&address), &length)) {
+            return "unknown";
+        }
+        char host[INET_ADDRSTRLEN];
+        if (!inet_ntop(AF_INET, &address.sin_addr, host, sizeof(host))) {
+            return "unknown";
+        }
+        std::ostringstream peer;
+        peer << host << ":" << ntohs(address.sin_port);
+        return peer.str();
+    }
+
+    bool TcpSocket::waitReadable(int timeout)
+    {
+        struct pollfd pfd;
+        pfd.fd = _fd;
+        pfd.events = POLLIN;
+        return (::poll(&pfd, 1, timeout) == 1);
+    }
+
+    void TcpSocket::setReadTimeout(int timeout)
+    {
+        struct timeval value;
+        value.tv_sec = timeout / 1000;
+        value.tv_usec = (timeout % 1000) * 1000;
+        if (setsockopt(_fd, SOL_SOCKET, SO_RCVTIMEO, &value, sizeof(value))) {
+            throw std::runtime_error("setsockopt: " + getErrorMessage());
+        }
+    }
+
+    size_t TcpSocket::read(void* buffer, size_t bytes)
+    {
+        char* ptr = static_cast<char*>(buffer);
+        size_t remain = bytes;
+        while (remain > 0) {
+            ssize_t pass = ::recv(_fd, ptr, remain, 0);
+            if (pass <= 0) {
+                if (pass < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    throw std::runtime_error("read failed: " + getErrorMessage());
+                }
+                break;
+            }
+            remain -= pass;
+            ptr += pass;
+        }
+        return (bytes - remain);
+    }
+
+    void TcpSocket::writev(struct iovec* iov, int count)
+    {
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = count;
+
+        while (msg.msg_iovlen > 0) {
+            // Suppress SIGPIPE if the other side has gone away; the error is
+            // reported via the return value instead
+            ssize_t pass = ::sendmsg(_fd, &msg, MSG_NOSIGNAL);
+            if (pass < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("write failed: " + getErrorMessage());
+            }
+
+            // Skip over the buffers that were completely written, and adjust
+            // the first partially written one
+            size_t written = pass;
+            while ((msg.msg_iovlen > 0) && (written >= msg.msg_iov->iov_len)) {
+                written -= msg.msg_iov->iov_len;
+                ++msg.msg_iov;
+                --msg.msg_iovlen;
+            }
+            if (msg.msg_iovlen > 0) {
+                msg.msg_iov->iov_base = static_cast<char*>(msg.msg_iov->iov_base) + written;
+                msg.msg_iov->iov_len -= written;
+            }
+        }
+    }
+
+    void TcpSocket::shutdown()
+    {
+        if (_fd >= 0) {
+            ::shutdown(_fd, SHUT_RDWR);
+        }
+    }
+
+    void TcpSocket::close()
+    {
+        if (_fd >= 0) {
+            ::close(_fd);
+            _fd = -1;
+        }
+    }
+
+    void TcpSocket::swap(TcpSocket& other)
+    {
+        std::swap(_fd, other._fd);
+    }
+}
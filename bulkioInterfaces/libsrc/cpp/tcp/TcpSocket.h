@@ -0,0 +1,84 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef __bulkio_tcpsocket_h
+#define __bulkio_tcpsocket_h
+
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace bulkio {
+
+    class TcpSocket {
+    public:
+        TcpSocket();
+        ~TcpSocket();
+
+        // Listens on the interface that the given host name resolves to,
+        // using a port chosen by the operating system, and returns the port
+        // number
+        unsigned short listen(const std::string& host);
+
+        // Waits up to timeout milliseconds for a connection on a listening
+        // socket; on success, the connection is stored in the given socket
+        bool accept(TcpSocket& connection, int timeout);
+
+        // Connects to the given address, failing if the connection is not
+        // established within timeout milliseconds
+        void connect(const std::string& host, unsigned short port, int timeout);
+
+        // Returns the address of the connected peer, for error messages
+        std::string peerAddress() const;
+
+        // Waits up to timeout milliseconds for data to read
+        bool waitReadable(int timeout);
+
+        // Sets the maximum time that read() blocks without receiving data; 0
+        // means no limit
+        void setReadTimeout(int timeout);
+
+        // Reads exactly the requested number of bytes, unless the connection
+        // is closed first
+        size_t read(void* buffer, size_t bytes);
+
+        // Writes all of the buffers as a single gather operation, retrying
+        // as needed on partial writes
+        void writev(struct iovec* iov, int count);
+
+        // Stops any further transfers; a blocked read returns immediately
+        void shutdown();
+        void close();
+
+        void swap(TcpSocket& other);
+
+    private:
+        // Non-copyable
+        TcpSocket(const TcpSocket&);
+        TcpSocket& operator=(const TcpSocket&);
+
+        static bool _connect(int fd, const struct sockaddr* address, socklen_t length, int timeout, std::string& message);
+
+        int _fd;
+    };
+}
+
+#endif // __bulkio_tcpsocket_h
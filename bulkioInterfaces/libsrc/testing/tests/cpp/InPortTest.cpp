@@ -20,7 +20,9 @@
 
 #include "InPortTest.h"
 
+#include <boost/bind.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
 
 class SriListener {
 public:
@@ -109,6 +111,94 @@ void InPortTest<Port>::testGetPacketStreamRemoved()
     CPPUNIT_ASSERT(streams.empty());
 }
 
+template <class Port>
+void InPortTest<Port>::testGetPacketStreamId()
+{
+    // Interleave packets from two streams
+    BULKIO::StreamSRI sri_a = bulkio::sri::create("stream_a");
+    port->pushSRI(sri_a);
+    BULKIO::StreamSRI sri_b = bulkio::sri::create("stream_b");
+    port->pushSRI(sri_b);
+
+    BULKIO::PrecisionUTCTime ts = bulkio::time::utils::now();
+    this->_pushTestPacket(10, ts, false, "stream_a");
+    this->_pushTestPacket(20, ts, false, "stream_b");
+    this->_pushTestPacket(11, ts, false, "stream_a");
+    this->_pushTestPacket(21, ts, true, "stream_b");
+    CPPUNIT_ASSERT_EQUAL(4, port->getCurrentQueueDepth());
+
+    // Reading one stream returns its packets in order, skipping the other
+    // stream's packets
+    boost::scoped_ptr<PacketType> packet;
+    packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING, "stream_b"));
+    CPPUNIT_ASSERT(packet);
+    CPPUNIT_ASSERT_EQUAL(std::string("stream_b"), packet->streamID);
+    CPPUNIT_ASSERT_EQUAL((size_t) 20, packet->dataBuffer.size());
+    CPPUNIT_ASSERT(!packet->EOS);
+    packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING, "stream_b"));
+    CPPUNIT_ASSERT(packet);
+    CPPUNIT_ASSERT_EQUAL((size_t) 21, packet->dataBuffer.size());
+    CPPUNIT_ASSERT(packet->EOS);
+
+    // The stream has ended; there is nothing more to read for it
+    packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING, "stream_b"));
+    CPPUNIT_ASSERT(!packet);
+    CPPUNIT_ASSERT_EQUAL(2, port->getCurrentQueueDepth());
+
+    // The other stream is unaffected
+    packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING, "stream_a"));
+    CPPUNIT_ASSERT(packet);
+    CPPUNIT_ASSERT_EQUAL((size_t) 10, packet->dataBuffer.size());
+    packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING, "stream_a"));
+    CPPUNIT_ASSERT(packet);
+    CPPUNIT_ASSERT_EQUAL((size_t) 11, packet->dataBuffer.size());
+    CPPUNIT_ASSERT_EQUAL(0, port->getCurrentQueueDepth());
+
+    // A new instance of the ended stream can be read
+    port->pushSRI(sri_b);
+    this->_pushTestPacket(5, ts, false, "stream_b");
+    packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING, "stream_b"));
+    CPPUNIT_ASSERT(packet);
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, packet->dataBuffer.size());
+    CPPUNIT_ASSERT(packet->sriChanged);
+}
+
+template <class Port>
+void InPortTest<Port>::testGetPacketStreamIdWait()
+{
+    BULKIO::StreamSRI sri = bulkio::sri::create("stream_wait");
+    port->pushSRI(sri);
+    BULKIO::StreamSRI other_sri = bulkio::sri::create("stream_other");
+    port->pushSRI(other_sri);
+
+    // Data for another stream does not satisfy the wait
+    BULKIO::PrecisionUTCTime ts = bulkio::time::utils::now();
+    this->_pushTestPacket(10, ts, false, "stream_other");
+    boost::scoped_ptr<PacketType> packet;
+    packet.reset(port->getPacket(0.1, "stream_wait"));
+    CPPUNIT_ASSERT(!packet);
+    CPPUNIT_ASSERT_EQUAL(1, port->getCurrentQueueDepth());
+
+    // Push data for the other stream and then for the waited-on stream from
+    // another thread; the reader should only return the latter
+    boost::thread pusher(boost::bind(&InPortTest<Port>::_pushDelayed, this, ts));
+    packet.reset(port->getPacket(2.0, "stream_wait"));
+    pusher.join();
+    CPPUNIT_ASSERT(packet);
+    CPPUNIT_ASSERT_EQUAL(std::string("stream_wait"), packet->streamID);
+    CPPUNIT_ASSERT_EQUAL((size_t) 30, packet->dataBuffer.size());
+    CPPUNIT_ASSERT_EQUAL(2, port->getCurrentQueueDepth());
+}
+
+template <class Port>
+void InPortTest<Port>::_pushDelayed(const BULKIO::PrecisionUTCTime& ts)
+{
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    this->_pushTestPacket(20, ts, false, "stream_other");
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    this->_pushTestPacket(30, ts, false, "stream_wait");
+}
+
 template <class Port>
 void InPortTest<Port>::testActiveSRIs()
 {
@@ -931,6 +1021,50 @@ void NumericInPortTest<Port>::testQueueFlushScenarios()
     CPPUNIT_ASSERT_EQUAL(number_alive_streams, 3);
 }
 
+template <class Port>
+void NumericInPortTest<Port>::testQueueBytes()
+{
+    BULKIO::StreamSRI sri = bulkio::sri::create("queue_bytes");
+    sri.blocking = false;
+    port->pushSRI(sri);
+
+    // With no byte limit, only the depth matters
+    CPPUNIT_ASSERT_EQUAL((size_t)0, port->getMaxQueueBytes());
+    this->_pushTestPacket(16, bulkio::time::utils::now(), false, sri.streamID);
+    const size_t packet_bytes = port->getCurrentQueueBytes();
+    CPPUNIT_ASSERT(packet_bytes > 0);
+
+    // Allow exactly three packets' worth of data
+    port->setMaxQueueBytes(packet_bytes * 3);
+    this->_pushTestPacket(16, bulkio::time::utils::now(), false, sri.streamID);
+    this->_pushTestPacket(16, bulkio::time::utils::now(), false, sri.streamID);
+    CPPUNIT_ASSERT_EQUAL(3, port->getCurrentQueueDepth());
+    CPPUNIT_ASSERT_EQUAL(packet_bytes * 3, port->getCurrentQueueBytes());
+
+    // The next packet should only discard the oldest one, not the whole queue
+    this->_pushTestPacket(16, bulkio::time::utils::now(), false, sri.streamID);
+    CPPUNIT_ASSERT_EQUAL(3, port->getCurrentQueueDepth());
+    CPPUNIT_ASSERT_EQUAL(packet_bytes * 3, port->getCurrentQueueBytes());
+
+    // The first remaining packet reports the flush and inherits the SRI change
+    // from the discarded packet
+    boost::scoped_ptr<PacketType> packet;
+    packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING));
+    CPPUNIT_ASSERT(packet);
+    CPPUNIT_ASSERT(packet->inputQueueFlushed);
+    CPPUNIT_ASSERT(packet->sriChanged);
+    for (int ii = 0; ii < 2; ++ii) {
+        packet.reset(port->getPacket(bulkio::Const::NON_BLOCKING));
+        CPPUNIT_ASSERT(packet);
+        CPPUNIT_ASSERT(!packet->inputQueueFlushed);
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t)0, port->getCurrentQueueBytes());
+
+    // A packet larger than the limit is still accepted into an empty queue
+    this->_pushTestPacket(64, bulkio::time::utils::now(), false, sri.streamID);
+    CPPUNIT_ASSERT_EQUAL(1, port->getCurrentQueueDepth());
+}
+
 template <class Port>
 void InPortTest<Port>::testQueueFlushFlags()
 {
@@ -31,6 +31,8 @@ class InPortTest : public InPortTestFixture<Port>
     CPPUNIT_TEST(testLegacyAPI);
     CPPUNIT_TEST(testGetPacket);
     CPPUNIT_TEST(testGetPacketStreamRemoved);
+    CPPUNIT_TEST(testGetPacketStreamId);
+    CPPUNIT_TEST(testGetPacketStreamIdWait);
     CPPUNIT_TEST(testActiveSRIs);
     CPPUNIT_TEST(testStreamIds);
     CPPUNIT_TEST(testQueueDepth);
@@ -48,6 +50,8 @@ public:
     void testLegacyAPI();
     void testGetPacket();
     void testGetPacketStreamRemoved();
+    void testGetPacketStreamId();
+    void testGetPacketStreamIdWait();
     void testActiveSRIs();
     void testStreamIds();
     void testQueueDepth();
@@ -66,6 +70,8 @@ protected:
 
     static const size_t BITS_PER_ELEMENT;
 
+    void _pushDelayed(const BULKIO::PrecisionUTCTime& ts);
+
     using TestBase::port;
 };
 
@@ -75,10 +81,12 @@ class NumericInPortTest : public InPortTest<Port>
     typedef InPortTest<Port> TestBase;
     CPPUNIT_TEST_SUB_SUITE(NumericInPortTest, TestBase);
     CPPUNIT_TEST(testQueueFlushScenarios);
+    CPPUNIT_TEST(testQueueBytes);
     CPPUNIT_TEST_SUITE_END();
 
 public:
     void testQueueFlushScenarios();
+    void testQueueBytes();
 
 protected:
     typedef typename Port::dataTransfer PacketType;
@@ -977,6 +977,42 @@ void BufferedInStreamTest<Port>::testDisableDiscard()
     CPPUNIT_ASSERT_EQUAL((size_t) 0, stream.samplesAvailable());
 }
 
+template <class Port>
+void BufferedInStreamTest<Port>::testMultipleStreams()
+{
+    // Interleave packets from two streams
+    BULKIO::StreamSRI sri_a = bulkio::sri::create("multiple_a");
+    port->pushSRI(sri_a);
+    BULKIO::StreamSRI sri_b = bulkio::sri::create("multiple_b");
+    port->pushSRI(sri_b);
+    for (int ii = 0; ii < 3; ++ii) {
+        this->_pushTestPacket(10, bulkio::time::utils::now(), false, sri_a.streamID);
+        this->_pushTestPacket(20, bulkio::time::utils::now(), false, sri_b.streamID);
+    }
+    this->_pushTestPacket(10, bulkio::time::utils::now(), true, sri_a.streamID);
+    CPPUNIT_ASSERT_EQUAL(7, port->getCurrentQueueDepth());
+
+    // Each stream only counts its own packets
+    StreamType stream_a = port->getStream("multiple_a");
+    CPPUNIT_ASSERT(stream_a);
+    StreamType stream_b = port->getStream("multiple_b");
+    CPPUNIT_ASSERT(stream_b);
+    CPPUNIT_ASSERT_EQUAL((size_t) 40, stream_a.samplesAvailable());
+    CPPUNIT_ASSERT_EQUAL((size_t) 60, stream_b.samplesAvailable());
+
+    // Disabling a stream discards its packets, up to and including the
+    // end-of-stream, without affecting the other stream
+    stream_a.disable();
+    CPPUNIT_ASSERT_EQUAL(3, port->getCurrentQueueDepth());
+    CPPUNIT_ASSERT_EQUAL((size_t) 60, stream_b.samplesAvailable());
+
+    DataBlockType block = stream_b.read(60);
+    CPPUNIT_ASSERT(block);
+    CPPUNIT_ASSERT_EQUAL((size_t) 60, block.buffer().size());
+    CPPUNIT_ASSERT_EQUAL(0, port->getCurrentQueueDepth());
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, stream_b.samplesAvailable());
+}
+
 template <class Port>
 void NumericInStreamTest<Port>::testSriModeChanges()
 {
@@ -68,6 +68,7 @@ class BufferedInStreamTest : public InStreamTest<Port>
     CPPUNIT_TEST(testReadTimestamps);
     CPPUNIT_TEST(testRepeatStreamIds);
     CPPUNIT_TEST(testDisableDiscard);
+    CPPUNIT_TEST(testMultipleStreams);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -84,6 +85,7 @@ public:
     void testRepeatStreamIds();
 
     void testDisableDiscard();
+    void testMultipleStreams();
 
 protected:
     typedef typename Port::StreamType StreamType;
@@ -0,0 +1,44 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef BULKIO_NONLOCALOUTPORT_H
+#define BULKIO_NONLOCALOUTPORT_H
+
+#include <string>
+
+#include <ossie/Port_impl.h>
+
+// Disables the in-process shortcut so that the port has to negotiate a
+// transport, even though both ends are in the same process
+template <class Base>
+class NonLocalOutPort : public Base
+{
+public:
+    NonLocalOutPort(const std::string& name) :
+        Base(name)
+    {
+    }
+
+    virtual redhawk::UsesTransport* _createLocalTransport(PortBase*, CORBA::Object_ptr, const std::string&)
+    {
+        return 0;
+    }
+};
+
+#endif // BULKIO_NONLOCALOUTPORT_H
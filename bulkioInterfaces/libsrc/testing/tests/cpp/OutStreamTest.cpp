@@ -574,6 +574,67 @@ void BufferedOutStreamTest<Port>::testFlushOnBufferSizeChange()
     CPPUNIT_ASSERT_MESSAGE("Disabling buffering did not flush", stub->packets.size() == 3);
 }
 
+template <class Port>
+void BufferedOutStreamTest<Port>::testAsyncWrite()
+{
+    StreamType stream = port->createStream("test_async_write");
+    stream.setAsync(4);
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, stream.asyncDepth());
+    CPPUNIT_ASSERT_EQUAL(bulkio::OVERFLOW_BLOCK, stream.overflowPolicy());
+
+    // Write more packets than the queue can hold; with the default policy,
+    // the writer waits for room so that nothing is lost
+    BufferType buffer;
+    buffer.resize(16);
+    for (size_t index = 0; index < 10; ++index) {
+        stream.write(buffer, bulkio::time::utils::now());
+    }
+
+    // Flush waits for the queue to empty
+    stream.flush();
+    CPPUNIT_ASSERT_EQUAL((size_t) 10, stub->packets.size());
+    bulkio::AsyncStatistics stats = stream.asyncStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, stats.queueDepth);
+    CPPUNIT_ASSERT_EQUAL((size_t) 10, stats.packetsQueued);
+    CPPUNIT_ASSERT_EQUAL((size_t) 10, stats.packetsSent);
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, stats.packetsDropped);
+
+    // Changing the SRI must not affect packets already written
+    stream.write(buffer, bulkio::time::utils::now());
+    stream.xdelta(0.5);
+    stream.write(buffer, bulkio::time::utils::now());
+
+    // Closing sends any queued packets followed by end-of-stream
+    stream.close();
+    CPPUNIT_ASSERT_EQUAL((size_t) 13, stub->packets.size());
+    CPPUNIT_ASSERT(!stub->packets[10].EOS);
+    CPPUNIT_ASSERT(stub->packets.back().EOS);
+    CPPUNIT_ASSERT_EQUAL(0.5, stub->H.back().xdelta);
+}
+
+template <class Port>
+void BufferedOutStreamTest<Port>::testAsyncDrop()
+{
+    StreamType stream = port->createStream("test_async_drop");
+    stream.setAsync(2, bulkio::OVERFLOW_DROP);
+    CPPUNIT_ASSERT_EQUAL(bulkio::OVERFLOW_DROP, stream.overflowPolicy());
+
+    BufferType buffer;
+    buffer.resize(16);
+    for (size_t index = 0; index < 100; ++index) {
+        stream.write(buffer, bulkio::time::utils::now());
+    }
+    stream.close();
+
+    // Every packet is accounted for as either sent or dropped, and the
+    // end-of-stream always makes it through
+    bulkio::AsyncStatistics stats = stream.asyncStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t) 101, stats.packetsSent + stats.packetsDropped);
+    CPPUNIT_ASSERT_EQUAL(stats.packetsDropped * buffer.size(), stats.samplesDropped);
+    CPPUNIT_ASSERT_EQUAL(stats.packetsSent, stub->packets.size());
+    CPPUNIT_ASSERT(stub->packets.back().EOS);
+}
+
 template <class Port>
 void NumericOutStreamTest<Port>::testStreamWriteCheck()
 {
@@ -76,6 +76,8 @@ class BufferedOutStreamTest : public OutStreamTest<Port>
     CPPUNIT_TEST(testFlushOnClose);
     CPPUNIT_TEST(testFlushOnSriChange);
     CPPUNIT_TEST(testFlushOnBufferSizeChange);
+    CPPUNIT_TEST(testAsyncWrite);
+    CPPUNIT_TEST(testAsyncDrop);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -87,6 +89,9 @@ public:
     void testFlushOnSriChange();
     void testFlushOnBufferSizeChange();
 
+    void testAsyncWrite();
+    void testAsyncDrop();
+
 protected:
     typedef typename Port::StreamType StreamType;
     typedef typename Port::CorbaType CorbaType;
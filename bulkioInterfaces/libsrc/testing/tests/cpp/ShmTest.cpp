@@ -0,0 +1,156 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "ShmTest.h"
+#include "NonLocalOutPort.h"
+#include <bulkio/bulkio.h>
+#include <ossie/shm/Allocator.h>
+
+#include <cstdlib>
+#include <vector>
+
+template <class OutPort, class InPort>
+void ShmTest<OutPort,InPort>::setUp()
+{
+    unsetenv("BULKIO_SHM");
+
+    std::string name = bulkio::CorbaTraits<typename OutPort::CorbaType>::name();
+    outPort = new NonLocalOutPort<OutPort>(name + "_out");
+    inPort = new InPort(name + "_in");
+
+    PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->activate_object(inPort);
+
+    CORBA::Object_var objref = inPort->_this();
+    outPort->connectPort(objref, "shm_connection");
+}
+
+template <class OutPort, class InPort>
+void ShmTest<OutPort,InPort>::tearDown()
+{
+    outPort->disconnectPort("shm_connection");
+
+    try {
+        PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->servant_to_id(inPort);
+        ossie::corba::RootPOA()->deactivate_object(oid);
+    } catch (...) {
+        // Ignore CORBA exceptions
+    }
+    inPort->_remove_ref();
+
+    delete outPort;
+}
+
+template <class OutPort, class InPort>
+void ShmTest<OutPort,InPort>::testConnection()
+{
+    // Shared memory may be unavailable on the test host, in which case the
+    // port falls back to another transport
+    if (!redhawk::shm::isEnabled()) {
+        return;
+    }
+
+    ExtendedCF::ConnectionStatusSequence_var status = outPort->connectionStatus();
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, status->length());
+    CPPUNIT_ASSERT_EQUAL(std::string("shmipc"), std::string(status[0].transportType));
+    CPPUNIT_ASSERT(status[0].alive);
+}
+
+template <class OutPort, class InPort>
+void ShmTest<OutPort,InPort>::testCopyFeedback()
+{
+    if (!redhawk::shm::isEnabled()) {
+        return;
+    }
+
+    // Writing from a plain pointer sends transient, process-local buffers,
+    // which the transport has to copy into shared memory
+    OutStreamType stream = outPort->createStream("test_copy_feedback");
+    _writeLocal(stream, COPY_THRESHOLD);
+    CPPUNIT_ASSERT_EQUAL(100.0, _getCopyRate());
+
+    // Once the threshold is reached, the stream makes its own shared memory
+    // copy, so the transport stops copying; the copy rate is computed over
+    // the last 10 packets
+    _writeLocal(stream, 10);
+    CPPUNIT_ASSERT_EQUAL(0.0, _getCopyRate());
+}
+
+template <class OutPort, class InPort>
+void ShmTest<OutPort,InPort>::testCopyFeedbackPerStream()
+{
+    if (!redhawk::shm::isEnabled()) {
+        return;
+    }
+
+    // Get one stream past the threshold
+    OutStreamType first = outPort->createStream("test_copy_feedback_1");
+    _writeLocal(first, COPY_THRESHOLD);
+
+    // The hint only applies to the stream that was copied; another stream
+    // is still copied by the transport
+    OutStreamType second = outPort->createStream("test_copy_feedback_2");
+    _writeLocal(second, 1);
+    CPPUNIT_ASSERT_EQUAL(100.0, _getCopyRate());
+
+    _writeLocal(first, 10);
+    CPPUNIT_ASSERT_EQUAL(0.0, _getCopyRate());
+
+    // Ending the stream clears the hint, so a new stream with the same ID is
+    // copied again: of the last 10 packets, 8 are from the old stream, one
+    // is the end-of-stream and one is copied
+    first.close();
+    first = outPort->createStream("test_copy_feedback_1");
+    _writeLocal(first, 1);
+    CPPUNIT_ASSERT_EQUAL(10.0, _getCopyRate());
+}
+
+template <class OutPort, class InPort>
+double ShmTest<OutPort,InPort>::_getCopyRate()
+{
+    BULKIO::UsesPortStatisticsSequence_var stats = outPort->statistics();
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, stats->length());
+    const redhawk::PropertyMap& keywords = redhawk::PropertyMap::cast(stats[0].statistics.keywords);
+    CPPUNIT_ASSERT(keywords.contains("shm::copy_rate"));
+    return keywords["shm::copy_rate"].toDouble();
+}
+
+template <class OutPort, class InPort>
+void ShmTest<OutPort,InPort>::_writeLocal(OutStreamType& stream, size_t count)
+{
+    std::vector<ScalarType> data(1024);
+    for (size_t packet = 0; packet < count; ++packet) {
+        stream.write(&data[0], data.size(), bulkio::time::utils::now());
+    }
+}
+
+#define CREATE_TEST(x)                                                  \
+    class Shm##x##Test : public ShmTest<bulkio::Out##x##Port,bulkio::In##x##Port> \
+    {                                                                   \
+        typedef ShmTest<bulkio::Out##x##Port,bulkio::In##x##Port> TestBase; \
+        CPPUNIT_TEST_SUB_SUITE(Shm##x##Test, TestBase);                 \
+        CPPUNIT_TEST_SUITE_END();                                       \
+    };                                                                  \
+    CPPUNIT_TEST_SUITE_REGISTRATION(Shm##x##Test);
+
+CREATE_TEST(Octet);
+CREATE_TEST(Short);
+CREATE_TEST(Long);
+CREATE_TEST(Float);
+CREATE_TEST(Double);
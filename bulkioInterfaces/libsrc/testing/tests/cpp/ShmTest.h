@@ -0,0 +1,59 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef BULKIO_SHMTEST_H
+#define BULKIO_SHMTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <ossie/debug.h>
+#include <bulkio/bulkio_typetraits.h>
+
+template <class OutPort, class InPort>
+class ShmTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(ShmTest);
+    CPPUNIT_TEST(testConnection);
+    CPPUNIT_TEST(testCopyFeedback);
+    CPPUNIT_TEST(testCopyFeedbackPerStream);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testConnection();
+    void testCopyFeedback();
+    void testCopyFeedbackPerStream();
+
+protected:
+    typedef typename OutPort::StreamType OutStreamType;
+    typedef typename OutStreamType::ScalarType ScalarType;
+
+    // Number of copies after which the shared memory transport asks the
+    // stream to allocate in shared memory
+    static const size_t COPY_THRESHOLD = 2;
+
+    double _getCopyRate();
+    void _writeLocal(OutStreamType& stream, size_t count);
+
+    OutPort* outPort;
+    InPort* inPort;
+};
+
+#endif // BULKIO_SHMTEST_H
@@ -0,0 +1,177 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "TcpTest.h"
+#include "NonLocalOutPort.h"
+#include <bulkio/bulkio.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+template <class OutPort, class InPort>
+void TcpTest<OutPort,InPort>::setUp()
+{
+    // Shared memory has a higher priority than TCP on the same host, and TCP
+    // is only used when enabled
+    setenv("BULKIO_SHM", "disable", 1);
+    setenv("BULKIO_TCP", "enable", 1);
+
+    std::string name = bulkio::CorbaTraits<CorbaType>::name();
+    outPort = new NonLocalOutPort<OutPort>(name + "_out");
+    inPort = new InPort(name + "_in");
+
+    PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->activate_object(inPort);
+
+    CORBA::Object_var objref = inPort->_this();
+    outPort->connectPort(objref, "tcp_connection");
+}
+
+template <class OutPort, class InPort>
+void TcpTest<OutPort,InPort>::tearDown()
+{
+    outPort->disconnectPort("tcp_connection");
+
+    try {
+        PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->servant_to_id(inPort);
+        ossie::corba::RootPOA()->deactivate_object(oid);
+    } catch (...) {
+        // Ignore CORBA exceptions
+    }
+    inPort->_remove_ref();
+
+    delete outPort;
+
+    unsetenv("BULKIO_SHM");
+    unsetenv("BULKIO_TCP");
+}
+
+template <class OutPort, class InPort>
+void TcpTest<OutPort,InPort>::testConnection()
+{
+    ExtendedCF::ConnectionStatusSequence_var status = outPort->connectionStatus();
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, status->length());
+    CPPUNIT_ASSERT_EQUAL(std::string("tcp"), std::string(status[0].transportType));
+    CPPUNIT_ASSERT(status[0].alive);
+}
+
+template <class OutPort, class InPort>
+void TcpTest<OutPort,InPort>::testDisabledByDefault()
+{
+    // Without the environment variable, a new connection falls back to the
+    // next transport
+    unsetenv("BULKIO_TCP");
+    std::string name = bulkio::CorbaTraits<CorbaType>::name();
+    NonLocalOutPort<OutPort> port(name + "_default");
+    CORBA::Object_var objref = inPort->_this();
+    port.connectPort(objref, "default_connection");
+
+    ExtendedCF::ConnectionStatusSequence_var status = port.connectionStatus();
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, status->length());
+    CPPUNIT_ASSERT(std::string("tcp") != std::string(status[0].transportType));
+    port.disconnectPort("default_connection");
+}
+
+template <class OutPort, class InPort>
+void TcpTest<OutPort,InPort>::testWrite()
+{
+    OutStreamType out_stream = outPort->createStream("test_stream");
+    MutableBufferType data(1024);
+    for (size_t index = 0; index < data.size(); ++index) {
+        data[index] = index;
+    }
+    BULKIO::PrecisionUTCTime time = bulkio::time::utils::now();
+    out_stream.write(data, time);
+
+    // Data arrives asynchronously over the socket
+    InStreamType in_stream = inPort->getCurrentStream(1.0);
+    CPPUNIT_ASSERT(in_stream);
+    CPPUNIT_ASSERT_EQUAL(std::string("test_stream"), in_stream.streamID());
+    DataBlockType block = in_stream.read();
+    CPPUNIT_ASSERT(block);
+
+    // The data has to be a copy, but the contents and time stamp must match
+    BufferType result = block.buffer();
+    CPPUNIT_ASSERT(data.data() != result.data());
+    CPPUNIT_ASSERT_EQUAL(data.size(), result.size());
+    CPPUNIT_ASSERT(std::equal(data.begin(), data.end(), result.begin()));
+    CPPUNIT_ASSERT(time == block.getStartTime());
+}
+
+template <class OutPort, class InPort>
+void TcpTest<OutPort,InPort>::testSriChange()
+{
+    OutStreamType out_stream = outPort->createStream("test_sri");
+    out_stream.xdelta(0.25);
+    out_stream.setKeyword("TEST_KEYWORD", std::string("value"));
+    out_stream.write(MutableBufferType(16), bulkio::time::utils::now());
+
+    // SRI travels on the same connection as the data, so it must be up to
+    // date by the time the first packet is read
+    InStreamType in_stream = inPort->getCurrentStream(1.0);
+    CPPUNIT_ASSERT(in_stream);
+    DataBlockType block = in_stream.read();
+    CPPUNIT_ASSERT(block);
+    CPPUNIT_ASSERT(block.sriChanged());
+    CPPUNIT_ASSERT_EQUAL(0.25, block.xdelta());
+    CPPUNIT_ASSERT_EQUAL(std::string("value"), in_stream.getKeyword("TEST_KEYWORD").toString());
+
+    // Change the SRI between writes
+    out_stream.xdelta(0.5);
+    out_stream.write(MutableBufferType(16), bulkio::time::utils::now());
+    block = in_stream.read();
+    CPPUNIT_ASSERT(block);
+    CPPUNIT_ASSERT(block.sriChanged());
+    CPPUNIT_ASSERT_EQUAL(0.5, block.xdelta());
+}
+
+template <class OutPort, class InPort>
+void TcpTest<OutPort,InPort>::testEndOfStream()
+{
+    OutStreamType out_stream = outPort->createStream("test_eos");
+    out_stream.write(MutableBufferType(16), bulkio::time::utils::now());
+    out_stream.close();
+
+    InStreamType in_stream = inPort->getCurrentStream(1.0);
+    CPPUNIT_ASSERT(in_stream);
+    DataBlockType block = in_stream.read();
+    CPPUNIT_ASSERT(block);
+    CPPUNIT_ASSERT(!in_stream.read());
+    CPPUNIT_ASSERT(in_stream.eos());
+}
+
+#define CREATE_TEST(x)                                                  \
+    class Tcp##x##Test : public TcpTest<bulkio::Out##x##Port,bulkio::In##x##Port> \
+    {                                                                   \
+        typedef TcpTest<bulkio::Out##x##Port,bulkio::In##x##Port> TestBase; \
+        CPPUNIT_TEST_SUB_SUITE(Tcp##x##Test, TestBase);                 \
+        CPPUNIT_TEST_SUITE_END();                                       \
+    };                                                                  \
+    CPPUNIT_TEST_SUITE_REGISTRATION(Tcp##x##Test);
+
+CREATE_TEST(Octet);
+CREATE_TEST(Char);
+CREATE_TEST(Short);
+CREATE_TEST(UShort);
+CREATE_TEST(Long);
+CREATE_TEST(ULong);
+CREATE_TEST(LongLong);
+CREATE_TEST(ULongLong);
+CREATE_TEST(Float);
+CREATE_TEST(Double);
@@ -0,0 +1,260 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#include <getopt.h>
+
+#include <ossie/PropertyMap.h>
+#include <bulkio/bulkio.h>
+
+/*
+ * Microbenchmarks for the SRI and timestamp helpers that BulkIO calls for
+ * every packet. Output is CSV on standard output, one line per benchmark,
+ * with the fastest and median time per operation over several passes and
+ * the number of heap allocations per operation.
+ */
+
+#if __cplusplus >= 201103L
+#  define BENCHMARK_THROW_BAD_ALLOC
+#  define BENCHMARK_NOTHROW noexcept
+#else
+#  define BENCHMARK_THROW_BAD_ALLOC throw(std::bad_alloc)
+#  define BENCHMARK_NOTHROW throw()
+#endif
+
+static volatile size_t allocation_count = 0;
+
+void* operator new(size_t size) BENCHMARK_THROW_BAD_ALLOC
+{
+    ++allocation_count;
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) BENCHMARK_THROW_BAD_ALLOC
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) BENCHMARK_NOTHROW
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) BENCHMARK_NOTHROW
+{
+    std::free(ptr);
+}
+
+static volatile size_t sink = 0;
+
+static double get_time()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + 1e-9*now.tv_nsec;
+}
+
+typedef void (*benchmark_func)(size_t);
+
+struct benchmark {
+    const char* name;
+    benchmark_func func;
+    size_t iterations;
+};
+
+static void run_benchmark(const benchmark& bench, int repeat)
+{
+    bench.func(bench.iterations / 10 + 1);
+
+    std::vector<double> times;
+    size_t allocations = 0;
+    for (int pass = 0; pass < repeat; ++pass) {
+        size_t start_count = allocation_count;
+        double start = get_time();
+        bench.func(bench.iterations);
+        double elapsed = get_time() - start;
+        allocations = allocation_count - start_count;
+        times.push_back(elapsed);
+    }
+    std::sort(times.begin(), times.end());
+
+    const double scale = 1e9 / bench.iterations;
+    std::ostringstream line;
+    line.setf(std::ios::fixed);
+    line.precision(2);
+    line << bench.name << "," << bench.iterations << ","
+         << times.front() * scale << "," << times[times.size() / 2] * scale << ","
+         << static_cast<double>(allocations) / bench.iterations;
+    std::cout << line.str() << std::endl;
+}
+
+// Creates an SRI with a representative set of keywords
+static BULKIO::StreamSRI create_sri()
+{
+    BULKIO::StreamSRI sri = bulkio::sri::create("benchmark_stream", 1e6);
+    redhawk::PropertyMap& keywords = redhawk::PropertyMap::cast(sri.keywords);
+    keywords["COL_RF"] = 1e9;
+    keywords["CHAN_RF"] = 1.0001e9;
+    keywords["COL_BW"] = 2e6;
+    keywords["DATA_REF_STR"] = "benchmark";
+    return sri;
+}
+
+static void test_sri_compare(size_t iterations)
+{
+    BULKIO::StreamSRI lhs = bulkio::sri::create("benchmark_stream", 1e6);
+    BULKIO::StreamSRI rhs = lhs;
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        sink += bulkio::sri::DefaultComparator(lhs, rhs);
+    }
+}
+
+static void test_sri_compare_keywords(size_t iterations)
+{
+    BULKIO::StreamSRI lhs = create_sri();
+    BULKIO::StreamSRI rhs = lhs;
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        sink += bulkio::sri::DefaultComparator(lhs, rhs);
+    }
+}
+
+static void test_sri_compare_fields(size_t iterations)
+{
+    BULKIO::StreamSRI lhs = create_sri();
+    BULKIO::StreamSRI rhs = lhs;
+    rhs.xdelta = 0.5;
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        sink += bulkio::sri::compareFields(lhs, rhs);
+    }
+}
+
+static void test_sri_copy(size_t iterations)
+{
+    BULKIO::StreamSRI sri = create_sri();
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        BULKIO::StreamSRI copy = sri;
+        sink += copy.keywords.length();
+    }
+}
+
+static void test_time_add(size_t iterations)
+{
+    BULKIO::PrecisionUTCTime time = bulkio::time::utils::create(1e9, 0.0);
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        time += 0.001;
+    }
+    sink += static_cast<size_t>(time.twsec);
+}
+
+static void test_time_difference(size_t iterations)
+{
+    BULKIO::PrecisionUTCTime begin = bulkio::time::utils::create(1e9, 0.25);
+    BULKIO::PrecisionUTCTime end = begin + 1.5;
+    double total = 0.0;
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        total += end - begin;
+    }
+    sink += static_cast<size_t>(total);
+}
+
+static void test_time_compare(size_t iterations)
+{
+    BULKIO::PrecisionUTCTime lhs = bulkio::time::utils::create(1e9, 0.25);
+    BULKIO::PrecisionUTCTime rhs = lhs + 1e-6;
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        sink += (lhs < rhs);
+        sink += (lhs == rhs);
+    }
+}
+
+static void test_time_now(size_t iterations)
+{
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        BULKIO::PrecisionUTCTime time = bulkio::time::utils::now();
+        sink += static_cast<size_t>(time.twsec);
+    }
+}
+
+static const benchmark benchmarks[] = {
+    { "sri-compare", &test_sri_compare, 1000000 },
+    { "sri-compare-keywords", &test_sri_compare_keywords, 100000 },
+    { "sri-compare-fields", &test_sri_compare_fields, 100000 },
+    { "sri-copy", &test_sri_copy, 100000 },
+    { "time-add", &test_time_add, 1000000 },
+    { "time-difference", &test_time_difference, 1000000 },
+    { "time-compare", &test_time_compare, 1000000 },
+    { "time-now", &test_time_now, 1000000 },
+};
+
+#define ARRAY_ELEMENTS(x) (sizeof(x) / sizeof(x[0]))
+
+int main(int argc, char* argv[])
+{
+    int repeat = 5;
+
+    struct option long_options[] = {
+        { "repeat", required_argument, 0, 0 },
+        { 0, 0, 0, 0 }
+    };
+
+    int option_index;
+    while (true) {
+        int status = getopt_long(argc, argv, "", long_options, &option_index);
+        if (status == '?') {
+            return -1;
+        } else if (status == 0) {
+            if (option_index == 0) {
+                repeat = std::max(atoi(optarg), 1);
+            }
+        } else {
+            break;
+        }
+    }
+
+    std::cout << "name,iterations,min(nsec/op),median(nsec/op),allocations/op" << std::endl;
+    for (size_t ii = 0; ii < ARRAY_ELEMENTS(benchmarks); ++ii) {
+        const benchmark& bench = benchmarks[ii];
+        // Arguments select benchmarks by name prefix
+        bool selected = (optind >= argc);
+        for (int arg = optind; arg < argc; ++arg) {
+            if (std::string(bench.name).compare(0, strlen(argv[arg]), argv[arg]) == 0) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            run_benchmark(bench, repeat);
+        }
+    }
+
+    return 0;
+}
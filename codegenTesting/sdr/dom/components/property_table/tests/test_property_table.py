@@ -0,0 +1,92 @@
+#!/usr/bin/env python
+
+import os
+
+import ossie.utils.testing
+from ossie.utils import sb
+from ossie.cf import CF
+from omniORB import any
+
+from redhawk.codegen.lang import cpp
+
+class ComponentTests(ossie.utils.testing.RHTestCase):
+    # Path to the SPD file, relative to this file. This must be set in order to
+    # launch the component.
+    SPD_FILE = '../property_table.spd.xml'
+
+    def setUp(self):
+        # Launch the component, using the selected implementation
+        self.comp = sb.launch(self.spd_file, impl=self.impl)
+
+    def tearDown(self):
+        # Clean up all sandbox artifacts created during test
+        sb.release()
+
+    def testGeneratedTable(self):
+        # The property_table option must have been honored
+        basefile = os.path.join(os.path.dirname(self.spd_file), 'cpp', 'property_table_base.cpp')
+        source = open(basefile, 'r').read()
+        self.assertTrue('PROPERTY_TABLE' in source)
+        self.assertTrue('redhawk::PropertyDescriptor' in source)
+
+    def testDefaults(self):
+        self.assertEqual(self.comp.frequency, 100e6)
+        self.assertEqual(self.comp.gain, None)
+        self.assertEqual(self.comp.model, 'table')
+        self.assertEqual(self.comp.taps, [1, 2, 3])
+        self.assertEqual(self.comp.settings.enabled, True)
+        self.assertEqual(self.comp.settings.label, 'default')
+        self.assertEqual(len(self.comp.channels), 1)
+        self.assertEqual(self.comp.channels[0].name, 'first')
+        self.assertNotEqual(self.comp.start_time.twsec, 0)
+
+    def testQueryById(self):
+        # Query each property individually, which looks it up by identifier
+        ids = ('frequency', 'gain', 'DCE:9f8b7a0e-5c1d-4e2f-8a3b-6c7d8e9f0a1b',
+               'start_time', 'taps', 'settings', 'channels')
+        for propid in ids:
+            props = self.comp.query([CF.DataType(propid, any.to_any(None))])
+            self.assertEqual(len(props), 1)
+            self.assertEqual(props[0].id, propid)
+
+        self.assertRaises(CF.UnknownProperties, self.comp.query, [CF.DataType('freq', any.to_any(None))])
+
+    def testConfigure(self):
+        self.comp.frequency = 1.5e9
+        self.assertEqual(self.comp.frequency, 1.5e9)
+        self.comp.gain = 10.0
+        self.assertEqual(self.comp.gain, 10.0)
+        self.comp.taps = [4, 5]
+        self.assertEqual(self.comp.taps, [4, 5])
+        self.comp.settings.label = 'changed'
+        self.assertEqual(self.comp.settings.label, 'changed')
+
+        self.assertRaises(CF.PropertySet.InvalidConfiguration, self.comp.configure,
+                          [CF.DataType('freq', any.to_any(1.0))])
+
+    def testPropertyHash(self):
+        # Known values that the C++ redhawk::PropertyTable::hash() must also
+        # return (see PropertyTableTest in the framework's C++ tests)
+        self.assertEqual(cpp.propertyHash('', 0), 2872998923)
+        self.assertEqual(cpp.propertyHash('a', 0), 444641715)
+        self.assertEqual(cpp.propertyHash('frequency', 0), 2731968032)
+        self.assertEqual(cpp.propertyHash('frequency', 1), 359568086)
+        self.assertEqual(cpp.propertyHash('frontend_tuner_status', 12345), 721965050)
+        self.assertEqual(cpp.propertyHash(u'DCE:a4e7b230-1d17-4a86-aeff-ddc6ea3df26e', 1), 1214782043)
+
+    def testPropertyTable(self):
+        # Every identifier must land in its own slot, at its own index
+        identifiers = ['prop_%d' % ii for ii in xrange(100)]
+        table = cpp.propertyTable([{'identifier': ident} for ident in identifiers])
+        self.assertEqual(len(table['entries']), len(identifiers))
+        buckets = len(table['displacements'])
+        slots = len(table['slots'])
+        for ident in identifiers:
+            bucket = cpp.propertyHash(ident, 0) % buckets
+            slot = cpp.propertyHash(ident, table['displacements'][bucket]) % slots
+            index = table['slots'][slot]
+            self.assertEqual(table['entries'][index]['identifier'], ident)
+            self.assertEqual(table['index'][ident], index)
+
+if __name__ == "__main__":
+    ossie.utils.testing.main() # By default tests all implementations
@@ -19,6 +19,7 @@
  */
 #include "fe_tuner_device.h"
 #include <exception>
+#include <set>
 
 namespace frontend {
     template < typename TunerStatusStructType > 
@@ -258,6 +259,8 @@ namespace frontend {
     void FrontendTunerDevice<TunerStatusStructType>::construct()
     {
         Resource_impl::_started = false;
+        use_tuner_index = false;
+        use_batch_allocation = false;
         loadProperties();
     }
 
@@ -405,6 +408,40 @@ namespace frontend {
                     "external",
                     "property");
 
+        // Replace the default struct sequence wrapper with one that caches the
+        // marshaled status, so that queries and change reports for devices with
+        // many tuners only marshal the tuners that changed
+        tuner_status_property = new frontend::TunerStatusProperty<TunerStatusStructType>(frontend_tuner_status);
+        replaceProperty("FRONTEND::tuner_status", tuner_status_property);
+    }
+
+    /* Enables (or disables) comparing every tuner's status against its last reported value each
+     * time frontend_tuner_status is queried. When disabled, only the tuners passed to
+     * tunerStatusChanged() are checked.
+     */
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::enableTunerStatusPolling(bool enable)
+    {
+        tuner_status_property->setPolling(enable);
+    }
+
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::tunerStatusChanged(size_t tuner_id)
+    {
+        tuner_status_property->markChanged(tuner_id);
+    }
+
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::_updateAllocationIdCsv(size_t tuner_id)
+    {
+        frontend_tuner_status[tuner_id].allocation_id_csv = createAllocationIdCsv(tuner_id);
+        tunerStatusChanged(tuner_id);
+    }
+
+    template < typename TunerStatusStructType >
+    unsigned long long FrontendTunerDevice<TunerStatusStructType>::getTunerStatusChanges(unsigned long long since, frontend::TunerStatusDeltaSequence& changes)
+    {
+        return tuner_status_property->getChanges(since, changes);
     }
 
     template < typename TunerStatusStructType >
@@ -489,6 +526,23 @@ namespace frontend {
         exclusive_lock lock(allocation_id_mapping_lock);
         checkValidIds(capacities);
 
+        // If enabled, multiple tuner and/or listener allocations in one request are applied as a batch
+        if (use_batch_allocation) {
+            CORBA::ULong allocation_count = 0;
+            for (CORBA::ULong ii = 0; ii < capacities.length(); ++ii) {
+                const std::string id = (const char*) capacities[ii].id;
+                if (id == "FRONTEND::tuner_allocation" || id == "FRONTEND::listener_allocation") {
+                    allocation_count++;
+                } else if (id == "FRONTEND::scanner_allocation") {
+                    allocation_count = 0;
+                    break;
+                }
+            }
+            if (allocation_count > 1) {
+                return _allocateBatch(capacities);
+            }
+        }
+
         bool has_listener = false;
         for (CORBA::ULong listen_idx = 0; listen_idx < capacities.length(); ++listen_idx) {
             const std::string id = (const char*) capacities[listen_idx].id;
@@ -531,7 +585,8 @@ namespace frontend {
                     }
 
                     // Next, try to allocate a new tuner
-                    for (size_t tuner_id = 0; tuner_id < tuner_allocation_ids.size(); tuner_id++) {
+                    for (frontend::TunerIndex::Cursor candidate = getCandidateTuners(frontend_tuner_allocation); !candidate.done(); ++candidate) {
+                        const size_t tuner_id = *candidate;
                         if(frontend_tuner_status[tuner_id].tuner_type != frontend_tuner_allocation.tuner_type) {
                             RH_DEBUG(_deviceLog,
                               "allocateCapacity: Requested tuner type '"<<frontend_tuner_allocation.tuner_type <<"' does not match tuner[" << tuner_id << "].tuner_type ("<<frontend_tuner_status[tuner_id].tuner_type<<")");
@@ -572,6 +627,7 @@ namespace frontend {
                                     frontend_tuner_status[tuner_id].center_frequency = orig_cf;
                                 if (frontend_tuner_status[tuner_id].sample_rate == frontend_tuner_allocation.sample_rate)
                                     frontend_tuner_status[tuner_id].sample_rate = orig_sr;
+                                tunerStatusChanged(tuner_id);
                                 // either not available or didn't succeed setting tuning, try next tuner
                                 if ( allocated ) {
                                     RH_TRACE(_deviceLog,
@@ -586,7 +642,8 @@ namespace frontend {
                             }
                             tuner_allocation_ids[tuner_id].control_allocation_id = frontend_tuner_allocation.allocation_id;
                             allocation_id_to_tuner_id.insert(std::pair<std::string, size_t > (frontend_tuner_allocation.allocation_id, tuner_id));
-                            frontend_tuner_status[tuner_id].allocation_id_csv = createAllocationIdCsv(tuner_id);
+                            _updateAllocationIdCsv(tuner_id);
+                            _updateTunerIndex(tuner_id);
                         } else {
                             // channelizer allocations must specify device control = true
                             if(frontend_tuner_allocation.tuner_type == "CHANNELIZER" || frontend_tuner_allocation.tuner_type == "TX"){
@@ -604,34 +661,13 @@ namespace frontend {
                             }
                             tuner_allocation_ids[tuner_id].listener_allocation_ids.push_back(frontend_tuner_allocation.allocation_id);
                             allocation_id_to_tuner_id.insert(std::pair<std::string, size_t > (frontend_tuner_allocation.allocation_id, tuner_id));
-                            frontend_tuner_status[tuner_id].allocation_id_csv = createAllocationIdCsv(tuner_id);
+                            _updateAllocationIdCsv(tuner_id);
                             this->assignListener(frontend_tuner_allocation.allocation_id,tuner_allocation_ids[tuner_id].control_allocation_id);
                         }
                         // if we've reached here, we found an eligible tuner with correct frequency
 
                         // check tolerances
-                        // only check when sample_rate was not set to don't care)
-                        RH_DEBUG(_deviceLog, std::fixed << " allocateCapacity - SR requested: " << frontend_tuner_allocation.sample_rate
-                                                                                                           << "  SR got: " << frontend_tuner_status[tuner_id].sample_rate);
-                        if( (floatingPointCompare(frontend_tuner_allocation.sample_rate,0)!=0) &&
-                            (floatingPointCompare(frontend_tuner_status[tuner_id].sample_rate,frontend_tuner_allocation.sample_rate)<0 ||
-                            floatingPointCompare(frontend_tuner_status[tuner_id].sample_rate,frontend_tuner_allocation.sample_rate+frontend_tuner_allocation.sample_rate * frontend_tuner_allocation.sample_rate_tolerance/100.0)>0 )){
-                            std::ostringstream eout;
-                            eout<<std::fixed<<"allocateCapacity("<<int(tuner_id)<<"): returned sr "<<frontend_tuner_status[tuner_id].sample_rate<<" does not meet tolerance criteria of "<<frontend_tuner_allocation.sample_rate_tolerance<<" percent";
-                            RH_INFO(_deviceLog, eout.str());
-                            throw std::logic_error(eout.str().c_str());
-                        }
-                        RH_DEBUG(_deviceLog, std::fixed << " allocateCapacity - BW requested: " << frontend_tuner_allocation.bandwidth
-                                                                                                           << "  BW got: " << frontend_tuner_status[tuner_id].bandwidth);
-                        // Only check when bandwidth was not set to don't care
-                        if( (floatingPointCompare(frontend_tuner_allocation.bandwidth,0)!=0) &&
-                            (floatingPointCompare(frontend_tuner_status[tuner_id].bandwidth,frontend_tuner_allocation.bandwidth)<0 ||
-                            floatingPointCompare(frontend_tuner_status[tuner_id].bandwidth,frontend_tuner_allocation.bandwidth+frontend_tuner_allocation.bandwidth * frontend_tuner_allocation.bandwidth_tolerance/100.0)>0 )){
-                            std::ostringstream eout;
-                            eout<<std::fixed<<"allocateCapacity("<<int(tuner_id)<<"): returned bw "<<frontend_tuner_status[tuner_id].bandwidth<<" does not meet tolerance criteria of "<<frontend_tuner_allocation.bandwidth_tolerance<<" percent";
-                            RH_INFO(_deviceLog, eout.str());
-                            throw std::logic_error(eout.str().c_str());
-                        }
+                        _checkTolerances(frontend_tuner_allocation, tuner_id);
 
                         if(frontend_tuner_allocation.device_control){
                             // enable tuner after successful allocation
@@ -686,7 +722,7 @@ namespace frontend {
 
                     tuner_allocation_ids[tuner_id].listener_allocation_ids.push_back(frontend_listener_allocation.listener_allocation_id);
                     allocation_id_to_tuner_id.insert(std::pair<std::string, size_t > (frontend_listener_allocation.listener_allocation_id, tuner_id));
-                    frontend_tuner_status[tuner_id].allocation_id_csv = createAllocationIdCsv(tuner_id);
+                    _updateAllocationIdCsv(tuner_id);
                     this->assignListener(frontend_listener_allocation.listener_allocation_id,frontend_listener_allocation.existing_allocation_id);
                     return true;
                 } else if (id == "FRONTEND::scanner_allocation") {
@@ -730,6 +766,292 @@ namespace frontend {
         return true;
     }
 
+    /* Applies every tuner and listener allocation in capacities as a single, all-or-nothing
+     * operation. Controlling tuner allocations are assigned first and tuned together through
+     * deviceSetTuningBatch, so that listeners in the same batch may refer to them; if any
+     * allocation cannot be satisfied, all of the allocations made by the batch are undone.
+     * Batches that include a scanner allocation are not supported.
+     */
+    template < typename TunerStatusStructType >
+    CORBA::Boolean FrontendTunerDevice<TunerStatusStructType>::_allocateBatch(const CF::Properties & capacities)
+    {
+        RH_TRACE(_deviceLog,__PRETTY_FUNCTION__);
+        std::vector<frontend_tuner_allocation_struct> control_requests;
+        std::vector<frontend_tuner_allocation_struct> listener_requests;
+        std::vector<frontend_listener_allocation_struct> listener_allocations;
+        std::set<std::string> batch_ids;
+
+        for (CORBA::ULong ii = 0; ii < capacities.length(); ++ii) {
+            const std::string id = (const char*) capacities[ii].id;
+            if (id == "FRONTEND::tuner_allocation") {
+                frontend_tuner_allocation_struct request;
+                if (!(capacities[ii].value >>= request)) {
+                    throw CF::Device::InvalidCapacity("COULD NOT PARSE CAPACITY", capacities);
+                }
+                if (request.allocation_id.empty()) {
+                    RH_INFO(_deviceLog,"allocateCapacity: MISSING ALLOCATION_ID");
+                    throw CF::Device::InvalidCapacity("MISSING ALLOCATION_ID", capacities);
+                }
+                if (request.device_control) {
+                    control_requests.push_back(request);
+                } else {
+                    if (request.tuner_type == "CHANNELIZER" || request.tuner_type == "TX") {
+                        std::ostringstream eout;
+                        eout<<request.tuner_type<<" allocation with device_control=false is invalid.";
+                        RH_DEBUG(_deviceLog, eout.str());
+                        throw CF::Device::InvalidCapacity(eout.str().c_str(), capacities);
+                    }
+                    listener_requests.push_back(request);
+                }
+                if (!batch_ids.insert(request.allocation_id).second || getTunerMapping(request.allocation_id) >= 0) {
+                    RH_INFO(_deviceLog,"allocateCapacity: ALLOCATION_ID ALREADY IN USE: [" << request.allocation_id << "]");
+                    throw AllocationAlreadyExists("ALLOCATION_ID ALREADY IN USE", capacities);
+                }
+            } else if (id == "FRONTEND::listener_allocation") {
+                frontend_listener_allocation_struct listener;
+                if (!(capacities[ii].value >>= listener)) {
+                    throw CF::Device::InvalidCapacity("COULD NOT PARSE CAPACITY", capacities);
+                }
+                if (listener.existing_allocation_id.empty()){
+                    RH_INFO(_deviceLog,"allocateCapacity: MISSING EXISTING ALLOCATION ID");
+                    throw CF::Device::InvalidCapacity("MISSING EXISTING ALLOCATION ID", capacities);
+                }
+                if (listener.listener_allocation_id.empty()){
+                    RH_INFO(_deviceLog,"allocateCapacity: MISSING LISTENER ALLOCATION ID");
+                    throw CF::Device::InvalidCapacity("MISSING LISTENER ALLOCATION ID", capacities);
+                }
+                if (!batch_ids.insert(listener.listener_allocation_id).second || getTunerMapping(listener.listener_allocation_id) >= 0) {
+                    RH_INFO(_deviceLog,"allocateCapacity: LISTENER ALLOCATION ID ALREADY IN USE: [" << listener.listener_allocation_id << "]");
+                    throw AllocationAlreadyExists("LISTENER ALLOCATION ID ALREADY IN USE", capacities);
+                }
+                listener_allocations.push_back(listener);
+            } else {
+                throw CF::Device::InvalidCapacity("Batch allocations may only contain tuner and listener allocations", capacities);
+            }
+        }
+
+        if (!control_requests.empty() && isBusy()) {
+            return false;
+        }
+        if (this->tuner_allocation_ids.size() != this->frontend_tuner_status.size()) {
+            this->tuner_allocation_ids.resize(this->frontend_tuner_status.size());
+        }
+
+        // Select a free tuner for every controlling allocation before touching the hardware
+        std::vector<size_t> tuner_ids;
+        std::set<size_t> claimed;
+        for (size_t req_idx = 0; req_idx < control_requests.size(); ++req_idx) {
+            frontend::TunerIndex::Cursor candidate = getCandidateTuners(control_requests[req_idx]);
+            for (; !candidate.done(); ++candidate) {
+                if (!tuner_allocation_ids[*candidate].control_allocation_id.empty() || claimed.count(*candidate)) {
+                    continue;
+                }
+                if (_tunerMatchesRequest(control_requests[req_idx], *candidate)) {
+                    break;
+                }
+            }
+            if (candidate.done()) {
+                RH_INFO(_deviceLog, "allocateCapacity: NO AVAILABLE TUNER for batch allocation [" << control_requests[req_idx].allocation_id << "]");
+                return false;
+            }
+            tuner_ids.push_back(*candidate);
+            claimed.insert(*candidate);
+        }
+
+        std::vector<TunerStatusStructType> original;
+        for (size_t req_idx = 0; req_idx < tuner_ids.size(); ++req_idx) {
+            original.push_back(frontend_tuner_status[tuner_ids[req_idx]]);
+        }
+        const bool tuned = tuner_ids.empty() || deviceSetTuningBatch(control_requests, tuner_ids);
+        for (size_t req_idx = 0; req_idx < tuner_ids.size(); ++req_idx) {
+            tunerStatusChanged(tuner_ids[req_idx]);
+        }
+        if (!tuned) {
+            RH_DEBUG(_deviceLog, "allocateCapacity: batch tuning of " << tuner_ids.size() << " tuner(s) did not succeed");
+            return false;
+        }
+
+        // The default deviceSetTuningBatch checks tolerances as it goes, but an override may not;
+        // either way, every tuner must be within tolerance before any allocation is recorded
+        for (size_t req_idx = 0; req_idx < tuner_ids.size(); ++req_idx) {
+            if (!_meetsTolerances(control_requests[req_idx], tuner_ids[req_idx])) {
+                for (size_t undo_idx = 0; undo_idx < tuner_ids.size(); ++undo_idx) {
+                    deviceDeleteTuning(frontend_tuner_status[tuner_ids[undo_idx]], tuner_ids[undo_idx]);
+                    frontend_tuner_status[tuner_ids[undo_idx]] = original[undo_idx];
+                    tunerStatusChanged(tuner_ids[undo_idx]);
+                }
+                return false;
+            }
+        }
+
+        std::vector<std::string> allocated_ids;
+        std::set<size_t> modified_tuners;
+        try {
+            for (size_t req_idx = 0; req_idx < control_requests.size(); ++req_idx) {
+                const size_t tuner_id = tuner_ids[req_idx];
+                const std::string& allocation_id = control_requests[req_idx].allocation_id;
+                tuner_allocation_ids[tuner_id].control_allocation_id = allocation_id;
+                allocation_id_to_tuner_id.insert(std::pair<std::string, size_t > (allocation_id, tuner_id));
+                allocated_ids.push_back(allocation_id);
+                modified_tuners.insert(tuner_id);
+                _updateTunerIndex(tuner_id);
+            }
+
+            for (size_t req_idx = 0; req_idx < listener_requests.size(); ++req_idx) {
+                frontend_tuner_allocation_struct& request = listener_requests[req_idx];
+                frontend::TunerIndex::Cursor candidate = getCandidateTuners(request);
+                for (; !candidate.done(); ++candidate) {
+                    if (tuner_allocation_ids[*candidate].control_allocation_id.empty()) {
+                        continue;
+                    }
+                    if (_tunerMatchesRequest(request, *candidate) && listenerRequestValidation(request, *candidate) &&
+                        _meetsTolerances(request, *candidate)) {
+                        break;
+                    }
+                }
+                if (candidate.done()) {
+                    std::ostringstream eout;
+                    eout<<"allocateCapacity: NO AVAILABLE TUNER for batch listener allocation ["<<request.allocation_id<<"]";
+                    RH_INFO(_deviceLog, eout.str());
+                    throw std::logic_error(eout.str().c_str());
+                }
+                const size_t tuner_id = *candidate;
+                tuner_allocation_ids[tuner_id].listener_allocation_ids.push_back(request.allocation_id);
+                allocation_id_to_tuner_id.insert(std::pair<std::string, size_t > (request.allocation_id, tuner_id));
+                allocated_ids.push_back(request.allocation_id);
+                modified_tuners.insert(tuner_id);
+                this->assignListener(request.allocation_id, tuner_allocation_ids[tuner_id].control_allocation_id);
+            }
+
+            for (size_t req_idx = 0; req_idx < listener_allocations.size(); ++req_idx) {
+                const frontend_listener_allocation_struct& listener = listener_allocations[req_idx];
+                long tuner_id = getTunerMapping(listener.existing_allocation_id);
+                if (tuner_id < 0){
+                    RH_INFO(_deviceLog,"allocateCapacity: UNKNOWN CONTROL ALLOCATION ID: ["<< listener.existing_allocation_id <<"]");
+                    throw FRONTEND::BadParameterException("UNKNOWN CONTROL ALLOCATION ID");
+                }
+                if(frontend_tuner_status[tuner_id].tuner_type == "CHANNELIZER" || frontend_tuner_status[tuner_id].tuner_type == "TX"){
+                    std::ostringstream eout;
+                    eout<<"allocateCapacity: listener allocations are not permitted for " << std::string(frontend_tuner_status[tuner_id].tuner_type) << " tuner type";
+                    RH_DEBUG(_deviceLog, eout.str());
+                    throw CF::Device::InvalidCapacity(eout.str().c_str(), capacities);
+                }
+                tuner_allocation_ids[tuner_id].listener_allocation_ids.push_back(listener.listener_allocation_id);
+                allocation_id_to_tuner_id.insert(std::pair<std::string, size_t > (listener.listener_allocation_id, tuner_id));
+                allocated_ids.push_back(listener.listener_allocation_id);
+                modified_tuners.insert(tuner_id);
+                this->assignListener(listener.listener_allocation_id, listener.existing_allocation_id);
+            }
+
+            for (size_t req_idx = 0; req_idx < tuner_ids.size(); ++req_idx) {
+                try {
+                    enableTuner(tuner_ids[req_idx], true);
+                } catch(...){
+                    std::ostringstream eout;
+                    eout<<"allocateCapacity: Failed to enable tuner after allocation";
+                    RH_INFO(_deviceLog, eout.str());
+                    throw std::logic_error(eout.str().c_str());
+                }
+            }
+        }
+        catch(const std::logic_error &e) {
+            _rollbackBatch(allocated_ids);
+            return false;
+        }
+        catch(FRONTEND::BadParameterException &e) {
+            _rollbackBatch(allocated_ids);
+            return false;
+        }
+        catch(...){
+            _rollbackBatch(allocated_ids);
+            throw;
+        }
+
+        // Rebuild the allocation id lists once per tuner rather than once per allocation
+        for (std::set<size_t>::iterator tuner_id = modified_tuners.begin(); tuner_id != modified_tuners.end(); ++tuner_id) {
+            _updateAllocationIdCsv(*tuner_id);
+        }
+        _usageState = updateUsageState();
+        return true;
+    }
+
+    /* Undoes the allocations made by a failed batch, most recent first, so that listeners are
+     * removed before the tuners they depend on.
+     */
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::_rollbackBatch(const std::vector<std::string> &allocation_ids)
+    {
+        std::vector<std::string>::const_reverse_iterator allocation_id = allocation_ids.rbegin();
+        for (; allocation_id != allocation_ids.rend(); ++allocation_id) {
+            long tuner_id = getTunerMapping(*allocation_id);
+            if (tuner_id < 0) {
+                continue;
+            }
+            try {
+                if (tuner_allocation_ids[tuner_id].control_allocation_id == *allocation_id) {
+                    enableTuner(tuner_id, false);
+                    _removeTunerMapping(tuner_id);
+                } else {
+                    _removeTunerMapping(tuner_id, *allocation_id);
+                }
+                _updateAllocationIdCsv(tuner_id);
+            } catch ( ... ) {
+                RH_DEBUG(_deviceLog, "ERROR WHEN ROLLING BACK BATCH ALLOCATION [" << *allocation_id << "]. SKIPPING...");
+            }
+        }
+        _usageState = updateUsageState();
+    }
+
+    /* Checks the tuner type, group_id and rf_flow_id of a tuner against an allocation request.
+     */
+    template < typename TunerStatusStructType >
+    bool FrontendTunerDevice<TunerStatusStructType>::_tunerMatchesRequest(const frontend_tuner_allocation_struct &request, size_t tuner_id)
+    {
+        const TunerStatusStructType& status = frontend_tuner_status[tuner_id];
+        if (status.tuner_type != request.tuner_type) {
+            return false;
+        }
+        if (!request.group_id.empty() && request.group_id != status.group_id) {
+            return false;
+        }
+        if (!request.rf_flow_id.empty() && request.rf_flow_id != status.rf_flow_id && request.tuner_type != "CHANNELIZER") {
+            return false;
+        }
+        return true;
+    }
+
+    template < typename TunerStatusStructType >
+    bool FrontendTunerDevice<TunerStatusStructType>::deviceSetTuningBatch(const std::vector<frontend_tuner_allocation_struct> &requests, const std::vector<size_t> &tuner_ids)
+    {
+        std::vector<TunerStatusStructType> original;
+        for (size_t req_idx = 0; req_idx < requests.size(); ++req_idx) {
+            const size_t tuner_id = tuner_ids[req_idx];
+            TunerStatusStructType& status = frontend_tuner_status[tuner_id];
+            original.push_back(status);
+            // pre-load frontend_tuner_status values (just in case the request is filled but the values are not populated)
+            status.bandwidth = requests[req_idx].bandwidth;
+            status.center_frequency = requests[req_idx].center_frequency;
+            status.sample_rate = requests[req_idx].sample_rate;
+            const bool set = deviceSetTuning(requests[req_idx], status, tuner_id);
+            // Check the tolerances of each tuner as it is set, so that an out-of-tolerance tuner
+            // stops the batch before the remaining tuners are touched
+            if (!set || !_meetsTolerances(requests[req_idx], tuner_id)) {
+                if (!set) {
+                    RH_DEBUG(_deviceLog, "allocateCapacity: Tuner["<<tuner_id<<"] didn't succeed while setting tuning ");
+                }
+                // Undo this tuner and every one that was set before it
+                for (size_t undo_idx = 0; undo_idx <= req_idx; ++undo_idx) {
+                    if (undo_idx < req_idx || set) {
+                        deviceDeleteTuning(frontend_tuner_status[tuner_ids[undo_idx]], tuner_ids[undo_idx]);
+                    }
+                    frontend_tuner_status[tuner_ids[undo_idx]] = original[undo_idx];
+                }
+                return false;
+            }
+        }
+        return true;
+    }
+
     /* This sets the number of entries in the frontend_tuner_status struct sequence property
     * as well as the tuner_allocation_ids vector. Call this function during initialization
     */
@@ -747,6 +1069,7 @@ namespace frontend {
     {
         frontend_tuner_status.clear();
         tuner_allocation_ids.clear();
+        tuner_index.clear();
         addChannels(num, tuner_type);
     }
 
@@ -758,7 +1081,98 @@ namespace frontend {
             tmp.enabled = false;
             tmp.tuner_type = tuner_type;
             frontend_tuner_status.push_back(tmp);
+            _updateTunerIndex(frontend_tuner_status.size()-1);
+        }
+    }
+
+    /* Enables (or disables) all-or-nothing handling of requests that carry more than one
+     * tuner and/or listener allocation.
+     */
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::enableBatchAllocation(bool enable)
+    {
+        exclusive_lock lock(allocation_id_mapping_lock);
+        use_batch_allocation = enable;
+    }
+
+    /* Enables (or disables) the use of the tuner index during allocation. When enabling,
+     * the index is rebuilt from the current contents of frontend_tuner_status.
+     */
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::enableTunerIndex(bool enable)
+    {
+        exclusive_lock lock(allocation_id_mapping_lock);
+        use_tuner_index = enable;
+        _rebuildTunerIndex();
+    }
+
+    /* Refreshes the tuner index entry for tuner_id. Call this after changing the tuner_type,
+     * group_id, rf_flow_id, center_frequency or bandwidth of a tuner outside of allocation.
+     */
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::updateTunerIndex(size_t tuner_id)
+    {
+        exclusive_lock lock(allocation_id_mapping_lock);
+        _updateTunerIndex(tuner_id);
+    }
+
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::rebuildTunerIndex()
+    {
+        exclusive_lock lock(allocation_id_mapping_lock);
+        _rebuildTunerIndex();
+    }
+
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::_updateTunerIndex(size_t tuner_id)
+    {
+        if (!use_tuner_index) {
+            return;
+        }
+        if (tuner_id >= frontend_tuner_status.size()) {
+            tuner_index.remove(tuner_id);
+            return;
         }
+        bool allocated = false;
+        if (tuner_id < tuner_allocation_ids.size()) {
+            allocated = !tuner_allocation_ids[tuner_id].control_allocation_id.empty();
+        }
+        const TunerStatusStructType& status = frontend_tuner_status[tuner_id];
+        tuner_index.update(tuner_id, status.tuner_type, status.group_id, status.rf_flow_id,
+                           status.center_frequency, status.bandwidth, allocated);
+    }
+
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::_rebuildTunerIndex()
+    {
+        tuner_index.clear();
+        if (!use_tuner_index) {
+            return;
+        }
+        for (size_t tuner_id = 0; tuner_id < frontend_tuner_status.size(); ++tuner_id) {
+            _updateTunerIndex(tuner_id);
+        }
+    }
+
+    /* Returns a cursor over the tuners that should be considered for the allocation
+     * request; the caller advances it only past the tuners it rejects. Without the tuner
+     * index, this is every tuner in ascending order.
+     */
+    template < typename TunerStatusStructType >
+    frontend::TunerIndex::Cursor FrontendTunerDevice<TunerStatusStructType>::getCandidateTuners(const frontend_tuner_allocation_struct &request)
+    {
+        if (!use_tuner_index) {
+            return frontend::TunerIndex::Cursor(tuner_allocation_ids.size());
+        }
+        if (request.device_control) {
+            return tuner_index.findAvailable(request.tuner_type, request.group_id, request.rf_flow_id);
+        }
+        if (request.tuner_type == "CHANNELIZER" || request.tuner_type == "TX") {
+            // Rejected by allocateCapacity as soon as any matching tuner is found
+            return tuner_index.findMatching(request.tuner_type, request.group_id, request.rf_flow_id);
+        }
+        return tuner_index.findListenable(request.tuner_type, request.group_id, request.rf_flow_id,
+                                          request.center_frequency, request.bandwidth);
     }
 
         
@@ -804,12 +1218,12 @@ namespace frontend {
                     if(tuner_allocation_ids[tuner_id].control_allocation_id == frontend_tuner_allocation.allocation_id){
                         enableTuner(tuner_id, false);
                         _removeTunerMapping(tuner_id);
-                        frontend_tuner_status[tuner_id].allocation_id_csv = createAllocationIdCsv(tuner_id);
+                        _updateAllocationIdCsv(tuner_id);
                     }
                     else {
                         // send EOS to listener connection only
                         _removeTunerMapping(tuner_id,frontend_tuner_allocation.allocation_id);
-                        frontend_tuner_status[tuner_id].allocation_id_csv = createAllocationIdCsv(tuner_id);
+                        _updateAllocationIdCsv(tuner_id);
                     }
                 }
                 else if (id == "FRONTEND::listener_allocation") {
@@ -824,7 +1238,7 @@ namespace frontend {
                     }
                     // send EOS to listener connection only
                     _removeTunerMapping(tuner_id,frontend_listener_allocation.listener_allocation_id);
-                    frontend_tuner_status[tuner_id].allocation_id_csv = createAllocationIdCsv(tuner_id);
+                    _updateAllocationIdCsv(tuner_id);
                 }
                 else {
                     RH_TRACE(_deviceLog,"WARNING: UNKNOWN ALLOCATION PROPERTY \""+ std::string(property->name) + "\". IGNORING!");
@@ -842,6 +1256,41 @@ namespace frontend {
         _usageState = updateUsageState();
     }
 
+    template < typename TunerStatusStructType >
+    void FrontendTunerDevice<TunerStatusStructType>::_checkTolerances(const frontend_tuner_allocation_struct &request, size_t tuner_id) {
+        if (!_meetsTolerances(request, tuner_id)) {
+            std::ostringstream eout;
+            eout<<"allocateCapacity("<<int(tuner_id)<<"): tuner does not meet tolerance criteria";
+            throw std::logic_error(eout.str().c_str());
+        }
+    }
+
+    /* Returns true if the sample rate and bandwidth of a tuner are within the tolerances of a
+     * request. Values of 0 in the request mean "don't care" and are not checked.
+     */
+    template < typename TunerStatusStructType >
+    bool FrontendTunerDevice<TunerStatusStructType>::_meetsTolerances(const frontend_tuner_allocation_struct &request, size_t tuner_id) {
+        // only check when sample_rate was not set to don't care)
+        RH_DEBUG(_deviceLog, std::fixed << " allocateCapacity - SR requested: " << request.sample_rate
+                                        << "  SR got: " << frontend_tuner_status[tuner_id].sample_rate);
+        if( (floatingPointCompare(request.sample_rate,0)!=0) &&
+            (floatingPointCompare(frontend_tuner_status[tuner_id].sample_rate,request.sample_rate)<0 ||
+            floatingPointCompare(frontend_tuner_status[tuner_id].sample_rate,request.sample_rate+request.sample_rate * request.sample_rate_tolerance/100.0)>0 )){
+            RH_INFO(_deviceLog, std::fixed<<"allocateCapacity("<<int(tuner_id)<<"): returned sr "<<frontend_tuner_status[tuner_id].sample_rate<<" does not meet tolerance criteria of "<<request.sample_rate_tolerance<<" percent");
+            return false;
+        }
+        RH_DEBUG(_deviceLog, std::fixed << " allocateCapacity - BW requested: " << request.bandwidth
+                                        << "  BW got: " << frontend_tuner_status[tuner_id].bandwidth);
+        // Only check when bandwidth was not set to don't care
+        if( (floatingPointCompare(request.bandwidth,0)!=0) &&
+            (floatingPointCompare(frontend_tuner_status[tuner_id].bandwidth,request.bandwidth)<0 ||
+            floatingPointCompare(frontend_tuner_status[tuner_id].bandwidth,request.bandwidth+request.bandwidth * request.bandwidth_tolerance/100.0)>0 )){
+            RH_INFO(_deviceLog, std::fixed<<"allocateCapacity("<<int(tuner_id)<<"): returned bw "<<frontend_tuner_status[tuner_id].bandwidth<<" does not meet tolerance criteria of "<<request.bandwidth_tolerance<<" percent");
+            return false;
+        }
+        return true;
+    }
+
     /*****************************************************************/
     /* Tuner Configurations                                          */
     /*****************************************************************/
@@ -862,6 +1311,7 @@ namespace frontend {
             deviceDisable(frontend_tuner_status[tuner_id], tuner_id);
         }
 
+        tunerStatusChanged(tuner_id);
         return true;
     }
 
@@ -984,6 +1434,7 @@ namespace frontend {
     bool FrontendTunerDevice<TunerStatusStructType>::_removeTunerMapping(size_t tuner_id) {
         RH_TRACE(_deviceLog,__PRETTY_FUNCTION__);
         deviceDeleteTuning(frontend_tuner_status[tuner_id], tuner_id);
+        tunerStatusChanged(tuner_id);
         removeAllocationIdRouting(tuner_id);
 
         long cnt = 0;
@@ -1000,6 +1451,7 @@ namespace frontend {
             }
         }
         tuner_allocation_ids[tuner_id].reset();
+        _updateTunerIndex(tuner_id);
         return cnt > 0;
     }
 
@@ -30,6 +30,8 @@
 #include "fe_tuner_port_impl.h"
 #include "fe_rfinfo_port_impl.h"
 #include "fe_rfsource_port_impl.h"
+#include "fe_tuner_index.h"
+#include "fe_tuner_status_property.h"
 
 /*********************************************************************************************/
 /**************************              FRONTEND                   **************************/
@@ -174,6 +176,12 @@ namespace frontend {
             virtual CORBA::Boolean allocateCapacity(const CF::Properties & capacities) throw (CORBA::SystemException, CF::Device::InvalidCapacity, CF::Device::InvalidState);
             virtual void deallocateCapacity(const CF::Properties & capacities)throw (CORBA::SystemException, CF::Device::InvalidCapacity, CF::Device::InvalidState);
 
+            /* Fills changes with the tuners, and the fields within each tuner, of frontend_tuner_status
+             * that changed after version "since" and returns the current version. Pass the returned
+             * version on the next call to receive only subsequent changes, or 0 to get every tuner.
+             */
+            unsigned long long getTunerStatusChanges(unsigned long long since, frontend::TunerStatusDeltaSequence& changes);
+
         protected:
             typedef std::map<std::string, size_t> string_number_mapping;
             typedef boost::mutex::scoped_lock exclusive_lock;
@@ -185,9 +193,19 @@ namespace frontend {
             frontend::frontend_listener_allocation_struct frontend_listener_allocation;
             std::vector<TunerStatusStructType> frontend_tuner_status;
 
+            // Property wrapper for frontend_tuner_status that caches its marshaled value
+            frontend::TunerStatusProperty<TunerStatusStructType>* tuner_status_property;
+
             virtual bool callDeviceSetTuning(size_t tuner_id);
             virtual void checkValidIds(const CF::Properties & capacities);
 
+            /* Tunes several tuners at once for a batch allocation, where requests[ii] is applied to
+             * tuner_ids[ii]. Devices that can retune their hardware as a group should override this;
+             * the default calls deviceSetTuning for each tuner in turn. Return true only if every
+             * tuner was set; on failure, any tuner that was set must be returned to its prior state.
+             */
+            virtual bool deviceSetTuningBatch(const std::vector<frontend_tuner_allocation_struct> &requests, const std::vector<size_t> &tuner_ids);
+
             // tuner_allocation_ids is exclusively paired with property frontend_tuner_status.
             // tuner_allocation_ids tracks allocation ids while frontend_tuner_status provides tuner information.
             std::vector<frontend::tunerAllocationIdsStruct> tuner_allocation_ids;
@@ -196,6 +214,15 @@ namespace frontend {
             string_number_mapping allocation_id_to_tuner_id;
             boost::mutex allocation_id_mapping_lock;
 
+            // Optional index of tuners by type, group and RF flow, used to
+            // narrow the search during allocation on devices with many tuners
+            frontend::TunerIndex tuner_index;
+            bool use_tuner_index;
+
+            // When enabled, requests with more than one tuner and/or listener
+            // allocation are applied as a single all-or-nothing batch
+            bool use_batch_allocation;
+
             ///////////////////////////////
             // Device specific functions // -- virtual - to be implemented by device developer
             ///////////////////////////////
@@ -221,6 +248,36 @@ namespace frontend {
             virtual void setNumChannels(size_t num, std::string tuner_type);
             virtual void addChannels(size_t num, std::string tuner_type);
 
+            ///////////////////////////////
+            // Tuner index -- when enabled, allocation only considers the tuners whose type,
+            // group_id and rf_flow_id match the request. If the device changes tuner_type,
+            // group_id, rf_flow_id, center_frequency or bandwidth of a tuner outside of
+            // allocation, it must call updateTunerIndex(tuner_id) afterwards; the generated
+            // setTunerCenterFrequency and setTunerBandwidth do so. If it replaces
+            // frontend_tuner_status wholesale, it must call rebuildTunerIndex().
+            ///////////////////////////////
+            void enableTunerIndex(bool enable);
+            void updateTunerIndex(size_t tuner_id);
+            void rebuildTunerIndex();
+            frontend::TunerIndex::Cursor getCandidateTuners(const frontend_tuner_allocation_struct &request);
+
+            ///////////////////////////////
+            // Batch allocation -- when enabled, an allocateCapacity request that carries more
+            // than one tuner and/or listener allocation is satisfied as a whole or not at all,
+            // and controlling allocations are tuned together via deviceSetTuningBatch. When
+            // disabled (the default), only the first allocation in a request is applied.
+            ///////////////////////////////
+            void enableBatchAllocation(bool enable);
+
+            ///////////////////////////////
+            // Tuner status change detection -- by default, each query of frontend_tuner_status
+            // compares every tuner against its last reported value. Devices with many tuners can
+            // turn this off with enableTunerStatusPolling(false); they must then call
+            // tunerStatusChanged(tuner_id) after changing a tuner's status outside of allocation.
+            ///////////////////////////////
+            void enableTunerStatusPolling(bool enable);
+            void tunerStatusChanged(size_t tuner_id);
+
             // Configure tuner - gets called during allocation
             virtual bool enableTuner(size_t tuner_id, bool enable);
             virtual bool listenerRequestValidation(frontend_tuner_allocation_struct &request, size_t tuner_id);
@@ -306,6 +363,14 @@ namespace frontend {
             virtual void _deallocateCapacity(const CF::Properties & capacities)throw (CORBA::SystemException, CF::Device::InvalidCapacity, CF::Device::InvalidState);
             virtual bool _removeTunerMapping(size_t tuner_id, std::string allocation_id);
             virtual bool _removeTunerMapping(size_t tuner_id);            
+            virtual CORBA::Boolean _allocateBatch(const CF::Properties & capacities);
+            void _rollbackBatch(const std::vector<std::string> &allocation_ids);
+            bool _tunerMatchesRequest(const frontend_tuner_allocation_struct &request, size_t tuner_id);
+            void _checkTolerances(const frontend_tuner_allocation_struct &request, size_t tuner_id);
+            bool _meetsTolerances(const frontend_tuner_allocation_struct &request, size_t tuner_id);
+            void _updateAllocationIdCsv(size_t tuner_id);
+            void _updateTunerIndex(size_t tuner_id);
+            void _rebuildTunerIndex();
     };
 
     /*
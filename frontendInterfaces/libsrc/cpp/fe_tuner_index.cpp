@@ -0,0 +1,259 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK frontendInterfaces.
+ *
+ * REDHAWK frontendInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK frontendInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+
+#include "fe_tuner_index.h"
+
+namespace frontend {
+
+    namespace {
+        // Frequency comparisons in the device are done to a tenth of a Hz
+        // (see floatingPointCompare); widen the search window so that the
+        // index never excludes a tuner the full validation would accept.
+        const double FREQUENCY_MARGIN = 1.0;
+    }
+
+    bool TunerIndex::Key::operator<(const Key& other) const
+    {
+        if (tuner_type != other.tuner_type) {
+            return tuner_type < other.tuner_type;
+        }
+        if (group_id != other.group_id) {
+            return group_id < other.group_id;
+        }
+        return rf_flow_id < other.rf_flow_id;
+    }
+
+    TunerIndex::TunerIndex() :
+        _count(0)
+    {
+    }
+
+    void TunerIndex::clear()
+    {
+        _pools.clear();
+        _entries.clear();
+        _count = 0;
+    }
+
+    size_t TunerIndex::size() const
+    {
+        return _count;
+    }
+
+    void TunerIndex::update(size_t tuner_id, const std::string& tuner_type, const std::string& group_id,
+                            const std::string& rf_flow_id, double center_frequency, double bandwidth,
+                            bool allocated)
+    {
+        if (tuner_id >= _entries.size()) {
+            _entries.resize(tuner_id + 1);
+        }
+        _erase(tuner_id);
+        Entry& entry = _entries[tuner_id];
+        entry.key = Key(tuner_type, group_id, rf_flow_id);
+        entry.center_frequency = center_frequency;
+        entry.bandwidth = bandwidth;
+        entry.allocated = allocated;
+        _insert(tuner_id);
+    }
+
+    void TunerIndex::setAllocated(size_t tuner_id, bool allocated)
+    {
+        if ((tuner_id >= _entries.size()) || !_entries[tuner_id].valid) {
+            return;
+        }
+        _erase(tuner_id);
+        _entries[tuner_id].allocated = allocated;
+        _insert(tuner_id);
+    }
+
+    void TunerIndex::remove(size_t tuner_id)
+    {
+        if (tuner_id < _entries.size()) {
+            _erase(tuner_id);
+        }
+    }
+
+    TunerIndex::Cursor::Cursor(size_t count) :
+        _allocatedPool(0),
+        _next(0),
+        _end(count),
+        _current(0),
+        _done(false)
+    {
+        _advance();
+    }
+
+    void TunerIndex::Cursor::_advance()
+    {
+        // Unallocated tuners come first; take the lowest tuner id at the
+        // head of any pool. The number of pools is small, so a linear search
+        // over them is cheaper than maintaining a heap.
+        size_t best = _available.size();
+        for (size_t pool = 0; pool < _available.size(); ++pool) {
+            if (_available[pool].first == _available[pool].second) {
+                continue;
+            }
+            if ((best == _available.size()) || (*_available[pool].first < *_available[best].first)) {
+                best = pool;
+            }
+        }
+        if (best < _available.size()) {
+            _current = *(_available[best].first++);
+            return;
+        }
+
+        while (_allocatedPool < _allocated.size()) {
+            std::pair<MapIterator,MapIterator>& range = _allocated[_allocatedPool];
+            if (range.first != range.second) {
+                _current = (range.first++)->second;
+                return;
+            }
+            ++_allocatedPool;
+        }
+
+        if (_next < _end) {
+            _current = _next++;
+            return;
+        }
+        _done = true;
+    }
+
+    TunerIndex::Cursor TunerIndex::findAvailable(const std::string& tuner_type, const std::string& group_id,
+                                                 const std::string& rf_flow_id) const
+    {
+        std::vector<const Pool*> pools;
+        _findPools(tuner_type, group_id, rf_flow_id, pools);
+
+        Cursor cursor;
+        for (std::vector<const Pool*>::const_iterator pool = pools.begin(); pool != pools.end(); ++pool) {
+            cursor._available.push_back(std::make_pair((*pool)->available.begin(), (*pool)->available.end()));
+        }
+        cursor._done = false;
+        cursor._advance();
+        return cursor;
+    }
+
+    TunerIndex::Cursor TunerIndex::findMatching(const std::string& tuner_type, const std::string& group_id,
+                                                const std::string& rf_flow_id) const
+    {
+        std::vector<const Pool*> pools;
+        _findPools(tuner_type, group_id, rf_flow_id, pools);
+
+        Cursor cursor;
+        for (std::vector<const Pool*>::const_iterator pool = pools.begin(); pool != pools.end(); ++pool) {
+            cursor._available.push_back(std::make_pair((*pool)->available.begin(), (*pool)->available.end()));
+            cursor._allocated.push_back(std::make_pair((*pool)->allocated.begin(), (*pool)->allocated.end()));
+        }
+        cursor._done = false;
+        cursor._advance();
+        return cursor;
+    }
+
+    TunerIndex::Cursor TunerIndex::findListenable(const std::string& tuner_type, const std::string& group_id,
+                                                  const std::string& rf_flow_id, double center_frequency,
+                                                  double bandwidth) const
+    {
+        std::vector<const Pool*> pools;
+        _findPools(tuner_type, group_id, rf_flow_id, pools);
+
+        const double low_edge = center_frequency - (bandwidth * 0.5);
+        const double high_edge = center_frequency + (bandwidth * 0.5);
+
+        Cursor cursor;
+        for (std::vector<const Pool*>::const_iterator pool = pools.begin(); pool != pools.end(); ++pool) {
+            // A tuner can only contain the requested band if its center
+            // frequency is within half of the widest tuner bandwidth of both
+            // edges of the request
+            const double half_width = ((*pool)->max_bandwidth * 0.5) + FREQUENCY_MARGIN;
+            MapIterator begin = (*pool)->allocated.lower_bound(high_edge - half_width);
+            MapIterator end = (*pool)->allocated.upper_bound(low_edge + half_width);
+            if (begin != end) {
+                cursor._allocated.push_back(std::make_pair(begin, end));
+            }
+        }
+        cursor._done = false;
+        cursor._advance();
+        return cursor;
+    }
+
+    void TunerIndex::_insert(size_t tuner_id)
+    {
+        Entry& entry = _entries[tuner_id];
+        Pool& pool = _pools[entry.key];
+        if (entry.allocated) {
+            pool.allocated.insert(std::make_pair(entry.center_frequency, tuner_id));
+            pool.max_bandwidth = std::max(pool.max_bandwidth, entry.bandwidth);
+        } else {
+            pool.available.insert(tuner_id);
+        }
+        entry.valid = true;
+        ++_count;
+    }
+
+    void TunerIndex::_erase(size_t tuner_id)
+    {
+        Entry& entry = _entries[tuner_id];
+        if (!entry.valid) {
+            return;
+        }
+        PoolMap::iterator pool = _pools.find(entry.key);
+        if (pool != _pools.end()) {
+            if (entry.allocated) {
+                std::multimap<double,size_t>::iterator iter = pool->second.allocated.lower_bound(entry.center_frequency);
+                for (; iter != pool->second.allocated.end() && iter->first == entry.center_frequency; ++iter) {
+                    if (iter->second == tuner_id) {
+                        pool->second.allocated.erase(iter);
+                        break;
+                    }
+                }
+            } else {
+                pool->second.available.erase(tuner_id);
+            }
+            // Empty pools are kept, so that an outstanding Cursor's ranges
+            // stay valid; there is one per distinct key
+        }
+        entry.valid = false;
+        --_count;
+    }
+
+    void TunerIndex::_findPools(const std::string& tuner_type, const std::string& group_id,
+                                const std::string& rf_flow_id, std::vector<const Pool*>& pools) const
+    {
+        // Channelizer allocations specify the input stream, which determines
+        // the rf_flow_id, so it is not used to select a tuner
+        const bool match_flow = !rf_flow_id.empty() && (tuner_type != "CHANNELIZER");
+
+        // Keys are sorted by tuner type first, so all of the pools for the
+        // requested type are contiguous
+        PoolMap::const_iterator pool = _pools.lower_bound(Key(tuner_type, "", ""));
+        for (; pool != _pools.end() && pool->first.tuner_type == tuner_type; ++pool) {
+            if (!group_id.empty() && (pool->first.group_id != group_id)) {
+                continue;
+            }
+            if (match_flow && (pool->first.rf_flow_id != rf_flow_id)) {
+                continue;
+            }
+            pools.push_back(&(pool->second));
+        }
+    }
+
+}; // end frontend namespace
@@ -0,0 +1,205 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK frontendInterfaces.
+ *
+ * REDHAWK frontendInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK frontendInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef FE_TUNER_INDEX_H
+#define FE_TUNER_INDEX_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+namespace frontend {
+
+    /*
+     * TunerIndex keeps track of the tuners of a FrontendTunerDevice grouped by
+     * tuner type, group id and RF flow id, so that allocation does not have
+     * to scan every entry of frontend_tuner_status for each request.
+     *
+     * For each (tuner_type, group_id, rf_flow_id) key, the index maintains:
+     *   - a free-list of the tuners that do not have a controlling allocation
+     *   - the allocated tuners ordered by center frequency, along with the
+     *     largest bandwidth seen, to narrow down listener candidates
+     *
+     * The index only narrows down the set of tuners to consider; the device
+     * still applies its full validation to each candidate. Candidates are
+     * visited through a Cursor, which walks the index in place, so that an
+     * allocation only pays for the candidates it rejects. Unallocated tuners
+     * are visited in ascending tuner id order so that the allocation behavior
+     * matches the linear search.
+     */
+    class TunerIndex {
+    private:
+        typedef std::set<size_t>::const_iterator SetIterator;
+        typedef std::multimap<double,size_t>::const_iterator MapIterator;
+
+    public:
+        /*
+         * Visits a sequence of candidate tuners:
+         *
+         *   for (TunerIndex::Cursor cursor = ...; !cursor.done(); ++cursor) {
+         *       size_t tuner_id = *cursor;
+         *   }
+         *
+         * A cursor remains valid while tuners are updated in the index,
+         * although it may or may not visit tuners that are added after it
+         * was created.
+         */
+        class Cursor {
+        public:
+            // Visits every tuner id in [0, count), for use without an index
+            explicit Cursor(size_t count=0);
+
+            bool done() const
+            {
+                return _done;
+            }
+
+            size_t operator*() const
+            {
+                return _current;
+            }
+
+            Cursor& operator++()
+            {
+                _advance();
+                return *this;
+            }
+
+        private:
+            friend class TunerIndex;
+
+            void _advance();
+
+            // Unallocated tuners, merged by tuner id across pools
+            std::vector<std::pair<SetIterator,SetIterator> > _available;
+            // Allocated tuners, visited one pool after another
+            std::vector<std::pair<MapIterator,MapIterator> > _allocated;
+            size_t _allocatedPool;
+            // Linear range, when not using an index
+            size_t _next;
+            size_t _end;
+
+            size_t _current;
+            bool _done;
+        };
+
+        TunerIndex();
+
+        // Removes all tuners from the index
+        void clear();
+
+        // Returns the number of tuners in the index
+        size_t size() const;
+
+        // Adds or updates the entry for the given tuner
+        void update(size_t tuner_id, const std::string& tuner_type, const std::string& group_id,
+                    const std::string& rf_flow_id, double center_frequency, double bandwidth,
+                    bool allocated);
+
+        // Updates only the allocation state of the given tuner
+        void setAllocated(size_t tuner_id, bool allocated);
+
+        // Removes the given tuner from the index
+        void remove(size_t tuner_id);
+
+        /*
+         * Visits the unallocated tuners matching the request, in ascending
+         * tuner id order. An empty group_id or rf_flow_id matches any tuner;
+         * CHANNELIZER requests ignore rf_flow_id because the allocation
+         * specifies the input stream.
+         */
+        Cursor findAvailable(const std::string& tuner_type, const std::string& group_id,
+                             const std::string& rf_flow_id) const;
+
+        /*
+         * Visits all of the tuners matching the request, the unallocated ones
+         * first
+         */
+        Cursor findMatching(const std::string& tuner_type, const std::string& group_id,
+                            const std::string& rf_flow_id) const;
+
+        /*
+         * Visits the allocated tuners matching the request whose tuned band
+         * may contain [center_frequency-bandwidth/2:center_frequency+bandwidth/2],
+         * in order of center frequency.
+         */
+        Cursor findListenable(const std::string& tuner_type, const std::string& group_id,
+                              const std::string& rf_flow_id, double center_frequency,
+                              double bandwidth) const;
+
+    private:
+        struct Key {
+            Key(const std::string& type, const std::string& group, const std::string& flow) :
+                tuner_type(type),
+                group_id(group),
+                rf_flow_id(flow)
+            {
+            }
+
+            bool operator<(const Key& other) const;
+
+            std::string tuner_type;
+            std::string group_id;
+            std::string rf_flow_id;
+        };
+
+        struct Pool {
+            Pool() :
+                max_bandwidth(0.0)
+            {
+            }
+
+            std::set<size_t> available;
+            std::multimap<double,size_t> allocated;
+            double max_bandwidth;
+        };
+
+        struct Entry {
+            Entry() :
+                valid(false),
+                key("", "", ""),
+                center_frequency(0.0),
+                bandwidth(0.0),
+                allocated(false)
+            {
+            }
+
+            bool valid;
+            Key key;
+            double center_frequency;
+            double bandwidth;
+            bool allocated;
+        };
+
+        typedef std::map<Key,Pool> PoolMap;
+
+        void _insert(size_t tuner_id);
+        void _erase(size_t tuner_id);
+        void _findPools(const std::string& tuner_type, const std::string& group_id,
+                        const std::string& rf_flow_id, std::vector<const Pool*>& pools) const;
+
+        PoolMap _pools;
+        std::vector<Entry> _entries;
+        size_t _count;
+    };
+
+}; // end frontend namespace
+
+#endif
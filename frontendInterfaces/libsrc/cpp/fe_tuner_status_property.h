@@ -0,0 +1,298 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK frontendInterfaces.
+ *
+ * REDHAWK frontendInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK frontendInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef FE_TUNER_STATUS_PROPERTY_H
+#define FE_TUNER_STATUS_PROPERTY_H
+
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+
+#include <ossie/PropertyInterface.h>
+#include <ossie/prop_helpers.h>
+
+namespace frontend {
+
+    /*
+     * Changes to a single entry of frontend_tuner_status: only the fields whose
+     * values changed are included. If the tuner no longer exists, removed is
+     * true and there are no fields.
+     */
+    struct TunerStatusDelta {
+        TunerStatusDelta() :
+            tuner_id(0),
+            removed(false)
+        {
+        }
+
+        CORBA::ULong tuner_id;
+        bool removed;
+        CF::Properties fields;
+    };
+
+    typedef std::vector<TunerStatusDelta> TunerStatusDeltaSequence;
+
+    /*
+     * Property wrapper for frontend_tuner_status that avoids re-marshaling the
+     * entire struct sequence on every query or change report.
+     *
+     * Each tuner's marshaled value is cached along with a copy of the value it
+     * was created from; on access, only the tuners whose value differs from
+     * the copy are marshaled again, and the complete sequence Any is rebuilt
+     * only when at least one tuner changed. Every change is stamped with a
+     * version number at the field level, so that consumers can retrieve only
+     * what changed since the last version they saw.
+     *
+     * By default, every access compares each tuner against its copy. When
+     * polling is disabled, only the tuners passed to markChanged() since the
+     * last access (and any tuners that were added) are compared.
+     *
+     * The value (and therefore the property contract) is identical to the
+     * standard struct sequence property.
+     */
+    template <typename T>
+    class TunerStatusProperty : public StructSequenceProperty<T>
+    {
+    public:
+        typedef StructSequenceProperty<T> super;
+        typedef typename super::value_type value_type;
+
+        TunerStatusProperty(value_type& value) :
+            super(value),
+            _version(0),
+            _dirty(true),
+            _polling(true)
+        {
+        }
+
+        virtual void getValue(CORBA::Any& outValue)
+        {
+            if (this->enableNil_ && this->isNil_) {
+                outValue = CORBA::Any();
+                return;
+            }
+            boost::mutex::scoped_lock lock(_cacheMutex);
+            _refresh();
+            if (_dirty) {
+                CORBA::AnySeq anySeq;
+                anySeq.length(_entries.size());
+                for (CORBA::ULong ii = 0; ii < anySeq.length(); ++ii) {
+                    anySeq[ii] = _entries[ii].any;
+                }
+                _cachedValue <<= anySeq;
+                _dirty = false;
+            }
+            outValue = _cachedValue;
+        }
+
+        virtual const value_type& getValue()
+        {
+            return super::getValue();
+        }
+
+        /*
+         * Fills changes with the tuners and fields that changed after version
+         * "since", and returns the current version. Tuners that were added
+         * after "since" include all of their fields, and tuners that were
+         * removed are reported as removed. Pass 0 to get the full status of
+         * every tuner.
+         */
+        unsigned long long getChanges(unsigned long long since, TunerStatusDeltaSequence& changes)
+        {
+            boost::mutex::scoped_lock lock(_cacheMutex);
+            _refresh();
+            changes.clear();
+            for (size_t tuner_id = 0; tuner_id < _entries.size(); ++tuner_id) {
+                const Entry& entry = _entries[tuner_id];
+                if (entry.version <= since) {
+                    continue;
+                }
+                TunerStatusDelta delta;
+                delta.tuner_id = tuner_id;
+                for (CORBA::ULong field = 0; field < entry.fields.length(); ++field) {
+                    if ((entry.created > since) || (entry.field_versions[field] > since)) {
+                        CORBA::ULong index = delta.fields.length();
+                        delta.fields.length(index + 1);
+                        delta.fields[index] = entry.fields[field];
+                    }
+                }
+                changes.push_back(delta);
+            }
+            if (since > 0) {
+                for (size_t tuner_id = _entries.size(); tuner_id < _removed.size(); ++tuner_id) {
+                    if (_removed[tuner_id] > since) {
+                        TunerStatusDelta delta;
+                        delta.tuner_id = tuner_id;
+                        delta.removed = true;
+                        changes.push_back(delta);
+                    }
+                }
+            }
+            return _version;
+        }
+
+        // Enables or disables comparing every tuner on each access
+        void setPolling(bool enable)
+        {
+            boost::mutex::scoped_lock lock(_cacheMutex);
+            _polling = enable;
+        }
+
+        // Notes that the status of tuner_id may have changed; when polling is
+        // disabled, this must be called after every change
+        void markChanged(size_t tuner_id)
+        {
+            boost::mutex::scoped_lock lock(_cacheMutex);
+            if (!_polling) {
+                _pending.push_back(tuner_id);
+            }
+        }
+
+        // Returns the number of tuners as of the last access
+        size_t size()
+        {
+            boost::mutex::scoped_lock lock(_cacheMutex);
+            return _entries.size();
+        }
+
+        // Discards all cached values, forcing every tuner to be marshaled again
+        void invalidate()
+        {
+            boost::mutex::scoped_lock lock(_cacheMutex);
+            _entries.clear();
+            _dirty = true;
+        }
+
+    private:
+        struct Entry {
+            Entry() :
+                created(0),
+                version(0)
+            {
+            }
+
+            T value;
+            CORBA::Any any;
+            CF::Properties fields;
+            std::vector<unsigned long long> field_versions;
+            unsigned long long created;
+            unsigned long long version;
+        };
+
+        // Brings the cache up to date with the current property value
+        void _refresh()
+        {
+            const value_type& current = getValue();
+            unsigned long long next = _version + 1;
+            bool changed = false;
+            if (current.size() < _entries.size()) {
+                // Remember when the missing tuners went away, for getChanges()
+                if (_removed.size() < _entries.size()) {
+                    _removed.resize(_entries.size(), 0);
+                }
+                for (size_t tuner_id = current.size(); tuner_id < _entries.size(); ++tuner_id) {
+                    _removed[tuner_id] = next;
+                }
+                _entries.resize(current.size());
+                changed = true;
+            } else if (current.size() > _entries.size()) {
+                for (size_t tuner_id = _entries.size(); tuner_id < current.size(); ++tuner_id) {
+                    _pending.push_back(tuner_id);
+                }
+                _entries.resize(current.size());
+            }
+
+            if (_polling) {
+                for (size_t tuner_id = 0; tuner_id < current.size(); ++tuner_id) {
+                    changed |= _check(tuner_id, current[tuner_id], next);
+                }
+            } else {
+                for (size_t index = 0; index < _pending.size(); ++index) {
+                    const size_t tuner_id = _pending[index];
+                    if (tuner_id < current.size()) {
+                        changed |= _check(tuner_id, current[tuner_id], next);
+                    }
+                }
+            }
+            _pending.clear();
+
+            if (changed) {
+                _version = next;
+                _dirty = true;
+            }
+        }
+
+        // Updates the entry for tuner_id if its value differs from the cached
+        // copy; returns true if it was updated
+        bool _check(size_t tuner_id, const T& value, unsigned long long version)
+        {
+            Entry& entry = _entries[tuner_id];
+            if (entry.version != 0 && entry.value == value) {
+                return false;
+            }
+            _update(entry, value, version);
+            return true;
+        }
+
+        void _update(Entry& entry, const T& value, unsigned long long version)
+        {
+            entry.value = value;
+            entry.any <<= value;
+            CF::Properties* fields = 0;
+            entry.any >>= fields;
+
+            if (entry.version == 0 || !fields || (fields->length() != entry.fields.length())) {
+                // New tuner (or unexpected layout): everything is new
+                entry.created = version;
+                if (fields) {
+                    entry.fields = *fields;
+                }
+                entry.field_versions.assign(entry.fields.length(), version);
+            } else {
+                std::string action("eq");
+                for (CORBA::ULong field = 0; field < fields->length(); ++field) {
+                    bool same = false;
+                    try {
+                        same = (strcmp(entry.fields[field].id, (*fields)[field].id) == 0) &&
+                               ossie::compare_anys(entry.fields[field].value, (*fields)[field].value, action);
+                    } catch (...) {
+                        // Types that cannot be compared are reported as changed
+                    }
+                    if (!same) {
+                        entry.fields[field] = (*fields)[field];
+                        entry.field_versions[field] = version;
+                    }
+                }
+            }
+            entry.version = version;
+        }
+
+        boost::mutex _cacheMutex;
+        std::vector<Entry> _entries;
+        CORBA::Any _cachedValue;
+        unsigned long long _version;
+        bool _dirty;
+        bool _polling;
+        std::vector<size_t> _pending;
+        std::vector<unsigned long long> _removed;
+    };
+
+}; // end frontend namespace
+
+#endif
@@ -0,0 +1,192 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "BatchAllocation.h"
+#include "TestTunerDevice.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BatchAllocationTest);
+
+namespace {
+    void addTuner(CF::Properties& capacities, const std::string& allocation_id, double center_frequency, bool control=true)
+    {
+        frontend::frontend_tuner_allocation_struct request;
+        request.tuner_type = "RX_DIGITIZER";
+        request.allocation_id = allocation_id;
+        request.center_frequency = center_frequency;
+        request.bandwidth = 1e6;
+        request.sample_rate = 2e6;
+        request.device_control = control;
+        CORBA::ULong index = capacities.length();
+        capacities.length(index + 1);
+        capacities[index].id = "FRONTEND::tuner_allocation";
+        capacities[index].value <<= request;
+    }
+
+    void addListener(CF::Properties& capacities, const std::string& existing_id, const std::string& listener_id)
+    {
+        frontend::frontend_listener_allocation_struct listener;
+        listener.existing_allocation_id = existing_id;
+        listener.listener_allocation_id = listener_id;
+        CORBA::ULong index = capacities.length();
+        capacities.length(index + 1);
+        capacities[index].id = "FRONTEND::listener_allocation";
+        capacities[index].value <<= listener;
+    }
+}
+
+void BatchAllocationTest::setUp()
+{
+    device = new TestTunerDevice(3);
+}
+
+void BatchAllocationTest::tearDown()
+{
+    device->_remove_ref();
+}
+
+void BatchAllocationTest::testDisabled()
+{
+    // Without batch allocation, only one allocation in a request is applied,
+    // as before
+    CF::Properties capacities;
+    addTuner(capacities, "tuner_1", 100e6);
+    addTuner(capacities, "tuner_2", 200e6);
+    CPPUNIT_ASSERT(device->allocateCapacity(capacities));
+    const bool tuner_1 = device->getTunerMapping("tuner_1") >= 0;
+    const bool tuner_2 = device->getTunerMapping("tuner_2") >= 0;
+    CPPUNIT_ASSERT(tuner_1 != tuner_2);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, device->tune_count);
+}
+
+void BatchAllocationTest::testBatch()
+{
+    device->enableBatchAllocation(true);
+
+    // Listeners may refer to tuners allocated earlier in the same batch
+    CF::Properties capacities;
+    addTuner(capacities, "tuner_1", 100e6);
+    addTuner(capacities, "tuner_2", 200e6);
+    addListener(capacities, "tuner_1", "listener_1");
+    addTuner(capacities, "listener_2", 200e6, false);
+    CPPUNIT_ASSERT(device->allocateCapacity(capacities));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, device->tune_count);
+
+    long tuner_1 = device->getTunerMapping("tuner_1");
+    long tuner_2 = device->getTunerMapping("tuner_2");
+    CPPUNIT_ASSERT(tuner_1 >= 0);
+    CPPUNIT_ASSERT(tuner_2 >= 0);
+    CPPUNIT_ASSERT(tuner_1 != tuner_2);
+    CPPUNIT_ASSERT_EQUAL(tuner_1, device->getTunerMapping("listener_1"));
+    CPPUNIT_ASSERT_EQUAL(tuner_2, device->getTunerMapping("listener_2"));
+    CPPUNIT_ASSERT(device->frontend_tuner_status[tuner_1].enabled);
+    CPPUNIT_ASSERT_EQUAL(std::string("tuner_1,listener_1"), device->frontend_tuner_status[tuner_1].allocation_id_csv);
+
+    // Deallocating the controlling allocations releases the listeners too
+    capacities.length(2);
+    device->deallocateCapacity(capacities);
+    CPPUNIT_ASSERT(device->getTunerMapping("tuner_1") < 0);
+    CPPUNIT_ASSERT(device->getTunerMapping("listener_2") < 0);
+}
+
+void BatchAllocationTest::testDuplicateId()
+{
+    device->enableBatchAllocation(true);
+
+    CF::Properties existing;
+    addTuner(existing, "tuner_1", 100e6);
+    CPPUNIT_ASSERT(device->allocateCapacity(existing));
+    const long tuner_1 = device->getTunerMapping("tuner_1");
+
+    // Reusing an existing ID must not disturb the existing allocation
+    CF::Properties capacities;
+    addTuner(capacities, "tuner_2", 200e6);
+    addTuner(capacities, "tuner_1", 300e6);
+    CPPUNIT_ASSERT_THROW(device->allocateCapacity(capacities), frontend::AllocationAlreadyExists);
+    CPPUNIT_ASSERT_EQUAL(tuner_1, device->getTunerMapping("tuner_1"));
+    CPPUNIT_ASSERT(device->getTunerMapping("tuner_2") < 0);
+
+    // Duplicates within the batch itself
+    capacities.length(0);
+    addTuner(capacities, "tuner_2", 200e6);
+    addListener(capacities, "tuner_1", "tuner_2");
+    CPPUNIT_ASSERT_THROW(device->allocateCapacity(capacities), frontend::AllocationAlreadyExists);
+    CPPUNIT_ASSERT(device->getTunerMapping("tuner_2") < 0);
+}
+
+void BatchAllocationTest::testRollback()
+{
+    device->enableBatchAllocation(true);
+
+    // More controlling allocations than tuners fails before tuning
+    CF::Properties capacities;
+    addTuner(capacities, "tuner_1", 100e6);
+    addTuner(capacities, "tuner_2", 200e6);
+    addTuner(capacities, "tuner_3", 300e6);
+    addTuner(capacities, "tuner_4", 400e6);
+    CPPUNIT_ASSERT(!device->allocateCapacity(capacities));
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, device->tune_count);
+
+    // A tuner that fails to tune undoes the ones before it
+    device->fail_tuner = 1;
+    capacities.length(3);
+    CPPUNIT_ASSERT(!device->allocateCapacity(capacities));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, device->tune_count);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, device->delete_count);
+    CPPUNIT_ASSERT_EQUAL(0.0, device->frontend_tuner_status[0].center_frequency);
+
+    // A listener that cannot be satisfied undoes the whole batch
+    device->fail_tuner = -1;
+    device->tune_count = 0;
+    device->delete_count = 0;
+    capacities.length(2);
+    addListener(capacities, "no_such_tuner", "listener_1");
+    CPPUNIT_ASSERT(!device->allocateCapacity(capacities));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, device->tune_count);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, device->delete_count);
+    for (size_t tuner_id = 0; tuner_id < device->tuner_allocation_ids.size(); ++tuner_id) {
+        CPPUNIT_ASSERT(device->tuner_allocation_ids[tuner_id].control_allocation_id.empty());
+        CPPUNIT_ASSERT(!device->frontend_tuner_status[tuner_id].enabled);
+        CPPUNIT_ASSERT(device->frontend_tuner_status[tuner_id].allocation_id_csv.empty());
+    }
+    CPPUNIT_ASSERT(device->getTunerMapping("tuner_1") < 0);
+    CPPUNIT_ASSERT_EQUAL(CF::Device::IDLE, device->usageState());
+}
+
+void BatchAllocationTest::testTolerance()
+{
+    device->enableBatchAllocation(true);
+
+    // Every tuner comes back 20% over the requested sample rate, outside of
+    // the default 10% tolerance; the batch stops at the first tuner
+    device->sample_rate_scale = 1.2;
+    CF::Properties capacities;
+    addTuner(capacities, "tuner_1", 100e6);
+    addTuner(capacities, "tuner_2", 200e6);
+    addTuner(capacities, "tuner_3", 300e6);
+    CPPUNIT_ASSERT(!device->allocateCapacity(capacities));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, device->tune_count);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, device->delete_count);
+    CPPUNIT_ASSERT_EQUAL(0.0, device->frontend_tuner_status[0].sample_rate);
+    CPPUNIT_ASSERT(device->getTunerMapping("tuner_1") < 0);
+
+    device->sample_rate_scale = 1.05;
+    CPPUNIT_ASSERT(device->allocateCapacity(capacities));
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, device->tune_count);
+}
@@ -0,0 +1,52 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef FRONTEND_BATCHALLOCATIONTEST_H
+#define FRONTEND_BATCHALLOCATIONTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class TestTunerDevice;
+
+class BatchAllocationTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(BatchAllocationTest);
+    CPPUNIT_TEST(testDisabled);
+    CPPUNIT_TEST(testBatch);
+    CPPUNIT_TEST(testDuplicateId);
+    CPPUNIT_TEST(testRollback);
+    CPPUNIT_TEST(testTolerance);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testDisabled();
+    void testBatch();
+    void testDuplicateId();
+    void testRollback();
+    void testTolerance();
+
+private:
+    TestTunerDevice* device;
+};
+
+#endif  // FRONTEND_BATCHALLOCATIONTEST_H
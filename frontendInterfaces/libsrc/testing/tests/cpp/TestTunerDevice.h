@@ -0,0 +1,97 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef FRONTEND_TESTTUNERDEVICE_H
+#define FRONTEND_TESTTUNERDEVICE_H
+
+#include <fe_tuner_device.cpp>
+
+/**
+ * Minimal tuner device for exercising FrontendTunerDevice allocation in
+ * process. Tuning sets the status to the requested values, scaled by
+ * sample_rate_scale, and can be made to fail for a given tuner.
+ */
+class TestTunerDevice : public frontend::FrontendTunerDevice<frontend::default_frontend_tuner_status_struct_struct>
+{
+public:
+    typedef frontend::default_frontend_tuner_status_struct_struct status_type;
+    typedef frontend::FrontendTunerDevice<status_type> base_type;
+
+    TestTunerDevice(size_t channels) :
+        base_type(const_cast<char*>(""), const_cast<char*>("test_tuner_device"),
+                  const_cast<char*>("test_tuner_device"), const_cast<char*>("")),
+        sample_rate_scale(1.0),
+        fail_tuner(-1),
+        tune_count(0),
+        delete_count(0)
+    {
+        setNumChannels(channels);
+    }
+
+    using base_type::enableBatchAllocation;
+    using base_type::enableTunerStatusPolling;
+    using base_type::getTunerMapping;
+    using base_type::frontend_tuner_status;
+    using base_type::tuner_allocation_ids;
+
+    double sample_rate_scale;
+    long fail_tuner;
+    size_t tune_count;
+    size_t delete_count;
+
+protected:
+    virtual void deviceEnable(status_type &fts, size_t tuner_id)
+    {
+        fts.enabled = true;
+    }
+
+    virtual void deviceDisable(status_type &fts, size_t tuner_id)
+    {
+        fts.enabled = false;
+    }
+
+    virtual bool deviceSetTuning(const frontend::frontend_tuner_allocation_struct &request, status_type &fts, size_t tuner_id)
+    {
+        if (fail_tuner == (long) tuner_id) {
+            return false;
+        }
+        tune_count++;
+        fts.center_frequency = request.center_frequency;
+        fts.bandwidth = request.bandwidth;
+        fts.sample_rate = request.sample_rate * sample_rate_scale;
+        return true;
+    }
+
+    virtual bool deviceDeleteTuning(status_type &fts, size_t tuner_id)
+    {
+        delete_count++;
+        return true;
+    }
+
+    virtual void removeAllocationIdRouting(const size_t tuner_id)
+    {
+    }
+
+    virtual void sendEOS(std::string allocation_id)
+    {
+    }
+};
+
+#endif  // FRONTEND_TESTTUNERDEVICE_H
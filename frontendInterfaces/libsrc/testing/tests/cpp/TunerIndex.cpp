@@ -0,0 +1,193 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "TunerIndex.h"
+
+#include <fe_tuner_index.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TunerIndexTest);
+
+namespace {
+    std::vector<size_t> collect(frontend::TunerIndex::Cursor cursor)
+    {
+        std::vector<size_t> result;
+        for (; !cursor.done(); ++cursor) {
+            result.push_back(*cursor);
+        }
+        return result;
+    }
+}
+
+void TunerIndexTest::testAvailable()
+{
+    frontend::TunerIndex index;
+    index.update(0, "RX_DIGITIZER", "", "", 0.0, 0.0, false);
+    index.update(1, "DDC", "", "", 0.0, 0.0, false);
+    index.update(2, "RX_DIGITIZER", "", "", 0.0, 0.0, false);
+    index.update(3, "RX_DIGITIZER", "", "", 100e6, 1e6, true);
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, index.size());
+
+    // Only unallocated tuners of the requested type, in tuner order
+    std::vector<size_t> available = collect(index.findAvailable("RX_DIGITIZER", "", ""));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, available[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available[1]);
+
+    available = collect(index.findAvailable("DDC", "", ""));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, available.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, available[0]);
+
+    CPPUNIT_ASSERT(collect(index.findAvailable("TX", "", "")).empty());
+
+    // Allocating and deallocating moves the tuner in and out of the free-list
+    index.setAllocated(0, true);
+    available = collect(index.findAvailable("RX_DIGITIZER", "", ""));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, available.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available[0]);
+    index.setAllocated(3, false);
+    available = collect(index.findAvailable("RX_DIGITIZER", "", ""));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, available[1]);
+
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, collect(index.findMatching("RX_DIGITIZER", "", "")).size());
+}
+
+void TunerIndexTest::testGroupAndFlow()
+{
+    frontend::TunerIndex index;
+    index.update(0, "RX_DIGITIZER", "group_a", "flow_1", 0.0, 0.0, false);
+    index.update(1, "RX_DIGITIZER", "group_b", "flow_1", 0.0, 0.0, false);
+    index.update(2, "RX_DIGITIZER", "group_a", "flow_2", 0.0, 0.0, false);
+    index.update(3, "CHANNELIZER", "group_a", "flow_1", 0.0, 0.0, false);
+
+    // Empty group and flow match everything
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, collect(index.findAvailable("RX_DIGITIZER", "", "")).size());
+
+    std::vector<size_t> available = collect(index.findAvailable("RX_DIGITIZER", "group_a", ""));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, available[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available[1]);
+
+    available = collect(index.findAvailable("RX_DIGITIZER", "", "flow_1"));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, available.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, available[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, available[1]);
+
+    available = collect(index.findAvailable("RX_DIGITIZER", "group_b", "flow_2"));
+    CPPUNIT_ASSERT(available.empty());
+
+    // Channelizer allocations ignore the RF flow
+    available = collect(index.findAvailable("CHANNELIZER", "", "flow_2"));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, available.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, available[0]);
+}
+
+void TunerIndexTest::testListenable()
+{
+    frontend::TunerIndex index;
+    index.update(0, "RX_DIGITIZER", "", "", 100e6, 1e6, true);
+    index.update(1, "RX_DIGITIZER", "", "", 200e6, 10e6, true);
+    index.update(2, "RX_DIGITIZER", "", "", 100.2e6, 1e6, true);
+    index.update(3, "RX_DIGITIZER", "", "", 100e6, 1e6, false);
+
+    // Request fully inside of tuners 0 and 2; unallocated tuner 3 is excluded
+    std::vector<size_t> listenable = collect(index.findListenable("RX_DIGITIZER", "", "", 100.1e6, 0.5e6));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, listenable.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, listenable[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, listenable[1]);
+
+    // Candidates for the wide tuner
+    listenable = collect(index.findListenable("RX_DIGITIZER", "", "", 204e6, 1e6));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, listenable.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, listenable[0]);
+
+    // Nothing tuned nearby
+    CPPUNIT_ASSERT(collect(index.findListenable("RX_DIGITIZER", "", "", 500e6, 1e6)).empty());
+}
+
+void TunerIndexTest::testUpdate()
+{
+    frontend::TunerIndex index;
+    index.update(0, "RX_DIGITIZER", "", "flow_1", 100e6, 1e6, true);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, collect(index.findListenable("RX_DIGITIZER", "", "flow_1", 100e6, 1e6)).size());
+
+    // Retuning and changing the RF flow moves the tuner within the index
+    index.update(0, "RX_DIGITIZER", "", "flow_2", 300e6, 1e6, true);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, index.size());
+    CPPUNIT_ASSERT(collect(index.findListenable("RX_DIGITIZER", "", "flow_1", 100e6, 1e6)).empty());
+    CPPUNIT_ASSERT(collect(index.findListenable("RX_DIGITIZER", "", "flow_2", 100e6, 1e6)).empty());
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, collect(index.findListenable("RX_DIGITIZER", "", "flow_2", 300e6, 1e6)).size());
+
+    index.remove(0);
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, index.size());
+    CPPUNIT_ASSERT(collect(index.findMatching("RX_DIGITIZER", "", "")).empty());
+
+    index.update(4, "RX_DIGITIZER", "", "", 0.0, 0.0, false);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, index.size());
+    index.clear();
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, index.size());
+}
+
+void TunerIndexTest::testCursor()
+{
+    // Without an index, a cursor visits every tuner in order
+    std::vector<size_t> tuners = collect(frontend::TunerIndex::Cursor(3));
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, tuners.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, tuners[0]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, tuners[2]);
+    CPPUNIT_ASSERT(frontend::TunerIndex::Cursor().done());
+
+    frontend::TunerIndex index;
+    index.update(0, "RX_DIGITIZER", "group_b", "", 0.0, 0.0, false);
+    index.update(1, "RX_DIGITIZER", "group_a", "", 0.0, 0.0, false);
+    index.update(2, "RX_DIGITIZER", "group_b", "", 0.0, 0.0, false);
+    index.update(3, "RX_DIGITIZER", "group_a", "", 100e6, 1e6, true);
+
+    // Unallocated tuners from different pools are merged in tuner order,
+    // followed by the allocated ones
+    tuners = collect(index.findMatching("RX_DIGITIZER", "", ""));
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, tuners.size());
+    for (size_t ii = 0; ii < tuners.size(); ++ii) {
+        CPPUNIT_ASSERT_EQUAL(ii, tuners[ii]);
+    }
+
+    // Allocating the current tuner, as allocateCapacity does, does not
+    // disturb the cursor
+    frontend::TunerIndex::Cursor cursor = index.findAvailable("RX_DIGITIZER", "", "");
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, *cursor);
+    index.update(0, "RX_DIGITIZER", "group_b", "", 50e6, 1e6, true);
+    ++cursor;
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, *cursor);
+    index.setAllocated(1, true);
+    ++cursor;
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, *cursor);
+    ++cursor;
+    CPPUNIT_ASSERT(cursor.done());
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, collect(index.findAvailable("RX_DIGITIZER", "", "")).size());
+}
+
+void TunerIndexTest::setUp()
+{
+}
+
+void TunerIndexTest::tearDown()
+{
+}
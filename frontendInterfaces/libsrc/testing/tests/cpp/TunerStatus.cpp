@@ -0,0 +1,237 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "TunerStatus.h"
+#include "TestTunerDevice.h"
+
+#include <boost/scoped_ptr.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TunerStatusTest);
+
+namespace {
+    typedef frontend::default_frontend_tuner_status_struct_struct status_type;
+    typedef frontend::TunerStatusProperty<status_type> property_type;
+
+    std::vector<status_type> createStatus(size_t count)
+    {
+        std::vector<status_type> status(count);
+        for (size_t tuner_id = 0; tuner_id < count; ++tuner_id) {
+            status[tuner_id].tuner_type = "RX_DIGITIZER";
+            status[tuner_id].center_frequency = 100e6 * (tuner_id + 1);
+        }
+        return status;
+    }
+
+    // Returns the delta for tuner_id, or null if there is none
+    const frontend::TunerStatusDelta* findDelta(const frontend::TunerStatusDeltaSequence& changes, size_t tuner_id)
+    {
+        for (size_t index = 0; index < changes.size(); ++index) {
+            if (changes[index].tuner_id == tuner_id) {
+                return &changes[index];
+            }
+        }
+        return 0;
+    }
+}
+
+void TunerStatusTest::setUp()
+{
+}
+
+void TunerStatusTest::tearDown()
+{
+}
+
+void TunerStatusTest::testValue()
+{
+    std::vector<status_type> status = createStatus(3);
+    property_type property(status);
+
+    // The cached value must match what the standard wrapper produces, before
+    // and after a change
+    boost::scoped_ptr<PropertyInterface> standard(PropertyWrapperFactory::Create(status));
+    for (int pass = 0; pass < 2; ++pass) {
+        CORBA::Any cached;
+        property.getValue(cached);
+        CORBA::Any expected;
+        standard->getValue(expected);
+
+        const CORBA::AnySeq* cached_seq;
+        const CORBA::AnySeq* expected_seq;
+        CPPUNIT_ASSERT(cached >>= cached_seq);
+        CPPUNIT_ASSERT(expected >>= expected_seq);
+        CPPUNIT_ASSERT_EQUAL(expected_seq->length(), cached_seq->length());
+        for (CORBA::ULong index = 0; index < cached_seq->length(); ++index) {
+            status_type cached_value;
+            status_type expected_value;
+            CPPUNIT_ASSERT((*cached_seq)[index] >>= cached_value);
+            CPPUNIT_ASSERT((*expected_seq)[index] >>= expected_value);
+            CPPUNIT_ASSERT(cached_value == expected_value);
+        }
+
+        status[1].bandwidth = 5e6;
+        status.push_back(status[0]);
+    }
+}
+
+void TunerStatusTest::testChanges()
+{
+    std::vector<status_type> status = createStatus(2);
+    property_type property(status);
+
+    // Everything is reported the first time
+    frontend::TunerStatusDeltaSequence changes;
+    unsigned long long version = property.getChanges(0, changes);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, changes.size());
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 8, changes[0].fields.length());
+    CPPUNIT_ASSERT(!changes[0].removed);
+
+    // No changes, same version
+    CPPUNIT_ASSERT_EQUAL(version, property.getChanges(version, changes));
+    CPPUNIT_ASSERT(changes.empty());
+
+    // Only the modified field of the modified tuner
+    status[1].center_frequency = 500e6;
+    unsigned long long next = property.getChanges(version, changes);
+    CPPUNIT_ASSERT(next > version);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, changes.size());
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, changes[0].tuner_id);
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, changes[0].fields.length());
+    CPPUNIT_ASSERT_EQUAL(std::string("FRONTEND::tuner_status::center_frequency"), std::string(changes[0].fields[0].id));
+
+    // A new tuner includes all of its fields
+    status.push_back(status[0]);
+    version = next;
+    next = property.getChanges(version, changes);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, changes.size());
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 2, changes[0].tuner_id);
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 8, changes[0].fields.length());
+}
+
+void TunerStatusTest::testRemoved()
+{
+    std::vector<status_type> status = createStatus(3);
+    property_type property(status);
+
+    frontend::TunerStatusDeltaSequence changes;
+    unsigned long long version = property.getChanges(0, changes);
+
+    status.resize(1);
+    unsigned long long next = property.getChanges(version, changes);
+    CPPUNIT_ASSERT(next > version);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, changes.size());
+    for (size_t tuner_id = 1; tuner_id < 3; ++tuner_id) {
+        const frontend::TunerStatusDelta* delta = findDelta(changes, tuner_id);
+        CPPUNIT_ASSERT(delta);
+        CPPUNIT_ASSERT(delta->removed);
+        CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 0, delta->fields.length());
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, property.size());
+
+    // The full status does not include removed tuners
+    property.getChanges(0, changes);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, changes.size());
+
+    // A tuner that comes back is reported in full
+    status.push_back(status[0]);
+    version = next;
+    property.getChanges(version, changes);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, changes.size());
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, changes[0].tuner_id);
+    CPPUNIT_ASSERT(!changes[0].removed);
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 8, changes[0].fields.length());
+}
+
+void TunerStatusTest::testPolling()
+{
+    std::vector<status_type> status = createStatus(2);
+    property_type property(status);
+    property.setPolling(false);
+
+    // New tuners are always picked up
+    frontend::TunerStatusDeltaSequence changes;
+    unsigned long long version = property.getChanges(0, changes);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, changes.size());
+
+    // Unmarked changes are not seen
+    status[0].enabled = true;
+    CPPUNIT_ASSERT_EQUAL(version, property.getChanges(version, changes));
+    CPPUNIT_ASSERT(changes.empty());
+
+    property.markChanged(0);
+    version = property.getChanges(version, changes);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, changes.size());
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 0, changes[0].tuner_id);
+
+    // Marking an unchanged tuner does not create a new version
+    property.markChanged(1);
+    CPPUNIT_ASSERT_EQUAL(version, property.getChanges(version, changes));
+    CPPUNIT_ASSERT(changes.empty());
+}
+
+void TunerStatusTest::testDevice()
+{
+    TestTunerDevice* device = new TestTunerDevice(2);
+
+    // The device's tuner status wrapper replaces the default one, keeping its
+    // configuration
+    PropertyInterface* property = device->getPropertyFromId("FRONTEND::tuner_status");
+    CPPUNIT_ASSERT(dynamic_cast<property_type*>(property));
+    CPPUNIT_ASSERT_EQUAL(std::string("frontend_tuner_status"), property->name);
+    CPPUNIT_ASSERT_EQUAL(std::string("readonly"), property->mode);
+    CPPUNIT_ASSERT(property->isProperty());
+
+    // With polling disabled, allocation still reports its own changes
+    device->enableTunerStatusPolling(false);
+    frontend::TunerStatusDeltaSequence changes;
+    unsigned long long version = device->getTunerStatusChanges(0, changes);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, changes.size());
+
+    frontend::frontend_tuner_allocation_struct request;
+    request.tuner_type = "RX_DIGITIZER";
+    request.allocation_id = "tuner_1";
+    request.center_frequency = 100e6;
+    CF::Properties capacities;
+    capacities.length(1);
+    capacities[0].id = "FRONTEND::tuner_allocation";
+    capacities[0].value <<= request;
+    CPPUNIT_ASSERT(device->allocateCapacity(capacities));
+    long tuner_id = device->getTunerMapping("tuner_1");
+    CPPUNIT_ASSERT(tuner_id >= 0);
+
+    version = device->getTunerStatusChanges(version, changes);
+    const frontend::TunerStatusDelta* delta = findDelta(changes, tuner_id);
+    CPPUNIT_ASSERT(delta);
+    bool csv = false;
+    bool enabled = false;
+    for (CORBA::ULong field = 0; field < delta->fields.length(); ++field) {
+        const std::string id(delta->fields[field].id);
+        csv |= (id == "FRONTEND::tuner_status::allocation_id_csv");
+        enabled |= (id == "FRONTEND::tuner_status::enabled");
+    }
+    CPPUNIT_ASSERT(csv);
+    CPPUNIT_ASSERT(enabled);
+
+    device->deallocateCapacity(capacities);
+    device->getTunerStatusChanges(version, changes);
+    CPPUNIT_ASSERT(findDelta(changes, tuner_id));
+
+    device->_remove_ref();
+}
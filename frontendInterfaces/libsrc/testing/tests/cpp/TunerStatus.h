@@ -0,0 +1,47 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK bulkioInterfaces.
+ *
+ * REDHAWK bulkioInterfaces is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK bulkioInterfaces is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef FRONTEND_TUNERSTATUSTEST_H
+#define FRONTEND_TUNERSTATUSTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class TunerStatusTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(TunerStatusTest);
+    CPPUNIT_TEST(testValue);
+    CPPUNIT_TEST(testChanges);
+    CPPUNIT_TEST(testRemoved);
+    CPPUNIT_TEST(testPolling);
+    CPPUNIT_TEST(testDevice);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testValue();
+    void testChanges();
+    void testRemoved();
+    void testPolling();
+    void testDevice();
+};
+
+#endif  // FRONTEND_TUNERSTATUSTEST_H
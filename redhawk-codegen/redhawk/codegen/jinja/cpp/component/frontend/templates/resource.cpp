@@ -163,6 +163,7 @@ void ${className}::setTunerCenterFrequency(const std::string& allocation_id, dou
     if (freq<0) throw FRONTEND::BadParameterException("Center frequency cannot be less than 0");
     // set hardware to new value. Raise an exception if it's not possible
     this->frontend_tuner_status[idx].center_frequency = freq;
+    this->updateTunerIndex(idx);
 }
 
 double ${className}::getTunerCenterFrequency(const std::string& allocation_id) {
@@ -179,6 +180,7 @@ void ${className}::setTunerBandwidth(const std::string& allocation_id, double bw
     if (bw<0) throw FRONTEND::BadParameterException("Bandwidth cannot be less than 0");
     // set hardware to new value. Raise an exception if it's not possible
     this->frontend_tuner_status[idx].bandwidth = bw;
+    this->updateTunerIndex(idx);
 }
 
 double ${className}::getTunerBandwidth(const std::string& allocation_id) {
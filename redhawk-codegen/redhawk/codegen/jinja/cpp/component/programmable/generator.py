@@ -37,8 +37,8 @@ loader = CodegenLoader(__package__,
 
 class ProgrammableComponentGenerator(PullComponentGenerator):
     # Need to keep use_vector_impl, auto_start and queued_ports to handle legacy options 
-    def parseopts (self, use_vector_impl=True,auto_start=True,queued_ports=False):
-        pass
+    def parseopts (self, use_vector_impl=True,auto_start=True,queued_ports=False,property_table=False,stream_processing=False):
+        PullComponentGenerator.parseopts(self, property_table=property_table, stream_processing=stream_processing)
 
     def loader(self, component):
         return loader
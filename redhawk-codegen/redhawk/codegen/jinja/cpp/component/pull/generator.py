@@ -18,6 +18,7 @@
 # along with this program.  If not, see http://www.gnu.org/licenses/.
 #
 
+from redhawk.codegen import utils
 from redhawk.codegen.jinja.generator import CodeGenerator
 from redhawk.codegen.jinja.loader import CodegenLoader
 from redhawk.codegen.jinja.common import ShellTemplate, AutomakeTemplate, AutoconfTemplate
@@ -39,8 +40,64 @@ loader = CodegenLoader(__package__,
 
 class PullComponentGenerator(CppCodeGenerator):
     # Need to keep use_vector_impl, auto_start and queued_ports to handle legacy options 
-    def parseopts (self, use_vector_impl=True,auto_start=True,queued_ports=False):
-        pass
+    # Native sample types of the BulkIO numeric ports, by port type name
+    NUMERIC_TYPES = {
+        'Char':      'int8_t',
+        'Octet':     'CORBA::Octet',
+        'Short':     'CORBA::Short',
+        'UShort':    'CORBA::UShort',
+        'Long':      'CORBA::Long',
+        'ULong':     'CORBA::ULong',
+        'LongLong':  'CORBA::LongLong',
+        'ULongLong': 'CORBA::ULongLong',
+        'Float':     'CORBA::Float',
+        'Double':    'CORBA::Double'
+    }
+
+    def parseopts (self, use_vector_impl=True,auto_start=True,queued_ports=False,property_table=False,stream_processing=False):
+        self.property_table = utils.parseBoolean(property_table)
+        self.stream_processing = utils.parseBoolean(stream_processing)
+
+    def map(self, softpkg):
+        component = super(PullComponentGenerator,self).map(softpkg)
+        # Emit a static property table with perfect-hash lookup instead of
+        # building property descriptions at runtime
+        component['propertytable'] = self.property_table
+        if self.stream_processing:
+            component['streamprocessing'] = self._mapStreamProcessing(component['ports'])
+        else:
+            component['streamprocessing'] = None
+        return component
+
+    def _numericType(self, port, direction):
+        # Returns the type name of a BulkIO numeric port (e.g., 'Float' for
+        # bulkio::InFloatPort), or None for any other kind of port
+        prefix = 'bulkio::' + direction
+        cpptype = port.get('cpptype', '')
+        if not cpptype.startswith(prefix) or not cpptype.endswith('Port'):
+            return None
+        name = cpptype[len(prefix):-len('Port')]
+        if name not in self.NUMERIC_TYPES:
+            return None
+        return name
+
+    def _mapStreamProcessing(self, ports):
+        # The stream processing skeleton reads from the first BulkIO numeric
+        # input port and writes to the first BulkIO numeric output port
+        inputs = [p for p in ports if p['direction'] == 'provides' and self._numericType(p, 'In')]
+        outputs = [p for p in ports if p['direction'] == 'uses' and self._numericType(p, 'Out')]
+        if not inputs or not outputs:
+            return None
+        intype = self._numericType(inputs[0], 'In')
+        outtype = self._numericType(outputs[0], 'Out')
+        return {'input':     inputs[0],
+                'output':    outputs[0],
+                'instream':  'bulkio::In%sStream' % intype,
+                'outstream': 'bulkio::Out%sStream' % outtype,
+                'datablock': 'bulkio::%sDataBlock' % intype,
+                'intype':    self.NUMERIC_TYPES[intype],
+                'outtype':   self.NUMERIC_TYPES[outtype],
+                'inplace':   (intype == outtype)}
 
     def loader(self, component):
         return loader
@@ -33,6 +33,10 @@
 **************************************************************************/
 
 #include "${component.userclass.header}"
+/*{% if component.streamprocessing %}*/
+
+#include <ossie/BufferManager.h>
+/*{% endif %}*/
 
 PREPARE_LOGGING(${className})
 
@@ -372,12 +376,93 @@ void ${className}::updateUsageState()
 /*{% endif %}*/
 
 ************************************************************************************************/
+/*{% if component.streamprocessing %}*/
+/*{%   set sp = component.streamprocessing %}*/
+int ${className}::serviceFunction()
+{
+    // Process every input stream that has data ready, instead of handling a
+    // single packet per call
+    ${sp.input.cpptype}::StreamList streams = ${sp.input.cppname}->pollStreams(bulkio::Const::NON_BLOCKING);
+    if (streams.empty()) {
+        return NOOP;
+    }
+
+    for (${sp.input.cpptype}::StreamList::iterator stream = streams.begin(); stream != streams.end(); ++stream) {
+        processStream(*stream);
+    }
+    return NORMAL;
+}
+
+void ${className}::processStream(${sp.instream}& inputStream)
+{
+    // Get the output stream, creating it if it doesn't exist yet
+    ${sp.outstream} outputStream = ${sp.output.cppname}->getStream(inputStream.streamID());
+    if (!outputStream) {
+        outputStream = ${sp.output.cppname}->createStream(inputStream.sri());
+    }
+
+    ${sp.datablock} block = inputStream.tryread();
+    if (!block) {
+        // Propagate end-of-stream
+        if (inputStream.eos()) {
+            outputStream.close();
+        }
+        return;
+    }
+
+    if (block.sriChanged()) {
+        outputStream.sri(block.sri());
+    }
+
+    // Take the input data and timestamp, then release the block so that it
+    // no longer holds a reference to the data
+    redhawk::shared_buffer<${sp.intype}> input = block.buffer();
+    BULKIO::PrecisionUTCTime time = block.getStartTime();
+    block = ${sp.datablock}();
+
+    redhawk::buffer<${sp.outtype}> output;
+/*{%   if sp.inplace %}*/
+    if (input.unique()) {
+        // Nothing else refers to the input data, so transform it in place
+        output = redhawk::buffer<${sp.outtype}>::reclaim(input);
+        process(output.data(), output.data(), output.size());
+    } else {
+        // Allocate the output from the BufferManager, which caches memory
+        // blocks per thread so that steady-state processing does not go to
+        // the operating system
+        output = redhawk::buffer<${sp.outtype}>(input.size(), redhawk::BufferManager::Allocator<${sp.outtype}>());
+        process(input.data(), output.data(), input.size());
+    }
+/*{%   else %}*/
+    // Allocate the output from the BufferManager, which caches memory blocks
+    // per thread so that steady-state processing does not go to the operating
+    // system
+    output = redhawk::buffer<${sp.outtype}>(input.size(), redhawk::BufferManager::Allocator<${sp.outtype}>());
+    process(input.data(), output.data(), input.size());
+/*{%   endif %}*/
+
+    // Write to the output stream; output must not be modified after this call
+    outputStream.write(output, time);
+}
+
+void ${className}::process(const ${sp.intype}* input, ${sp.outtype}* output, size_t count)
+{
+    // Transform input data into output data. The loop has no function calls
+    // or allocations, so that the compiler is free to vectorize it; output
+    // may be the same array as input. Complex data (block.complex() is true)
+    // is interleaved real/imaginary pairs.
+    for (size_t index = 0; index < count; ++index) {
+        output[index] = input[index];
+    }
+}
+/*{% else %}*/
 int ${className}::serviceFunction()
 {
     RH_DEBUG(this->_baseLog, "serviceFunction() example log message");
     
     return NOOP;
 }
+/*{% endif %}*/
 /*{% block extensions %}*/
 /*{% endblock %}*/
 /*{% block fei_port_delegations %}*/
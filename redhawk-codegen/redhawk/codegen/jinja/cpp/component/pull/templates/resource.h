@@ -47,6 +47,12 @@ class ${className} : public ${baseClass}
         int serviceFunction();
 
     protected:
+/*{% if component.streamprocessing %}*/
+/*{%   set sp = component.streamprocessing %}*/
+        void processStream(${sp.instream}& inputStream);
+        void process(const ${sp.intype}* input, ${sp.outtype}* output, size_t count);
+
+/*{% endif %}*/
 /*{% if component is device %}*/
 /*{% block updateUsageState %}*/
 
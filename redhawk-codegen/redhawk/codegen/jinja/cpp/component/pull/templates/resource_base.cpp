@@ -184,7 +184,14 @@ void ${className}::connectionTableChanged(const std::vector<connection_descripto
 
 /*{% endif %}*/
 /*{% block loadProperties %}*/
-/*{% from "properties/properties.cpp" import addproperty, initsequence, initializestructseq %}*/
+/*{% from "properties/properties.cpp" import addproperty, addtableproperty, propertytable, initsequence, initializestructseq %}*/
+/*{% if component.propertytable %}*/
+/*{%   set table = cpp.propertyTable(component.properties) %}*/
+/*{%   if table.entries %}*/
+${propertytable(table)}
+
+/*{%   endif %}*/
+/*{% endif %}*/
 void ${className}::loadProperties()
 {
 /*{% for prop in component.properties %}*/
@@ -192,7 +199,11 @@ void ${className}::loadProperties()
     ${initsequence(prop)|indent(4)}
 //%    endif
 /*{%   if not prop.inherited %}*/
+/*{%     if component.propertytable %}*/
+    ${addtableproperty(prop, table)|indent(4)}
+/*{%     else %}*/
     ${addproperty(prop)|indent(4)}
+/*{%     endif %}*/
 
 /*{%   elif prop.cppvalue %}*/
     ${prop.cppname} = ${prop.cppvalue};
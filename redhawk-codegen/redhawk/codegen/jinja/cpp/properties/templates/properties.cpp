@@ -49,6 +49,43 @@ addProperty(${prop.cppname},
             "${prop.kinds|join(',')}");
 /*{%- endmacro %}*/
 
+/*{% macro addtableproperty(prop, table) %}*/
+addProperty(${prop.cppname},
+//% if prop.cppvalues
+            ${prop.cppname},
+//% elif prop.cppvalue
+            ${prop.cppvalue},
+//% endif
+            PROPERTY_TABLE,
+            ${table.index[prop.identifier]}); // ${prop.identifier}
+/*{%- endmacro %}*/
+
+/*{% macro propertytable(table) %}*/
+namespace {
+    // Property descriptors, sorted by identifier
+    const redhawk::PropertyDescriptor PROPERTY_DESCRIPTORS[] = {
+//% for prop in table.entries
+        { "${prop.identifier}", "${prop.name}", "${prop.mode}", "${prop.units}", "${prop.action}", "${prop.kinds|join(',')}" }${',' if not loop.last}
+//% endfor
+    };
+
+    // Perfect hash over the property identifiers
+    const unsigned int PROPERTY_DISPLACEMENTS[] = {
+        ${table.displacements|join(', ')|wordwrap(80, wrapstring='\n        ')}
+    };
+
+    const short PROPERTY_SLOTS[] = {
+        ${table.slots|join(', ')|wordwrap(80, wrapstring='\n        ')}
+    };
+
+    const redhawk::PropertyTable PROPERTY_TABLE = {
+        PROPERTY_DESCRIPTORS, ${table.entries|length},
+        PROPERTY_DISPLACEMENTS, ${table.displacements|length},
+        PROPERTY_SLOTS, ${table.slots|length}
+    };
+}
+/*{%- endmacro %}*/
+
 /*{% macro initializestructseq(prop) %}*/
 /*{% for value in prop.cppvalues %}*/
     {
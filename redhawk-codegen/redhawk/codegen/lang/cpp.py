@@ -179,3 +179,70 @@ def idlHeader(idl):
     idlpath = '/'.join(idl.idl().fullpath.split('/')[-2:])
     header = idlpath.replace('.idl', extension)
     return '<'+header+'>'
+
+def propertyHash(identifier, seed):
+    """
+    Returns the hash of a property identifier, matching
+    redhawk::PropertyTable::hash() in the C++ framework.
+    """
+    if isinstance(identifier, unicode):
+        identifier = identifier.encode('utf-8')
+    value = 2166136261 ^ seed
+    for ch in identifier:
+        value ^= ord(ch)
+        value = (value * 16777619) & 0xFFFFFFFF
+    value ^= value >> 16
+    value = (value * 0x85ebca6b) & 0xFFFFFFFF
+    value ^= value >> 13
+    value = (value * 0xc2b2ae35) & 0xFFFFFFFF
+    value ^= value >> 16
+    return value
+
+def propertyTable(properties):
+    """
+    Returns a static property table for the given properties: the properties
+    sorted by identifier, the index of each identifier, and the displacements
+    and slots of a perfect hash over the identifiers (see
+    redhawk::PropertyTable in the C++ framework). Inherited properties are
+    registered by the base class, and are not included.
+    """
+    entries = [prop for prop in properties if not prop.get('inherited', False)]
+    entries.sort(key=lambda prop: prop['identifier'])
+    identifiers = [prop['identifier'] for prop in entries]
+
+    # Hash and displace: group the identifiers into buckets, then, starting
+    # with the largest bucket, find a seed that places every identifier in the
+    # bucket into an unused slot
+    bucketCount = max(1, len(identifiers) / 2)
+    slotCount = len(identifiers) + len(identifiers) / 4 + 1
+    while True:
+        buckets = [[] for ii in xrange(bucketCount)]
+        for index, identifier in enumerate(identifiers):
+            buckets[propertyHash(identifier, 0) % bucketCount].append(index)
+
+        slots = [-1] * slotCount
+        displacements = [0] * bucketCount
+        placed = True
+        for bucket in sorted(xrange(bucketCount), key=lambda b: -len(buckets[b])):
+            members = buckets[bucket]
+            if not members:
+                continue
+            for seed in xrange(1, 100000):
+                positions = [propertyHash(identifiers[index], seed) % slotCount for index in members]
+                if len(set(positions)) == len(positions) and max(slots[pos] for pos in positions) < 0:
+                    break
+            else:
+                placed = False
+                break
+            for index, pos in zip(members, positions):
+                slots[pos] = index
+            displacements[bucket] = seed
+        if placed:
+            break
+        # No seed found for some bucket; retry with more room
+        slotCount += slotCount / 2 + 1
+
+    return {'entries':       entries,
+            'index':         dict((ident, index) for index, ident in enumerate(identifiers)),
+            'displacements': displacements,
+            'slots':         slots}
@@ -19,6 +19,7 @@
  */
 
 #include <iostream>
+#include <cstdlib>
 
 #include <ossie/BufferManager.h>
 #include "inplace_list.h"
@@ -32,25 +33,28 @@ struct BufferManager::CacheBlock {
     {
     }
 
+    // The header is padded out to the alignment so that the data that follows
+    // it is aligned as well
+    static const size_t HEADER_BYTES = BufferManager::ALIGNMENT;
+
     static CacheBlock* from_pointer(void* ptr)
     {
-        CacheBlock* block = reinterpret_cast<CacheBlock*>(ptr);
-        return block - 1;
+        return reinterpret_cast<CacheBlock*>(static_cast<char*>(ptr) - HEADER_BYTES);
     }
 
     void* data()
     {
-        return this + 1;
+        return reinterpret_cast<char*>(this) + HEADER_BYTES;
     }
 
     static size_t required_bytes(size_t bytes)
     {
-        return bytes + sizeof(CacheBlock);
+        return bytes + HEADER_BYTES;
     }
 
     static size_t usable_bytes(size_t bytes)
     {
-        return bytes - sizeof(CacheBlock);
+        return bytes - HEADER_BYTES;
     }
 
     const size_t size;
@@ -306,13 +310,16 @@ size_t BufferManager::_nearestSize(size_t bytes)
 
 BufferManager::CacheBlock* BufferManager::_allocate(size_t bytes)
 {
-    void* buffer = ::operator new(CacheBlock::required_bytes(bytes));
+    void* buffer = 0;
+    if (posix_memalign(&buffer, ALIGNMENT, CacheBlock::required_bytes(bytes))) {
+        throw std::bad_alloc();
+    }
     return new (buffer) CacheBlock(bytes);
 }
 
 void BufferManager::_deallocate(CacheBlock* block)
 {
-    ::operator delete(block);
+    free(block);
 }
 
 bool BufferManager::isEnabled() const
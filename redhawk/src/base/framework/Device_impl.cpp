@@ -85,6 +85,7 @@ void Device_impl::initResources (char* devMgr_ior, char* _id,
     _adminState = CF::Device::UNLOCKED;
     initialConfiguration = true;
     sig_fd=-1;
+    _stateChangeQueueDepth = 0;
 
     useNewAllocation = false;
     this->_devMgr = NULL;
@@ -1200,6 +1201,20 @@ void Device_impl::connectIDMChannel( const std::string &idm_channel_ior ) {
     }  
   }
 
+  if ( _stateChangeQueueDepth > 0 ) {
+    setAsyncStateChanges( _stateChangeQueueDepth );
+  }
+
+}
+
+void Device_impl::setAsyncStateChanges( size_t maxQueue ) {
+  _stateChangeQueueDepth = maxQueue;
+  if ( idm_publisher ) {
+    // If state changes back up, only the net change for each state category
+    // is sent
+    idm_publisher->setAsync( maxQueue );
+    idm_publisher->setCoalescing( maxQueue > 0 );
+  }
 }
 
 void Device_impl::start_device(Device_impl::ctor_type ctor, struct sigaction sa, int argc, char* argv[])
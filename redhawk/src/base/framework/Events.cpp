@@ -17,11 +17,14 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
+#include <sstream>
+#include <algorithm>
 #include <boost/thread/thread.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <ossie/RedhawkDefs.h>
 #include <ossie/CF/StandardEvent.h>
 #include <ossie/Events.h>
+#include <ossie/affinity.h>
 #include <ossie/Resource_impl.h>
 #include <ossie/Device_impl.h>
 
@@ -443,6 +446,8 @@ namespace events {
 
     virtual ~EM_Publisher() {
       RH_NL_TRACE("EM_Publisher", "DTOR START ch:" << _creg.reg.channel_name << " reg:" << _creg.reg.reg_id );
+      // send any queued events while still registered
+      setAsync(0);
       // unregister the object with the Manager
       _ecm._unregister( _creg, this );
       RH_NL_TRACE("EM_Publisher", "DTOR END");
@@ -924,8 +929,21 @@ namespace events {
   };
 
   Publisher::Publisher( ossie::events::EventChannel_ptr   inChannel ) :
-    _disconnectReceiver(NULL)
+    _disconnectReceiver(NULL),
+    _sender(0),
+    _senderRunning(false),
+    _inFlight(0),
+    _batchSize(1),
+    _coalescing(false)
     {
+      _stats.queueDepth = 0;
+      _stats.maxQueue = 0;
+      _stats.queued = 0;
+      _stats.sent = 0;
+      _stats.failed = 0;
+      _stats.dropped = 0;
+      _stats.coalesced = 0;
+
       // if user passes a bad param then throw...
       if ( CORBA::is_nil(inChannel) == true ) throw (CF::EventChannelManager::OperationNotAllowed());
       channel = ossie::events::EventChannel::_duplicate(inChannel);
@@ -953,6 +971,9 @@ namespace events {
 
     RH_NL_TRACE("Publisher", "DTOR - START." );
 
+    // Send anything still queued before leaving the channel
+    _stopSender();
+
     try {
       if ( _disconnectReceiver && !_disconnectReceiver->get_disconnect() ) {
         RH_NL_DEBUG("Publisher::DTOR", "DISCONNECT." );
@@ -1144,6 +1165,19 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
 
 
   int     Publisher::push( CORBA::Any &data ) {
+      {
+        // Events keep going through the queue while the sender is stopping,
+        // so that they are not sent ahead of the ones it is still draining
+        boost::mutex::scoped_lock lock(_queueMutex);
+        if ( _sender ) {
+          return _queue(data);
+        }
+      }
+      return _send(data);
+    }
+
+
+  int     Publisher::_send( const CORBA::Any &data ) {
       int retval=0;
       try {
         if (!CORBA::is_nil(proxy)) {
@@ -1161,6 +1195,203 @@ int Publisher::disconnect(const int retries,  const int retry_wait )
     }
 
 
+  void    Publisher::setAsync( size_t maxQueue, size_t batchSize ) {
+      // Changing the configuration always starts from an empty queue
+      _stopSender();
+
+      boost::mutex::scoped_lock lock(_queueMutex);
+      _stats.maxQueue = maxQueue;
+      _batchSize = std::max(batchSize, (size_t) 1);
+      if ( maxQueue > 0 ) {
+        _senderRunning = true;
+        _sender = new boost::thread(&Publisher::_runSender, this);
+      }
+    }
+
+
+  bool    Publisher::isAsync() {
+      boost::mutex::scoped_lock lock(_queueMutex);
+      return (_sender != 0);
+    }
+
+
+  void    Publisher::setCoalescing( bool enabled ) {
+      boost::mutex::scoped_lock lock(_queueMutex);
+      _coalescing = enabled;
+      if ( !enabled ) {
+        _pendingStateChanges.clear();
+      }
+    }
+
+
+  void    Publisher::flush() {
+      boost::mutex::scoped_lock lock(_queueMutex);
+      while ( !_queueEvents.empty() || (_inFlight > 0) ) {
+        _queueCond.wait(lock);
+      }
+    }
+
+
+  Publisher::AsyncStatistics Publisher::asyncStatistics() {
+      boost::mutex::scoped_lock lock(_queueMutex);
+      AsyncStatistics stats = _stats;
+      stats.queueDepth = _queueEvents.size() + _inFlight;
+      return stats;
+    }
+
+
+  //
+  // Adds an event to the send queue; the caller must hold _queueMutex
+  //
+  int     Publisher::_queue( const CORBA::Any &data ) {
+      std::string key;
+      if ( _coalescing && _coalesce(data, key) ) {
+        _stats.coalesced++;
+        return 0;
+      }
+
+      if ( _queueEvents.size() >= _stats.maxQueue ) {
+        _stats.dropped++;
+        RH_NL_TRACE("Publisher", "Event queue full, dropping event" );
+        return -1;
+      }
+
+      _queueEvents.push_back(QueuedEvent());
+      _queueEvents.back().data = data;
+      if ( !key.empty() ) {
+        _queueEvents.back().key = key;
+        _pendingStateChanges[key] = --_queueEvents.end();
+      }
+      _stats.queued++;
+      _queueCond.notify_all();
+      return 0;
+    }
+
+
+  //
+  // If data is a state change with an unsent predecessor from the same
+  // producer and source, folds it into the queued event and returns true.
+  // Otherwise, sets key to identify the event if it is a state change so that
+  // later changes can find it.
+  //
+  bool    Publisher::_coalesce( const CORBA::Any &data, std::string &key ) {
+      std::ostringstream id;
+      const StandardEvent::StateChangeEventType *smsg;
+      const ExtendedEvent::ResourceStateChangeEventType *rmsg;
+      if ( data >>= smsg ) {
+        id << "std:" << smsg->producerId.in() << ":" << smsg->sourceId.in() << ":" << smsg->stateChangeCategory;
+      } else if ( data >>= rmsg ) {
+        id << "res:" << rmsg->sourceId.in();
+      } else {
+        return false;
+      }
+      key = id.str();
+
+      PendingStateChanges::iterator pending = _pendingStateChanges.find(key);
+      if ( pending == _pendingStateChanges.end() ) {
+        return false;
+      }
+
+      // Keep the state the pending event started from, and take everything
+      // else from the newer event
+      CORBA::Any &queued = pending->second->data;
+      if ( key[0] == 's' ) {
+        const StandardEvent::StateChangeEventType *prior;
+        if ( !(queued >>= prior) ) return false;
+        StandardEvent::StateChangeEventType merged = *smsg;
+        merged.stateChangeFrom = prior->stateChangeFrom;
+        queued <<= merged;
+      } else {
+        const ExtendedEvent::ResourceStateChangeEventType *prior;
+        if ( !(queued >>= prior) ) return false;
+        ExtendedEvent::ResourceStateChangeEventType merged = *rmsg;
+        merged.stateChangeFrom = prior->stateChangeFrom;
+        queued <<= merged;
+      }
+      return true;
+    }
+
+
+  void    Publisher::_runSender() {
+      redhawk::affinity::apply_thread_affinity( redhawk::affinity::HOUSEKEEPING_THREAD );
+
+      boost::mutex::scoped_lock lock(_queueMutex);
+      while ( true ) {
+        while ( _senderRunning && _queueEvents.empty() ) {
+          _queueCond.wait(lock);
+        }
+        if ( _queueEvents.empty() ) {
+          // Stopped and drained
+          break;
+        }
+        _sendBatch(lock);
+      }
+    }
+
+
+  //
+  // Sends the next batch from the queue; the caller must hold _queueMutex via
+  // lock, which is released while sending
+  //
+  void    Publisher::_sendBatch( boost::mutex::scoped_lock &lock ) {
+      // Take the batch off of the queue, so that publishers can keep queueing
+      // while it is sent
+      EventQueue batch;
+      EventQueue::iterator end = _queueEvents.begin();
+      for ( size_t count = 0; (count < _batchSize) && (end != _queueEvents.end()); ++count, ++end ) {
+        if ( !end->key.empty() ) {
+          PendingStateChanges::iterator pending = _pendingStateChanges.find(end->key);
+          if ( (pending != _pendingStateChanges.end()) && (pending->second == end) ) {
+            _pendingStateChanges.erase(pending);
+          }
+        }
+      }
+      batch.splice(batch.end(), _queueEvents, _queueEvents.begin(), end);
+      _inFlight = batch.size();
+
+      lock.unlock();
+      size_t failed = 0;
+      for ( EventQueue::iterator event = batch.begin(); event != batch.end(); ++event ) {
+        if ( _send(event->data) != 0 ) {
+          failed++;
+        }
+      }
+      lock.lock();
+
+      _stats.sent += batch.size() - failed;
+      _stats.failed += failed;
+      _inFlight = 0;
+      _queueCond.notify_all();
+    }
+
+
+  void    Publisher::_stopSender() {
+      boost::thread *sender;
+      {
+        boost::mutex::scoped_lock lock(_queueMutex);
+        sender = _sender;
+        if ( !sender ) {
+          return;
+        }
+        _senderRunning = false;
+        _queueCond.notify_all();
+      }
+
+      // The sender exits once the queue is empty
+      sender->join();
+      delete sender;
+
+      // Events pushed after the sender found the queue empty are still
+      // queued; send them in order before returning to synchronous mode
+      boost::mutex::scoped_lock lock(_queueMutex);
+      while ( !_queueEvents.empty() ) {
+        _sendBatch(lock);
+      }
+      _sender = 0;
+      _pendingStateChanges.clear();
+    }
+
+
 
   ///////////////////////////////////////////////////////////////////////////
   ///////////////////////////////////////////////////////////////////////////
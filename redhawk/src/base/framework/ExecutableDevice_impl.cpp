@@ -326,6 +326,17 @@ CF::ExecutableDevice::ProcessID_Type ExecutableDevice_impl::do_execute (const ch
         args.push_back(ossie::any_to_string(parameters[i].value));
     }
 
+    // Thread role affinity is applied by the resource as its threads start
+    try {
+        std::string thread_affinity = redhawk::affinity::get_thread_affinity(options);
+        if (!thread_affinity.empty()) {
+            args.push_back(redhawk::affinity::THREAD_AFFINITY_ID);
+            args.push_back(thread_affinity);
+        }
+    } catch (...) {
+        RH_WARN(_executabledeviceLog, "Unable to read thread affinity directives");
+    }
+
     RH_DEBUG(_executabledeviceLog, "Forking process " << path);
 
     std::vector<char*> argv(args.size() + 1, NULL);
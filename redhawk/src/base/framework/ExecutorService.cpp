@@ -19,18 +19,58 @@
  */
 
 #include <ossie/ExecutorService.h>
+#include <ossie/affinity.h>
+
+#include <time.h>
+
+#include <algorithm>
 
 using namespace redhawk;
 
-ExecutorService::ExecutorService() :
-    _thread(0),
-    _running(false)
+namespace {
+    // Strict weak ordering by deadline, used to merge expired tasks from
+    // multiple slots; stable sorting preserves insertion order for tasks
+    // with the same deadline
+    template <class TaskPtr>
+    bool compare_deadline(const TaskPtr& lhs, const TaskPtr& rhs)
+    {
+        return lhs->deadline < rhs->deadline;
+    }
+}
+
+ExecutorService::ExecutorService()
 {
+    _initialize(1);
+}
+
+ExecutorService::ExecutorService(size_t threads)
+{
+    _initialize(threads);
+}
+
+void ExecutorService::_initialize(size_t threads)
+{
+    _threadCount = std::max(threads, (size_t) 1);
+    _timerThread = 0;
+    _running = false;
+    _wheel.resize(WHEEL_SLOTS);
+    _currentTick = _monotonicTime() / TICK_NSEC;
+    _scheduled = 0;
+    _nextId = 1;
+
+    // The timer thread waits for absolute times on the monotonic clock, so
+    // that changes to the system time do not affect scheduling
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&_timerCond, &attr);
+    pthread_condattr_destroy(&attr);
 }
 
 ExecutorService::~ExecutorService()
 {
     stop();
+    pthread_cond_destroy(&_timerCond);
 }
 
 void ExecutorService::start ()
@@ -41,71 +81,312 @@ void ExecutorService::start ()
     }
 
     _running = true;
-    _thread = new boost::thread(&ExecutorService::_run, this);
+    _timerThread = new boost::thread(&ExecutorService::_runTimer, this);
+    for (size_t index = 0; index < _threadCount; ++index) {
+        _workers.push_back(new boost::thread(&ExecutorService::_runWorker, this));
+    }
 }
 
 void ExecutorService::stop ()
 {
-    boost::thread* old_thread = 0;
+    std::vector<boost::thread*> old_threads;
     {
         boost::mutex::scoped_lock lock(_mutex);
         _running = false;
-        old_thread = _thread;
-        _thread = 0;
-        _cond.notify_all();
+        if (_timerThread) {
+            old_threads.push_back(_timerThread);
+            _timerThread = 0;
+        }
+        old_threads.insert(old_threads.end(), _workers.begin(), _workers.end());
+        _workers.clear();
+        pthread_cond_broadcast(&_timerCond);
+        _workCond.notify_all();
     }
-    if (old_thread) {
-        old_thread->join();
-        delete old_thread;
+    for (std::vector<boost::thread*>::iterator thread = old_threads.begin(); thread != old_threads.end(); ++thread) {
+        (*thread)->join();
+        delete *thread;
     }
 }
 
+size_t ExecutorService::threads () const
+{
+    return _threadCount;
+}
+
+bool ExecutorService::cancel (task_id id)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    std::map<task_id,TaskPtr>::iterator periodic = _periodic.find(id);
+    if (periodic == _periodic.end()) {
+        return false;
+    }
+    TaskPtr task = periodic->second;
+    _periodic.erase(periodic);
+    task->cancelled = true;
+
+    // Remove the task if it is waiting to run; if it is running now, the
+    // cancelled flag prevents it from being scheduled again
+    TaskList& slot = _wheel[task->tick % WHEEL_SLOTS];
+    TaskList::iterator pos = std::find(slot.begin(), slot.end(), task);
+    if (pos != slot.end()) {
+        slot.erase(pos);
+        --_scheduled;
+    }
+    std::deque<TaskPtr>::iterator ready = std::find(_ready.begin(), _ready.end(), task);
+    if (ready != _ready.end()) {
+        _ready.erase(ready);
+    }
+    return true;
+}
+
+std::vector<ExecutorService::TaskStatistics> ExecutorService::statistics ()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    std::vector<TaskStatistics> result;
+    for (std::map<task_id,TaskPtr>::iterator periodic = _periodic.begin(); periodic != _periodic.end(); ++periodic) {
+        result.push_back(periodic->second->stats);
+    }
+    return result;
+}
+
 void ExecutorService::clear ()
 {
     boost::mutex::scoped_lock lock(_mutex);
-    _queue.clear();
-    _cond.notify_all();
+    for (std::map<task_id,TaskPtr>::iterator periodic = _periodic.begin(); periodic != _periodic.end(); ++periodic) {
+        periodic->second->cancelled = true;
+    }
+    _periodic.clear();
+    for (std::vector<TaskList>::iterator slot = _wheel.begin(); slot != _wheel.end(); ++slot) {
+        slot->clear();
+    }
+    _scheduled = 0;
+    _ready.clear();
+    pthread_cond_broadcast(&_timerCond);
 }
 
 size_t ExecutorService::pending ()
 {
     boost::mutex::scoped_lock lock(_mutex);
-    return _queue.size();
+    return _scheduled + _ready.size();
+}
+
+ExecutorService::nsec_type ExecutorService::_monotonicTime ()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec * 1000000000LL) + now.tv_nsec;
 }
 
-void ExecutorService::_run ()
+void ExecutorService::_runTimer ()
 {
+    redhawk::affinity::apply_thread_affinity(redhawk::affinity::HOUSEKEEPING_THREAD);
+
     boost::mutex::scoped_lock lock(_mutex);
     while (_running) {
-        if (_queue.empty()) {
-            _cond.wait(lock);
+        nsec_type now = _monotonicTime();
+        nsec_type now_tick = now / TICK_NSEC;
+
+        // Move every task whose time has come to the ready queue, in order
+        // of deadline. After a long gap (e.g., when the service was stopped)
+        // every slot may hold expired tasks, so merge them all at once.
+        size_t ready = _ready.size();
+        if ((now_tick - _currentTick) >= (nsec_type) WHEEL_SLOTS) {
+            _expireAll(now_tick);
         } else {
-            task_queue::iterator task = _queue.begin();
-            if (task->first > boost::get_system_time()) {
-                // Head of queue is scheduled in the future
-                boost::system_time when = task->first;
-                _cond.timed_wait(lock, when);
-            } else {
-                // Copy the task's function and remove it from the queue
-                func_type func = task->second;
-                _queue.erase(task);
-
-                // Run task with the lock released
-                lock.unlock();
-                func();
-                lock.lock();
+            for (; _currentTick < now_tick; ++_currentTick) {
+                _expireSlot(_currentTick, now);
             }
         }
+        _currentTick = now_tick;
+        _expireSlot(now_tick, now);
+        if (_ready.size() > ready) {
+            _workCond.notify_all();
+        }
+
+        nsec_type next = _nextDeadline(now);
+        if (next < 0) {
+            pthread_cond_wait(&_timerCond, lock.mutex()->native_handle());
+        } else {
+            struct timespec when;
+            when.tv_sec = next / 1000000000LL;
+            when.tv_nsec = next % 1000000000LL;
+            pthread_cond_timedwait(&_timerCond, lock.mutex()->native_handle(), &when);
+        }
+    }
+}
+
+void ExecutorService::_runWorker ()
+{
+    redhawk::affinity::apply_thread_affinity(redhawk::affinity::HOUSEKEEPING_THREAD);
+
+    boost::mutex::scoped_lock lock(_mutex);
+    while (_running) {
+        if (_ready.empty()) {
+            _workCond.wait(lock);
+            continue;
+        }
+
+        TaskPtr task = _ready.front();
+        _ready.pop_front();
+        if (task->cancelled) {
+            continue;
+        }
+
+        // Run task with the lock released
+        lock.unlock();
+        nsec_type start = _monotonicTime();
+        task->func();
+        nsec_type end = _monotonicTime();
+        lock.lock();
+
+        _finishTask(task, start, end);
     }
 }
 
+void ExecutorService::_finishTask (const TaskPtr& task, nsec_type start, nsec_type end)
+{
+    if (task->period == 0) {
+        return;
+    }
+
+    TaskStatistics& stats = task->stats;
+    const double runtime = (end - start) * 1e-9;
+    stats.runs++;
+    stats.lastRuntime = runtime;
+    stats.maxRuntime = std::max(stats.maxRuntime, runtime);
+    stats.maxLatency = std::max(stats.maxLatency, (start - task->deadline) * 1e-9);
+    task->totalRuntime += runtime;
+    stats.averageRuntime = task->totalRuntime / stats.runs;
+
+    if (task->cancelled) {
+        return;
+    }
+
+    // Schedule relative to the previous deadline to avoid drift; if that
+    // time has already passed, skip ahead to the next period that has not
+    nsec_type next = task->deadline + task->period;
+    if (next <= end) {
+        nsec_type missed = (end - next) / task->period + 1;
+        stats.overruns += missed;
+        next += missed * task->period;
+    }
+    task->deadline = next;
+    _schedule(task);
+}
+
 void ExecutorService::_insertSorted (func_type func, boost::system_time when)
 {
+    // Convert the requested time to the monotonic clock
+    nsec_type delay = (nsec_type) (when - boost::get_system_time()).total_microseconds() * 1000;
+    TaskPtr task(new Task());
+    task->func = func;
+    task->deadline = _monotonicTime() + std::max(delay, 0LL);
+    task->period = 0;
+    task->id = 0;
+    task->cancelled = false;
+
+    boost::mutex::scoped_lock lock(_mutex);
+    _schedule(task);
+}
+
+ExecutorService::task_id ExecutorService::_insertPeriodic (const std::string& name, boost::posix_time::time_duration period, func_type func)
+{
+    TaskPtr task(new Task());
+    task->func = func;
+    task->period = std::max((nsec_type) period.total_microseconds() * 1000, 1LL);
+    task->deadline = _monotonicTime() + task->period;
+    task->cancelled = false;
+    task->stats.name = name;
+    task->stats.period = period;
+    task->stats.runs = 0;
+    task->stats.overruns = 0;
+    task->stats.lastRuntime = 0.0;
+    task->stats.averageRuntime = 0.0;
+    task->stats.maxRuntime = 0.0;
+    task->stats.maxLatency = 0.0;
+    task->totalRuntime = 0.0;
+
     boost::mutex::scoped_lock lock(_mutex);
-    task_queue::iterator pos = _queue.begin();
-    while ((pos != _queue.end()) && (when > pos->first)) {
+    task->id = _nextId++;
+    _periodic[task->id] = task;
+    _schedule(task);
+    return task->id;
+}
+
+void ExecutorService::_schedule (const TaskPtr& task)
+{
+    // Tasks that are already due go into the current slot, so that they are
+    // picked up by the next pass of the timer thread
+    task->tick = std::max(task->deadline / TICK_NSEC, _currentTick);
+    TaskList& slot = _wheel[task->tick % WHEEL_SLOTS];
+    TaskList::iterator pos = slot.begin();
+    while ((pos != slot.end()) && (task->deadline >= (*pos)->deadline)) {
         ++pos;
     }
-    _queue.insert(pos, std::make_pair(when, func));
-    _cond.notify_all();
+    slot.insert(pos, task);
+    ++_scheduled;
+
+    // Wake the timer thread in case this is now the earliest deadline
+    pthread_cond_signal(&_timerCond);
+}
+
+void ExecutorService::_expireSlot (nsec_type tick, nsec_type now)
+{
+    TaskList& slot = _wheel[tick % WHEEL_SLOTS];
+    TaskList::iterator task = slot.begin();
+    while (task != slot.end()) {
+        if ((*task)->deadline > now) {
+            // The slot is sorted by deadline, so nothing else is due
+            break;
+        }
+        if ((*task)->tick > tick) {
+            // Belongs to a later rotation of the wheel
+            ++task;
+            continue;
+        }
+        _ready.push_back(*task);
+        task = slot.erase(task);
+        --_scheduled;
+    }
+}
+
+void ExecutorService::_expireAll (nsec_type tick)
+{
+    std::vector<TaskPtr> expired;
+    for (std::vector<TaskList>::iterator slot = _wheel.begin(); slot != _wheel.end(); ++slot) {
+        TaskList::iterator task = slot->begin();
+        while (task != slot->end()) {
+            if ((*task)->tick < tick) {
+                expired.push_back(*task);
+                task = slot->erase(task);
+                --_scheduled;
+            } else {
+                ++task;
+            }
+        }
+    }
+    std::stable_sort(expired.begin(), expired.end(), &compare_deadline<TaskPtr>);
+    _ready.insert(_ready.end(), expired.begin(), expired.end());
+}
+
+ExecutorService::nsec_type ExecutorService::_nextDeadline (nsec_type now)
+{
+    if (_scheduled == 0) {
+        return -1;
+    }
+
+    // Find the first slot, starting with the current tick, with a task for
+    // the slot's tick; its first such task has the earliest deadline
+    nsec_type tick = now / TICK_NSEC;
+    for (size_t offset = 0; offset < WHEEL_SLOTS; ++offset, ++tick) {
+        const TaskList& slot = _wheel[tick % WHEEL_SLOTS];
+        for (TaskList::const_iterator task = slot.begin(); task != slot.end(); ++task) {
+            if ((*task)->tick == tick) {
+                return (*task)->deadline;
+            }
+        }
+    }
+
+    // Every task is at least one full rotation away
+    return tick * TICK_NSEC;
 }
@@ -21,6 +21,7 @@
 #include "ossie/LoadableDevice_impl.h"
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include <fstream>
 #include <boost/filesystem.hpp>
 #include <iostream>
@@ -38,6 +39,51 @@ static time_t getModTime (const CF::Properties& properties)
     return static_cast<time_t>(modTime);
 }
 
+/*
+ * If the file described by fileInfo is served from this host, copies it
+ * directly from its local path into localPath, skipping the transfer through
+ * CF::File. Returns false if the file needs to be transferred.
+ */
+static bool copyLocalFile(const CF::FileSystem::FileInformationType& fileInfo, const std::string& localPath)
+{
+    if (fileInfo.kind != CF::FileSystem::PLAIN) {
+        return false;
+    }
+
+    const redhawk::PropertyMap& fileprops = redhawk::PropertyMap::cast(fileInfo.fileProperties);
+    if (!fileprops.contains("HOSTNAME") || !fileprops.contains("LOCAL_PATH")) {
+        return false;
+    }
+    char hostname[256];
+    if (gethostname(hostname, sizeof(hostname))) {
+        return false;
+    }
+    hostname[sizeof(hostname)-1] = '\0';
+    if (fileprops["HOSTNAME"].toString() != hostname) {
+        return false;
+    }
+
+    // Host names are not guaranteed to be unique, so also make sure that the
+    // local file matches the one the file system reported
+    const std::string sourcePath = fileprops["LOCAL_PATH"].toString();
+    struct stat status;
+    if (stat(sourcePath.c_str(), &status) || !S_ISREG(status.st_mode) ||
+        (static_cast<CORBA::ULongLong>(status.st_size) != fileInfo.size) ||
+        (status.st_mtime != getModTime(fileInfo.fileProperties))) {
+        return false;
+    }
+
+    std::ifstream source(sourcePath.c_str(), std::ios::in | std::ios::binary);
+    std::ofstream dest(localPath.c_str(), std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!source.is_open() || !dest.is_open()) {
+        return false;
+    }
+    if (status.st_size > 0) {
+        dest << source.rdbuf();
+    }
+    return dest.good();
+}
+
 static bool checkPath(const std::string& envpath, const std::string& pattern, char delim=':')
 {
     // First, check if the pattern is even in the input path
@@ -171,6 +217,16 @@ void LoadableDevice_impl::_init () {
               "external",
               "configure");
 
+  localCopy=true;
+  addProperty(localCopy,
+              true,
+              "LoadableDevice::local_copy",
+              "LoadableDevice::local_copy",
+              "readwrite",
+              "",
+              "external",
+              "configure");
+
   // Default to the current working directory
   cacheDirectory = ossie::getCurrentDirName();
   setLogger(this->_baseLog->getChildLogger("LoadableDevice", "system"));
@@ -415,7 +471,7 @@ throw (CORBA::SystemException, CF::Device::InvalidState,
             }
         }
 
-        _copyFile( fs, workingFileName, relativeFileName, workingFileName );
+        _copyFile( fs, workingFileName, relativeFileName, workingFileName, *fileInfo );
         chmod(relativeFileName.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
         fileTypeTable[workingFileName] = CF::FileSystem::PLAIN;
     } else {
@@ -621,10 +677,10 @@ void LoadableDevice_impl::_loadTree(CF::FileSystem_ptr fs, std::string remotePat
             fs::path localFile(mod_localPath / fileName);
             if (*(remotePath.end() - 1) == '/') {
                 RH_DEBUG(_loadabledeviceLog, "_copyFile " << remotePath + fileName << " " << localFile)
-                _copyFile(fs, remotePath + fileName, localFile.string(), fileKey);
+                _copyFile(fs, remotePath + fileName, localFile.string(), fileKey, fis[i]);
             } else {
                 RH_DEBUG(_loadabledeviceLog, "_copyFile " << remotePath << " " << localFile)
-                _copyFile(fs, remotePath, localFile.string(), fileKey);
+                _copyFile(fs, remotePath, localFile.string(), fileKey, fis[i]);
             }
             const redhawk::PropertyMap& fileprops = redhawk::PropertyMap::cast(fis[i].fileProperties);
             if (fileprops.get("EXECUTABLE", false).toBoolean()) {
@@ -718,9 +774,18 @@ std::string LoadableDevice_impl::prependCacheIfAvailable(const std::string &loca
     return mod_localPath;
 }
 
-void LoadableDevice_impl::_copyFile(CF::FileSystem_ptr fs, const std::string &remotePath, const std::string &localPath, const std::string &fileKey)
+void LoadableDevice_impl::_copyFile(CF::FileSystem_ptr fs, const std::string &remotePath, const std::string &localPath, const std::string &fileKey, const CF::FileSystem::FileInformationType& fileInfo)
 {
     std::string mod_localPath(prependCacheIfAvailable(localPath));
+
+    // The file information comes from the listing the caller already did, so
+    // checking for a local copy costs no additional calls to the file system
+    if (localCopy && copyLocalFile(fileInfo, mod_localPath)) {
+        RH_DEBUG(_loadabledeviceLog, "Copied " << remotePath << " to " << mod_localPath << " from its local path");
+        copiedFiles.insert(copiedFiles_type::value_type(fileKey, mod_localPath));
+        return;
+    }
+
     CF::File_var fileToLoad = CF::File::_nil();
     try {
        fileToLoad= fs->open(remotePath.c_str(), true);
@@ -18,8 +18,11 @@
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 
+#include <stdexcept>
+
 #include <ossie/MessageInterface.h>
 #include <ossie/PropertyMap.h>
+#include <ossie/affinity.h>
 
 PREPARE_CF_LOGGING(MessageConsumerPort)
 
@@ -71,12 +74,22 @@ CosEventChannelAdmin::ProxyPullConsumer_ptr SupplierAdmin_i::obtain_pull_consume
     
 MessageConsumerPort::MessageConsumerPort(std::string port_name) :
     Port_Provides_base_impl(port_name),
-    supplier_admin(0)
+    supplier_admin(0),
+    _dispatchQueueLimit(0),
+    _dispatchThread(0),
+    _dispatchRunning(false)
 {
 }
 
 MessageConsumerPort::~MessageConsumerPort()
 {
+    // Deliver any queued messages before the callbacks are deleted
+    try {
+        setThreadedDispatch(false);
+    } catch (const std::logic_error& exc) {
+        LOG_ERROR(MessageConsumerPort, "Port destroyed from its own message callback: " << exc.what());
+    }
+
     // If a SupplierAdmin was created, deactivate and delete it
     if (supplier_admin) {
         PortableServer::POA_var poa = supplier_admin->_default_POA();
@@ -167,6 +180,130 @@ CosEventComm::PushSupplier_ptr MessageConsumerPort::removeSupplier (const std::s
 };
 
 void MessageConsumerPort::fireCallback (const std::string& id, const CORBA::Any& data) {
+    if (!_queueDispatch(id, data)) {
+        _dispatchMessage(id, data);
+    }
+};
+
+void MessageConsumerPort::setThreadedDispatch (bool enabled, size_t maxQueue)
+{
+    boost::thread* old_thread = 0;
+    {
+        boost::mutex::scoped_lock lock(_dispatchMutex);
+        if (!enabled && _dispatchThread && (_dispatchThread->get_id() == boost::this_thread::get_id())) {
+            // The dispatch thread would have to wait for itself to exit
+            throw std::logic_error("threaded dispatch cannot be disabled from a message callback");
+        }
+        _dispatchQueueLimit = maxQueue;
+        if (enabled) {
+            if (!_dispatchThread) {
+                _dispatchRunning = true;
+                _dispatchThread = new boost::thread(&MessageConsumerPort::_runDispatch, this);
+            }
+            // The limit may have been raised, let any blocked senders proceed
+            _dispatchSpace.notify_all();
+            return;
+        }
+        _dispatchRunning = false;
+        old_thread = _dispatchThread;
+        _dispatchThread = 0;
+        _dispatchReady.notify_all();
+        _dispatchSpace.notify_all();
+    }
+
+    // The dispatch thread exits once the queue is empty
+    if (old_thread) {
+        old_thread->join();
+        delete old_thread;
+    }
+}
+
+bool MessageConsumerPort::isThreadedDispatch ()
+{
+    boost::mutex::scoped_lock lock(_dispatchMutex);
+    return _dispatchRunning;
+}
+
+bool MessageConsumerPort::_waitForDispatchSpace (boost::mutex::scoped_lock& lock)
+{
+    while (_dispatchRunning && _dispatchQueueLimit && (_dispatchQueue.size() >= _dispatchQueueLimit)) {
+        _dispatchSpace.wait(lock);
+    }
+    return _dispatchRunning;
+}
+
+bool MessageConsumerPort::_queueDispatch (const std::string& id, const CORBA::Any& data)
+{
+    boost::mutex::scoped_lock lock(_dispatchMutex);
+    if (!_waitForDispatchSpace(lock)) {
+        return false;
+    }
+    _dispatchQueue.push_back(QueuedMessage());
+    QueuedMessage& message = _dispatchQueue.back();
+    message.id = id;
+    message.data = data;
+    message.callback = 0;
+    message.direct = 0;
+    _dispatchReady.notify_one();
+    return true;
+}
+
+bool MessageConsumerPort::_queueDirect (const std::string& id, MessageCallback* callback, const void* data)
+{
+    // Copy the message before taking the lock
+    void* copy = callback->clone(data);
+    boost::mutex::scoped_lock lock(_dispatchMutex);
+    if (!_waitForDispatchSpace(lock)) {
+        lock.unlock();
+        callback->release(copy);
+        return false;
+    }
+    _dispatchQueue.push_back(QueuedMessage());
+    QueuedMessage& message = _dispatchQueue.back();
+    message.id = id;
+    message.callback = callback;
+    message.direct = copy;
+    _dispatchReady.notify_one();
+    return true;
+}
+
+void MessageConsumerPort::_runDispatch ()
+{
+    redhawk::affinity::apply_thread_affinity(redhawk::affinity::PROCESSING_THREAD);
+
+    boost::mutex::scoped_lock lock(_dispatchMutex);
+    while (true) {
+        while (_dispatchRunning && _dispatchQueue.empty()) {
+            _dispatchReady.wait(lock);
+        }
+        if (_dispatchQueue.empty()) {
+            // Only reached when dispatch has been disabled
+            return;
+        }
+        QueuedMessage message = _dispatchQueue.front();
+        _dispatchQueue.pop_front();
+        _dispatchSpace.notify_one();
+
+        lock.unlock();
+        try {
+            if (message.direct) {
+                message.callback->dispatch(message.id, static_cast<const void*>(message.direct));
+            } else {
+                _dispatchMessage(message.id, message.data);
+            }
+        } catch (const std::exception& exc) {
+            LOG_ERROR(MessageConsumerPort, "Unhandled exception in callback for message '" << message.id << "': " << exc.what());
+        } catch (...) {
+            LOG_ERROR(MessageConsumerPort, "Unhandled exception in callback for message '" << message.id << "'");
+        }
+        if (message.direct) {
+            message.callback->release(message.direct);
+        }
+        lock.lock();
+    }
+}
+
+void MessageConsumerPort::_dispatchMessage (const std::string& id, const CORBA::Any& data) {
     MessageCallback* callback = getMessageCallback(id);
     if (callback) {
         callback->dispatch(id, data);
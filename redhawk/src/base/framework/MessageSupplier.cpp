@@ -18,6 +18,8 @@
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 
+#include <algorithm>
+
 #include <ossie/MessageInterface.h>
 #include <ossie/PropertyMap.h>
 
@@ -39,6 +41,21 @@ public:
     virtual void queueMessage(const std::string& msgId, const char* format, const void* msgData, MessageSupplierPort::SerializerFunc serializer) = 0;
     virtual void sendMessages() = 0;
 
+    // Batching support; transports that always deliver immediately keep the
+    // default no-op implementations
+    virtual void setBatchSize(size_t /*unused*/)
+    {
+    }
+
+    virtual size_t pending() const
+    {
+        return 0;
+    }
+
+    virtual void flush()
+    {
+    }
+
 private:
     CosEventChannelAdmin::EventChannel_var _channel;
 };
@@ -47,7 +64,8 @@ class MessageSupplierPort::CorbaTransport : public MessageSupplierPort::MessageT
 {
 public:
     CorbaTransport(MessageSupplierPort* port, CosEventChannelAdmin::EventChannel_ptr channel) :
-        MessageTransport(port)
+        MessageTransport(port),
+        _batchSize(1)
     {
         CosEventChannelAdmin::SupplierAdmin_var supplier_admin = channel->for_suppliers();
         _consumer = supplier_admin->obtain_push_consumer();
@@ -75,6 +93,12 @@ public:
 
     void beginQueue(size_t count)
     {
+        if (_queue.length() > 0) {
+            // Messages from a partial batch are still pending; new messages
+            // are appended to them
+            return;
+        }
+
         // Pre-allocate enough space to hold the entire queue
         if (_queue.maximum() < count) {
             _queue.replace(count, 0, CF::Properties::allocbuf(count), true);
@@ -93,6 +117,58 @@ public:
     }
 
     void sendMessages()
+    {
+        if ((_batchSize > 1) && (_queue.length() < _batchSize)) {
+            // Wait for a full batch (or a flush)
+            return;
+        }
+        _sendQueue();
+    }
+
+    void setBatchSize(size_t batchSize)
+    {
+        _batchSize = batchSize;
+    }
+
+    size_t pending() const
+    {
+        return _queue.length();
+    }
+
+    void flush()
+    {
+        if (_queue.length() > 0) {
+            _sendQueue();
+        }
+    }
+
+    void disconnect()
+    {
+        try {
+            flush();
+        } catch (...) {
+            // Pending messages are lost if the consumer cannot be reached
+        }
+        try {
+            _consumer->disconnect_push_consumer();
+        } catch (...) {
+            // Ignore errors on disconnect
+        }
+    }
+
+private:
+    void _sendQueue()
+    {
+        try {
+            _pushQueue();
+        } catch (...) {
+            _queue.length(0);
+            throw;
+        }
+        _queue.length(0);
+    }
+
+    void _pushQueue()
     {
         try {
             CORBA::Any data;
@@ -123,18 +199,9 @@ public:
         }
     }
 
-    void disconnect()
-    {
-        try {
-            _consumer->disconnect_push_consumer();
-        } catch (...) {
-            // Ignore errors on disconnect
-        }
-    }
-
-private:
     CosEventChannelAdmin::ProxyPushConsumer_var _consumer;
     CF::Properties _queue;
+    size_t _batchSize;
 };
 
 class MessageSupplierPort::LocalTransport : public MessageSupplierPort::MessageTransport
@@ -175,26 +242,47 @@ public:
     void queueMessage(const std::string& msgId, const char* format, const void* msgData, MessageSupplierPort::SerializerFunc serializer)
     {
         CallbackEntry* entry = getCallback(msgId, format);
+        const bool generic = _consumer->hasGenericCallbacks();
+
+        // The message is serialized to a CORBA Any at most once, and only
+        // when it's required, so that the best case of direct message
+        // dispatch runs significantly faster
+        CORBA::Any data;
+        bool serialized = false;
+
+        if (_consumer->isThreadedDispatch()) {
+            // The consumer dispatches from its own thread after this call
+            // returns, so it needs its own copy of the message. A typed copy
+            // is enough unless generic callbacks also need the Any.
+            if (entry && entry->direct && !generic) {
+                if (_consumer->_queueDirect(msgId, entry->callback, msgData)) {
+                    return;
+                }
+            }
+            serializer(data, msgData);
+            _consumer->fireCallback(msgId, data);
+            return;
+        }
+
         if (entry) {
             // There is a message-specific callback registered; use direct
             // dispatch if available, otherwise fall back to CORBA Any
             if (entry->direct) {
                 entry->callback->dispatch(msgId, msgData); 
             } else {
-                CORBA::Any data;
                 serializer(data, msgData);
+                serialized = true;
                 entry->callback->dispatch(msgId, data);
             }
         }
 
-        // If the receiver has any generic callbacks registered, serialize the
-        // message to a CORBA Any (which, technically speaking, may have also
-        // been done above if the message format differed) and send it along.
-        // By serializing only when it's required, the best case of direct
-        // message dispatch runs significantly faster.
-        if (_consumer->hasGenericCallbacks()) {
-            CORBA::Any data;
-            serializer(data, msgData);
+        // If the receiver has any generic callbacks registered, send the
+        // message along as a CORBA Any, reusing the serialized value from
+        // above if the message format differed
+        if (generic) {
+            if (!serialized) {
+                serializer(data, msgData);
+            }
             _consumer->dispatchGeneric(msgId, data);
         }
     }
@@ -239,12 +327,17 @@ private:
 };
 
 MessageSupplierPort::MessageSupplierPort (const std::string& name) :
-    UsesPort(name)
+    UsesPort(name),
+    _batchSize(1),
+    _batchDelay(boost::posix_time::seconds(0)),
+    _flushScheduled(false)
 {
 }
 
 MessageSupplierPort::~MessageSupplierPort (void)
 {
+    // Stop the flush thread before any of the connections go away
+    _flushService.stop();
 }
 
 void MessageSupplierPort::_validatePort(CORBA::Object_ptr object)
@@ -276,10 +369,35 @@ redhawk::UsesTransport* MessageSupplierPort::_createTransport(CORBA::Object_ptr
     if (local_port) {
         return new LocalTransport(this, local_port);
     } else {
-        return new CorbaTransport(this, channel);
+        CorbaTransport* transport = new CorbaTransport(this, channel);
+        transport->setBatchSize(_batchSize);
+        return transport;
     }
 }
 
+void MessageSupplierPort::setBatching(size_t maxMessages, double maxDelay)
+{
+    boost::mutex::scoped_lock lock(updatingPortsLock);
+    _batchSize = std::max(maxMessages, (size_t) 1);
+    _batchDelay = boost::posix_time::microseconds(maxDelay * 1e6);
+    for (TransportIterator connection = _connections.begin(); connection != _connections.end(); ++connection) {
+        connection.transport()->setBatchSize(_batchSize);
+    }
+
+    if (_batchSize == 1) {
+        // Batching is now disabled, send whatever was waiting
+        _flushMessageQueues();
+    } else if (_batchDelay > boost::posix_time::seconds(0)) {
+        _flushService.start();
+    }
+}
+
+void MessageSupplierPort::flush()
+{
+    boost::mutex::scoped_lock lock(updatingPortsLock);
+    _flushMessageQueues();
+}
+
 void MessageSupplierPort::push(const CORBA::Any& data, const std::string& connectionId)
 {
     boost::mutex::scoped_lock lock(updatingPortsLock);
@@ -289,12 +407,15 @@ void MessageSupplierPort::push(const CORBA::Any& data, const std::string& connec
             continue;
         }
         try {
+            // Preserve ordering with any messages in a partial batch
+            connection.transport()->flush();
             connection.transport()->push(data);
         } catch (const redhawk::TransportError& exc) {
             RH_NL_WARN("MessageSupplierPort", "Could not deliver the message. " << exc.what());
         } catch (...) {
         }
     }
+    _updateFlushSchedule();
 }
 
 std::string MessageSupplierPort::getRepid() const 
@@ -339,6 +460,52 @@ void MessageSupplierPort::_sendMessageQueue(const std::string& connectionId)
         } catch (...) {
         }
     }
+    _updateFlushSchedule();
+}
+
+void MessageSupplierPort::_updateFlushSchedule()
+{
+    bool pending = false;
+    for (TransportIterator connection = _connections.begin(); connection != _connections.end(); ++connection) {
+        if (connection.transport()->pending() > 0) {
+            pending = true;
+            break;
+        }
+    }
+
+    if (!pending) {
+        // Every batch has been sent; a flush that was already scheduled will
+        // find that it is no longer current and do nothing
+        _flushScheduled = false;
+    } else if (!_flushScheduled && (_batchDelay > boost::posix_time::seconds(0))) {
+        // Bound the time that this partial batch can wait
+        _flushScheduled = true;
+        _flushDeadline = boost::get_system_time() + _batchDelay;
+        _flushService.schedule(_flushDeadline, &MessageSupplierPort::_scheduledFlush, this, _flushDeadline);
+    }
+}
+
+void MessageSupplierPort::_flushMessageQueues()
+{
+    _flushScheduled = false;
+    for (TransportIterator connection = _connections.begin(); connection != _connections.end(); ++connection) {
+        try {
+            connection.transport()->flush();
+        } catch (const redhawk::TransportError& exc) {
+            RH_NL_WARN("MessageSupplierPort", "Could not deliver the message. " << exc.what());
+        } catch (...) {
+        }
+    }
+}
+
+void MessageSupplierPort::_scheduledFlush(boost::system_time deadline)
+{
+    boost::mutex::scoped_lock lock(updatingPortsLock);
+    // Only the most recently scheduled flush applies; earlier ones were for
+    // batches that have since been sent
+    if (_flushScheduled && (deadline == _flushDeadline)) {
+        _flushMessageQueues();
+    }
 }
 
 bool MessageSupplierPort::_isConnectionSelected(const std::string& connectionId, const std::string& targetId)
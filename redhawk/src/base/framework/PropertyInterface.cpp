@@ -18,6 +18,8 @@
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 
+#include <cstring>
+
 #include "ossie/PropertyInterface.h"
 
 namespace CF {
@@ -237,6 +239,26 @@ void PropertyInterface::configure(const std::string& _id, const std::string& _na
     }
 }
 
+void PropertyInterface::configure(const redhawk::PropertyDescriptor& descriptor)
+{
+    // Assign directly from the generated strings, without the temporaries
+    // the string-based overload requires
+    id = descriptor.id;
+    name = descriptor.name;
+    mode = descriptor.mode;
+    units = descriptor.units;
+    action = descriptor.action;
+    const char* start = descriptor.kinds;
+    while (*start) {
+        const char* end = std::strchr(start, ',');
+        if (!end) {
+            end = start + std::strlen(start);
+        }
+        kinds.push_back(std::string(start, end));
+        start = (*end) ? end + 1 : end;
+    }
+}
+
 
 template <typename T>
 class SimplePropertyWrapper : public PropertyWrapper<T>
@@ -19,7 +19,9 @@
  */
 
 
+#include <algorithm>
 #include <iostream>
+#include <stdexcept>
 
 #include "ossie/ThreadedComponent.h"
 #include "ossie/PropertySet_impl.h"
@@ -94,6 +96,7 @@ PREPARE_CF_LOGGING(PropertySet_impl);
 PropertySet_impl::PropertySet_impl ():
   propertyChangePort(0),
   _propertyQueryTimestamp("QUERY_TIMESTAMP"),
+  _propertyIndex(0),
   _propChangeThread( new PropertyChangeThread(*this), 0.1 ),
   _propertiesInitialized(false)
 {
@@ -524,6 +527,12 @@ void PropertySet_impl::unregisterPropertyListener( const char *reg_id )
 
 PropertyInterface* PropertySet_impl::getPropertyFromId (const std::string& id)
 {
+  if (_propertyIndex) {
+    int index = _propertyIndex->find(id.c_str());
+    if ((index >= 0) && _indexedProperties[index]) {
+      return _indexedProperties[index];
+    }
+  }
   PropertyMap::iterator property = propTable.find(id);
   if (property != propTable.end()) {
     return property->second;
@@ -531,6 +540,49 @@ PropertyInterface* PropertySet_impl::getPropertyFromId (const std::string& id)
   return 0;
 }
 
+void PropertySet_impl::insertIndexedProperty (const redhawk::PropertyTable& table, size_t index,
+                                              PropertyInterface* property, PropertyChange::Monitor* monitor)
+{
+  ownedWrappers.push_back(property);
+  // The property map is still needed to iterate over all properties (e.g.,
+  // for query and configure); only lookups by identifier use the table
+  propTable[property->id] = property;
+  _propMonitors[property->id] = monitor;
+
+  if (_propertyIndex != &table) {
+    _propertyIndex = &table;
+    _indexedProperties.assign(table.count, 0);
+  }
+  _indexedProperties[index] = property;
+}
+
+PropertyInterface* PropertySet_impl::replaceProperty (const std::string& id, PropertyInterface* wrapper)
+{
+  PropertyMap::iterator property = propTable.find(id);
+  if (property == propTable.end()) {
+    throw std::invalid_argument("No property with id '" + id + "'");
+  }
+  PropertyInterface* old_wrapper = property->second;
+  if (old_wrapper == wrapper) {
+    return wrapper;
+  }
+  wrapper->id = old_wrapper->id;
+  wrapper->name = old_wrapper->name;
+  wrapper->mode = old_wrapper->mode;
+  wrapper->units = old_wrapper->units;
+  wrapper->action = old_wrapper->action;
+  wrapper->kinds = old_wrapper->kinds;
+  wrapper->enableNil_ = old_wrapper->enableNil_;
+  wrapper->isNil_ = old_wrapper->isNil_;
+
+  // Every reference to the old wrapper must be updated before it is deleted
+  property->second = wrapper;
+  std::replace(ownedWrappers.begin(), ownedWrappers.end(), old_wrapper, wrapper);
+  std::replace(_indexedProperties.begin(), _indexedProperties.end(), old_wrapper, wrapper);
+  delete old_wrapper;
+  return wrapper;
+}
+
 PropertyInterface* PropertySet_impl::getPropertyFromName (const std::string& name)
 {
     for (PropertyMap::iterator property = propTable.begin(); property != propTable.end(); ++property) {
@@ -0,0 +1,53 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <cstring>
+
+#include <ossie/PropertyTable.h>
+
+using redhawk::PropertyTable;
+
+int PropertyTable::find(const char* id) const
+{
+    if (slotCount == 0) {
+        return -1;
+    }
+    const unsigned int bucket = hash(id, 0) % bucketCount;
+    const int index = slots[hash(id, displacements[bucket]) % slotCount];
+    if ((index < 0) || (strcmp(descriptors[index].id, id) != 0)) {
+        return -1;
+    }
+    return index;
+}
+
+unsigned int PropertyTable::hash(const char* id, unsigned int seed)
+{
+    unsigned int value = 2166136261u ^ seed;
+    for (const unsigned char* ch = reinterpret_cast<const unsigned char*>(id); *ch; ++ch) {
+        value ^= *ch;
+        value *= 16777619u;
+    }
+    value ^= value >> 16;
+    value *= 0x85ebca6bu;
+    value ^= value >> 13;
+    value *= 0xc2b2ae35u;
+    value ^= value >> 16;
+    return value;
+}
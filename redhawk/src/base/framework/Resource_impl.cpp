@@ -23,6 +23,7 @@
 #include "ossie/Resource_impl.h"
 #include "ossie/Events.h"
 #include "ossie/Component.h"
+#include "ossie/affinity.h"
 #include <boost/algorithm/string.hpp>
 
 Resource_impl::Resource_impl (const char* _uuid) :
@@ -231,6 +232,14 @@ void Resource_impl::setCommandLineProperty(const std::string& id, const redhawk:
         _softwareProfile = value.toString();
     } else if (id == "RH::DEPLOYMENT_ROOT") {
         _deploymentRoot = value.toString();
+    } else if (id == redhawk::affinity::THREAD_AFFINITY_ID) {
+        // Per-role directives are applied by each thread as it starts
+        try {
+            redhawk::affinity::set_thread_affinity(value.toString());
+            redhawk::affinity::enable_orb_thread_affinity();
+        } catch (const redhawk::affinity::AffinityFailed& exc) {
+            RH_WARN(_resourceLog, "Ignoring thread affinity: " << exc.what());
+        }
     } else {
         PropertySet_impl::setCommandLineProperty(id, value);
     }
@@ -381,6 +390,22 @@ void Resource_impl::start_component(Resource_impl::ctor_type ctor, int argc, cha
         }
     }
 
+    // Likewise, the ORB thread affinity must be in place before the ORB
+    // starts its thread pool; errors are reported when the property is set
+    // on the resource
+    for (int index = 1; index < argc; ++index) {
+        if (redhawk::affinity::THREAD_AFFINITY_ID == argv[index]) {
+            if (++index < argc) {
+                try {
+                    redhawk::affinity::set_thread_affinity(argv[index]);
+                    redhawk::affinity::enable_orb_thread_affinity();
+                } catch (const redhawk::affinity::AffinityFailed&) {
+                }
+            }
+            break;
+        }
+    }
+
     // The ORB must be initialized before anything that might depend on CORBA,
     // such as PropertyMap and logging configuration
     ossie::corba::CorbaInit(argc, argv);
@@ -20,6 +20,7 @@
 
 #include <ossie/ThreadedComponent.h>
 #include <ossie/CorbaUtils.h>
+#include <ossie/affinity.h>
 
 namespace ossie {
 
@@ -53,6 +54,12 @@ void ProcessThread::run()
         pthread_setname_np(pthread_self(), name.c_str());
     }
 
+    redhawk::affinity::apply_thread_affinity(redhawk::affinity::PROCESSING_THREAD);
+
+    // A placement for the component itself (e.g., assigned by ComponentHost)
+    // takes precedence over the process-wide role
+    redhawk::affinity::apply_placement(dynamic_cast<void*>(_target));
+
     while (_running) {
         int state;
         try {
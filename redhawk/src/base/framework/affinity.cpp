@@ -21,18 +21,23 @@
 #include <fstream>
 #include <sstream>
 #include <list>
+#include <map>
 #include <string>
 #include <sched.h>
 #include <sys/types.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include <dirent.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
+#include <boost/thread/mutex.hpp>
 #ifdef HAVE_LIBNUMA
 #include <numa.h>
 #endif
 #ifdef HAVE_OMNIORB4_CORBA_H
 #include "omniORB4/CORBA.h"
+#include "omniORB4/omniInterceptors.h"
 #endif
 #include "ossie/affinity.h"
 #include "ossie/debug.h"
@@ -75,6 +80,30 @@ static std::string _AFFINITY_PROPS_( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>
       <kind kindtype=\"configure\"/> \
       <action type=\"external\"/> \
     </simple> \
+   <simple id=\"affinity::thread_processing\" mode=\"readwrite\" name=\"thread_processing\" type=\"string\" optional=\"true\"> \
+      <description>Affinity for processing (service function and message dispatch) threads, as directive class and context separated by a colon (e.g., cpu:2-3). Supports socket, cpu and nic classes.</description> \
+      <kind kindtype=\"property\"/> \
+      <kind kindtype=\"configure\"/> \
+      <action type=\"external\"/> \
+    </simple> \
+   <simple id=\"affinity::thread_transport\" mode=\"readwrite\" name=\"thread_transport\" type=\"string\" optional=\"true\"> \
+      <description>Affinity for data transport threads, as directive class and context separated by a colon (e.g., cpu:2-3). Supports socket, cpu and nic classes.</description> \
+      <kind kindtype=\"property\"/> \
+      <kind kindtype=\"configure\"/> \
+      <action type=\"external\"/> \
+    </simple> \
+   <simple id=\"affinity::thread_orb\" mode=\"readwrite\" name=\"thread_orb\" type=\"string\" optional=\"true\"> \
+      <description>Affinity for ORB request threads, as directive class and context separated by a colon (e.g., cpu:2-3). Supports socket, cpu and nic classes.</description> \
+      <kind kindtype=\"property\"/> \
+      <kind kindtype=\"configure\"/> \
+      <action type=\"external\"/> \
+    </simple> \
+   <simple id=\"affinity::thread_housekeeping\" mode=\"readwrite\" name=\"thread_housekeeping\" type=\"string\" optional=\"true\"> \
+      <description>Affinity for housekeeping (executor and event publishing) threads, as directive class and context separated by a colon (e.g., cpu:2-3). Supports socket, cpu and nic classes.</description> \
+      <kind kindtype=\"property\"/> \
+      <kind kindtype=\"configure\"/> \
+      <action type=\"external\"/> \
+    </simple> \
 </properties> \
  ");
 
@@ -806,6 +835,216 @@ namespace  redhawk {
 
     }
 
+
+    //
+    // Thread role affinity
+    //
+    static const char* _thread_role_names[] = { "processing", "transport", "orb", "housekeeping" };
+    static const int  _thread_role_count = sizeof(_thread_role_names) / sizeof(_thread_role_names[0]);
+
+    static boost::mutex        _thread_directives_lock;
+    static AffinityDirectives  _thread_directives[_thread_role_count];
+
+    static bool _is_thread_directive( const std::string &pol ) {
+      return ( pol == "cpu" || pol == "socket" || pol == "nic" );
+    }
+
+    std::string get_thread_affinity( const CF::Properties& options ) {
+      const redhawk::PropertyMap ops(options);
+      std::string aid  = AFFINITY_ID;
+      if ( ops.contains(aid) == false ) {
+        aid  = boost::to_upper_copy( aid );
+        if ( ops.contains(aid) == false ) {
+          return std::string();
+        }
+      }
+
+      std::vector< std::string > directives;
+      const redhawk::PropertyMap affinity_map(ops[aid].asProperties());
+      for ( int role=0; role < _thread_role_count; role++ ) {
+        const std::string pid = std::string("affinity::thread_") + _thread_role_names[role];
+        if ( affinity_map.contains(pid) ) {
+          const std::string value = affinity_map[pid].toString();
+          if ( !value.empty() ) {
+            directives.push_back( std::string(_thread_role_names[role]) + "=" + value );
+          }
+        }
+      }
+      return boost::algorithm::join( directives, ";" );
+    }
+
+    void set_thread_affinity( const std::string &directives )
+      throw (AffinityFailed)
+    {
+      AffinityDirectives spec[_thread_role_count];
+
+      std::vector< std::string > entries;
+      boost::algorithm::split( entries, directives, boost::is_any_of(";"), boost::algorithm::token_compress_on );
+      std::vector< std::string >::iterator entry = entries.begin();
+      for ( ; entry != entries.end(); entry++ ) {
+        std::string text = boost::trim_copy( *entry );
+        if ( text.empty() ) continue;
+
+        // role=class:context
+        std::string::size_type eq = text.find('=');
+        std::string::size_type colon = text.find(':', eq);
+        if ( eq == std::string::npos || colon == std::string::npos ) {
+          throw AffinityFailed("Invalid thread affinity directive: <" + text + ">" );
+        }
+
+        const std::string role = text.substr(0, eq);
+        AffinityDirective pol( text.substr(eq+1, colon-eq-1), text.substr(colon+1) );
+        if ( !_is_thread_directive(pol.first) ) {
+          throw AffinityFailed("Thread affinity does not support directive class: <" + pol.first + ">" );
+        }
+
+        int index = 0;
+        while ( index < _thread_role_count && role != _thread_role_names[index] ) index++;
+        if ( index == _thread_role_count ) {
+          throw AffinityFailed("Unknown thread role in affinity directive: <" + role + ">" );
+        }
+        RH_DEBUG(_affinity_logger, "Thread affinity role: " << role << " " << pol.first << ":" << pol.second );
+        spec[index].push_back( pol );
+      }
+
+      boost::mutex::scoped_lock lock(_thread_directives_lock);
+      for ( int role=0; role < _thread_role_count; role++ ) {
+        _thread_directives[role] = spec[role];
+      }
+    }
+
+    void set_thread_affinity( const ThreadRole role, const AffinityDirectives &spec ) {
+      if ( role < 0 || role >= _thread_role_count ) return;
+      boost::mutex::scoped_lock lock(_thread_directives_lock);
+      _thread_directives[role] = spec;
+    }
+
+    AffinityDirectives get_thread_directives( const ThreadRole role ) {
+      if ( role < 0 || role >= _thread_role_count ) return AffinityDirectives();
+      boost::mutex::scoped_lock lock(_thread_directives_lock);
+      return _thread_directives[role];
+    }
+
+    int apply_thread_affinity( const ThreadRole role ) {
+      if ( is_disabled() ) {
+        return 0;
+      }
+
+      AffinityDirectives spec = get_thread_directives( role );
+      if ( spec.empty() ) {
+        return 0;
+      }
+
+      // On Linux, scheduler affinity set for a thread id applies only to that thread
+      pid_t tid = syscall(SYS_gettid);
+      try {
+        RH_DEBUG(_affinity_logger, "Setting " << _thread_role_names[role] << " thread affinity, tid: " << tid );
+        set_affinity( spec, tid );
+      }
+      catch( AffinityFailed &e ) {
+        RH_WARN(_affinity_logger, "Unable to set " << _thread_role_names[role] << " thread affinity: " << e.what() );
+        return -1;
+      }
+      return 0;
+    }
+
+#ifdef HAVE_OMNIORB4_CORBA_H
+    static void _orb_thread_start( omniInterceptors::createThread_T::info_T &info ) {
+      apply_thread_affinity( ORB_THREAD );
+      info.run();
+    }
+#endif
+
+    void enable_orb_thread_affinity() {
+#ifdef HAVE_OMNIORB4_CORBA_H
+      static bool installed = false;
+      boost::mutex::scoped_lock lock(_thread_directives_lock);
+      if ( !installed ) {
+        omniORB::getInterceptors()->createThread.add( &_orb_thread_start );
+        installed = true;
+      }
+#endif
+    }
+
+
+    int get_node_count() {
+#ifdef HAVE_LIBNUMA
+      if ( check_numa() ) {
+        return numa_max_node() + 1;
+      }
+#endif
+      return 1;
+    }
+
+    int get_current_node() {
+#ifdef HAVE_LIBNUMA
+      if ( check_numa() ) {
+        int cpu = sched_getcpu();
+        if ( cpu >= 0 ) {
+          int node = numa_node_of_cpu( cpu );
+          if ( node >= 0 ) return node;
+        }
+      }
+#endif
+      return 0;
+    }
+
+
+    //
+    // Object placement
+    //
+    typedef std::map< const void*, AffinityDirectives >  PlacementTable;
+    static boost::mutex    _placement_lock;
+    static PlacementTable  _placements;
+
+    void set_placement( const void *object, const AffinityDirectives &spec ) {
+      boost::mutex::scoped_lock lock(_placement_lock);
+      _placements[object] = spec;
+    }
+
+    void clear_placement( const void *object ) {
+      boost::mutex::scoped_lock lock(_placement_lock);
+      _placements.erase(object);
+    }
+
+    AffinityDirectives get_placement( const void *object ) {
+      boost::mutex::scoped_lock lock(_placement_lock);
+      PlacementTable::const_iterator iter = _placements.find(object);
+      if ( iter == _placements.end() ) {
+        return AffinityDirectives();
+      }
+      return iter->second;
+    }
+
+    int apply_placement( const void *object ) {
+      if ( is_disabled() ) {
+        return 0;
+      }
+
+      AffinityDirectives spec = get_placement( object );
+      if ( spec.empty() ) {
+        return 0;
+      }
+
+      pid_t tid = syscall(SYS_gettid);
+      try {
+        RH_DEBUG(_affinity_logger, "Applying placement to tid: " << tid );
+        set_affinity( spec, tid );
+      }
+      catch( AffinityFailed &e ) {
+        RH_WARN(_affinity_logger, "Unable to apply placement: " << e.what() );
+        return -1;
+      }
+
+#ifdef HAVE_LIBNUMA
+      // Allocate from the node the thread now runs on
+      if ( check_numa() ) {
+        numa_set_localalloc();
+      }
+#endif
+      return 0;
+    }
+
   };
 
 };
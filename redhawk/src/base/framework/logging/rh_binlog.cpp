@@ -0,0 +1,411 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include <ossie/logging/rh_binlog.h>
+
+namespace rh_logger {
+
+  namespace binary {
+
+    namespace detail {
+      // No level is at or below the disabled threshold; Level::ALL_INT has the
+      // same value, so open() maps it to the highest level instead
+      static const int DISABLED = INT_MIN;
+
+      // Disabled until a file is opened
+      int threshold = DISABLED;
+      volatile unsigned int generation = 0;
+    };
+
+    namespace {
+
+      // Fixed size of the site table; at roughly 200 bytes per site, this
+      // is enough for several thousand logging statements
+      static const size_t SITE_CAPACITY = 1024*1024;
+
+      struct LogFile {
+        std::string path;
+        format::FileHeader* header;
+        char* sites;
+        char* ring;
+        uint64_t mask;
+        uint32_t siteCount;
+      };
+
+      // Protects opening and closing, and the site table
+      static boost::mutex fileMutex;
+      static LogFile* volatile current = 0;
+
+      static __thread pid_t threadId = 0;
+
+      static uint64_t timestamp()
+      {
+        struct timespec now;
+        clock_gettime(CLOCK_REALTIME, &now);
+        return (now.tv_sec * 1000000000ULL) + now.tv_nsec;
+      }
+
+      static pid_t getThreadId()
+      {
+        if (!threadId) {
+          threadId = syscall(SYS_gettid);
+        }
+        return threadId;
+      }
+
+      // Copies data into the ring starting at the given absolute offset,
+      // wrapping around the end as needed
+      static void writeRing(LogFile* file, uint64_t offset, const char* data, size_t bytes)
+      {
+        size_t start = offset & file->mask;
+        size_t first = std::min(bytes, static_cast<size_t>(file->mask + 1 - start));
+        std::memcpy(file->ring + start, data, first);
+        if (first < bytes) {
+          std::memcpy(file->ring, data + first, bytes - first);
+        }
+      }
+
+      static std::string getProcessName()
+      {
+        std::ifstream comm("/proc/self/comm");
+        std::string name;
+        std::getline(comm, name);
+        return name;
+      }
+
+      static int parseLevel(const char* value)
+      {
+        static const struct {
+          const char* name;
+          int level;
+        } LEVELS[] = {
+          { "ALL", Level::ALL_INT },
+          { "TRACE", Level::TRACE_INT },
+          { "DEBUG", Level::DEBUG_INT },
+          { "INFO", Level::INFO_INT },
+          { "WARN", Level::WARN_INT },
+          { "ERROR", Level::ERROR_INT },
+          { "FATAL", Level::FATAL_INT }
+        };
+        for (size_t index = 0; index < sizeof(LEVELS)/sizeof(LEVELS[0]); ++index) {
+          if (strcasecmp(value, LEVELS[index].name) == 0) {
+            return LEVELS[index].level;
+          }
+        }
+        std::cerr << "Invalid value for RH_LOG_BINARY_LEVEL: '" << value << "'" << std::endl;
+        return Level::DEBUG_INT;
+      }
+
+      static size_t parseSize(const char* value)
+      {
+        char* end = 0;
+        unsigned long long size = strtoull(value, &end, 10);
+        switch (*end) {
+        case 'G': case 'g':
+          size *= 1024;
+          // fall through
+        case 'M': case 'm':
+          size *= 1024;
+          // fall through
+        case 'K': case 'k':
+          size *= 1024;
+          ++end;
+          break;
+        default:
+          break;
+        }
+        if ((end == value) || (*end != '\0')) {
+          std::cerr << "Invalid value for RH_LOG_BINARY_SIZE: '" << value << "'" << std::endl;
+          return 0;
+        }
+        return size;
+      }
+
+      // Enables binary logging at startup if requested by the environment
+      struct Initializer {
+        Initializer()
+        {
+          const char* directory = getenv("RH_LOG_BINARY");
+          if (!directory || (*directory == '\0')) {
+            return;
+          }
+          size_t bytes = 16*1024*1024;
+          const char* size = getenv("RH_LOG_BINARY_SIZE");
+          if (size && (*size != '\0')) {
+            size_t value = parseSize(size);
+            if (value) {
+              bytes = value;
+            }
+          }
+          int threshold = Level::DEBUG_INT;
+          const char* level = getenv("RH_LOG_BINARY_LEVEL");
+          if (level && (*level != '\0')) {
+            threshold = parseLevel(level);
+          }
+          open(directory, bytes, threshold);
+        }
+      };
+
+      static Initializer initializer;
+    }
+
+    bool open(const std::string& directory, size_t bytes, int threshold)
+    {
+      boost::mutex::scoped_lock lock(fileMutex);
+
+      // Events are recorded at or below the threshold, so recording every
+      // level means using the highest one
+      if (threshold == Level::ALL_INT) {
+        threshold = Level::FATAL_INT;
+      }
+
+      // Round the ring size up to a power of two, so that offsets can be
+      // masked instead of divided
+      size_t capacity = 64*1024;
+      while (capacity < bytes) {
+        capacity <<= 1;
+      }
+
+      std::ostringstream oss;
+      oss << directory << "/rhlog-" << getpid() << ".bin";
+      const std::string path = oss.str();
+
+      const size_t header_size = sysconf(_SC_PAGESIZE);
+      const size_t total = header_size + SITE_CAPACITY + capacity;
+
+      int fd = ::open(path.c_str(), O_RDWR|O_CREAT|O_TRUNC, 0644);
+      if (fd < 0) {
+        std::cerr << "Unable to create binary log file " << path << ": " << strerror(errno) << std::endl;
+        return false;
+      }
+      if (ftruncate(fd, total) < 0) {
+        std::cerr << "Unable to size binary log file " << path << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        unlink(path.c_str());
+        return false;
+      }
+      void* addr = mmap(0, total, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+      ::close(fd);
+      if (addr == MAP_FAILED) {
+        std::cerr << "Unable to map binary log file " << path << ": " << strerror(errno) << std::endl;
+        unlink(path.c_str());
+        return false;
+      }
+
+      LogFile* file = new LogFile();
+      file->path = path;
+      file->header = static_cast<format::FileHeader*>(addr);
+      file->sites = static_cast<char*>(addr) + header_size;
+      file->ring = file->sites + SITE_CAPACITY;
+      file->mask = capacity - 1;
+      file->siteCount = 0;
+
+      format::FileHeader* header = file->header;
+      std::memcpy(header->magic, format::MAGIC, sizeof(header->magic));
+      header->version = format::FORMAT_VERSION;
+      header->pid = getpid();
+      header->created = timestamp();
+      header->siteOffset = header_size;
+      header->siteCapacity = SITE_CAPACITY;
+      header->ringOffset = header_size + SITE_CAPACITY;
+      header->ringCapacity = capacity;
+      header->siteBytes = 0;
+      header->cursor = 0;
+      std::string process = getProcessName();
+      strncpy(header->process, process.c_str(), sizeof(header->process) - 1);
+
+      // Publish the new file, then invalidate all site IDs from any previous
+      // file; the previous file is intentionally left mapped
+      __sync_synchronize();
+      current = file;
+      ++detail::generation;
+      detail::threshold = threshold;
+      return true;
+    }
+
+    void close()
+    {
+      boost::mutex::scoped_lock lock(fileMutex);
+      detail::threshold = detail::DISABLED;
+      current = 0;
+    }
+
+    std::string filename()
+    {
+      boost::mutex::scoped_lock lock(fileMutex);
+      LogFile* file = current;
+      if (file) {
+        return file->path;
+      }
+      return std::string();
+    }
+
+    void Site::_register()
+    {
+      boost::mutex::scoped_lock lock(fileMutex);
+      unsigned int generation = detail::generation;
+      if (_generation == generation) {
+        // Another thread registered this site first
+        return;
+      }
+
+      uint32_t id = 0;
+      LogFile* file = current;
+      if (file) {
+        format::SiteHeader site;
+        site.level = _level;
+        site.line = _line;
+        site.fileLength = strlen(_file);
+        site.functionLength = strlen(_function);
+        site.size = sizeof(site) + site.fileLength + site.functionLength;
+
+        // If the table is full, the site is left unidentified (0) but its
+        // events are still recorded
+        uint64_t offset = file->header->siteBytes;
+        if ((offset + format::align(site.size)) <= file->header->siteCapacity) {
+          id = site.id = ++file->siteCount;
+          char* dest = file->sites + offset;
+          std::memcpy(dest, &site, sizeof(site));
+          dest += sizeof(site);
+          std::memcpy(dest, _file, site.fileLength);
+          dest += site.fileLength;
+          std::memcpy(dest, _function, site.functionLength);
+          __sync_synchronize();
+          file->header->siteBytes = offset + format::align(site.size);
+        }
+      }
+
+      _id = id;
+      __sync_synchronize();
+      _generation = generation;
+    }
+
+    Record::Record(Site& site, const LoggerPtr& logger) :
+      _size(sizeof(format::RecordHeader)),
+      _text(0),
+      _truncated(false),
+      _file(current)
+    {
+      if (!_file) {
+        return;
+      }
+
+      _header.size = 0;
+      _header.site = site.id();
+      _header.time = timestamp();
+      _header.thread = getThreadId();
+      _header.flags = 0;
+
+      const std::string& name = logger->getNameRef();
+      size_t length = std::min(name.size(), static_cast<size_t>(256));
+      std::memcpy(_data + _size, name.data(), length);
+      _header.loggerLength = length;
+      _size += length;
+    }
+
+    Record::~Record()
+    {
+      if (_text) {
+        _endText();
+      }
+      LogFile* file = static_cast<LogFile*>(_file);
+      if (!file) {
+        return;
+      }
+
+      if (_truncated) {
+        _header.flags |= format::RECORD_TRUNCATED;
+      }
+
+      // Reserve space in the ring, and write the record with its size as
+      // zero until the entire contents have been copied
+      const uint32_t size = _size;
+      const size_t reserved = format::align(size);
+      _header.offset = __sync_fetch_and_add(&file->header->cursor, reserved);
+      writeRing(file, _header.offset, _data, size);
+      __sync_synchronize();
+      format::RecordHeader* header = reinterpret_cast<format::RecordHeader*>(file->ring + (_header.offset & file->mask));
+      header->size = size;
+    }
+
+    void Record::_appendText(const char* text, size_t length)
+    {
+      if (!_text) {
+        // Start a new text argument, leaving room for the length
+        if ((_size + 1 + sizeof(uint32_t)) > CAPACITY) {
+          _truncated = true;
+          return;
+        }
+        _data[_size++] = format::ARG_TEXT;
+        _text = _size;
+        _size += sizeof(uint32_t);
+      }
+      if ((_size + length) > CAPACITY) {
+        length = CAPACITY - _size;
+        _truncated = true;
+      }
+      std::memcpy(_data + _size, text, length);
+      _size += length;
+    }
+
+    void Record::_endText()
+    {
+      uint32_t length = _size - _text - sizeof(uint32_t);
+      std::memcpy(_data + _text, &length, sizeof(length));
+      _text = 0;
+    }
+
+    Record::TextBuffer::int_type Record::TextBuffer::overflow(int_type ch)
+    {
+      if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        char value = traits_type::to_char_type(ch);
+        _record._appendText(&value, 1);
+      }
+      return traits_type::not_eof(ch);
+    }
+
+    std::streamsize Record::TextBuffer::xsputn(const char* s, std::streamsize count)
+    {
+      _record._appendText(s, count);
+      return count;
+    }
+
+  };
+
+};
@@ -37,6 +37,10 @@ namespace redhawk {
             static boost::once_flag heapInit = BOOST_ONCE_INIT;
             static boost::scoped_ptr<Heap> instance(0);
 
+            // Calling thread's owner tag for allocations; a plain thread-local
+            // integer, because it is read on every allocation
+            static __thread uint32_t allocationTag = 0;
+
             static void initializeHeap()
             {
                 if (!redhawk::env::getEnable("RH_SHMALLOC", true)) {
@@ -79,7 +83,7 @@ namespace redhawk {
             if (!heap) {
                 return 0;
             }
-            return heap->allocate(bytes);
+            return heap->allocate(bytes, allocationTag);
         }
 
         void deallocate(void* ptr)
@@ -98,7 +102,7 @@ namespace redhawk {
                 return redhawk::BufferManager::Allocate(bytes);
             }
 
-            void* ptr = heap->allocate(bytes);
+            void* ptr = heap->allocate(bytes, allocationTag);
             if (ptr) {
                 return ptr;
             }
@@ -130,5 +134,45 @@ namespace redhawk {
                 heap->deallocate(ptr);
             }
         }
+
+        uint32_t internAllocationTag(const std::string& tag)
+        {
+            Heap* heap = getProcessHeap();
+            if (!heap) {
+                return 0;
+            }
+            return heap->internTag(tag);
+        }
+
+        void releaseAllocationTag(uint32_t tag)
+        {
+            Heap* heap = getProcessHeap();
+            if (heap) {
+                heap->releaseTag(tag);
+            }
+        }
+
+        void setAllocationTag(uint32_t tag)
+        {
+            allocationTag = tag;
+        }
+
+        uint32_t getAllocationTag()
+        {
+            return allocationTag;
+        }
+
+        bool isExclusive(const void* ptr)
+        {
+            if (!getProcessHeap()) {
+                // Without a process heap, hybrid allocations have no block
+                // header, so they cannot be told apart from memory attached
+                // from another process; assume the memory is shared
+                return false;
+            }
+            const Block* block = Block::from_pointer(const_cast<void*>(ptr));
+            assert(block->valid());
+            return (block->getRefcount() <= 1);
+        }
     }
 }
@@ -23,6 +23,7 @@
 
 #include <inttypes.h>
 #include <assert.h>
+#include <time.h>
 
 #include "atomic_counter.h"
 #include "offset_ptr.h"
@@ -49,7 +50,9 @@ namespace redhawk {
                 _magic(Block::BLOCK_MAGIC),
                 _refcount(-1),
                 _offset(offset),
-                _size(blocks)
+                _size(blocks),
+                _tag(0),
+                _time(0)
             {
             }
 
@@ -210,6 +213,37 @@ namespace redhawk {
                 return _refcount;
             }
 
+            // Records the owner tag (an index into the heap's tag table) and
+            // the allocation time, for live heap accounting
+            void setOwner(uint32_t tag, uint32_t time)
+            {
+                _tag = tag;
+                _time = time;
+            }
+
+            uint32_t getTag() const
+            {
+                return _tag;
+            }
+
+            uint32_t getTime() const
+            {
+                return _time;
+            }
+
+            // Returns the current time in seconds, on a clock that is shared
+            // by all processes on the system
+            static uint32_t timestamp()
+            {
+                struct timespec now;
+#ifdef CLOCK_MONOTONIC_COARSE
+                clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+#else
+                clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+                return now.tv_sec;
+            }
+
         private:
             static const magic_type FLAG_PREV = 1;
 
@@ -222,6 +256,16 @@ namespace redhawk {
             atomic_counter<int32_t> _refcount;
             blocksize_type _offset;
             blocksize_type _size;
+            // Owner accounting. The four fields above are all needed (the
+            // magic number in particular is what lets getUsage() walk a heap
+            // that is in use without locking), so these cannot be packed into
+            // them, and the header must stay a multiple of BLOCK_SIZE to keep
+            // data 16-byte aligned: the header is 32 bytes rather than 16.
+            // This costs 16 bytes per allocation, under 1% for packets of 2KB
+            // or more; the smallest block (a FreeBlock) grows from 32 to 48.
+            uint32_t _tag;
+            uint32_t _time;
+            uint32_t _reserved[2];
         };
     }
 }
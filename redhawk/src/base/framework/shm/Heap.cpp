@@ -138,9 +138,10 @@ Heap::~Heap()
     }
 }
 
-void* Heap::allocate(size_t bytes)
+void* Heap::allocate(size_t bytes, uint32_t tag)
 {
     ThreadState* state = _getThreadState();
+    state->tag = tag;
     Pool* pool = _getPool(state);
     return pool->allocate(state, bytes);
 }
@@ -171,6 +172,23 @@ const std::string& Heap::name() const
     return _file.name();
 }
 
+SuperblockFile::Usage Heap::getUsage()
+{
+    return _file.getUsage();
+}
+
+uint32_t Heap::internTag(const std::string& tag)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    return _file.internTag(tag);
+}
+
+void Heap::releaseTag(uint32_t tag)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    _file.releaseTag(tag);
+}
+
 Heap::Pool* Heap::_getPool(ThreadState* state)
 {
     size_t pool_id = policy->getPoolAssignment(state);
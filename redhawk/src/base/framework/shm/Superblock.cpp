@@ -184,6 +184,50 @@ void Superblock::_dump(std::ostream& stream) const
     stream << blocks << " block(s)" << std::endl;
 }
 
+bool Superblock::getUsage(SuperblockFile::Usage& usage, TagTable& tags, uint32_t now) const
+{
+    const Block* end = _end();
+    for (const Block* block = _begin(); block < end; ) {
+        // The owner may be modifying the superblock, so check every block
+        // before trusting its contents
+        if (!block->valid() || (block->size() == 0)) {
+            return false;
+        }
+        const Block* next = block->next();
+        if (next > end) {
+            return false;
+        }
+
+        const size_t bytes = block->byteSize();
+        const int refcount = block->getRefcount();
+        if (refcount < 0) {
+            usage.freeBlocks++;
+            usage.freeBytes += bytes;
+            usage.largestFree = std::max(usage.largestFree, bytes);
+        } else {
+            usage.blocks++;
+            usage.bytes += bytes;
+            if (refcount > 1) {
+                usage.sharedBlocks++;
+            }
+
+            const uint32_t time = block->getTime();
+            const uint32_t age = (now > time) ? (now - time) : 0;
+            size_t bucket = 0;
+            while ((bucket < (SuperblockFile::AGE_BUCKETS - 1)) && (age >= SuperblockFile::AgeLimit(bucket))) {
+                ++bucket;
+            }
+            usage.ages[bucket]++;
+
+            SuperblockFile::TagUsage& tag = tags[block->getTag()];
+            tag.blocks++;
+            tag.bytes += bytes;
+        }
+        block = next;
+    }
+    return true;
+}
+
 char* Superblock::_data()
 {
     char* ptr = reinterpret_cast<char*>(this);
@@ -378,6 +422,7 @@ void* Superblock::allocate(ThreadState* thread, size_t bytes)
 
     // Mark the block as "allocated"
     block->markUsed();
+    block->setOwner(thread->tag, Block::timestamp());
     Block* next = block->next();
     if (next != _end()) {
         assert(next->valid());
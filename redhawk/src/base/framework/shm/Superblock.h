@@ -22,8 +22,11 @@
 #define REDHAWK_SHM_SUPERBLOCK_H
 
 #include <ostream>
+#include <map>
 #include <inttypes.h>
 
+#include <ossie/shm/SuperblockFile.h>
+
 #include "shared_mutex.h"
 
 namespace redhawk {
@@ -54,6 +57,14 @@ namespace redhawk {
 
             void dump(std::ostream& stream) const;
 
+            typedef std::map<uint32_t,SuperblockFile::TagUsage> TagTable;
+
+            // Adds the blocks in this superblock to usage, with the allocated
+            // blocks by tag index added to tags; returns false if an
+            // inconsistency was found (i.e., the superblock was modified
+            // concurrently)
+            bool getUsage(SuperblockFile::Usage& usage, TagTable& tags, uint32_t now) const;
+
         protected:
             struct FreeBlock;
 
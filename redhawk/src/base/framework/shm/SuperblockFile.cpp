@@ -22,6 +22,9 @@
 
 #include <stdexcept>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <cstring>
 
 #include <sys/types.h>
 #include <signal.h>
@@ -30,6 +33,7 @@
 #include <ossie/shm/System.h>
 
 #include "Superblock.h"
+#include "Block.h"
 #include "atomic_counter.h"
 #include "Metrics.h"
 
@@ -43,22 +47,63 @@ struct SuperblockFile::Header {
     // ABI version of superblock file. If the layout of the header or the
     // Superblock class changes, changes, this version must be incremented.
     typedef uint32_t version_type;
-    static const version_type SUPERBLOCK_VERSION = 1;
+    static const version_type SUPERBLOCK_VERSION = 2;
 
     Header() :
         magic(SUPERBLOCK_MAGIC),
         version(SUPERBLOCK_VERSION),
         refcount(1),
-        creator(getpid())
+        creator(getpid()),
+        tagCount(1)
     {
+        std::memset(tagRefs, 0, sizeof(tagRefs));
+        std::memset(tags, 0, sizeof(tags));
     }
 
     const magic_type magic;
     const version_type version;
     atomic_counter<int32_t> refcount;
     const pid_t creator;
+
+    // Owner tag table for live accounting; index 0 is reserved for untagged
+    // allocations. Only the creator adds tags, writing the name before
+    // publishing it by incrementing the count. Each entry is reference
+    // counted by the creator, and reused once it is no longer referenced.
+    static const size_t MAX_TAGS = 64;
+    static const size_t TAG_LENGTH = 48;
+    atomic_counter<int32_t> tagCount;
+    int32_t tagRefs[MAX_TAGS];
+    char tags[MAX_TAGS][TAG_LENGTH];
 };
 
+SuperblockFile::TagUsage::TagUsage() :
+    blocks(0),
+    bytes(0)
+{
+}
+
+SuperblockFile::Usage::Usage() :
+    blocks(0),
+    bytes(0),
+    sharedBlocks(0),
+    freeBlocks(0),
+    freeBytes(0),
+    largestFree(0),
+    tags(),
+    complete(true)
+{
+    std::fill(ages, ages + AGE_BUCKETS, 0);
+}
+
+unsigned int SuperblockFile::AgeLimit(size_t bucket)
+{
+    static const unsigned int limits[AGE_BUCKETS] = { 1, 10, 60, 600, 3600, 0 };
+    if (bucket >= AGE_BUCKETS) {
+        return 0;
+    }
+    return limits[bucket];
+}
+
 SuperblockFile::SuperblockFile(const std::string& name) :
     _file(name),
     _attached(false),
@@ -165,6 +210,119 @@ SuperblockFile::Statistics SuperblockFile::getStatistics()
     return stats;
 }
 
+SuperblockFile::Usage SuperblockFile::getUsage()
+{
+    Usage usage;
+    Superblock::TagTable tags;
+    const uint32_t now = Block::timestamp();
+
+    size_t offset = MappedFile::PAGE_SIZE;
+    const size_t end = _file.size();
+    while (offset < end) {
+        // Map the superblock header to get its size, then map the whole
+        // superblock read-only to walk its blocks
+        void* base = _file.map(MappedFile::PAGE_SIZE, MappedFile::READONLY, offset);
+        const Superblock* superblock = reinterpret_cast<const Superblock*>(base);
+        bool valid = (superblock->offset() == offset);
+        size_t superblock_size = superblock->size();
+        _file.unmap(base, MappedFile::PAGE_SIZE);
+        if (!valid) {
+            usage.complete = false;
+            break;
+        }
+
+        const size_t total_size = MappedFile::PAGE_SIZE + superblock_size;
+        base = _file.map(total_size, MappedFile::READONLY, offset);
+        superblock = reinterpret_cast<const Superblock*>(base);
+        if (!superblock->getUsage(usage, tags, now)) {
+            usage.complete = false;
+        }
+        _file.unmap(base, total_size);
+
+        offset += total_size;
+    }
+
+    for (Superblock::TagTable::const_iterator tag = tags.begin(); tag != tags.end(); ++tag) {
+        TagUsage& tag_usage = usage.tags[getTag(tag->first)];
+        tag_usage.blocks += tag->second.blocks;
+        tag_usage.bytes += tag->second.bytes;
+    }
+
+    return usage;
+}
+
+uint32_t SuperblockFile::internTag(const std::string& tag)
+{
+    if (!_header) {
+        throw std::logic_error("not attached");
+    }
+    if (tag.empty()) {
+        return 0;
+    }
+
+    // Look for the tag among the entries in use, remembering the first
+    // unused entry in case it has to be added
+    const std::string name = tag.substr(0, Header::TAG_LENGTH - 1);
+    const int32_t count = _header->tagCount;
+    int32_t unused = 0;
+    for (int32_t index = 1; index < count; ++index) {
+        if (_header->tagRefs[index] == 0) {
+            if (!unused) {
+                unused = index;
+            }
+        } else if (name == _header->tags[index]) {
+            _header->tagRefs[index]++;
+            return index;
+        }
+    }
+
+    if (unused) {
+        // Blocks allocated under the entry's previous tag that are still
+        // alive will be reported under the new one
+        std::strcpy(_header->tags[unused], name.c_str());
+        _header->tagRefs[unused] = 1;
+        return unused;
+    }
+
+    if (count >= (int32_t) Header::MAX_TAGS) {
+        return 0;
+    }
+    std::strcpy(_header->tags[count], name.c_str());
+    _header->tagRefs[count] = 1;
+    __sync_synchronize();
+    _header->tagCount.increment();
+    return count;
+}
+
+void SuperblockFile::releaseTag(uint32_t index)
+{
+    if (!_header) {
+        throw std::logic_error("not attached");
+    }
+    if ((index == 0) || (index >= (uint32_t) _header->tagCount)) {
+        return;
+    }
+    // Leave the name in place, so that blocks that outlive the tag are still
+    // reported under it until the entry is reused
+    if (_header->tagRefs[index] > 0) {
+        _header->tagRefs[index]--;
+    }
+}
+
+std::string SuperblockFile::getTag(uint32_t index) const
+{
+    if (!_header || (index == 0)) {
+        return std::string();
+    }
+    if (index >= (uint32_t) _header->tagCount) {
+        std::ostringstream oss;
+        oss << "#" << index;
+        return oss.str();
+    }
+    const char* name = _header->tags[index];
+    return std::string(name, strnlen(name, Header::TAG_LENGTH));
+}
+
 void SuperblockFile::create()
 {
     if (_header) {
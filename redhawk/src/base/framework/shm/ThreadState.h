@@ -22,6 +22,7 @@
 #define REDHAWK_THREADSTATE_H
 
 #include <cstddef>
+#include <inttypes.h>
 
 namespace redhawk {
 
@@ -32,13 +33,17 @@ namespace redhawk {
         public:
             ThreadState() :
                 last(0),
-                contention(0)
+                contention(0),
+                tag(0)
             {
             }
 
             shm::Superblock* last;
             int contention;
             size_t poolId;
+
+            // Owner tag for the allocation in progress
+            uint32_t tag;
         };
     }
 }
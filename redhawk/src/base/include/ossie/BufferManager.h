@@ -45,6 +45,13 @@ namespace redhawk {
      */
     class BufferManager {
     public:
+        /**
+         * @brief  Alignment, in bytes, of memory returned by allocate().
+         *
+         * Memory blocks are aligned to the size of a cache line, which is
+         * sufficient for any SIMD instruction set.
+         */
+        static const size_t ALIGNMENT = 64;
 
         /**
          * @brief  STL-compliant allocator using BufferManager.
@@ -52,7 +59,9 @@ namespace redhawk {
          * %Allocator goes through the BufferManager to improve performance
          * with repetitive allocations.  In testing, allocations under 1K bytes
          * did not show any benefit from %BufferManager; as a result, they
-         * defer to the basic std::allocator<T> implementation.
+         * defer to the basic std::allocator<T> implementation. Only
+         * allocations of at least MIN_ELEMENTS are guaranteed to be aligned to
+         * BufferManager::ALIGNMENT.
          */
         template <typename T>
         class Allocator : public std::allocator<T>
@@ -132,7 +141,8 @@ namespace redhawk {
         /**
          * @brief  Allocate memory.
          * @param bytes  Required number of bytes.
-         * @return  A void* to a memory block of at least @a bytes.
+         * @return  A void* to a memory block of at least @a bytes, aligned to
+         *          ALIGNMENT bytes.
          *
          * If the requested allocation can be satisfied by the current thread's
          * cache, a previously used memory block is returned. Otherwise, a new
@@ -134,6 +134,13 @@ protected:
                           StandardEvent::StateChangeType &toState,
                           StandardEvent::StateChangeCategoryType category );
     void connectIDMChannel( const std::string &idm_ior="" );
+    //
+    // Publish state changes from a background thread that queues at most
+    // maxQueue events, so that a slow event service does not block state
+    // updates. A maxQueue of 0, the default, sends them on the calling thread.
+    //
+    void setAsyncStateChanges( size_t maxQueue );
+    size_t _stateChangeQueueDepth;
     bool initialConfiguration;
     CF::Properties originalCap;
     void deallocate (CORBA::Any& deviceCapacity, const CORBA::Any& resourceRequest);
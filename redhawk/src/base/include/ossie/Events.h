@@ -24,7 +24,11 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
 #include <boost/ref.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <deque>
+#include <list>
+#include <map>
 #include <ossie/RedhawkDefs.h>
 #include <ossie/EventTypes.h>
 #include <ossie/debug.h>
@@ -466,13 +470,7 @@ namespace events {
         CORBA::Any data;
         RH_NL_TRACE("Publisher", "Creating event message object for proxy.");
         data <<= msg;
-        if (!CORBA::is_nil(proxy)) {
-          proxy->push(data);
-          RH_NL_TRACE("Publisher", "Message sent downstream......");
-        }
-        else{
-          retval=-1;
-        }
+        retval = push(data);
       }
       catch( CORBA::Exception& ex) {
         retval=-1;
@@ -489,13 +487,7 @@ namespace events {
         CORBA::Any data;
         RH_NL_TRACE("Publisher", "Creating event message object for proxy.");
         data <<= msg;
-        if (!CORBA::is_nil(proxy)) {
-          proxy->push(data);
-          RH_NL_TRACE("Publisher", "Message sent downstream......");
-        }
-        else{
-          retval=-1;
-        }
+        retval = push(data);
       }
       catch( CORBA::Exception& ex) {
         retval=-1;
@@ -508,6 +500,51 @@ namespace events {
     int     push( const std::string &msg );
     int     push( CORBA::Any &data );
 
+    //
+    // Counters for asynchronous publishing
+    //
+    struct AsyncStatistics {
+      size_t queueDepth;     // events waiting to be sent
+      size_t maxQueue;       // configured queue limit
+      size_t queued;         // events accepted into the queue
+      size_t sent;           // events sent to the channel
+      size_t failed;         // events the channel rejected
+      size_t dropped;        // events discarded because the queue was full
+      size_t coalesced;      // state changes merged into a pending event
+    };
+
+    //
+    // Enable asynchronous publishing
+    //
+    // By default, push sends each event to the channel on the caller's thread,
+    // so a slow or unresponsive event service blocks the caller. In
+    // asynchronous mode, push places the event in a queue of at most maxQueue
+    // events that is sent by a background thread; when the queue is full, the
+    // new event is dropped and push returns -1. The sender takes up to
+    // batchSize events from the queue each time it wakes, sending them back
+    // to back without contending with publishers. A maxQueue of 0 sends any
+    // queued events and returns to synchronous mode.
+    //
+    void setAsync( size_t maxQueue, size_t batchSize=1 );
+
+    bool isAsync();
+
+    //
+    // When enabled (asynchronous mode only), a state change event
+    // (StandardEvent::StateChangeEventType or
+    // ExtendedEvent::ResourceStateChangeEventType) for a producer and source
+    // that already has an unsent state change in the queue updates the queued
+    // event's final state instead of adding a new one.
+    //
+    void setCoalescing( bool enabled );
+
+    //
+    // Wait until all queued events have been sent
+    //
+    void flush();
+
+    AsyncStatistics asyncStatistics();
+
     //
     // disconnect from the event channnel
     //
@@ -536,10 +573,36 @@ namespace events {
 
   private:
 
+    struct QueuedEvent {
+      CORBA::Any   data;
+      std::string  key;
+    };
+    typedef std::list< QueuedEvent >                         EventQueue;
+    typedef std::map< std::string, EventQueue::iterator >    PendingStateChanges;
+
+    int  _send( const CORBA::Any &data );
+    int  _queue( const CORBA::Any &data );
+    bool _coalesce( const CORBA::Any &data, std::string &key );
+    void _runSender();
+    void _sendBatch( boost::mutex::scoped_lock &lock );
+    void _stopSender();
+
     // handle to object that responds to disconnect messages
     Receiver                                 *_disconnectReceiver;
     rh_logger::LoggerPtr _publisherLog;
 
+    // asynchronous publishing state
+    boost::mutex                              _queueMutex;
+    boost::condition_variable                 _queueCond;
+    EventQueue                                _queueEvents;
+    PendingStateChanges                       _pendingStateChanges;
+    boost::thread                            *_sender;
+    bool                                      _senderRunning;
+    size_t                                    _inFlight;
+    size_t                                    _batchSize;
+    bool                                      _coalescing;
+    AsyncStatistics                           _stats;
+
   };
 
 
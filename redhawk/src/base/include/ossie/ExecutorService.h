@@ -22,9 +22,16 @@
 #define REDHAWK_EXECUTORSERVICE_H
 
 #include <list>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <pthread.h>
 
 #include <boost/bind.hpp>
 #include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 
 namespace redhawk {
@@ -37,42 +44,93 @@ namespace redhawk {
      * periodic monitors, executing deferred callbacks, or other operations
      * that do not need to be performed immediately (and do not require a
      * return value).
+     *
+     * Scheduled functions are kept in a timer wheel that is serviced by a
+     * dedicated timer thread using the monotonic clock, and are run by a pool
+     * of one or more worker threads. A slow function therefore only occupies
+     * one worker, and does not delay the timing of other functions. With a
+     * single worker thread (the default), functions run in the order of
+     * their scheduled times.
      */
     class ExecutorService {
     public:
         /**
-         * @brief  Construct an %ExecutorService.
+         * @brief  Identifies a periodic task.
+         */
+        typedef unsigned long task_id;
+
+        /**
+         * @brief  Runtime statistics for a periodic task.
+         */
+        struct TaskStatistics {
+            /// Name given when the task was scheduled.
+            std::string name;
+            /// Requested period.
+            boost::posix_time::time_duration period;
+            /// Number of times the task has run.
+            size_t runs;
+            /// Number of periods skipped because the task ran late.
+            size_t overruns;
+            /// Duration of the most recent run, in seconds.
+            double lastRuntime;
+            /// Mean duration of a run, in seconds.
+            double averageRuntime;
+            /// Longest duration of a run, in seconds.
+            double maxRuntime;
+            /// Longest delay between the scheduled and actual start of a run,
+            /// in seconds.
+            double maxLatency;
+        };
+
+        /**
+         * @brief  Construct an %ExecutorService with a single worker thread.
          *
          * The %ExecutorService is created in a stopped state.  To begin
          * executing scheduled functions, call start().
          */
         ExecutorService();
 
+        /**
+         * @brief  Construct an %ExecutorService with a pool of worker threads.
+         * @param threads  Number of worker threads (minimum 1).
+         *
+         * The %ExecutorService is created in a stopped state.  To begin
+         * executing scheduled functions, call start().
+         */
+        explicit ExecutorService(size_t threads);
+
         /**
          * @brief  Destroys the %ExecutorService.
          *
-         * The executor thread is stopped and all queued functions are purged.
+         * The executor threads are stopped and all queued functions are
+         * purged.
          */
         ~ExecutorService();
 
         /**
          * @brief  Starts executing scheduled functions.
          *
-         * If the executor thread is not running, it is started. Any functions
-         * scheduled for the current time (or earlier) will be run at the next
-         * possible time.
+         * If the executor threads are not running, they are started. Any
+         * functions scheduled for the current time (or earlier) will be run
+         * at the next possible time.
          */
         void start ();
 
         /**
          * @brief  Stops executing scheduled functions.
          *
-         * If the executor thread is running, it is stopped. Any remaining
+         * If the executor threads are running, they are stopped once any
+         * functions that are currently executing return. Any remaining
          * scheduled functions will not be run until the %ExecutorService is
          * started again.
          */
         void stop ();
 
+        /**
+         * @brief  Returns the number of worker threads.
+         */
+        size_t threads () const;
+
         /**
          * @brief  Calls a function on the executor thread.
          * @param func  Callable object.
@@ -202,7 +260,81 @@ namespace redhawk {
         }
 
         /**
-         * @brief  Discards all pending functions.
+         * @brief  Schedules a function to run periodically.
+         * @param name    Name used to identify the task in statistics().
+         * @param period  Time between successive runs.
+         * @param func    Callable object.
+         * @return  Identifier that can be passed to cancel().
+         *
+         * Queues the callable object @a func to be called on a worker thread
+         * every @a period, starting one period from now. Each run is
+         * scheduled relative to the previous scheduled time, not the time it
+         * actually ran, so that the task does not drift. If a run takes
+         * longer than @a period, the missed periods are skipped and counted
+         * as overruns. A periodic task never runs concurrently with itself.
+         */
+        template <class F>
+        task_id schedulePeriodic (const std::string& name, boost::posix_time::time_duration period, F func)
+        {
+            return _insertPeriodic(name, period, func);
+        }
+
+        /**
+         * @brief  Schedules a function to run periodically.
+         * @param name    Name used to identify the task in statistics().
+         * @param period  Time between successive runs.
+         * @param func    Callable object.
+         * @param A1  Argument to pass to callable object.
+         * @return  Identifier that can be passed to cancel().
+         *
+         * If @a func is a class member function, the class instance should be
+         * passed as @a A1.
+         *
+         * @see schedulePeriodic(const std::string&,boost::posix_time::time_duration,F)
+         */
+        template <class F, class A1>
+        task_id schedulePeriodic (const std::string& name, boost::posix_time::time_duration period, F func, A1 arg1)
+        {
+            return _insertPeriodic(name, period, boost::bind(func, arg1));
+        }
+
+        /**
+         * @brief  Schedules a function to run periodically.
+         * @param name    Name used to identify the task in statistics().
+         * @param period  Time between successive runs.
+         * @param func    Callable object.
+         * @param A1  First argument to pass to callable object.
+         * @param A2  Second argument to pass to callable object.
+         * @return  Identifier that can be passed to cancel().
+         *
+         * If @a func is a class member function, the class instance should be
+         * passed as @a A1.
+         *
+         * @see schedulePeriodic(const std::string&,boost::posix_time::time_duration,F)
+         */
+        template <class F, class A1, class A2>
+        task_id schedulePeriodic (const std::string& name, boost::posix_time::time_duration period, F func, A1 arg1, A2 arg2)
+        {
+            return _insertPeriodic(name, period, boost::bind(func, arg1, arg2));
+        }
+
+        /**
+         * @brief  Cancels a periodic task.
+         * @param id  Identifier returned by schedulePeriodic().
+         * @return  true if the task was found, false otherwise.
+         *
+         * If the task is currently running, that run completes but the task
+         * is not scheduled again.
+         */
+        bool cancel (task_id id);
+
+        /**
+         * @brief  Returns the runtime statistics of all periodic tasks.
+         */
+        std::vector<TaskStatistics> statistics ();
+
+        /**
+         * @brief  Discards all pending functions, including periodic tasks.
          */
         void clear ();
 
@@ -215,28 +347,71 @@ namespace redhawk {
         /// @cond IMPL
 
         typedef boost::function<void ()> func_type;
-        typedef std::pair<boost::system_time,func_type> task_type;
-        typedef std::list<task_type> task_queue;
 
-        // Thread main function.
-        void _run ();
+        // Monotonic time, in nanoseconds.
+        typedef long long nsec_type;
 
-        // Inserts a callable object into the task queue at the given time,
+        struct Task {
+            func_type func;
+            nsec_type deadline;
+            nsec_type tick;
+            nsec_type period;
+            task_id id;
+            bool cancelled;
+            TaskStatistics stats;
+            double totalRuntime;
+        };
+        typedef boost::shared_ptr<Task> TaskPtr;
+        typedef std::list<TaskPtr> TaskList;
+
+        // Number of slots in the timer wheel, and the time covered by each.
+        static const size_t WHEEL_SLOTS = 512;
+        static const nsec_type TICK_NSEC = 1000000;
+
+        static nsec_type _monotonicTime ();
+
+        void _initialize (size_t threads);
+
+        // Thread main functions.
+        void _runTimer ();
+        void _runWorker ();
+
+        // Inserts a callable object into the timer wheel at the given time,
         // defaulting to now (i.e., run at the next possible time).
         void _insertSorted (func_type func, boost::system_time when=boost::get_system_time());
+        task_id _insertPeriodic (const std::string& name, boost::posix_time::time_duration period, func_type func);
+
+        // The following must be called with the mutex held.
+        void _schedule (const TaskPtr& task);
+        void _expireSlot (nsec_type tick, nsec_type now);
+        void _expireAll (nsec_type tick);
+        nsec_type _nextDeadline (nsec_type now);
+        void _finishTask (const TaskPtr& task, nsec_type start, nsec_type end);
 
-        // Mutex/condvar pair to synchronize access and handle waiting for the
-        // next scheduled event.
+        // Mutex to synchronize access; the timer thread waits on a condition
+        // variable that uses the monotonic clock, while the workers wait for
+        // tasks to become ready.
         boost::mutex _mutex;
-        boost::condition_variable _cond;
+        pthread_cond_t _timerCond;
+        boost::condition_variable _workCond;
         
-        // Executor thread and control flag.
-        boost::thread* _thread;
+        // Executor threads and control flag.
+        size_t _threadCount;
+        boost::thread* _timerThread;
+        std::vector<boost::thread*> _workers;
         volatile bool _running;
 
-        // Function queue, sorted by scheduled time such that the first item on
-        // the queue is the next function to call.
-        task_queue _queue;
+        // Timer wheel: each slot holds the tasks whose deadline falls within
+        // a tick that maps to the slot, sorted by deadline. Tasks whose time
+        // has come are moved to the ready queue in order.
+        std::vector<TaskList> _wheel;
+        nsec_type _currentTick;
+        size_t _scheduled;
+        std::deque<TaskPtr> _ready;
+
+        // Periodic tasks, by identifier.
+        std::map<task_id,TaskPtr> _periodic;
+        task_id _nextId;
 
         /// @endcond
     };
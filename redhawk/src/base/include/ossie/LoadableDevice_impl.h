@@ -225,6 +225,9 @@ protected:
     void update_selected_paths(std::vector<sharedLibraryStorage> &paths);
     // Transfer size when loading files
     CORBA::LongLong           transferSize;          // block transfer size when loading files
+    // Copy files served from this host straight from disk instead of
+    // transferring them through CF::File
+    bool                      localCopy;
     std::string prependCacheIfAvailable(const std::string &localPath);
 
     // Returns the base directory in use for the file cache
@@ -242,7 +245,7 @@ protected:
     void _loadTree(CF::FileSystem_ptr fs, std::string remotePath, boost::filesystem::path& localPath, std::string fileKey);
     void _deleteTree(const std::string &fileKey);
     bool _treeIntact(const std::string &fileKey);
-    void _copyFile(CF::FileSystem_ptr fs, const std::string &remotePath, const std::string &localPath, const std::string &fileKey);
+    void _copyFile(CF::FileSystem_ptr fs, const std::string &remotePath, const std::string &localPath, const std::string &fileKey, const CF::FileSystem::FileInformationType& fileInfo);
 };
 
 #endif
@@ -24,9 +24,12 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <deque>
 #include <iterator>
 
 #include <boost/utility/enable_if.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 
 #include "CF/ExtendedEvent.h"
 #include "CF/QueryablePort.h"
@@ -112,6 +115,23 @@ public:
         generic_callbacks_.add(target, func);
     }
 
+    /*
+     * Enable or disable dispatching of message callbacks on a dedicated thread
+     * @param enabled If true, incoming messages are queued and the callbacks
+     *                are invoked from a separate thread, so that slow callbacks
+     *                do not hold up the ORB thread (or a local supplier)
+     * @param maxQueue The maximum number of messages waiting to be dispatched;
+     *                 when the queue is full, delivery blocks until there is
+     *                 room. A value of 0 means no limit.
+     *
+     * When disabling, any messages that are already queued are dispatched
+     * before this method returns. Disabling from within a message callback
+     * throws std::logic_error.
+     */
+    void setThreadedDispatch (bool enabled, size_t maxQueue=0);
+
+    bool isThreadedDispatch ();
+
     // CF::Port methods
     void connectPort(CORBA::Object_ptr connection, const char* connectionId);
 
@@ -145,6 +165,12 @@ protected:
 
     bool hasGenericCallbacks();
     void dispatchGeneric(const std::string& id, const CORBA::Any& data);
+
+    void _dispatchMessage(const std::string& id, const CORBA::Any& data);
+    bool _queueDispatch(const std::string& id, const CORBA::Any& data);
+    bool _queueDirect(const std::string& id, MessageCallback* callback, const void* data);
+    bool _waitForDispatchSpace(boost::mutex::scoped_lock& lock);
+    void _runDispatch();
     
     boost::mutex portInterfaceAccess;
     std::map<std::string, Consumer_i*> consumers;
@@ -162,6 +188,11 @@ protected:
         virtual void dispatch (const std::string& value, const void* data) = 0;
         virtual ~MessageCallback () { }
 
+        // Typed copies of messages passed by pointer, so that dispatch can be
+        // deferred without serializing to a CORBA::Any
+        virtual void* clone (const void* data) = 0;
+        virtual void release (void* data) = 0;
+
         bool isCompatible (const char* format)
         {
             if (_format.empty()) {
@@ -213,6 +244,16 @@ protected:
             func_(value, *message);
         }
 
+        virtual void* clone (const void* data)
+        {
+            return new Message(*reinterpret_cast<const Message*>(data));
+        }
+
+        virtual void release (void* data)
+        {
+            delete reinterpret_cast<Message*>(data);
+        }
+
     private:
         CallbackFunc func_;
     };
@@ -226,6 +267,22 @@ protected:
 
     typedef std::map<std::string, CosEventComm::PushSupplier_var> SupplierTable;
     SupplierTable suppliers_;
+
+    // State for threaded dispatch; messages from local suppliers with a
+    // compatible callback are held as typed copies instead of Anys
+    struct QueuedMessage {
+        std::string id;
+        CORBA::Any data;
+        MessageCallback* callback;
+        void* direct;
+    };
+    std::deque<QueuedMessage> _dispatchQueue;
+    size_t _dispatchQueueLimit;
+    boost::thread* _dispatchThread;
+    bool _dispatchRunning;
+    boost::mutex _dispatchMutex;
+    boost::condition_variable _dispatchReady;
+    boost::condition_variable _dispatchSpace;
 };
 
 #include "MessageSupplier.h"
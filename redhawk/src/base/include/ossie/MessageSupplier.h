@@ -28,6 +28,7 @@
 #include <COS/CosEventChannelAdmin.hh>
 
 #include "UsesPort.h"
+#include "ExecutorService.h"
 #include "internal/message_traits.h"
 
 /************************************************************************************
@@ -97,6 +98,26 @@ public:
         _sendMessageQueue(connectionId);
     }
 
+    /**
+     * @brief  Configures batching of messages to remote consumers.
+     * @param maxMessages  Number of queued messages that triggers a send; 0 or
+     *                     1 disables batching.
+     * @param maxDelay     Maximum time, in seconds, that a message may wait
+     *                     in a partial batch before it is sent. If 0, partial
+     *                     batches are only sent by flush().
+     *
+     * With batching enabled, messages sent to connections that are not in
+     * the same process are coalesced into a single push of up to
+     * @p maxMessages messages. Local connections always deliver immediately.
+     * Disabling batching sends any pending messages.
+     */
+    void setBatching(size_t maxMessages, double maxDelay);
+
+    /**
+     * @brief  Sends any messages waiting in a partial batch.
+     */
+    void flush();
+
     std::string getRepid() const;
 
 protected:
@@ -125,6 +146,16 @@ protected:
     void _checkConnectionId(const std::string& connectionId);
     void _push(const CORBA::Any& data, const std::string& connectionId=std::string());
 
+    void _flushMessageQueues();
+    void _updateFlushSchedule();
+    void _scheduledFlush(boost::system_time deadline);
+
+    size_t _batchSize;
+    boost::posix_time::time_duration _batchDelay;
+    bool _flushScheduled;
+    boost::system_time _flushDeadline;
+    redhawk::ExecutorService _flushService;
+
     class MessageTransport;
     class CorbaTransport;
     class LocalTransport;
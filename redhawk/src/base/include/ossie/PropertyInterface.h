@@ -43,6 +43,7 @@
 #include "CF/ExtendedEvent.h"
 #include <COS/CosEventChannelAdmin.hh>
 #include "PropertyMonitor.h"
+#include "PropertyTable.h"
 
 #include <iomanip>
 
@@ -82,6 +83,7 @@ public:
 
     void configure(const std::string& _id, const std::string& _name, const std::string& _mode,
                    const std::string& _units, const std::string& _action, const std::string& _kinds);
+    void configure(const redhawk::PropertyDescriptor& descriptor);
 
     virtual void getValue (CORBA::Any& a) = 0;
     virtual void setValue (const CORBA::Any& a, bool callbacks=true) = 0;
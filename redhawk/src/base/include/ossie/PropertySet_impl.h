@@ -31,6 +31,7 @@
 
 #include "ossie/debug.h"
 #include "ossie/PropertyInterface.h"
+#include "ossie/PropertyTable.h"
 #include "ossie/ProcessThread.h"
 #include "ossie/Autocomplete.h"
 #include "CF/cf.h"
@@ -160,6 +161,59 @@ protected:
         return wrapper;
     }
     
+    /*
+     * Adds a property described by an entry in a generated property table;
+     * lookups by identifier for properties added this way use the table's
+     * perfect hash. The descriptor is applied directly to the new wrapper,
+     * rather than going through the string-based overloads.
+     */
+    template <typename T>
+    PropertyInterface* addProperty (T& value,
+                                    const redhawk::PropertyTable& table,
+                                    size_t index)
+    {
+        PropertyInterface* wrapper = PropertyWrapperFactory::Create(value);
+        wrapper->configure(table.descriptors[index]);
+        wrapper->isNil(true);
+        insertIndexedProperty(table, index, wrapper, PropertyChange::MonitorFactory::Create(value));
+        return wrapper;
+    }
+
+    template <typename T, typename T2>
+    PropertyInterface* addProperty (T& value,
+                                    const T2& initial_value,
+                                    const redhawk::PropertyTable& table,
+                                    size_t index)
+    {
+        PropertyInterface* wrapper = addProperty(value, table, index);
+        value = initial_value;
+        wrapper->isNil(false);
+        return wrapper;
+    }
+
+    template <typename T2>
+    PropertyInterface* addProperty (CF::UTCTime& value,
+                                    const T2& initial_value,
+                                    const redhawk::PropertyTable& table,
+                                    size_t index)
+    {
+        PropertyInterface* wrapper = addProperty(value, table, index);
+        value = redhawk::time::utils::convert(initial_value);
+        wrapper->isNil(false);
+        return wrapper;
+    }
+
+    /*
+     * Replaces the wrapper for an existing property with another wrapper for
+     * the same value, such as a subclass that marshals the value differently.
+     * The new wrapper takes over the configuration and nil state of the old
+     * one, and is owned by the PropertySet from then on; the old wrapper is
+     * deleted. Callbacks and listeners registered on the old wrapper are not
+     * carried over, so this should be called while properties are loaded.
+     * Throws std::invalid_argument if there is no property with the given id.
+     */
+    PropertyInterface* replaceProperty (const std::string& id, PropertyInterface* wrapper);
+
     template <typename T2>
     PropertyInterface* addProperty (CF::UTCTime& value, 
                                     const T2& initial_value, 
@@ -362,6 +416,13 @@ protected:
     void setLogger(rh_logger::LoggerPtr logptr);
 
 private:
+    void insertIndexedProperty(const redhawk::PropertyTable& table, size_t index,
+                               PropertyInterface* property, PropertyChange::Monitor* monitor);
+
+    // Generated property table, if any, and the properties for its entries
+    const redhawk::PropertyTable* _propertyIndex;
+    std::vector<PropertyInterface*> _indexedProperties;
+
     template <typename T>
     PropertyWrapper<T>* castProperty(PropertyInterface* property)
     {
@@ -0,0 +1,72 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef REDHAWK_PROPERTYTABLE_H
+#define REDHAWK_PROPERTYTABLE_H
+
+#include <cstddef>
+
+namespace redhawk {
+
+    /*
+     * Static description of a property, as emitted by the code generator.
+     */
+    struct PropertyDescriptor {
+        const char* id;
+        const char* name;
+        const char* mode;
+        const char* units;
+        const char* action;
+        const char* kinds;
+    };
+
+    /*
+     * Read-only table of property descriptors, sorted by identifier, with a
+     * minimal perfect hash over the identifiers that is computed by the code
+     * generator. Looking up an identifier takes two hashes and one string
+     * comparison, regardless of the number of properties.
+     *
+     * The hash is two-level ("hash and displace"): the identifier's bucket
+     * is hash(id, 0) % bucketCount, and its slot is
+     * hash(id, displacements[bucket]) % slotCount. Each slot holds the index
+     * of a descriptor, or -1 if unused.
+     *
+     * PropertyTable has no constructors so that generated tables are
+     * initialized statically, with no code run at startup.
+     */
+    struct PropertyTable {
+        const PropertyDescriptor* descriptors;
+        size_t count;
+        const unsigned int* displacements;
+        size_t bucketCount;
+        const short* slots;
+        size_t slotCount;
+
+        // Returns the index of the descriptor for id, or -1 if there is none
+        int find(const char* id) const;
+
+        // 32-bit FNV-1a hash of id with the given seed, followed by a final
+        // mix; the code generator must use the identical function
+        static unsigned int hash(const char* id, unsigned int seed);
+    };
+
+}
+
+#endif // REDHAWK_PROPERTYTABLE_H
@@ -192,6 +192,103 @@ namespace redhawk
       int set_affinity( const AffinityDirectives &spec, const pid_t pid, const CpuList &blacklist = CpuList(0))
         throw (AffinityFailed);
 
+      /*
+         Thread roles within a resource process that can be given their own affinity, so that (for example)
+         processing threads can own isolated cores while ORB and housekeeping threads run elsewhere.
+
+            PROCESSING_THREAD    service function thread and message dispatch threads
+            TRANSPORT_THREAD     data transport threads (e.g., shared memory and TCP readers, asynchronous senders)
+            ORB_THREAD           threads created by the ORB to service requests
+            HOUSEKEEPING_THREAD  executor service and event publishing threads
+       */
+      enum ThreadRole {
+        PROCESSING_THREAD,
+        TRANSPORT_THREAD,
+        ORB_THREAD,
+        HOUSEKEEPING_THREAD
+      };
+
+      /*
+         Execparam that carries thread role affinity directives to a resource process
+       */
+      const std::string THREAD_AFFINITY_ID("RH::THREAD_AFFINITY");
+
+      /*
+         get_thread_affinity
+
+         Returns the thread role directives from the <affinity> section of a deployment, formatted as the value of the 
+         RH::THREAD_AFFINITY execparam, or an empty string if there are none. Thread role directives are given as 
+         affinity::thread_<role> properties, whose values are a directive class and context separated by a colon:
+
+              <simpleref refid="affinity::thread_processing" value="cpu:2-3"/>
+              <simpleref refid="affinity::thread_orb" value="cpu:0"/>
+
+         Only the socket, cpu and nic classes apply to individual threads.
+       */
+      std::string get_thread_affinity( const CF::Properties &options );
+
+      /*
+         Set the thread role directives for this process from an RH::THREAD_AFFINITY execparam value 
+         (e.g., "processing=cpu:2-3;orb=cpu:0")
+       */
+      void set_thread_affinity( const std::string &directives )
+        throw (AffinityFailed);
+
+      /*
+         Set or get the directives for a single thread role in this process
+       */
+      void set_thread_affinity( const ThreadRole role, const AffinityDirectives &spec );
+      AffinityDirectives get_thread_directives( const ThreadRole role );
+
+      /*
+         apply_thread_affinity
+
+         Applies the directives for the given role to the calling thread. Threads created by the framework call this 
+         as they start; resource developers can do the same for threads they create.
+
+         @return 0  no directives for the role, or directives applied
+         @return -1 directives could not be applied (the reason is logged)
+       */
+      int apply_thread_affinity( const ThreadRole role );
+
+      /*
+         Apply the ORB_THREAD directives to threads the ORB creates from now on. Threads that already exist are not
+         affected, so components call this before initializing the ORB.
+       */
+      void enable_orb_thread_affinity();
+
+      /*
+         Returns the number of NUMA nodes (processor sockets) on this host, or 1 if NUMA support is not available
+       */
+      int get_node_count();
+
+      /*
+         Returns the NUMA node of the cpu the calling thread is running on, or 0 if NUMA support is not available
+       */
+      int get_current_node();
+
+      /*
+         Object placement
+
+         When several resources share a process (e.g., in a ComponentHost), each one can be given its own placement. 
+         The object is identified by the address of its most-derived instance (i.e., dynamic_cast<void*>), so that 
+         threads that only know one of its base classes can find it. Only the socket, cpu and nic classes are supported.
+       */
+      void set_placement( const void *object, const AffinityDirectives &spec );
+      void clear_placement( const void *object );
+      AffinityDirectives get_placement( const void *object );
+
+      /*
+         apply_placement
+
+         Applies the placement for the given object to the calling thread, and prefers memory from the local node 
+         for the thread's allocations.
+
+         @return 0  no placement for the object, or placement applied
+         @return -1 placement could not be applied (the reason is logged)
+       */
+      int apply_placement( const void *object );
+
     };  // affinity namespace
     
 }  // redhawk  Namespace
@@ -45,6 +45,7 @@
 //
 #include <sstream>
 #include "ossie/logging/rh_logger.h"
+#include "ossie/logging/rh_binlog.h"
 
 
 #define ENABLE_LOGGING \
@@ -72,9 +73,15 @@
 
 #define _RH_LOG( level, logger, msg)	\
   if ( logger && logger->is##level##Enabled() ) {			\
-    std::ostringstream _msg;						\
-    _msg <<  msg;				          		\
-    logger->handleLogEvent( rh_logger::Level::get##level(), _msg.str(), rh_logger::spi::LocationInfo(__FILE__,__PRETTY_FUNCTION__,__LINE__) ); \
+    if ( rh_logger::binary::capturing( rh_logger::binary::levels::level ) ) { \
+      static rh_logger::binary::Site _rh_site( rh_logger::binary::levels::level, __FILE__, __PRETTY_FUNCTION__, __LINE__ ); \
+      rh_logger::binary::Record _rec( _rh_site, logger );		\
+      _rec << msg;							\
+    } else {								\
+      std::ostringstream _msg;						\
+      _msg <<  msg;				          		\
+      logger->handleLogEvent( rh_logger::Level::get##level(), _msg.str(), rh_logger::spi::LocationInfo(__FILE__,__PRETTY_FUNCTION__,__LINE__) ); \
+    }									\
   }
 
 
@@ -0,0 +1,429 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef  RH_BINLOG_H
+#define  RH_BINLOG_H
+
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <stdint.h>
+
+#include <boost/scoped_ptr.hpp>
+#include <boost/utility/enable_if.hpp>
+
+#include "rh_logger.h"
+
+//
+// Binary logging
+//
+// When enabled, log events at or below a threshold level (DEBUG by default)
+// are not formatted or passed to the logging implementation. Instead, the
+// LOG_XXX/RH_XXX macros record the ID of the logging statement ("site") and
+// the raw values of the streamed arguments into a per-process ring file that
+// is memory-mapped, so the cost of a log call is a few stores and an atomic
+// increment. The redhawk-logdecode program renders the file as text offline.
+//
+// Binary logging is enabled at startup by setting RH_LOG_BINARY to the
+// directory in which to create the file (named rhlog-<pid>.bin). The optional
+// RH_LOG_BINARY_LEVEL sets the threshold level, and RH_LOG_BINARY_SIZE the
+// size of the ring in bytes (with an optional K, M or G suffix).
+//
+// Integers, floating point numbers, characters, strings and void pointers
+// are recorded as-is; values of any other type, or values streamed while a
+// manipulator (e.g., std::hex or std::setw) is in effect, are formatted as
+// usual and recorded as text.
+//
+namespace rh_logger {
+
+  namespace binary {
+
+    //
+    // File format, shared with the decoder. All values are in host byte
+    // order, and all structures are 8-byte aligned.
+    //
+    // The file consists of the header, followed by the site table, followed
+    // by the record ring. Sites are appended to the table the first time
+    // each logging statement records an event. Records are written to the
+    // ring at the absolute offset given by the header's cursor, modulo the
+    // ring size (a power of two); a record's size is written last, so that
+    // a record with a size of zero is incomplete.
+    //
+    namespace format {
+
+      static const char MAGIC[8] = { 'R', 'H', 'B', 'L', 'O', 'G', '\0', '\0' };
+      static const uint32_t FORMAT_VERSION = 1;
+
+      struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t pid;
+        uint64_t created;
+        uint64_t siteOffset;
+        uint64_t siteCapacity;
+        uint64_t ringOffset;
+        uint64_t ringCapacity;
+        volatile uint64_t siteBytes;
+        volatile uint64_t cursor;
+        char process[64];
+      };
+
+      struct SiteHeader {
+        uint32_t size;
+        uint32_t id;
+        int32_t level;
+        uint32_t line;
+        uint32_t fileLength;
+        uint32_t functionLength;
+      };
+
+      struct RecordHeader {
+        volatile uint32_t size;
+        uint32_t site;
+        uint64_t offset;
+        uint64_t time;
+        uint32_t thread;
+        uint16_t loggerLength;
+        uint16_t flags;
+      };
+
+      // Record flags
+      enum {
+        RECORD_TRUNCATED = 1
+      };
+
+      // Argument type codes; each is followed by the value in the given
+      // representation
+      enum {
+        ARG_SIGNED = 1,   // int64_t
+        ARG_UNSIGNED,     // uint64_t
+        ARG_DOUBLE,       // double
+        ARG_CHAR,         // char
+        ARG_POINTER,      // uint64_t
+        ARG_TEXT          // uint32_t length, followed by characters
+      };
+
+      inline size_t align(size_t size)
+      {
+        return (size + 7) & ~static_cast<size_t>(7);
+      }
+    };
+
+    //
+    // Level identifiers for use by the logging macros
+    //
+    struct levels {
+      enum {
+        Fatal = Level::FATAL_INT,
+        Error = Level::ERROR_INT,
+        Warn = Level::WARN_INT,
+        Info = Level::INFO_INT,
+        Debug = Level::DEBUG_INT,
+        Trace = Level::TRACE_INT
+      };
+    };
+
+    namespace detail {
+      extern int threshold;
+      extern volatile unsigned int generation;
+    };
+
+    //
+    // Returns true if log events at the given level are being recorded in
+    // the binary log instead of through the logging implementation
+    //
+    inline bool capturing(int level)
+    {
+      return level <= detail::threshold;
+    }
+
+    //
+    // Creates a binary log file in the given directory and starts recording
+    // events at or below the threshold level (Level::ALL_INT records every
+    // level); returns false if the file could not be created
+    //
+    bool open(const std::string& directory, size_t bytes=16*1024*1024, int threshold=Level::DEBUG_INT);
+
+    //
+    // Stops recording events; the file remains mapped until the process
+    // exits, because other threads may still be writing to it
+    //
+    void close();
+
+    //
+    // Returns the path of the current binary log file, or an empty string
+    // if binary logging is not enabled
+    //
+    std::string filename();
+
+    //
+    // Static information about a logging statement, recorded once per file
+    //
+    class Site {
+    public:
+      Site(int level, const char* file, const char* function, int line) :
+        _level(level),
+        _file(file),
+        _function(function),
+        _line(line),
+        _id(0),
+        _generation(0)
+      {
+      }
+
+      uint32_t id()
+      {
+        if (_generation != detail::generation) {
+          _register();
+        }
+        return _id;
+      }
+
+    private:
+      void _register();
+
+      const int _level;
+      const char* const _file;
+      const char* const _function;
+      const int _line;
+      volatile uint32_t _id;
+      volatile unsigned int _generation;
+    };
+
+    //
+    // A single log event, written to the ring on destruction. The values that
+    // can be recorded as-is are handled by the operator<< overloads below;
+    // any other value is formatted with an output stream, which is only
+    // created if the event needs one.
+    //
+    class Record {
+    public:
+      Record(Site& site, const LoggerPtr& logger);
+      ~Record();
+
+      // Returns true if no formatting state is in effect, so that values
+      // can be recorded without formatting
+      bool plain() const
+      {
+        return !_formatter || _formatter->plain();
+      }
+
+      // Returns the output stream used to format values, creating it on
+      // first use
+      std::ostream& stream()
+      {
+        if (!_formatter) {
+          _formatter.reset(new Formatter(*this));
+        }
+        return _formatter->stream;
+      }
+
+      void put(bool value) { _putSigned(value); }
+      void put(char value) { _put(format::ARG_CHAR, &value, sizeof(value)); }
+      void put(signed char value) { put(static_cast<char>(value)); }
+      void put(unsigned char value) { put(static_cast<char>(value)); }
+      void put(short value) { _putSigned(value); }
+      void put(unsigned short value) { _putUnsigned(value); }
+      void put(int value) { _putSigned(value); }
+      void put(unsigned int value) { _putUnsigned(value); }
+      void put(long value) { _putSigned(value); }
+      void put(unsigned long value) { _putUnsigned(value); }
+      void put(long long value) { _putSigned(value); }
+      void put(unsigned long long value) { _putUnsigned(value); }
+      void put(float value) { put(static_cast<double>(value)); }
+      void put(double value) { _put(format::ARG_DOUBLE, &value, sizeof(value)); }
+      void put(const void* value)
+      {
+        uint64_t address = reinterpret_cast<uintptr_t>(value);
+        _put(format::ARG_POINTER, &address, sizeof(address));
+      }
+      void put(const char* value)
+      {
+        if (value) {
+          _appendText(value, strlen(value));
+        } else {
+          // Matches the ostream behavior of setting badbit, which suppresses
+          // the rest of the message
+          stream().setstate(std::ios_base::badbit);
+        }
+      }
+      void put(const std::string& value) { _appendText(value.data(), value.size()); }
+
+      // Manipulators (e.g., std::hex or std::endl) apply to the stream
+      Record& operator<<(std::ostream& (*manip)(std::ostream&))
+      {
+        stream() << manip;
+        return *this;
+      }
+
+      Record& operator<<(std::ios& (*manip)(std::ios&))
+      {
+        stream() << manip;
+        return *this;
+      }
+
+      Record& operator<<(std::ios_base& (*manip)(std::ios_base&))
+      {
+        stream() << manip;
+        return *this;
+      }
+
+    private:
+      // Receives any text formatted via the stream
+      class TextBuffer : public std::streambuf {
+      public:
+        TextBuffer(Record& record) : _record(record) { }
+
+      protected:
+        virtual int_type overflow(int_type ch);
+        virtual std::streamsize xsputn(const char* s, std::streamsize count);
+
+      private:
+        Record& _record;
+      };
+
+      struct Formatter {
+        Formatter(Record& record) :
+          buffer(record),
+          stream(&buffer)
+        {
+        }
+
+        bool plain() const
+        {
+          return stream.good() && (stream.flags() == (std::ios_base::skipws | std::ios_base::dec)) &&
+            (stream.width() == 0) && (stream.precision() == 6);
+        }
+
+        TextBuffer buffer;
+        std::ostream stream;
+      };
+
+      static const size_t CAPACITY = 1024;
+
+      // Non-copyable
+      Record(const Record&);
+      Record& operator=(const Record&);
+
+      void _putSigned(int64_t value) { _put(format::ARG_SIGNED, &value, sizeof(value)); }
+      void _putUnsigned(uint64_t value) { _put(format::ARG_UNSIGNED, &value, sizeof(value)); }
+
+      void _put(uint8_t type, const void* value, size_t bytes)
+      {
+        if (_text) {
+          _endText();
+        }
+        if ((_size + 1 + bytes) > CAPACITY) {
+          _truncated = true;
+          return;
+        }
+        _data[_size++] = type;
+        std::memcpy(_data + _size, value, bytes);
+        _size += bytes;
+      }
+
+      void _appendText(const char* text, size_t length);
+      void _endText();
+
+      boost::scoped_ptr<Formatter> _formatter;
+      size_t _size;
+      size_t _text;
+      bool _truncated;
+      void* _file;
+      union {
+        format::RecordHeader _header;
+        char _data[CAPACITY];
+      };
+    };
+
+    namespace detail {
+      // Types that Record can store without formatting
+      template <typename T>
+      struct is_raw {
+        static const bool value = false;
+      };
+
+#define RH_BINLOG_RAW_TYPE(T)                   \
+      template <>                               \
+      struct is_raw<T> {                        \
+        static const bool value = true;         \
+      };
+
+      RH_BINLOG_RAW_TYPE(bool)
+      RH_BINLOG_RAW_TYPE(char)
+      RH_BINLOG_RAW_TYPE(signed char)
+      RH_BINLOG_RAW_TYPE(unsigned char)
+      RH_BINLOG_RAW_TYPE(short)
+      RH_BINLOG_RAW_TYPE(unsigned short)
+      RH_BINLOG_RAW_TYPE(int)
+      RH_BINLOG_RAW_TYPE(unsigned int)
+      RH_BINLOG_RAW_TYPE(long)
+      RH_BINLOG_RAW_TYPE(unsigned long)
+      RH_BINLOG_RAW_TYPE(long long)
+      RH_BINLOG_RAW_TYPE(unsigned long long)
+      RH_BINLOG_RAW_TYPE(float)
+      RH_BINLOG_RAW_TYPE(double)
+      RH_BINLOG_RAW_TYPE(void*)
+      RH_BINLOG_RAW_TYPE(const void*)
+      RH_BINLOG_RAW_TYPE(char*)
+      RH_BINLOG_RAW_TYPE(const char*)
+      RH_BINLOG_RAW_TYPE(std::string)
+
+#undef RH_BINLOG_RAW_TYPE
+
+      // String literals
+      template <size_t N>
+      struct is_raw<char[N]> {
+        static const bool value = true;
+      };
+    };
+
+    //
+    // Records a value as-is if possible
+    //
+    template <typename T>
+    inline typename boost::enable_if_c<detail::is_raw<T>::value,Record&>::type
+    operator<<(Record& record, const T& value)
+    {
+      if (record.plain()) {
+        record.put(value);
+      } else {
+        record.stream() << value;
+      }
+      return record;
+    }
+
+    //
+    // Formats any other value as text, using the same operator<< as for any
+    // other ostream
+    //
+    template <typename T>
+    inline typename boost::disable_if_c<detail::is_raw<T>::value,Record&>::type
+    operator<<(Record& record, const T& value)
+    {
+      record.stream() << value;
+      return record;
+    }
+
+  };
+
+};
+
+#endif   // RH_BINLOG_H
@@ -281,6 +281,11 @@ namespace rh_logger {
     virtual std::string getName() const;
     virtual void  getName( std::string &oname ) const;
 
+    //
+    // Return a reference to the name of the logger, without copying
+    //
+    const std::string& getNameRef() const { return name; }
+
     //
     // Log a message to the logging output stream
     //
@@ -230,6 +230,20 @@ namespace redhawk {
             }
         }
 
+        /**
+         * Returns true if this is the only %refcount_memory in this process
+         * pointing to the allocated memory. References held by other
+         * processes to process-shared memory are not included.
+         */
+        bool unique() const
+        {
+            if (_M_impl) {
+                return (_M_impl->refcount == 1);
+            } else {
+                return false;
+            }
+        }
+
         /**
          * Returns the base address of the allocated memory.
          */
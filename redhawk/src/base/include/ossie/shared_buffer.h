@@ -375,6 +375,24 @@ namespace redhawk {
             return !(this->_M_memory);
         }
 
+        /**
+         * @brief  Returns true if this is the only reference to the array.
+         *
+         * A unique %shared_buffer may be converted into a writable %buffer
+         * without copying (see buffer::reclaim()). Transient arrays are
+         * never unique; process-shared arrays are unique only if no other
+         * process holds a reference.
+         */
+        bool unique() const
+        {
+            if (!this->_M_memory.unique()) {
+                return false;
+            } else if (this->_M_memory.is_process_shared()) {
+                return redhawk::shm::isExclusive(this->_M_memory.address());
+            }
+            return true;
+        }
+
     protected:
         /// @cond IMPL
 
@@ -856,6 +874,28 @@ namespace redhawk {
             return shared_type::template _M_recast<buffer>(other);
         }
 
+        /**
+         * @brief  Takes write access to the contents of a %shared_buffer.
+         * @param other  %shared_buffer to reclaim.
+         * @return  A %buffer with the contents of @a other.
+         *
+         * If @a other is the only reference to its array, the array is
+         * transferred to the returned %buffer without copying, so that it can
+         * be modified in place; otherwise, the contents are copied into a
+         * newly-allocated array. In either case, @a other is empty afterwards.
+         */
+        static buffer reclaim(shared_type& other)
+        {
+            buffer result;
+            if (other.unique()) {
+                result._M_swap(other);
+            } else {
+                result = other.copy();
+                other = shared_type();
+            }
+            return result;
+        }
+
     protected:
         /// @cond IMPL
 
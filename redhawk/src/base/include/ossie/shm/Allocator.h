@@ -24,6 +24,9 @@
 #include <cstddef>
 #include <string>
 
+#include <inttypes.h>
+#include <sys/types.h>
+
 namespace redhawk {
 
     namespace shm {
@@ -40,6 +43,47 @@ namespace redhawk {
         void* allocateHybrid(size_t bytes);
         void deallocateHybrid(void* ptr);
 
+        // Returns true if no other process holds a reference to the
+        // process-shared memory at ptr
+        bool isExclusive(const void* ptr);
+
+        // Interns an owner tag (e.g., the port and connection being serviced)
+        // in the process heap, for live heap accounting, returning an index to
+        // pass to setAllocationTag(); the index is 0 (untagged) if shared
+        // memory is not enabled or the heap's tag table is full. Tags should
+        // be interned once and released when no longer used, so that the
+        // heap can reuse their entries.
+        uint32_t internAllocationTag(const std::string& tag);
+        void releaseAllocationTag(uint32_t tag);
+
+        // Sets the owner tag recorded with shared memory allocations made by
+        // the calling thread; 0 clears it
+        void setAllocationTag(uint32_t tag);
+        uint32_t getAllocationTag();
+
+        // Sets the calling thread's allocation tag for the lifetime of the
+        // object, restoring the previous tag on destruction
+        class ScopedAllocationTag {
+        public:
+            explicit ScopedAllocationTag(uint32_t tag) :
+                _previous(getAllocationTag())
+            {
+                setAllocationTag(tag);
+            }
+
+            ~ScopedAllocationTag()
+            {
+                setAllocationTag(_previous);
+            }
+
+        private:
+            // Non-copyable, non-assignable
+            ScopedAllocationTag(const ScopedAllocationTag&);
+            ScopedAllocationTag& operator=(const ScopedAllocationTag&);
+
+            uint32_t _previous;
+        };
+
         template <class T>
         struct Allocator : public std::allocator<T>
         {
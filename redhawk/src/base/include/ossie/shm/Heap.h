@@ -44,13 +44,23 @@ namespace redhawk {
             Heap(const std::string& name);
             ~Heap();
 
-            void* allocate(size_t bytes);
+            // Allocates at least the given number of bytes, recording tag (as
+            // returned by internTag()) as the owner
+            void* allocate(size_t bytes, uint32_t tag=0);
             void deallocate(void* ptr);
 
             static MemoryRef getRef(const void* ptr);
 
             const std::string& name() const;
 
+            // Returns live accounting of the heap's allocations
+            SuperblockFile::Usage getUsage();
+
+            // Interns and releases owner tags for allocations (see
+            // SuperblockFile::internTag())
+            uint32_t internTag(const std::string& tag);
+            void releaseTag(uint32_t tag);
+
         private:
             struct Pool;
 
@@ -22,6 +22,9 @@
 #define REDHAWK_SHM_SUPERBLOCKFILE_H
 
 #include <map>
+#include <string>
+#include <inttypes.h>
+#include <sys/types.h>
 
 #include "MappedFile.h"
 
@@ -41,6 +44,45 @@ namespace redhawk {
                 size_t unused;
             };
 
+            // Number of buckets in the allocation age histogram
+            static const size_t AGE_BUCKETS = 6;
+
+            // Returns the upper limit, in seconds, of an age histogram bucket;
+            // the last bucket has no limit and returns 0
+            static unsigned int AgeLimit(size_t bucket);
+
+            struct TagUsage
+            {
+                TagUsage();
+
+                size_t blocks;
+                size_t bytes;
+            };
+
+            typedef std::map<std::string,TagUsage> TagUsageMap;
+
+            // Live accounting of the allocated and free blocks in the heap
+            struct Usage
+            {
+                Usage();
+
+                // Allocated blocks, and their size in bytes including overhead
+                size_t blocks;
+                size_t bytes;
+                // Allocated blocks that are referenced by more than one process
+                size_t sharedBlocks;
+                size_t freeBlocks;
+                size_t freeBytes;
+                size_t largestFree;
+                // Number of allocated blocks in each age bucket
+                size_t ages[AGE_BUCKETS];
+                // Allocated blocks by owner tag
+                TagUsageMap tags;
+                // False if the heap changed while it was being walked and some
+                // blocks could not be accounted for
+                bool complete;
+            };
+
             SuperblockFile(const std::string& name);
             ~SuperblockFile();
 
@@ -52,6 +94,21 @@ namespace redhawk {
 
             Statistics getStatistics();
 
+            // Walks every block in the heap; this does not lock the heap, so
+            // it is safe to call on a heap in use by another process
+            Usage getUsage();
+
+            // Returns the index of an owner tag in the tag table, adding it if
+            // necessary, and takes a reference to it; only the creator of the
+            // heap may add tags. Returns 0 (no tag) if the table is full.
+            uint32_t internTag(const std::string& tag);
+
+            // Releases a reference to an owner tag; once no references remain,
+            // its entry may be reused for another tag
+            void releaseTag(uint32_t index);
+
+            std::string getTag(uint32_t index) const;
+
             void create();
             void open(bool attach=true);
             void close();
@@ -0,0 +1,533 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <sys/vfs.h>
+
+#include <ossie/DirectoryIndex.h>
+#include <ossie/debug.h>
+
+using namespace ossie;
+
+namespace {
+
+    const char* LOGGER_NAME = "FileSystem_impl.DirectoryIndex";
+
+    const uint32_t WATCH_MASK = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                IN_MODIFY | IN_ATTRIB | IN_DELETE_SELF | IN_MOVE_SELF |
+                                IN_ONLYDIR;
+
+    // Splits path into its components, ignoring empty and "." components;
+    // returns false if the path contains "..", which the index does not try
+    // to resolve
+    bool split_path(const std::string& path, std::vector<std::string>& components)
+    {
+        std::string::size_type start = 0;
+        while (start <= path.size()) {
+            std::string::size_type end = path.find('/', start);
+            if (end == std::string::npos) {
+                end = path.size();
+            }
+            const std::string component = path.substr(start, end - start);
+            if (component == "..") {
+                return false;
+            } else if (!component.empty() && (component != ".")) {
+                components.push_back(component);
+            }
+            start = end + 1;
+        }
+        return true;
+    }
+
+    // inotify only reports changes made through the local kernel, so trees on
+    // shared file systems may be modified by other hosts without notice
+    bool is_network_filesystem(const std::string& path)
+    {
+        struct statfs info;
+        if (statfs(path.c_str(), &info)) {
+            return false;
+        }
+        switch (static_cast<unsigned int>(info.f_type)) {
+        case 0x6969:     // NFS
+        case 0x517B:     // SMB
+        case 0xFF534D42: // CIFS
+        case 0xFE534D42: // SMB2
+        case 0x65735546: // FUSE
+        case 0x5346414F: // AFS
+        case 0x00C36400: // Ceph
+        case 0x01161970: // GFS2
+        case 0x47504653: // GPFS
+        case 0x0BD00BD0: // Lustre
+        case 0x7461636F: // OCFS2
+            return true;
+        default:
+            return false;
+        }
+    }
+
+}
+
+struct DirectoryIndex::Node {
+    Node(Node* parent, const std::string& name) :
+        parent(parent),
+        wd(-1),
+        indexed(false),
+        link(false),
+        device(0),
+        inode(0)
+    {
+        entry.name = name;
+    }
+
+    Node* parent;
+    Entry entry;
+    NodeMap children;
+    int wd;
+    bool indexed;
+    bool link;
+    dev_t device;
+    ino_t inode;
+};
+
+DirectoryIndex::Entry::Entry() :
+    kind(MISSING),
+    size(0),
+    modified(0),
+    readonly(false),
+    executable(false)
+{
+}
+
+DirectoryIndex::DirectoryIndex(const std::string& root) :
+    _tree(0),
+    _ready(false),
+    _inotify(-1),
+    _thread(0)
+{
+    _wake[0] = _wake[1] = -1;
+    split_path(root, _root);
+    if (!root.empty() && (root[0] == '/')) {
+        _rootPath = "/";
+    }
+    for (size_t index = 0; index < _root.size(); ++index) {
+        if (index > 0) {
+            _rootPath += "/";
+        }
+        _rootPath += _root[index];
+    }
+}
+
+DirectoryIndex::~DirectoryIndex()
+{
+    stop();
+}
+
+bool DirectoryIndex::start()
+{
+    if (_thread) {
+        return true;
+    }
+    if (is_network_filesystem(_rootPath)) {
+        RH_NL_INFO(LOGGER_NAME, _rootPath << " is on a network file system, not indexing");
+        return false;
+    }
+
+    _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify < 0) {
+        RH_NL_WARN(LOGGER_NAME, "Unable to initialize inotify: " << strerror(errno));
+        return false;
+    }
+    if (pipe2(_wake, O_CLOEXEC)) {
+        RH_NL_WARN(LOGGER_NAME, "Unable to create wakeup pipe: " << strerror(errno));
+        ::close(_inotify);
+        _inotify = -1;
+        return false;
+    }
+
+    _thread = new boost::thread(&DirectoryIndex::_run, this);
+    return true;
+}
+
+void DirectoryIndex::stop()
+{
+    if (_thread) {
+        // Wake the index thread so that it exits
+        ssize_t status;
+        do {
+            status = ::write(_wake[1], "", 1);
+        } while ((status < 0) && (errno == EINTR));
+        _thread->join();
+        delete _thread;
+        _thread = 0;
+    }
+
+    boost::mutex::scoped_lock lock(_mutex);
+    _ready = false;
+    if (_tree) {
+        _remove(_tree);
+        _tree = 0;
+    }
+    if (_inotify >= 0) {
+        ::close(_inotify);
+        _inotify = -1;
+    }
+    for (int index = 0; index < 2; ++index) {
+        if (_wake[index] >= 0) {
+            ::close(_wake[index]);
+            _wake[index] = -1;
+        }
+    }
+}
+
+bool DirectoryIndex::ready()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    return _ready;
+}
+
+void DirectoryIndex::rebuild()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    if (!_ready) {
+        // The initial scan has not finished yet
+        return;
+    }
+    _rebuild();
+}
+
+bool DirectoryIndex::lookup(const std::string& path, Entry& entry)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    if (!_ready) {
+        return false;
+    }
+    _drain();
+
+    bool covered;
+    Node* node = _find(path, covered);
+    if (!covered) {
+        return false;
+    } else if (node) {
+        entry = node->entry;
+    } else {
+        entry = Entry();
+    }
+    return true;
+}
+
+bool DirectoryIndex::list(const std::string& path, Entry& entry, std::vector<Entry>& contents)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    if (!_ready) {
+        return false;
+    }
+    _drain();
+
+    bool covered;
+    Node* node = _find(path, covered);
+    if (!covered) {
+        return false;
+    } else if (!node) {
+        entry = Entry();
+        return true;
+    } else if ((node->entry.kind == DIRECTORY) && !node->indexed) {
+        // The directory exists but its contents are unknown
+        return false;
+    }
+
+    entry = node->entry;
+    for (NodeMap::iterator child = node->children.begin(); child != node->children.end(); ++child) {
+        contents.push_back(child->second->entry);
+    }
+    return true;
+}
+
+void DirectoryIndex::_run()
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _rebuild();
+        _ready = true;
+    }
+    RH_NL_DEBUG(LOGGER_NAME, "Finished indexing " << _rootPath);
+
+    struct pollfd fds[2];
+    fds[0].fd = _inotify;
+    fds[0].events = POLLIN;
+    fds[1].fd = _wake[0];
+    fds[1].events = POLLIN;
+    while (true) {
+        int status = poll(fds, 2, -1);
+        if (status < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            RH_NL_WARN(LOGGER_NAME, "Error waiting for file system events: " << strerror(errno));
+            break;
+        }
+        if (fds[1].revents) {
+            break;
+        }
+        if (fds[0].revents) {
+            boost::mutex::scoped_lock lock(_mutex);
+            _drain();
+        }
+    }
+}
+
+bool DirectoryIndex::_split(const std::string& path, std::vector<std::string>& components) const
+{
+    std::vector<std::string> full;
+    if (!split_path(path, full) || (full.size() < _root.size())) {
+        return false;
+    }
+    if (!std::equal(_root.begin(), _root.end(), full.begin())) {
+        return false;
+    }
+    components.assign(full.begin() + _root.size(), full.end());
+    return true;
+}
+
+DirectoryIndex::Node* DirectoryIndex::_find(const std::string& path, bool& covered)
+{
+    covered = false;
+    std::vector<std::string> components;
+    if (!_tree || !_tree->indexed || !_split(path, components)) {
+        return 0;
+    }
+
+    Node* node = _tree;
+    for (std::vector<std::string>::iterator name = components.begin(); name != components.end(); ++name) {
+        if (node->entry.kind != DIRECTORY) {
+            // Nothing can exist under a plain file
+            covered = true;
+            return 0;
+        } else if (!node->indexed) {
+            return 0;
+        }
+        NodeMap::iterator child = node->children.find(*name);
+        if (child == node->children.end()) {
+            covered = true;
+            return 0;
+        }
+        node = child->second;
+    }
+    covered = true;
+    return node;
+}
+
+std::string DirectoryIndex::_path(const Node* node) const
+{
+    std::string path;
+    for (; node->parent; node = node->parent) {
+        path = "/" + node->entry.name + path;
+    }
+    if (_rootPath == "/") {
+        return path.empty() ? _rootPath : path;
+    }
+    return _rootPath + path;
+}
+
+void DirectoryIndex::_drain()
+{
+    char buffer[8192] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    while (true) {
+        ssize_t length = ::read(_inotify, buffer, sizeof(buffer));
+        if (length < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // EAGAIN: no more pending events
+            return;
+        } else if (length == 0) {
+            return;
+        }
+
+        const char* current = buffer;
+        while (current < (buffer + length)) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(current);
+            _handleEvent(event->wd, event->mask, event->len ? event->name : 0);
+            current += sizeof(struct inotify_event) + event->len;
+        }
+    }
+}
+
+void DirectoryIndex::_handleEvent(int wd, unsigned int mask, const char* name)
+{
+    if (mask & IN_Q_OVERFLOW) {
+        RH_NL_WARN(LOGGER_NAME, "File system events were lost, rebuilding index of " << _rootPath);
+        _rebuild();
+        return;
+    }
+
+    WatchMap::iterator watch = _watches.find(wd);
+    if (watch == _watches.end()) {
+        // Stale event for a directory that has already been removed
+        return;
+    }
+    Node* dir = watch->second;
+
+    if (mask & IN_IGNORED) {
+        // The kernel removed the watch (e.g., the file system was unmounted);
+        // the directory's contents can no longer be trusted
+        _watches.erase(watch);
+        dir->wd = -1;
+        dir->indexed = false;
+    } else if (name && *name) {
+        _refresh(dir, name);
+    } else if (mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+        // Changes to subdirectories are also reported, by name, to the parent
+        // directory; only the root needs special handling
+        if (dir == _tree) {
+            RH_NL_WARN(LOGGER_NAME, "Root directory " << _rootPath << " was moved or deleted, disabling index");
+            dir->indexed = false;
+        }
+    } else if (mask & IN_ATTRIB) {
+        _stat(dir);
+    }
+}
+
+void DirectoryIndex::_rebuild()
+{
+    if (_tree) {
+        _remove(_tree);
+    }
+    _tree = new Node(0, std::string());
+    if (_stat(_tree) && (_tree->entry.kind == DIRECTORY)) {
+        _watch(_tree);
+    }
+}
+
+bool DirectoryIndex::_stat(Node* node)
+{
+    const std::string path = _path(node);
+    struct stat status;
+    if (::stat(path.c_str(), &status)) {
+        node->entry.kind = MISSING;
+        return false;
+    }
+
+    if (S_ISDIR(status.st_mode)) {
+        node->entry.kind = DIRECTORY;
+        node->entry.size = 0;
+    } else if (S_ISREG(status.st_mode)) {
+        node->entry.kind = PLAIN;
+        node->entry.size = status.st_size;
+    } else {
+        node->entry.kind = OTHER;
+        node->entry.size = 0;
+    }
+    node->entry.modified = status.st_mtime;
+    node->entry.readonly = access(path.c_str(), W_OK);
+    node->entry.executable = !access(path.c_str(), X_OK);
+    node->device = status.st_dev;
+    node->inode = status.st_ino;
+
+    struct stat link_status;
+    node->link = !lstat(path.c_str(), &link_status) && S_ISLNK(link_status.st_mode);
+    return true;
+}
+
+void DirectoryIndex::_watch(Node* node)
+{
+    const std::string path = _path(node);
+    int wd = inotify_add_watch(_inotify, path.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        // Most likely the user's watch limit was reached; lookups under this
+        // directory go to the disk
+        RH_NL_WARN(LOGGER_NAME, "Unable to watch " << path << ": " << strerror(errno));
+        return;
+    } else if (_watches.count(wd)) {
+        // Already watching this directory by another path (e.g., through a
+        // bind mount); do not index it twice
+        return;
+    }
+    node->wd = wd;
+    _watches[wd] = node;
+
+    DIR* dir = opendir(path.c_str());
+    if (!dir) {
+        RH_NL_WARN(LOGGER_NAME, "Unable to read directory " << path << ": " << strerror(errno));
+        return;
+    }
+    while (struct dirent* child = readdir(dir)) {
+        if ((strcmp(child->d_name, ".") == 0) || (strcmp(child->d_name, "..") == 0)) {
+            continue;
+        }
+        _refresh(node, child->d_name);
+    }
+    closedir(dir);
+    node->indexed = true;
+}
+
+void DirectoryIndex::_refresh(Node* dir, const std::string& name)
+{
+    NodeMap::iterator existing = dir->children.find(name);
+    Node* node = new Node(dir, name);
+    if (!_stat(node)) {
+        delete node;
+        if (existing != dir->children.end()) {
+            _remove(existing->second);
+        }
+        return;
+    }
+
+    if (existing != dir->children.end()) {
+        Node* current = existing->second;
+        if ((current->device == node->device) && (current->inode == node->inode) &&
+            (current->link == node->link) && (current->entry.kind == node->entry.kind)) {
+            // Same file, only the metadata changed
+            current->entry = node->entry;
+            delete node;
+            return;
+        }
+        // Replaced by a different file (e.g., renamed over the old one)
+        _remove(current);
+    }
+
+    dir->children[name] = node;
+    if ((node->entry.kind == DIRECTORY) && !node->link) {
+        _watch(node);
+    }
+}
+
+void DirectoryIndex::_remove(Node* node)
+{
+    while (!node->children.empty()) {
+        _remove(node->children.begin()->second);
+    }
+    if (node->wd >= 0) {
+        inotify_rm_watch(_inotify, node->wd);
+        _watches.erase(node->wd);
+    }
+    if (node->parent) {
+        node->parent->children.erase(node->entry.name);
+    }
+    delete node;
+}
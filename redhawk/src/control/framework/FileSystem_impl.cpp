@@ -21,14 +21,17 @@
 
 /* SCA */
 
+#include <cstdlib>
 #include <iostream>
 #include <string>
 
 #include <fnmatch.h>
+#include <unistd.h>
 
 #include <boost/filesystem.hpp>
 
 #include "ossie/FileSystem_impl.h"
+#include "ossie/DirectoryIndex.h"
 #include "ossie/File_impl.h"
 #include "ossie/CorbaUtils.h"
 #include "ossie/ossieSupport.h"
@@ -137,6 +140,16 @@ namespace {
 #undef RETRY_START
 #undef RETRY_END
 
+    std::string local_hostname ()
+    {
+        char hostname[256];
+        if (gethostname(hostname, sizeof(hostname))) {
+            return std::string();
+        }
+        hostname[sizeof(hostname)-1] = '\0';
+        return hostname;
+    }
+
 }
 
 
@@ -146,6 +159,14 @@ PREPARE_CF_LOGGING(FileSystem_impl)
 FileSystem_impl::FileSystem_impl (const char* _root):
     root(_root)
 {
+    // The index uses a thread and inotify watches for each file system; it
+    // can be turned off, in which case every query goes to the disk
+    if (!getenv("REDHAWK_DISABLE_FS_INDEX")) {
+        dirIndex.reset(new ossie::DirectoryIndex(_root));
+        if (!dirIndex->start()) {
+            dirIndex.reset();
+        }
+    }
 }
 
 FileSystem_impl::~FileSystem_impl ()
@@ -274,6 +295,11 @@ throw (CORBA::SystemException, CF::InvalidFileName)
 bool FileSystem_impl::_local_exists (const char* fileName)
 {
     fs::path fname(root / fileName);
+    ossie::DirectoryIndex::Entry entry;
+    if (dirIndex && dirIndex->lookup(fname.string(), entry)) {
+        return (entry.kind != ossie::DirectoryIndex::MISSING);
+    }
+
     UnreliableFS fsops;
     RH_TRACE(_fileSysLog, "Checking for existence of local file " << fname.string());
     try {
@@ -291,9 +317,20 @@ CF::FileSystem::FileInformationSequence* FileSystem_impl::list (const char* patt
     fs::path dirPath(filePath.parent_path());
     UnreliableFS fsops;
 
-    // Validate the input pattern and its path.
+    // Validate the input pattern and its path, consulting the index first and
+    // falling back to the disk if it cannot answer
     if ((dirPath.string().find('?') != std::string::npos) || (dirPath.string().find('*') != std::string::npos)) {
         throw CF::InvalidFileName(CF::CF_EINVAL, "Wildcards can only be applied after the rightmost path separator");
+    }
+    ossie::DirectoryIndex::Entry dirEntry;
+    std::vector<ossie::DirectoryIndex::Entry> contents;
+    const bool indexed = dirIndex && dirIndex->list(dirPath.string(), dirEntry, contents);
+    if (indexed) {
+        if (dirEntry.kind == ossie::DirectoryIndex::MISSING) {
+            throw CF::FileException(CF::CF_EEXIST, "Path does not exist");
+        } else if (dirEntry.kind != ossie::DirectoryIndex::DIRECTORY) {
+            throw CF::FileException(CF::CF_ENOTDIR, "Path is not a directory");
+        }
     } else if (!fsops.exists(dirPath)) {
         throw CF::FileException(CF::CF_EEXIST, "Path does not exist");
     } else if (!fsops.is_directory(dirPath)) {
@@ -301,55 +338,87 @@ CF::FileSystem::FileInformationSequence* FileSystem_impl::list (const char* patt
     }
 
     std::string searchPattern = BOOST_PATH_STRING(filePath.filename());
-    if ((searchPattern == ".") && (fsops.is_directory(filePath))) {
+    if (searchPattern == ".") {
+        // The pattern refers to the directory itself (i.e., it has a trailing
+        // slash), which has already been confirmed to be a directory
         searchPattern = "*";
     }
-    RH_TRACE(_fileSysLog, "List using search pattern " << searchPattern << " in " << dirPath);
-
-    CF::FileSystem::FileInformationSequence_var result = new CF::FileSystem::FileInformationSequence;
-
-    const fs::directory_iterator end_itr; // an end iterator (by boost definition)
-    for (fs::directory_iterator itr = fsops.begin(dirPath); itr != end_itr; fsops.increment(itr)) {
-        const std::string filename = BOOST_PATH_STRING(itr->path().filename());
-        if (fnmatch(searchPattern.c_str(), filename.c_str(), 0) == 0) {
-            RH_TRACE(_fileSysLog, "Match in list with " << filename);
-            CORBA::ULong index = result->length();
-            result->length(index + 1);
-                
-            // We need to specially handle the empty '' pattern
-            if (strlen(pattern) == 0) {
-                result[index].name = CORBA::string_dup("/");
-            } else {
-                result[index].name = CORBA::string_dup(filename.c_str());
+    RH_TRACE(_fileSysLog, "List using search pattern " << searchPattern << " in " << dirPath
+             << (indexed ? " (indexed)" : ""));
+
+    std::vector<ossie::DirectoryIndex::Entry> matches;
+    if (indexed) {
+        for (std::vector<ossie::DirectoryIndex::Entry>::iterator entry = contents.begin(); entry != contents.end(); ++entry) {
+            if (fnmatch(searchPattern.c_str(), entry->name.c_str(), 0) == 0) {
+                if (entry->kind == ossie::DirectoryIndex::OTHER) {
+                    RH_WARN(_fileSysLog, "File cannot be evaluated, excluding from list: " << entry->name);
+                    continue;
+                }
+                matches.push_back(*entry);
             }
-            CORBA::ULongLong modtime = 0;
-            try {
-                if (fsops.is_directory(*itr)) {
-                    result[index].kind = CF::FileSystem::DIRECTORY;
-                    result[index].size = 0;
-                } else {
-                    result[index].kind = CF::FileSystem::PLAIN;
-                    result[index].size = fs::file_size(*itr);
+        }
+    } else {
+        const fs::directory_iterator end_itr; // an end iterator (by boost definition)
+        for (fs::directory_iterator itr = fsops.begin(dirPath); itr != end_itr; fsops.increment(itr)) {
+            const std::string filename = BOOST_PATH_STRING(itr->path().filename());
+            if (fnmatch(searchPattern.c_str(), filename.c_str(), 0) == 0) {
+                ossie::DirectoryIndex::Entry entry;
+                entry.name = filename;
+                try {
+                    if (fsops.is_directory(*itr)) {
+                        entry.kind = ossie::DirectoryIndex::DIRECTORY;
+                        entry.size = 0;
+                    } else {
+                        entry.kind = ossie::DirectoryIndex::PLAIN;
+                        entry.size = fs::file_size(*itr);
+                    }
+                    entry.modified = fs::last_write_time(*itr);
+                } catch ( ... ) {
+                    // this file is not good (i.e.: bad link)
+                    RH_WARN(_fileSysLog, "File cannot be evaluated, excluding from list: " << filename);
+                    continue;
                 }
-                modtime = fs::last_write_time(*itr);
-            } catch ( ... ) {
-                // this file is not good (i.e.: bad link)
-                result->length(index);
-                RH_WARN(_fileSysLog, "File cannot be evaluated, excluding from list: " << filename);
-                continue;
+                const std::string localFilename = itr->path().string();
+                entry.readonly = access(localFilename.c_str(), W_OK);
+                entry.executable = !access(localFilename.c_str(), X_OK);
+                matches.push_back(entry);
             }
+        }
+    }
 
-            const std::string localFilename = itr->path().string();
-            bool readonly = access(localFilename.c_str(), W_OK);
-            bool executable = !access(localFilename.c_str(), X_OK);
-
-            redhawk::PropertyMap& props = redhawk::PropertyMap::cast(result[index].fileProperties);
-            props[CF::FileSystem::CREATED_TIME_ID] = modtime;
-            props[CF::FileSystem::MODIFIED_TIME_ID] = modtime;
-            props[CF::FileSystem::LAST_ACCESS_TIME_ID] = modtime;
-            props["READ_ONLY"] = readonly;
-            props["EXECUTABLE"] = executable;
-            props["IOR_AVAILABLE"] = getFileIOR(localFilename);
+    static const std::string hostname = local_hostname();
+    CF::FileSystem::FileInformationSequence_var result = new CF::FileSystem::FileInformationSequence;
+    result->length(matches.size());
+    for (CORBA::ULong index = 0; index < matches.size(); ++index) {
+        const ossie::DirectoryIndex::Entry& entry = matches[index];
+        RH_TRACE(_fileSysLog, "Match in list with " << entry.name);
+
+        // We need to specially handle the empty '' pattern
+        if (strlen(pattern) == 0) {
+            result[index].name = CORBA::string_dup("/");
+        } else {
+            result[index].name = CORBA::string_dup(entry.name.c_str());
+        }
+        if (entry.kind == ossie::DirectoryIndex::DIRECTORY) {
+            result[index].kind = CF::FileSystem::DIRECTORY;
+        } else {
+            result[index].kind = CF::FileSystem::PLAIN;
+        }
+        result[index].size = entry.size;
+
+        const std::string localFilename = (dirPath / entry.name).string();
+        const CORBA::ULongLong modtime = entry.modified;
+        redhawk::PropertyMap& props = redhawk::PropertyMap::cast(result[index].fileProperties);
+        props[CF::FileSystem::CREATED_TIME_ID] = modtime;
+        props[CF::FileSystem::MODIFIED_TIME_ID] = modtime;
+        props[CF::FileSystem::LAST_ACCESS_TIME_ID] = modtime;
+        props["READ_ONLY"] = entry.readonly;
+        props["EXECUTABLE"] = entry.executable;
+        props["IOR_AVAILABLE"] = getFileIOR(localFilename);
+        if (entry.kind == ossie::DirectoryIndex::PLAIN) {
+            // Allow clients on the same host to read the file directly
+            props["HOSTNAME"] = hostname;
+            props["LOCAL_PATH"] = localFilename;
         }
     }
 
@@ -0,0 +1,133 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option) any
+ * later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef __DIRECTORYINDEX_H__
+#define __DIRECTORYINDEX_H__
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+#include <boost/thread.hpp>
+
+namespace ossie {
+
+    /*
+     * In-memory index of the metadata (type, size, modification time and
+     * access) of every file under a local directory tree, kept up-to-date
+     * with inotify so that existence checks and directory listings do not
+     * need to walk and stat the disk.
+     *
+     * The initial scan runs on a background thread, which then applies
+     * change notifications as they arrive. Queries also apply any pending
+     * notifications before answering, so changes made by other processes are
+     * visible as soon as the call that made them returns.
+     *
+     * Queries return false for any path the index cannot vouch for (before
+     * the initial scan completes, outside of the root, or under a directory
+     * that could not be watched, such as a symbolic link); the caller is
+     * expected to go to the disk instead.
+     */
+    class DirectoryIndex
+    {
+    public:
+        enum Kind {
+            MISSING,
+            PLAIN,
+            DIRECTORY,
+            OTHER
+        };
+
+        struct Entry {
+            Entry();
+
+            std::string name;
+            Kind kind;
+            unsigned long long size;
+            unsigned long long modified;
+            bool readonly;
+            bool executable;
+        };
+
+        DirectoryIndex(const std::string& root);
+        ~DirectoryIndex();
+
+        // Begins indexing the root in the background; returns false if the
+        // root cannot be indexed reliably (e.g., it is on a network file
+        // system, where changes made by other hosts are not reported)
+        bool start();
+        void stop();
+
+        bool ready();
+
+        // Discards the index and rescans the disk; done automatically when
+        // change notifications are lost (i.e., the inotify queue overflows)
+        void rebuild();
+
+        // Looks up the metadata for path; if path is covered by the index but
+        // does not exist, entry.kind is MISSING
+        bool lookup(const std::string& path, Entry& entry);
+
+        // Looks up the metadata for the directory path, and if it exists,
+        // its contents
+        bool list(const std::string& path, Entry& entry, std::vector<Entry>& contents);
+
+    private:
+        struct Node;
+        typedef std::map<std::string,Node*> NodeMap;
+        typedef std::map<int,Node*> WatchMap;
+
+        // Disallow copies
+        DirectoryIndex(const DirectoryIndex&);
+        DirectoryIndex& operator=(const DirectoryIndex&);
+
+        void _run();
+
+        bool _split(const std::string& path, std::vector<std::string>& components) const;
+        Node* _find(const std::string& path, bool& covered);
+        std::string _path(const Node* node) const;
+
+        void _drain();
+        void _handleEvent(int wd, unsigned int mask, const char* name);
+
+        void _rebuild();
+        bool _stat(Node* node);
+        void _watch(Node* node);
+        void _refresh(Node* dir, const std::string& name);
+        void _remove(Node* node);
+
+        std::vector<std::string> _root;
+        std::string _rootPath;
+
+        boost::mutex _mutex;
+        Node* _tree;
+        WatchMap _watches;
+        bool _ready;
+
+        int _inotify;
+        int _wake[2];
+        boost::thread* _thread;
+    };
+
+}
+
+#endif // __DIRECTORYINDEX_H__
@@ -28,11 +28,16 @@
 #include <string>
 
 #include <boost/filesystem/path.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <boost/thread/mutex.hpp>
 
 #include <ossie/CF/cf.h>
 #include <ossie/debug.h>
 
+namespace ossie {
+    class DirectoryIndex;
+}
+
 class FileSystem_impl: public virtual POA_CF::FileSystem
 {
     ENABLE_LOGGING
@@ -108,5 +113,9 @@ private:
     boost::mutex interfaceAccess;
     boost::mutex fileIORCountAccess;
 
+    // Cached metadata for the local tree; null if the root cannot be indexed
+    // or REDHAWK_DISABLE_FS_INDEX is set
+    boost::scoped_ptr<ossie::DirectoryIndex> dirIndex;
+
 };                                                /* END CLASS DEFINITION FileSystem */
 #endif                                            /* __FILESYSTEM__ */
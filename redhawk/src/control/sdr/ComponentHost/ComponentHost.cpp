@@ -20,6 +20,8 @@
 
 #include <boost/filesystem.hpp>
 #include <boost/scoped_ptr.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string/join.hpp>
 
 #include "ComponentHost.h"
 
@@ -30,6 +32,7 @@ namespace redhawk {
     struct ComponentEntry {
         boost::scoped_ptr<ModuleBundle> bundle;
         Resource_impl* servant;
+        std::string placement;
     };
 }
 
@@ -37,7 +40,8 @@ PREPARE_LOGGING(ComponentHost);
 
 ComponentHost::ComponentHost(const char* identifier, const char* label) :
     Component(identifier, label),
-    counter(0)
+    counter(0),
+    homeNode(-1)
 {
     loadProperties();
 }
@@ -57,6 +61,25 @@ void ComponentHost::loadProperties()
                 "",
                 "external",
                 "property");
+
+    addProperty(placement_policy,
+                "none",
+                "placement_policy",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+    addPropertyListener(placement_policy, this, &ComponentHost::placementPolicyChanged);
+
+    addProperty(placement,
+                placement,
+                "placement",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
 }
 
 void ComponentHost::constructor()
@@ -211,9 +234,25 @@ CF::ExecutableDevice::ProcessID_Type ComponentHost::executeLinked(const char* na
     component->bundle.swap(bundle);
     component->servant = servant;
 
+    // The placement must be registered before the component is started, so
+    // that its processing thread picks it up
+    redhawk::affinity::AffinityDirectives spec = getPlacement(options);
+    std::vector<std::string> directives;
+    for (redhawk::affinity::AffinityDirectives::iterator iter = spec.begin(); iter != spec.end(); ++iter) {
+        directives.push_back(iter->first + ":" + iter->second);
+    }
+    if (directives.empty()) {
+        component->placement = "none";
+    } else {
+        redhawk::affinity::set_placement(dynamic_cast<void*>(servant), spec);
+        component->placement = boost::algorithm::join(directives, ",");
+    }
+    LOG_DEBUG(ComponentHost, "Component " << servant->getIdentifier() << " placement: " << component->placement);
+
     int thread_id = ++counter;
     activeComponents[thread_id] = component;
     LOG_DEBUG(ComponentHost, "Assigning thread ID " << thread_id);
+    updatePlacementProperty();
 
     servant->addReleaseListener(this, &ComponentHost::componentReleased);
 
@@ -237,8 +276,78 @@ void ComponentHost::componentReleased(Resource_impl* component)
         return;
     }
 
+    // Remove the placement while the servant's address is still unique
+    redhawk::affinity::clear_placement(dynamic_cast<void*>(component));
+
     executorService.execute(&ComponentHost::cleanupComponent, this, entry->second);
     activeComponents.erase(entry);
+    updatePlacementProperty();
+}
+
+redhawk::affinity::AffinityDirectives ComponentHost::getPlacement(const CF::Properties& options)
+{
+    redhawk::affinity::AffinityDirectives spec;
+    if (redhawk::affinity::has_affinity(options)) {
+        try {
+            redhawk::affinity::AffinityDirectives requested = redhawk::affinity::convert_properties(options);
+            redhawk::affinity::AffinityDirectives::iterator iter = requested.begin();
+            for (; iter != requested.end(); ++iter) {
+                if (iter->first == "cgroup" || iter->first == "cpuset") {
+                    // These apply to the whole process, which is shared
+                    LOG_WARN(ComponentHost, "Ignoring " << iter->first << " affinity for hosted component");
+                    continue;
+                }
+                spec.push_back(*iter);
+
+                // The first explicit socket becomes the home node for
+                // collocated components that do not request one
+                if ((homeNode < 0) && (iter->first == "socket")) {
+                    try {
+                        homeNode = boost::lexical_cast<int>(iter->second);
+                    } catch (const boost::bad_lexical_cast&) {
+                        // Node lists do not identify a single home node
+                    }
+                }
+            }
+        } catch (const redhawk::affinity::AffinityFailed& exc) {
+            LOG_WARN(ComponentHost, "Invalid affinity for hosted component: " << exc.what());
+        }
+    }
+
+    // Keep collocated components on one node, so that data exchanged through
+    // local transports stays in that node's caches and memory
+    std::string policy;
+    {
+        boost::mutex::scoped_lock lock(propertySetAccess);
+        policy = placement_policy;
+    }
+    if (spec.empty() && (policy == "collocate") && (redhawk::affinity::get_node_count() > 1)) {
+        if (homeNode < 0) {
+            homeNode = redhawk::affinity::get_current_node();
+        }
+        spec.push_back(redhawk::affinity::AffinityDirective("socket", boost::lexical_cast<std::string>(homeNode)));
+    }
+    return spec;
+}
+
+void ComponentHost::placementPolicyChanged(const std::string& oldValue, const std::string& newValue)
+{
+    // Only affects components executed from now on
+    if ((newValue != "collocate") && (newValue != "none")) {
+        LOG_WARN(ComponentHost, "Unknown placement policy '" << newValue << "', hosted components will not be placed");
+    }
+}
+
+void ComponentHost::updatePlacementProperty()
+{
+    // Caller must hold loadMutex
+    std::vector<std::string> current;
+    for (ComponentTable::iterator entry = activeComponents.begin(); entry != activeComponents.end(); ++entry) {
+        current.push_back(entry->second->servant->getIdentifier() + "=" + entry->second->placement);
+    }
+
+    boost::mutex::scoped_lock lock(propertySetAccess);
+    placement.swap(current);
 }
 
 void ComponentHost::cleanupComponent(ComponentEntry* component)
@@ -23,6 +23,7 @@
 
 #include <ossie/Component.h>
 #include <ossie/ExecutorService.h>
+#include <ossie/affinity.h>
 
 #include "ModuleLoader.h"
 
@@ -66,6 +67,10 @@ namespace redhawk {
 
         std::string getRealPath(const std::string& path);
 
+        redhawk::affinity::AffinityDirectives getPlacement(const CF::Properties& options);
+        void updatePlacementProperty();
+        void placementPolicyChanged(const std::string& oldValue, const std::string& newValue);
+
         int counter;
 
         boost::mutex loadMutex;
@@ -75,8 +80,17 @@ namespace redhawk {
         // Threaded service for performing cleanup checks
         redhawk::ExecutorService executorService;
 
+        // NUMA node shared by collocated components without explicit affinity
+        int homeNode;
+
         /// Property: preload
         std::vector<std::string> preload;
+
+        /// Property: placement_policy
+        std::string placement_policy;
+
+        /// Property: placement
+        std::vector<std::string> placement;
     };
 }
 
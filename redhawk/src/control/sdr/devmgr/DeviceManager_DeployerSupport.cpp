@@ -65,6 +65,12 @@ void DeviceManager_impl::createDeviceThreadAndHandleExceptions(
         const std::string&                            compositeDeviceIOR ){
 
     try {
+        // Shared library devices are loaded into their parent by CORBA calls
+        // that do not modify this process, so those calls may run in parallel
+        const local_spd::ImplementationInfo *matchingImpl = compProfile->getSelectedImplementation();
+        const bool isSharedLibrary = matchingImpl && (matchingImpl->getCodeType() == CF::LoadableDevice::SHARED_LIBRARY);
+        boost::mutex::scoped_lock lock(launchMutex);
+
 	// proces any instance overrides from DCD componentproperties
 	const ossie::ComponentPropertyList& overrideProps = instantiation.getProperties();
 	for (unsigned int j = 0; j < overrideProps.size (); j++) {
@@ -77,18 +83,31 @@ void DeviceManager_impl::createDeviceThreadAndHandleExceptions(
         std::string usageName; 
         createDeviceCacheLocation(devcache, devcwd, usageName, compProfile, instantiation);
 
-        // these variables will cleanup path and environment from package mods that might have failed
-        ProcessEnvironment  restoreState;
-
-        createDeviceThread(componentPlacement,
-			   compProfile,
-                           componentType,
-                           codeFilePath,
-                           instantiation,
-                           devcache,
-                           devcwd,
-                           usageName,
-                           compositeDeviceIOR );
+        if (isSharedLibrary) {
+            lock.unlock();
+            createDeviceThread(componentPlacement,
+                               compProfile,
+                               componentType,
+                               codeFilePath,
+                               instantiation,
+                               devcache,
+                               devcwd,
+                               usageName,
+                               compositeDeviceIOR );
+        } else {
+            // these variables will cleanup path and environment from package mods that might have failed
+            ProcessEnvironment  restoreState;
+
+            createDeviceThread(componentPlacement,
+                               compProfile,
+                               componentType,
+                               codeFilePath,
+                               instantiation,
+                               devcache,
+                               devcwd,
+                               usageName,
+                               compositeDeviceIOR );
+        }
 
     } catch (std::runtime_error& ex) {
         RH_ERROR(this->_baseLog, 
@@ -186,9 +205,6 @@ void DeviceManager_impl::createDeviceThread(
     const local_spd::ImplementationInfo *matchingImpl = compProfile->getSelectedImplementation();
     bool isSharedLibrary = (matchingImpl->getCodeType() == CF::LoadableDevice::SHARED_LIBRARY);
     
-    // reset package modifications list
-    sharedPkgs.clear();
-
     // Logic for persona devices
     // check is parent exists and if the code type is "SharedLibrary"
     if (isSharedLibrary) {
@@ -263,7 +279,9 @@ void DeviceManager_impl::createDeviceThread(
 
     } else {
 
-       
+        // reset package modifications list
+        sharedPkgs.clear();
+
         ProcessEnvironment myenv( false /* == do not restore */ );
 
         std::vector< std::string > new_argv;
@@ -297,6 +315,7 @@ void DeviceManager_impl::createDeviceThread(
 
         rh_logger::LevelPtr  lvl = DeviceManager_impl::__logger->getLevel();
 
+        const boost::system_time launchTime = boost::get_system_time();
         int pid = fork();
         if (pid > 0) {
             // parent process: pid is the process ID of the child
@@ -309,6 +328,7 @@ void DeviceManager_impl::createDeviceThread(
                 serviceNode->identifier = instantiation.getID();
                 serviceNode->label = usageName;
                 serviceNode->pid = pid;
+                serviceNode->launchTime = launchTime;
                 boost::recursive_mutex::scoped_lock lock(registeredDevicesmutex);
                 _pendingServices.push_back(serviceNode);
             } else {
@@ -316,6 +336,7 @@ void DeviceManager_impl::createDeviceThread(
                 deviceNode->identifier = instantiation.getID();
                 deviceNode->label      = usageName;
                 deviceNode->pid        = pid;
+                deviceNode->launchTime = launchTime;
                 boost::recursive_mutex::scoped_lock lock(registeredDevicesmutex);
                 _pendingDevices.push_back(deviceNode);
             }
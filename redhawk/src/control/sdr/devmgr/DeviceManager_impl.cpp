@@ -26,8 +26,11 @@
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 #include <algorithm>
+#include <set>
 #include <ossie/debug.h>
 #include <ossie/ossieSupport.h>
 #include <ossie/DeviceManagerConfiguration.h>
@@ -179,6 +182,24 @@ DeviceManager_impl::DeviceManager_impl(
                "seconds",
                "external",
                "property");
+
+    addProperty(PARALLEL_STARTUP,
+                false,
+               "PARALLEL_STARTUP",
+               "PARALLEL_STARTUP",
+               "readonly",
+               "",
+               "external",
+               "property");
+
+    addProperty(DEVICE_REGISTRATION_TIMEOUT,
+                60,
+               "DEVICE_REGISTRATION_TIMEOUT",
+               "DEVICE_REGISTRATION_TIMEOUT",
+               "readwrite",
+               "seconds",
+               "external",
+               "property");
  
     // translate cpuBlackList to cpu ids 
     try {
@@ -653,7 +674,7 @@ void DeviceManager_impl::recordComponentInstantiationId(
         const ComponentInstantiation& instantiation,
         const std::string &impl_id ) {
 
-    boost::mutex::scoped_try_lock lock(componentImplMapmutex);
+    boost::mutex::scoped_lock lock(componentImplMapmutex);
     _componentImplMap[instantiation.getID()] = impl_id;
 }
 
@@ -821,40 +842,461 @@ void DeviceManager_impl::registerDeviceManagerWithDomainManager(
     }
 }
 
-void DeviceManager_impl::getCompositeDeviceIOR(
+bool DeviceManager_impl::getCompositeDeviceIOR(
         std::string&                               compositeDeviceIOR, 
         const std::vector<ossie::DevicePlacement>& componentPlacements,
+        const ossie::DevicePlacement&              componentPlacementInst,
+        float                                      timeout) {
+
+    // Wait for the parent device to register; a timeout of 0 waits forever
+    const boost::system_time end = getRegistrationDeadline(boost::get_system_time(), timeout);
+    boost::recursive_mutex::scoped_lock lock(registeredDevicesmutex);
+    while (!findCompositeDeviceIOR(compositeDeviceIOR, componentPlacements, componentPlacementInst)) {
+        if (!waitForRegistrationChange(lock, end)) {
+            return findCompositeDeviceIOR(compositeDeviceIOR, componentPlacements, componentPlacementInst);
+        }
+    }
+    return true;
+}
+
+bool DeviceManager_impl::findCompositeDeviceIOR(
+        std::string&                               compositeDeviceIOR,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
         const ossie::DevicePlacement&              componentPlacementInst) {
 
     //see if component is composite part of device
     RH_TRACE(this->_baseLog, "Checking composite part of device");
-    if (componentPlacementInst.isCompositePartOf()) {
-        std::string parentDeviceRefid = componentPlacementInst.getCompositePartOfDeviceID();
-        RH_TRACE(this->_baseLog, "CompositePartOfDevice: <" << parentDeviceRefid << ">");
-        //find parent ID and stringify the IOR
-        for (unsigned int cp_idx = 0; cp_idx < componentPlacements.size(); cp_idx++) {
-            // must match to a particular instance
-            for (unsigned int ci_idx = 0; ci_idx < componentPlacements[cp_idx].getInstantiations().size(); ci_idx++) {
-                const std::string& instanceID = componentPlacements[cp_idx].instantiations[ci_idx].getID();
-                if (instanceID == parentDeviceRefid) {
-                    RH_TRACE(this->_baseLog, "CompositePartOfDevice: Found parent device instance <" 
-                            << componentPlacements[cp_idx].getInstantiations()[ci_idx].getID() 
-                            << "> for child device <" << componentPlacementInst.getFileRefId() << ">");
-                    // now get the associated IOR
-                    while (true) {
-                        std::string tmpior = getIORfromID(instanceID);
-                        if (!tmpior.empty()) {
-                            compositeDeviceIOR = tmpior;
-                            RH_TRACE(this->_baseLog, "CompositePartOfDevice: Found parent device IOR <" << compositeDeviceIOR << ">");
-                            break;
+    if (!componentPlacementInst.isCompositePartOf()) {
+        return true;
+    }
+
+    std::string parentDeviceRefid = componentPlacementInst.getCompositePartOfDeviceID();
+    RH_TRACE(this->_baseLog, "CompositePartOfDevice: <" << parentDeviceRefid << ">");
+    //find parent ID and stringify the IOR
+    for (unsigned int cp_idx = 0; cp_idx < componentPlacements.size(); cp_idx++) {
+        // must match to a particular instance
+        for (unsigned int ci_idx = 0; ci_idx < componentPlacements[cp_idx].getInstantiations().size(); ci_idx++) {
+            const std::string& instanceID = componentPlacements[cp_idx].instantiations[ci_idx].getID();
+            if (instanceID == parentDeviceRefid) {
+                RH_TRACE(this->_baseLog, "CompositePartOfDevice: Found parent device instance <" 
+                        << componentPlacements[cp_idx].getInstantiations()[ci_idx].getID() 
+                        << "> for child device <" << componentPlacementInst.getFileRefId() << ">");
+                // now get the associated IOR
+                std::string tmpior = getIORfromID(instanceID);
+                if (tmpior.empty()) {
+                    return false;
+                }
+                compositeDeviceIOR = tmpior;
+                RH_TRACE(this->_baseLog, "CompositePartOfDevice: Found parent device IOR <" << compositeDeviceIOR << ">");
+            }
+        }
+    }
+    return true;
+}
+
+void DeviceManager_impl::launchStandalonePlacement(
+        const Deployment&                          deployment,
+        const std::string&                         compositeDeviceIOR,
+        FileSystem_impl*&                          fs_servant) {
+
+      const DevicePlacement &compPlacement = deployment.first;
+      local_spd::ProgramProfile *compProfile = deployment.second;
+      const local_spd::ImplementationInfo *matchingImpl = compProfile->getSelectedImplementation();
+      std::string compId(compPlacement.instantiations[0].getID());
+      RH_INFO(this->_baseLog, "Placing Component CompId: " << compId << " ProfileName : " << compProfile->getName() );
+
+      // should not happen
+      if (!matchingImpl) return;
+
+      ossie::Properties deviceProperties;
+      if (!addDeviceImplProperties( compProfile, *matchingImpl )) {
+	RH_INFO(this->_baseLog, "Skipping instantiation of device '" << compProfile->getInstantiationIdentifier() << 
+		 ", failed to merge properties ");
+	return;
+      }
+
+      std::vector<ComponentInstantiation>::const_iterator cpInstIter;
+      for (cpInstIter =  compPlacement.getInstantiations().begin(); 
+	   cpInstIter != compPlacement.getInstantiations().end(); 
+	   cpInstIter++) {
+
+	const ComponentInstantiation instantiation = *cpInstIter;
+	RH_TRACE(this->_baseLog, "Placing component id: " << instantiation.getID());
+
+        // setup profile with instantiation context
+        recordComponentInstantiationId(instantiation, matchingImpl->getId());
+        std::ostringstream identifier;
+        identifier << instantiation.getID() << ":" << node_dcd.getName();
+        compProfile->setIdentifier( instantiation.getID(), instantiation.getID());
+        compProfile->setNamingServiceName(instantiation.getFindByNamingServiceName());
+        compProfile->setUsageName(instantiation.getUsageName());
+        compProfile->setAffinity( instantiation.getAffinity() );
+        compProfile->setLoggingConfig( instantiation.getLoggingConfig() );
+
+	//spawn device
+	std::string codeFilePath;
+	if (!getCodeFilePath(codeFilePath,
+			     *matchingImpl,
+			     compProfile->spd,
+			     fs_servant)) {
+	  continue;
+	}
+
+	std::string componentType;
+	if (!getDeviceOrService(componentType, compProfile )) {
+	  // We got a type other than "device" or "service"
+	  continue;
+	}
+
+	// add to list of deployed resources
+        {
+            SCOPED_LOCK(componentImplMapmutex);
+            deployed_comps.push_back( deployment );
+	}
+        // Attempt to create the requested device or service
+        createDeviceThreadAndHandleExceptions(compPlacement,
+					      compProfile,
+					      componentType,
+					      codeFilePath,
+					      instantiation,
+					      compositeDeviceIOR );
+      }
+}
+
+/*
+ * Launch the composite device children that were set aside during parallel
+ * startup as their parents register. Each child waits at most
+ * DEVICE_REGISTRATION_TIMEOUT seconds from the time its parent was launched.
+ */
+void DeviceManager_impl::launchDeferredPlacements(
+        DeploymentList&                            deferred,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
+        FileSystem_impl*&                          fs_servant) {
+
+    const boost::system_time start = boost::get_system_time();
+
+    while (!deferred.empty()) {
+        DeploymentList ready;
+        boost::system_time next(boost::posix_time::pos_infin);
+        {
+            boost::recursive_mutex::scoped_lock lock(registeredDevicesmutex);
+            if ((_adminState == DEVMGR_SHUTTING_DOWN) || (_adminState == DEVMGR_SHUTDOWN)) {
+                return;
+            }
+
+            DeploymentList::iterator iter = deferred.begin();
+            while (iter != deferred.end()) {
+                std::string compositeDeviceIOR;
+                if (findCompositeDeviceIOR(compositeDeviceIOR, componentPlacements, iter->first)) {
+                    ready.push_back(*iter);
+                    iter = deferred.erase(iter);
+                    continue;
+                }
+
+                // If the parent has not been launched yet (e.g., it is itself
+                // waiting on a composite parent), measure from the start of the
+                // deferred launch
+                const std::string parentId = iter->first.getCompositePartOfDeviceID();
+                boost::system_time launched = getLaunchTime(parentId);
+                if (launched.is_not_a_date_time()) {
+                    launched = start;
+                }
+                const boost::system_time deadline = getRegistrationDeadline(launched, DEVICE_REGISTRATION_TIMEOUT);
+                if (boost::get_system_time() >= deadline) {
+                    RH_ERROR(this->_baseLog, "Skipping instantiation of '" << iter->second->getName()
+                             << "': composite parent '" << parentId << "' did not register within "
+                             << DEVICE_REGISTRATION_TIMEOUT << " seconds");
+                    iter = deferred.erase(iter);
+                    continue;
+                }
+                next = std::min(next, deadline);
+                ++iter;
+            }
+
+            // Sleep until a parent registers or the earliest deadline passes
+            if (ready.empty() && !deferred.empty()) {
+                waitForRegistrationChange(lock, next);
+            }
+        }
+
+        // Launch outside of the lock, so that devices can register meanwhile
+        for (DeploymentList::iterator iter = ready.begin(); iter != ready.end(); ++iter) {
+            std::string compositeDeviceIOR;
+            findCompositeDeviceIOR(compositeDeviceIOR, componentPlacements, iter->first);
+            launchStandalonePlacement(*iter, compositeDeviceIOR, fs_servant);
+        }
+    }
+}
+
+/*
+ * Launch the devices that are deployed on a composite device (e.g., personas
+ * loaded into a programmable device).
+ */
+void DeviceManager_impl::launchCompositePlacement(
+        const Deployment&                          deployment,
+        const DeploymentList&                      standaloneComponentPlacements,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
+        FileSystem_impl*&                          fs_servant) {
+
+    const DevicePlacement &compPlacement = deployment.first;
+    local_spd::ProgramProfile *compProfile = deployment.second;
+    std::string compId("UT OHHH");
+    // get Device Manager implementation
+    const char* compositePartDeviceID = compPlacement.getCompositePartOfDeviceID();
+    const local_spd::ImplementationInfo *matchingImpl = compProfile->getSelectedImplementation();
+    const local_spd::ImplementationInfo *parentImpl=0;
+    
+    if ( compPlacement.instantiations.size() > 0 ) {
+        compId = compPlacement.instantiations[0].getID();
+    }
+    else {
+    RH_FATAL(this->_baseLog, "Missing Instantiaion for Placing Composite ParentCompId: " << compositePartDeviceID << " ProfileName : " << compProfile->getName() );
+    }
+
+    RH_INFO(this->_baseLog, "Placing Composite ParentCompId: " << compositePartDeviceID << " ProfileName : " << compProfile->getName() << " CompID " << compId );
+
+    bool foundCompositeDeployed = false;
+    DeploymentList::const_iterator cIter;
+    for (cIter =  standaloneComponentPlacements.begin();
+         cIter != standaloneComponentPlacements.end();
+         cIter++) {
+
+        const DevicePlacement &parentPlacement = cIter->first;
+        local_spd::ProgramProfile *parentProfile = cIter->second;
+
+        const std::vector<ComponentInstantiation> &parentInstantiations = parentPlacement.getInstantiations();
+        std::vector<ComponentInstantiation>::const_iterator compInstIter;
+        for (compInstIter = parentInstantiations.begin();
+             compInstIter != parentInstantiations.end();
+             compInstIter++) {
+
+            std::string parent_inst_id(compInstIter->getID());
+
+            if ( parent_inst_id == std::string(compositePartDeviceID)) {
+                parentImpl = parentProfile->getSelectedImplementation();
+		  
+                // make sure parent was deployed...
+                {
+                    SCOPED_LOCK(componentImplMapmutex);                        
+                    DeploymentList::iterator i=deployed_comps.begin();
+                    for ( ; i != deployed_comps.end(); i++ ) {
+                        const std::vector<ComponentInstantiation> &pinst = i->first.getInstantiations();
+                        std::vector<ComponentInstantiation>::const_iterator piter = pinst.begin();
+                        for ( ; piter != pinst.end(); piter++ ){ 
+                            std::string d_inst_id(piter->getID());
+                            if ( parent_inst_id == d_inst_id ) {
+                                foundCompositeDeployed = true;
+                            }
                         }
-                        usleep(100);
+
                     }
                 }
+                break;
+
+            }
+        }
+
+        if (foundCompositeDeployed == false) {
+            RH_ERROR(this->_baseLog,
+                      "Unable to locate ComppositeParent '" << compositePartDeviceID << " for '" << compositePartDeviceID << "'... Skipping instantiation of '" << compId );
+            continue;
+        }
+
+        if (matchingImpl == NULL) {
+            RH_ERROR(this->_baseLog,
+                      "Skipping instantiation of device '" << compId << "' - '" << compProfile->spd.getSoftPkgID() << "; "
+                      << "no available device implementations match device manager properties")
+                continue;
+        }
+
+        if (parentImpl == NULL) {
+            RH_ERROR(this->_baseLog,
+                      "Skipping instantiation of device '" << compId << "' - '" << compProfile->spd.getSoftPkgID() << "; "
+                      << "Composite parent has no matching implementations")
+                continue;
+        }
+
+        // store the matchedDeviceImpl's implementation ID in a map for use with "getComponentImplementationId"
+        if (!addDeviceImplProperties(compProfile, *matchingImpl)) {
+            RH_ERROR(this->_baseLog,"Skipping instantiation of device '" << compId << "' - '" << compProfile->spd.getSoftPkgID() << "'");
+            continue;
+        }
+
+        std::string compositeDeviceIOR;
+        if (!getCompositeDeviceIOR(compositeDeviceIOR,
+                                   componentPlacements,
+                                   compPlacement,
+                                   PARALLEL_STARTUP ? DEVICE_REGISTRATION_TIMEOUT : 0)) {
+            RH_ERROR(this->_baseLog, "Skipping instantiation of device '" << compId << "'; composite parent '"
+                     << compositePartDeviceID << "' did not register within " << DEVICE_REGISTRATION_TIMEOUT << " seconds");
+            continue;
+        }
+
+        std::vector<ComponentInstantiation>::const_iterator cpInstIter =compPlacement.instantiations.begin();
+
+        for (; cpInstIter != compPlacement.instantiations.end(); cpInstIter++) {
+
+            const ComponentInstantiation instantiation = *cpInstIter;
+
+            // setup profile with instantiation context
+            recordComponentInstantiationId(instantiation, matchingImpl->getId());
+            std::ostringstream identifier;
+            identifier << instantiation.getID() << ":" << node_dcd.getName();
+            //compProfile->setIdentifier( identifier.str().c_str(), instantiation.getID());
+            compProfile->setIdentifier( instantiation.getID(), instantiation.getID() );
+            compProfile->setNamingServiceName(instantiation.getFindByNamingServiceName());
+            compProfile->setUsageName(instantiation.getUsageName());
+            compProfile->setAffinity( instantiation.getAffinity() );
+            compProfile->setLoggingConfig( instantiation.getLoggingConfig() );
+
+            // Set Code file path
+            std::string codeFilePath;
+            if ( !getCodeFilePath(codeFilePath, *matchingImpl, compProfile->spd,fs_servant,false ) ) {
+                continue;
+            }
+
+            {
+                SCOPED_LOCK(componentImplMapmutex);
+                deployed_comps.push_back( deployment );
+            }
+
+            // Set ComponentType
+            std::string componentType = "SharedLibrary"; 
+            // Attempt to create the requested device or service
+            createDeviceThreadAndHandleExceptions(
+                                                  compPlacement,
+                                                  compProfile,
+                                                  componentType,
+                                                  codeFilePath,
+                                                  instantiation,
+                                                  compositeDeviceIOR );
+        }
+    }
+}
 
+/*
+ * Launch a group of devices that share the same composite parent, in order.
+ * During parallel startup, each parent's group is launched on its own thread,
+ * so that the load and execute calls to different parents overlap.
+ */
+void DeviceManager_impl::launchCompositePlacements(
+        const DeploymentList&                      compositePlacements,
+        const DeploymentList&                      standaloneComponentPlacements,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
+        FileSystem_impl*                           fs_servant) {
+
+    for (DeploymentList::const_iterator iter = compositePlacements.begin(); iter != compositePlacements.end(); ++iter) {
+        try {
+            launchCompositePlacement(*iter, standaloneComponentPlacements, componentPlacements, fs_servant);
+        } catch ( ... ) {
+            RH_ERROR(this->_baseLog, "Unable to launch '" << iter->second->getName() << "' on composite parent '"
+                     << iter->first.getCompositePartOfDeviceID() << "'");
+        }
+    }
+}
+
+/*
+ * Return the time at which the pending device or service with the given
+ * identifier was launched, or not_a_date_time if it is not pending.
+ */
+boost::system_time DeviceManager_impl::getLaunchTime(const std::string& identifier)
+{
+    boost::recursive_mutex::scoped_lock lock(registeredDevicesmutex);
+    for (DeviceList::iterator device = _pendingDevices.begin(); device != _pendingDevices.end(); ++device) {
+        if ((*device)->identifier == identifier) {
+            return (*device)->launchTime;
+        }
+    }
+    for (ServiceList::iterator service = _pendingServices.begin(); service != _pendingServices.end(); ++service) {
+        if ((*service)->identifier == identifier) {
+            return (*service)->launchTime;
+        }
+    }
+    return boost::system_time();
+}
+
+/*
+ * Return the time at which a registration that began at start times out. A
+ * timeout of 0 (or less) waits forever.
+ */
+boost::system_time DeviceManager_impl::getRegistrationDeadline(const boost::system_time& start, float timeout)
+{
+    if (timeout <= 0) {
+        return boost::system_time(boost::posix_time::pos_infin);
+    }
+    return start + boost::posix_time::microseconds(static_cast<long>(timeout * 1e6));
+}
+
+/*
+ * Wait, with registeredDevicesmutex held, until a device or service registers
+ * or the DeviceManager shuts down. Returns false if the deadline passed or the
+ * DeviceManager is shutting down.
+ */
+bool DeviceManager_impl::waitForRegistrationChange(boost::recursive_mutex::scoped_lock& lock, const boost::system_time& deadline)
+{
+    if ((_adminState == DEVMGR_SHUTTING_DOWN) || (_adminState == DEVMGR_SHUTDOWN)) {
+        return false;
+    }
+    if (deadline.is_pos_infinity()) {
+        registrationChanged.wait(lock);
+    } else if (!registrationChanged.timed_wait(lock, deadline)) {
+        return false;
+    }
+    return (_adminState != DEVMGR_SHUTTING_DOWN) && (_adminState != DEVMGR_SHUTDOWN);
+}
+
+/*
+ * Wait for all of the devices and services launched during parallel startup
+ * to register, giving each one DEVICE_REGISTRATION_TIMEOUT seconds from its
+ * launch (0 waits forever). Nodes that time out remain pending, and may still
+ * register later.
+ */
+void DeviceManager_impl::waitForRegistrations()
+{
+    const boost::system_time start = boost::get_system_time();
+    std::set<std::string> timedOut;
+
+    boost::recursive_mutex::scoped_lock lock(registeredDevicesmutex);
+    while ((_adminState != DEVMGR_SHUTTING_DOWN) && (_adminState != DEVMGR_SHUTDOWN)) {
+        const boost::system_time now = boost::get_system_time();
+        boost::system_time next(boost::posix_time::pos_infin);
+        size_t waiting = 0;
+        for (DeviceList::iterator device = _pendingDevices.begin(); device != _pendingDevices.end(); ++device) {
+            if ((*device)->launchTime.is_not_a_date_time() || timedOut.count((*device)->identifier)) {
+                continue;
+            }
+            const boost::system_time deadline = getRegistrationDeadline((*device)->launchTime, DEVICE_REGISTRATION_TIMEOUT);
+            if (now >= deadline) {
+                RH_WARN(this->_baseLog, "Device '" << (*device)->label << "' did not register within "
+                        << DEVICE_REGISTRATION_TIMEOUT << " seconds");
+                timedOut.insert((*device)->identifier);
+            } else {
+                next = std::min(next, deadline);
+                ++waiting;
             }
         }
+        for (ServiceList::iterator service = _pendingServices.begin(); service != _pendingServices.end(); ++service) {
+            if ((*service)->launchTime.is_not_a_date_time() || timedOut.count((*service)->identifier)) {
+                continue;
+            }
+            const boost::system_time deadline = getRegistrationDeadline((*service)->launchTime, DEVICE_REGISTRATION_TIMEOUT);
+            if (now >= deadline) {
+                RH_WARN(this->_baseLog, "Service '" << (*service)->label << "' did not register within "
+                        << DEVICE_REGISTRATION_TIMEOUT << " seconds");
+                timedOut.insert((*service)->identifier);
+            } else {
+                next = std::min(next, deadline);
+                ++waiting;
+            }
+        }
+        if (waiting == 0) {
+            break;
+        }
+        waitForRegistrationChange(lock, next);
     }
+
+    RH_INFO(this->_baseLog, "Parallel startup finished in " << (boost::get_system_time() - start).total_milliseconds()
+            << " ms; " << timedOut.size() << " device(s)/service(s) did not register in time");
 }
 
 CF::Properties DeviceManager_impl::getResourceOptions( const ossie::ComponentInstantiation& instantiation ){
@@ -1123,217 +1565,70 @@ void DeviceManager_impl::postConstructor (
 
     ////////////////////////////////////////////////////////////////////////////
     // Iterate and launch all non-deployOnDevice compPlacements
+    //
+    // In parallel startup mode, devices that are part of a composite device
+    // whose parent has not yet registered are set aside, so that the rest of
+    // the node can be launched without waiting on the parent.
+    DeploymentList deferredComponentPlacements;
     DeploymentList::const_iterator cIter;
     for (cIter =  standaloneComponentPlacements.begin();
          cIter != standaloneComponentPlacements.end();
          cIter++) {
-      
-      const DevicePlacement &compPlacement = cIter->first;
-      local_spd::ProgramProfile *compProfile = cIter->second;
-      const local_spd::ImplementationInfo *matchingImpl = compProfile->getSelectedImplementation();
-      std::string compId(compPlacement.instantiations[0].getID());
-      RH_INFO(this->_baseLog, "Placing Component CompId: " << compId << " ProfileName : " << compProfile->getName() );
-
-      // should not happen
-      if (!matchingImpl) continue;
-
-      ossie::Properties deviceProperties;
-      if (!addDeviceImplProperties( compProfile, *matchingImpl )) {
-	RH_INFO(this->_baseLog, "Skipping instantiation of device '" << compProfile->getInstantiationIdentifier() << 
-		 ", failed to merge properties ");
-	continue;
-      }
 
       std::string compositeDeviceIOR;
-      getCompositeDeviceIOR(compositeDeviceIOR, 
-			    componentPlacements, 
-			    compPlacement);
-
-      std::vector<ComponentInstantiation>::const_iterator cpInstIter;
-      for (cpInstIter =  compPlacement.getInstantiations().begin(); 
-	   cpInstIter != compPlacement.getInstantiations().end(); 
-	   cpInstIter++) {
-
-	const ComponentInstantiation instantiation = *cpInstIter;
-	RH_TRACE(this->_baseLog, "Placing component id: " << instantiation.getID());
-
-        // setup profile with instantiation context
-        recordComponentInstantiationId(instantiation, matchingImpl->getId());
-        std::ostringstream identifier;
-        identifier << instantiation.getID() << ":" << node_dcd.getName();
-        compProfile->setIdentifier( instantiation.getID(), instantiation.getID());
-        compProfile->setNamingServiceName(instantiation.getFindByNamingServiceName());
-        compProfile->setUsageName(instantiation.getUsageName());
-        compProfile->setAffinity( instantiation.getAffinity() );
-        compProfile->setLoggingConfig( instantiation.getLoggingConfig() );
-
-	//spawn device
-	std::string codeFilePath;
-	if (!getCodeFilePath(codeFilePath,
-			     *matchingImpl,
-			     compProfile->spd,
-			     fs_servant)) {
-	  continue;
-	}
-
-	std::string componentType;
-	if (!getDeviceOrService(componentType, compProfile )) {
-	  // We got a type other than "device" or "service"
-	  continue;
-	}
-
-	// add to list of deployed resources
-        {
-            SCOPED_LOCK(componentImplMapmutex);
-            deployed_comps.push_back( *cIter );
-	}
-        // Attempt to create the requested device or service
-        createDeviceThreadAndHandleExceptions(compPlacement,
-					      compProfile,
-					      componentType,
-					      codeFilePath,
-					      instantiation,
-					      compositeDeviceIOR );
+      if (PARALLEL_STARTUP) {
+          if (!findCompositeDeviceIOR(compositeDeviceIOR, componentPlacements, cIter->first)) {
+              RH_DEBUG(this->_baseLog, "Deferring launch of '" << cIter->second->getName() << "' until composite parent '"
+                       << cIter->first.getCompositePartOfDeviceID() << "' registers");
+              deferredComponentPlacements.push_back(*cIter);
+              continue;
+          }
+      } else {
+          getCompositeDeviceIOR(compositeDeviceIOR, componentPlacements, cIter->first);
       }
+      launchStandalonePlacement(*cIter, compositeDeviceIOR, fs_servant);
+    }
+
+    if (!deferredComponentPlacements.empty()) {
+        launchDeferredPlacements(deferredComponentPlacements, componentPlacements, fs_servant);
     }
 
     ////////////////////////////////////////////////////////////////////////////
     // Iterate and launch all deployOnDevice compPlacements
-    DeploymentList::const_iterator compPlaceIter;
-    for (compPlaceIter =  compositePartDeviceComponentPlacements.begin();
-         compPlaceIter != compositePartDeviceComponentPlacements.end();
-         compPlaceIter++) {
-
-      const DevicePlacement &compPlacement = compPlaceIter->first;
-      local_spd::ProgramProfile *compProfile = compPlaceIter->second;
-      std::string compId("UT OHHH");
-      // get Device Manager implementation
-      const char* compositePartDeviceID = compPlacement.getCompositePartOfDeviceID();
-      const local_spd::ImplementationInfo *matchingImpl = compProfile->getSelectedImplementation();
-      const local_spd::ImplementationInfo *parentImpl=0;
-      
-      if ( compPlacement.instantiations.size() > 0 ) {
-          compId = compPlacement.instantiations[0].getID();
-      }
-      else {
-      RH_FATAL(this->_baseLog, "Missing Instantiaion for Placing Composite ParentCompId: " << compositePartDeviceID << " ProfileName : " << compProfile->getName() );
-      }
-
-      RH_INFO(this->_baseLog, "Placing Composite ParentCompId: " << compositePartDeviceID << " ProfileName : " << compProfile->getName() << " CompID " << compId );
-
-        bool foundCompositeDeployed = false;
-        for (cIter =  standaloneComponentPlacements.begin();
-             cIter != standaloneComponentPlacements.end();
-             cIter++) {
-
-            const DevicePlacement &parentPlacement = cIter->first;
-            local_spd::ProgramProfile *parentProfile = cIter->second;
-
-            const std::vector<ComponentInstantiation> &parentInstantiations = parentPlacement.getInstantiations();
-            std::vector<ComponentInstantiation>::const_iterator compInstIter;
-            for (compInstIter = parentInstantiations.begin();
-                 compInstIter != parentInstantiations.end();
-                 compInstIter++) {
-
-                std::string parent_inst_id(compInstIter->getID());
-
-                if ( parent_inst_id == std::string(compositePartDeviceID)) {
-                    parentImpl = parentProfile->getSelectedImplementation();
-		  
-                    // make sure parent was deployed...
-                    {
-                        SCOPED_LOCK(componentImplMapmutex);                        
-                        DeploymentList::iterator i=deployed_comps.begin();
-                        for ( ; i != deployed_comps.end(); i++ ) {
-                            const std::vector<ComponentInstantiation> &pinst = i->first.getInstantiations();
-                            std::vector<ComponentInstantiation>::const_iterator piter = pinst.begin();
-                            for ( ; piter != pinst.end(); piter++ ){ 
-                                std::string d_inst_id(piter->getID());
-                                if ( parent_inst_id == d_inst_id ) {
-                                    foundCompositeDeployed = true;
-                                }
-                            }
-
-                        }
-                    }
-                    break;
-
-                }
-            }
-
-            if (foundCompositeDeployed == false) {
-                RH_ERROR(this->_baseLog,
-                          "Unable to locate ComppositeParent '" << compositePartDeviceID << " for '" << compositePartDeviceID << "'... Skipping instantiation of '" << compId );
-                continue;
-            }
-
-            if (matchingImpl == NULL) {
-                RH_ERROR(this->_baseLog,
-                          "Skipping instantiation of device '" << compId << "' - '" << compProfile->spd.getSoftPkgID() << "; "
-                          << "no available device implementations match device manager properties")
-                    continue;
-            }
-
-            if (parentImpl == NULL) {
-                RH_ERROR(this->_baseLog,
-                          "Skipping instantiation of device '" << compId << "' - '" << compProfile->spd.getSoftPkgID() << "; "
-                          << "Composite parent has no matching implementations")
-                    continue;
-            }
-
-            // store the matchedDeviceImpl's implementation ID in a map for use with "getComponentImplementationId"
-            if (!addDeviceImplProperties(compProfile, *matchingImpl)) {
-                RH_ERROR(this->_baseLog,"Skipping instantiation of device '" << compId << "' - '" << compProfile->spd.getSoftPkgID() << "'");
-                continue;
-            }
-
-            std::string compositeDeviceIOR;
-            getCompositeDeviceIOR(compositeDeviceIOR,
-                                  componentPlacements,
-                                  compPlacement);
-
-            std::vector<ComponentInstantiation>::const_iterator cpInstIter =compPlacement.instantiations.begin();
-
-            for (; cpInstIter != compPlacement.instantiations.end(); cpInstIter++) {
-
-                const ComponentInstantiation instantiation = *cpInstIter;
-
-                // setup profile with instantiation context
-                recordComponentInstantiationId(instantiation, matchingImpl->getId());
-                std::ostringstream identifier;
-                identifier << instantiation.getID() << ":" << node_dcd.getName();
-                //compProfile->setIdentifier( identifier.str().c_str(), instantiation.getID());
-                compProfile->setIdentifier( instantiation.getID(), instantiation.getID() );
-                compProfile->setNamingServiceName(instantiation.getFindByNamingServiceName());
-                compProfile->setUsageName(instantiation.getUsageName());
-                compProfile->setAffinity( instantiation.getAffinity() );
-                compProfile->setLoggingConfig( instantiation.getLoggingConfig() );
-
-                // Set Code file path
-                std::string codeFilePath;
-                if ( !getCodeFilePath(codeFilePath, *matchingImpl, compProfile->spd,fs_servant,false ) ) {
-                    continue;
-                }
-
-                {
-                    SCOPED_LOCK(componentImplMapmutex);
-                    deployed_comps.push_back( *compPlaceIter );
-                }
-
-                // Set ComponentType
-                std::string componentType = "SharedLibrary"; 
-                // Attempt to create the requested device or service
-                createDeviceThreadAndHandleExceptions(
-                                                      compPlacement,
-                                                      compProfile,
-                                                      componentType,
-                                                      codeFilePath,
-                                                      instantiation,
-                                                      compositeDeviceIOR );
-            }
+    //
+    // In parallel startup mode, the devices for each composite parent are
+    // launched on a separate thread, each waiting for its own parent.
+    if (PARALLEL_STARTUP) {
+        std::map<std::string, DeploymentList> parentPlacements;
+        DeploymentList::const_iterator compPlaceIter;
+        for (compPlaceIter =  compositePartDeviceComponentPlacements.begin();
+             compPlaceIter != compositePartDeviceComponentPlacements.end();
+             compPlaceIter++) {
+            parentPlacements[compPlaceIter->first.getCompositePartOfDeviceID()].push_back(*compPlaceIter);
+        }
+
+        boost::thread_group launchers;
+        std::map<std::string, DeploymentList>::const_iterator parent;
+        for (parent = parentPlacements.begin(); parent != parentPlacements.end(); ++parent) {
+            launchers.create_thread(boost::bind(&DeviceManager_impl::launchCompositePlacements, this,
+                                                boost::cref(parent->second),
+                                                boost::cref(standaloneComponentPlacements),
+                                                boost::cref(componentPlacements),
+                                                fs_servant));
+        }
+        launchers.join_all();
+    } else {
+        DeploymentList::const_iterator compPlaceIter;
+        for (compPlaceIter =  compositePartDeviceComponentPlacements.begin();
+             compPlaceIter != compositePartDeviceComponentPlacements.end();
+             compPlaceIter++) {
+            launchCompositePlacement(*compPlaceIter, standaloneComponentPlacements, componentPlacements, fs_servant);
         }
     }
 
+    if (PARALLEL_STARTUP) {
+        waitForRegistrations();
+    }
 
    if ( _spdFile.empty() ) return;
 
@@ -2035,6 +2330,11 @@ throw (CORBA::SystemException)
     }
 
   _adminState = DEVMGR_SHUTTING_DOWN;
+    {
+        // Wake up any launches that are waiting on a registration
+        boost::recursive_mutex::scoped_lock lock(registeredDevicesmutex);
+        registrationChanged.notify_all();
+    }
 
     stopOrder();
 
@@ -2675,6 +2975,11 @@ void DeviceManager_impl::increment_registeredServices(CORBA::Object_ptr register
         serviceNode->pid = 0;
     }
 
+    if (!serviceNode->launchTime.is_not_a_date_time()) {
+        RH_INFO(this->_baseLog, "Service " << name << " registered "
+                << (boost::get_system_time() - serviceNode->launchTime).total_milliseconds() << " ms after launch");
+    }
+
     //The registerService operation shall add the input registeringService to the DeviceManagers
     //registeredServices attribute when the input registeringService does not already exist in the
     //registeredServices attribute. The registeringService is ignored when duplicated.
@@ -2683,6 +2988,7 @@ void DeviceManager_impl::increment_registeredServices(CORBA::Object_ptr register
     serviceNode->service = CORBA::Object::_duplicate(registeringService);
 
     _registeredServices.push_back(serviceNode);
+    registrationChanged.notify_all();
 }
 
 /*
@@ -2715,6 +3021,11 @@ void DeviceManager_impl::increment_registeredDevices(CF::Device_ptr registeringD
         deviceNode->pid = 0;
     }
 
+    if (!deviceNode->launchTime.is_not_a_date_time()) {
+        RH_INFO(this->_baseLog, "Device " << identifier << " registered "
+                << (boost::get_system_time() - deviceNode->launchTime).total_milliseconds() << " ms after launch");
+    }
+
     // Fill in the device node fields that were not known at launch time (label has probably
     // not changed, but we consider the device authoritative).
     deviceNode->label = ossie::corba::returnString(registeringDevice->label());
@@ -2722,6 +3033,7 @@ void DeviceManager_impl::increment_registeredDevices(CF::Device_ptr registeringD
     deviceNode->device = CF::Device::_duplicate(registeringDevice);
 
     _registeredDevices.push_back(deviceNode);
+    registrationChanged.notify_all();
 }
 
 /*
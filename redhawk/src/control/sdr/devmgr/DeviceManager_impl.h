@@ -26,6 +26,7 @@
 #include <map>
 
 #include <boost/thread/recursive_mutex.hpp>
+#include <boost/thread/thread_time.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <ossie/ComponentDescriptor.h>
@@ -152,6 +153,7 @@ private:
         CF::Device_var device;
         pid_t pid;
         bool started;
+        boost::system_time launchTime;
 
     DeviceNode():
       identifier(""),
@@ -159,7 +161,8 @@ private:
         IOR(""),
         device(CF::Device::_nil()),
         pid(0),
-        started(false)
+        started(false),
+        launchTime()
       {};
     };
 
@@ -170,13 +173,15 @@ private:
         CORBA::Object_var service;
         pid_t pid;
         bool started;
+        boost::system_time launchTime;
     ServiceNode():
       identifier(""),
         label(""),
         IOR(""),
         service(CORBA::Object::_nil()),
         pid(0),
-        started(false)
+        started(false),
+        launchTime()
       {};      
     };
     
@@ -207,6 +212,8 @@ private:
     float           DEVICE_FORCE_QUIT_TIME;
     CORBA::ULong    CLIENT_WAIT_TIME;
     float           DOMAIN_REFRESH;
+    bool            PARALLEL_STARTUP;
+    float           DEVICE_REGISTRATION_TIMEOUT;
     
     // read only attributes
     struct utsname _uname;
@@ -273,11 +280,47 @@ private:
     void registerDeviceManagerWithDomainManager(
         CF::DeviceManager_var& my_object_var);
 
-    void getCompositeDeviceIOR(
+    bool getCompositeDeviceIOR(
         std::string&                               compositeDeviceIOR, 
         const std::vector<ossie::DevicePlacement>& componentPlacements,
+        const ossie::DevicePlacement&              componentPlacementInst,
+        float                                      timeout=0);
+
+    bool findCompositeDeviceIOR(
+        std::string&                               compositeDeviceIOR,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
         const ossie::DevicePlacement&              componentPlacementInst);
 
+    void launchStandalonePlacement(
+        const Deployment&                          deployment,
+        const std::string&                         compositeDeviceIOR,
+        FileSystem_impl*&                          fs_servant);
+
+    void launchDeferredPlacements(
+        DeploymentList&                            deferred,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
+        FileSystem_impl*&                          fs_servant);
+
+    void launchCompositePlacement(
+        const Deployment&                          deployment,
+        const DeploymentList&                      standaloneComponentPlacements,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
+        FileSystem_impl*&                          fs_servant);
+
+    void launchCompositePlacements(
+        const DeploymentList&                      compositePlacements,
+        const DeploymentList&                      standaloneComponentPlacements,
+        const std::vector<ossie::DevicePlacement>& componentPlacements,
+        FileSystem_impl*                           fs_servant);
+
+    boost::system_time getLaunchTime(const std::string& identifier);
+
+    boost::system_time getRegistrationDeadline(const boost::system_time& start, float timeout);
+
+    bool waitForRegistrationChange(boost::recursive_mutex::scoped_lock& lock, const boost::system_time& deadline);
+
+    void waitForRegistrations();
+
     bool addDeviceImplProperties (
         local_spd::ProgramProfile *compProfile,
         const local_spd::ImplementationInfo& deviceImpl );
@@ -376,6 +419,8 @@ private:
     // this mutex is used for synchronizing _registeredDevices, _pendingDevices, and _registeredServices
     boost::recursive_mutex registeredDevicesmutex;
     boost::condition_variable_any pendingDevicesEmpty;
+    // signalled when a device or service registers, or on shutdown
+    boost::condition_variable_any registrationChanged;
     void increment_registeredDevices(CF::Device_ptr registeringDevice);
     void increment_registeredServices(CORBA::Object_ptr registeringService, 
                                       const char* name);
@@ -422,6 +467,10 @@ private:
     DeploymentList                     deployed_comps;
     PackageMods                        sharedPkgs;
 
+    // this mutex is used for serializing the process-wide state (environment,
+    // working directory, sharedPkgs) modified while launching a device
+    boost::mutex                       launchMutex;
+
     
     // DeviceManager context... 
     ossie::DeviceManagerConfiguration          node_dcd;
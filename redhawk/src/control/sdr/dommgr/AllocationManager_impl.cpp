@@ -296,7 +296,7 @@ bool AllocationManager_impl::allocateDevice(const CF::Properties& requestedPrope
                                             const std::vector<ossie::SPD::NameVersionPair>& osDeps,
                                             const CF::Properties& devicerequires)
 {
-    if (!ossie::corba::objectExists(node.device)) {
+    if (!_domainManager->objectExists(node.device)) {
         RH_WARN(_allocMgrLog, "Not using device for uses_device allocation " << node.identifier << " because it no longer exists");
         return false;
     }
@@ -815,7 +815,7 @@ bool AllocationManager_impl::deallocateLocal(const std::string& allocationID)
     partitionProperties(localAlloc.allocationProperties, allocations);
     RH_TRACE(_allocMgrLog, "Deallocating " << localAlloc.allocationProperties.length()
               << " properties (" << allocations.size() << " calls) for local allocation " << allocationID);
-    if (!ossie::corba::objectExists(localAlloc.allocatedDevice)) {
+    if (!_domainManager->objectExists(localAlloc.allocatedDevice)) {
         RH_WARN(_allocMgrLog, "Not deallocating capacity a device because it no longer exists");
     } else {
         bool warned = false;
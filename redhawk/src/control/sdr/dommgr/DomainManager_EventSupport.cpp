@@ -30,6 +30,12 @@
 
 using namespace ossie;
 
+namespace {
+  // Limits for the ODM channel's asynchronous publisher
+  const size_t ODM_EVENT_QUEUE_DEPTH = 10000;
+  const size_t ODM_EVENT_BATCH_SIZE = 32;
+}
+
 
 //
 //  A Publisher Interface for Domain Event Channels
@@ -204,6 +210,22 @@ void DomainManager_impl::idmTerminationMessages(const redhawk::events::Component
 }
 
 
+//
+//  Apply the ASYNC_EVENTS setting to the ODM Channel publisher
+//
+void DomainManager_impl::_configureODMPublisher() {
+  if ( !_odm_publisher ) return;
+
+  if ( asyncEvents ) {
+    // Send domain events from a background thread so that a slow event
+    // service does not hold up deployment and teardown
+    _odm_publisher->setAsync( ODM_EVENT_QUEUE_DEPTH, ODM_EVENT_BATCH_SIZE );
+  } else {
+    _odm_publisher->setAsync( 0 );
+  }
+}
+
+
 void DomainManager_impl::establishDomainManagementChannels( const std::string &dburi ) {
 
     // Create Outgoing Domain Management (ODM) event channel
@@ -229,6 +251,7 @@ void DomainManager_impl::establishDomainManagementChannels( const std::string &d
         cname = redhawk::events::ODM_Channel_Spec;
         _odm_publisher =  publisher( cname );
         if ( _odm_publisher ) {
+          _configureODMPublisher();
           RH_INFO(this->_baseLog, "Domain Channel: " << cname << " created.");
         }
         else {
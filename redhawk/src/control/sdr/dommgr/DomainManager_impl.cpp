@@ -85,7 +85,8 @@ DomainManager_impl::DomainManager_impl (const char* dmdFile, const char* _rootpa
   _useLogConfigUriResolver(useLogCfgResolver),
   _strict_spd_validation(false),
   _initialLogLevel(initialLogLevel),
-  _bindToDomain(bindToDomain)
+  _bindToDomain(bindToDomain),
+  _livenessCache(0)
 {
     std::string std_logconfig_uri;
     if (_logconfig_uri) {
@@ -114,6 +115,14 @@ DomainManager_impl::DomainManager_impl (const char* dmdFile, const char* _rootpa
     addProperty(componentBindingTimeout, 60, "COMPONENT_BINDING_TIMEOUT", "component_binding_timeout",
                 "readwrite", "seconds", "external", "configure");
 
+    addProperty(objectLivenessTTL, 0, "OBJECT_LIVENESS_TTL", "object_liveness_ttl",
+                "readwrite", "seconds", "external", "configure");
+    addPropertyListener(objectLivenessTTL, this, &DomainManager_impl::objectLivenessTTLChanged);
+
+    addProperty(asyncEvents, false, "ASYNC_EVENTS", "async_events",
+                "readwrite", "", "external", "configure");
+    addPropertyListener(asyncEvents, this, &DomainManager_impl::asyncEventsChanged);
+
     addProperty(redhawk_version, VERSION, "REDHAWK_VERSION", "redhawk_version",
                 "readonly", "", "external", "configure");
     
@@ -215,6 +224,10 @@ DomainManager_impl::DomainManager_impl (const char* dmdFile, const char* _rootpa
 
 // \todo lookup and install any services specified in the DMD
 
+    // Keep the status of registered objects fresh in the background
+    _livenessCache.setLogger(_baseLog->getChildLogger("LivenessCache", ""));
+    _livenessCache.start();
+
     RH_TRACE(this->_baseLog, "Looking for ApplicationFactories POA");
     appFact_poa = poa->find_POA("ApplicationFactories", 1);
 
@@ -292,7 +305,7 @@ void DomainManager_impl::restoreEventChannels(const std::string& _db_uri) {
          ++i) {
         RH_TRACE(this->_baseLog, "Attempting to recover connection to Event Channel " << i->boundName);
         try {
-            if (ossie::corba::objectExists(i->channel)) {
+            if (objectExists(i->channel)) {
                 RH_INFO(this->_baseLog, "Recovered connection to Event Channel: " << i->boundName);
                 
                 // try to restore channel with event channel manager..
@@ -373,7 +386,7 @@ void DomainManager_impl::restoreState(const std::string& _db_uri) {
     for (DeviceManagerList::iterator ii = _restoredDeviceManagers.begin(); ii != _restoredDeviceManagers.end(); ++ii) {
         RH_TRACE(this->_baseLog, "Attempting to recover connection to Device Manager " << ii->identifier << " " << ii->label);
         try {
-            if (ossie::corba::objectExists(ii->deviceManager)) {
+            if (objectExists(ii->deviceManager)) {
                 RH_INFO(this->_baseLog, "Recovered connection to Device Manager: " << ii->identifier << " " << ii->label);
                 addDeviceMgr(ii->deviceManager);
                 mountDeviceMgrFileSys(ii->deviceManager);
@@ -396,9 +409,9 @@ void DomainManager_impl::restoreState(const std::string& _db_uri) {
         boost::shared_ptr<DeviceNode> i = *iter;
         RH_TRACE(this->_baseLog, "Attempting to recover connection to Device " << i->identifier << " " << i->label);
         try {
-            if (ossie::corba::objectExists(i->device)) {
+            if (objectExists(i->device)) {
                 RH_INFO(this->_baseLog, "Recovered connection to Device: " << i->identifier << " " << i->label);
-                if (ossie::corba::objectExists(i->devMgr.deviceManager)) {
+                if (objectExists(i->devMgr.deviceManager)) {
                     storeDeviceInDomainMgr(i->device, i->devMgr.deviceManager);
                 } else {
                     RH_WARN(this->_baseLog, "Failed to recover connection to Device: " << i->identifier << ": device manager no longer exists");
@@ -421,7 +434,7 @@ void DomainManager_impl::restoreState(const std::string& _db_uri) {
     for (ServiceList::iterator ii = _restoredServices.begin(); ii != _restoredServices.end(); ++ii) {
         RH_TRACE(this->_baseLog, "Attempting to recover connection to Service " << ii->name);
         try {
-            if (ossie::corba::objectExists(ii->service)) {
+            if (objectExists(ii->service)) {
                 RH_INFO(this->_baseLog, "Recovered connection to Service: " << ii->name);
                 ossie::DeviceManagerList::iterator deviceManager = findDeviceManagerById(ii->deviceManagerId);
                 if (deviceManager != _registeredDeviceManagers.end()) {
@@ -538,6 +551,9 @@ void DomainManager_impl::restoreState(const std::string& _db_uri) {
     }
     _allocationMgr->restoreRemoteAllocations(_restoredRemoteAllocations);
 
+    // Objects that could not be recovered do not need to be tracked
+    _livenessCache.removeDead();
+
     RH_DEBUG(this->_baseLog, "Done restoring state from URL " << _db_uri);
 }
 
@@ -666,6 +682,7 @@ void DomainManager_impl::shutdown (int signal)
     }
 
     ossie::GCThread::shutdown();
+    _livenessCache.stop();
 
     boost::recursive_mutex::scoped_lock lock(stateAccess);
     db.close();
@@ -743,6 +760,18 @@ uint32_t  DomainManager_impl::getServiceWaitTime() {
     return client_wait_times.services;
 }
 
+bool DomainManager_impl::objectExists(CORBA::Object_ptr obj) {
+    return _livenessCache.exists(obj);
+}
+
+void DomainManager_impl::objectLivenessTTLChanged(float oldValue, float newValue) {
+    _livenessCache.setTimeToLive(newValue);
+}
+
+void DomainManager_impl::asyncEventsChanged(bool oldValue, bool newValue) {
+    _configureODMPublisher();
+}
+
 char *
 DomainManager_impl::identifier (void)
 throw (CORBA::SystemException)
@@ -1002,7 +1031,7 @@ void DomainManager_impl::_local_registerDeviceManager (CF::DeviceManager_ptr dev
 
     DeviceManagerList::iterator node = findDeviceManagerById(identifier);
     if (node != _registeredDeviceManagers.end()) {
-        if (!ossie::corba::objectExists(node->deviceManager)) {
+        if (!_livenessCache.refresh(node->deviceManager)) {
             RH_WARN(this->_baseLog, "Cleaning up registration of dead device manager: " << identifier);
             catastrophicUnregisterDeviceManager(node);
             RH_TRACE(this->_baseLog, "Continuing with registration of new device manager: " << identifier);
@@ -1117,6 +1146,7 @@ DomainManager_impl::addDeviceMgr (CF::DeviceManager_ptr deviceMgr)
         catch(...){
         }
         _registeredDeviceManagers.push_back(tmp_devMgr);
+        _livenessCache.markAlive(deviceMgr);
 
         try {
             db.store("DEVICE_MANAGERS", _registeredDeviceManagers);
@@ -1273,6 +1303,7 @@ ossie::DeviceManagerList::iterator DomainManager_impl::removeDeviceManager (ossi
     // is reachable or not. Therefore, no CORBA calls can be made.
     boost::recursive_mutex::scoped_lock lock(stateAccess);
 
+    _livenessCache.remove(deviceManager->deviceManager);
     deviceManager = _registeredDeviceManagers.erase(deviceManager);
     try {
         db.store("DEVICE_MANAGERS", _registeredDeviceManagers);
@@ -1323,7 +1354,7 @@ void DomainManager_impl::_local_registerDevice (CF::Device_ptr registeringDevice
     DeviceList::iterator deviceNode = findDeviceById(devId);
     if (deviceNode != _registeredDevices.end()) {
         RH_TRACE(this->_baseLog, "Device <" << devId << "> already registered; checking existence");
-        if (!ossie::corba::objectExists((*deviceNode)->device)) {
+        if (!_livenessCache.refresh((*deviceNode)->device)) {
             RH_WARN(this->_baseLog, "Cleaning up registration; device <" << devId << "> is registered and no longer exists");
             try {
                 _local_unregisterDevice(deviceNode);
@@ -1400,6 +1431,7 @@ void DomainManager_impl::storeDeviceInDomainMgr (CF::Device_ptr registeringDevic
     parseDeviceProfile(*newDeviceNode);
 
     _registeredDevices.push_back (newDeviceNode);
+    _livenessCache.markAlive(registeringDevice);
 
     try {
         db.store("DEVICES", _registeredDevices);
@@ -1437,6 +1469,7 @@ DomainManager_impl::storeServiceInDomainMgr (CORBA::Object_ptr registeringServic
 
     // Add service to registered list, updating changes in the persistence store.
     _registeredServices.push_back(node);
+    _livenessCache.markAlive(registeringService);
     try {
         db.store("SERVICES", _registeredServices);
     } catch (const ossie::PersistenceException& ex) {
@@ -1504,6 +1537,7 @@ ossie::DeviceList::iterator DomainManager_impl::_local_unregisterDevice (ossie::
     sendRemoveEvent(_identifier, (*deviceNode)->identifier, (*deviceNode)->label, StandardEvent::DEVICE);
 
     // Remove the device from the internal list.
+    _livenessCache.remove((*deviceNode)->device);
     deviceNode = _registeredDevices.erase(deviceNode);
 
     // Write the updated device list to the persistence store.
@@ -2247,6 +2281,7 @@ ossie::ServiceList::iterator DomainManager_impl::_local_unregisterService(ossie:
     }
 
     // Remove the service from the internal list.
+    _livenessCache.remove(service->service);
     service = _registeredServices.erase(service);
 
     if (!_applications.empty()) {
@@ -48,6 +48,7 @@
 #include "EventChannelManager.h"
 #include "struct_props.h"
 #include "struct_props.h"
+#include "LivenessCache.h"
 
 #include "../../parser/internal/dcd-pimpl.h"
 
@@ -259,6 +260,10 @@ public:
     uint32_t  getManagerWaitTime();
     uint32_t  getDeviceWaitTime();
     uint32_t  getServiceWaitTime();
+
+    // Returns whether a domain object exists, using the liveness cache so
+    // that hot paths do not block on unreachable objects
+    bool objectExists(CORBA::Object_ptr obj);
     CF::LogLevel log_level();
     int getInitialLogLevel() {
         return _initialLogLevel;
@@ -392,6 +397,8 @@ private:
     std::string      logging_config_uri;
     StringProperty*  logging_config_prop;
     CORBA::ULong     componentBindingTimeout;
+    float            objectLivenessTTL;
+    bool             asyncEvents;
     std::string      redhawk_version;
     bool             _useLogConfigUriResolver;
     bool             _strict_spd_validation;
@@ -408,6 +415,11 @@ private:
 
     int _initialLogLevel;
     bool             _bindToDomain;
+
+    redhawk::LivenessCache _livenessCache;
+    void objectLivenessTTLChanged(float oldValue, float newValue);
+    void asyncEventsChanged(bool oldValue, bool newValue);
+    void _configureODMPublisher();
 };                                            /* END CLASS DEFINITION DomainManager */
 
 
@@ -0,0 +1,235 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file 
+ * distributed with this source distribution.
+ * 
+ * This file is part of REDHAWK core.
+ * 
+ * REDHAWK core is free software: you can redistribute it and/or modify it 
+ * under the terms of the GNU Lesser General Public License as published by the 
+ * Free Software Foundation, either version 3 of the License, or (at your 
+ * option) any later version.
+ * 
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT 
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License 
+ * for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License 
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <vector>
+
+#include "LivenessCache.h"
+
+using namespace redhawk;
+
+LivenessCache::LivenessCache(float ttl) :
+    _ttl(boost::posix_time::microseconds(static_cast<long>(ttl * 1e6))),
+    _thread(0),
+    _running(false),
+    _log(rh_logger::Logger::getLogger("LivenessCache"))
+{
+}
+
+LivenessCache::~LivenessCache()
+{
+    stop();
+}
+
+void LivenessCache::setLogger(rh_logger::LoggerPtr log)
+{
+    _log = log;
+}
+
+void LivenessCache::start()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    if (_thread) {
+        return;
+    }
+    _running = true;
+    _thread = new boost::thread(&LivenessCache::_run, this);
+}
+
+void LivenessCache::stop()
+{
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        if (!_thread) {
+            return;
+        }
+        _running = false;
+        _cond.notify_all();
+    }
+    _thread->join();
+    delete _thread;
+    _thread = 0;
+}
+
+void LivenessCache::setTimeToLive(float ttl)
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    _ttl = boost::posix_time::microseconds(static_cast<long>(ttl * 1e6));
+    _cond.notify_all();
+}
+
+bool LivenessCache::exists(CORBA::Object_ptr obj)
+{
+    if (CORBA::is_nil(obj)) {
+        return false;
+    }
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        if (_ttl <= boost::posix_time::time_duration()) {
+            // Caching is disabled
+            lock.unlock();
+            return ossie::corba::objectExists(obj);
+        }
+        EntryMap::iterator entry = _find(obj, _hash(obj));
+        if (entry != _entries.end()) {
+            // Only trust the cached status within the time-to-live; a stale
+            // status may hide an object that has since gone away
+            if ((boost::get_system_time() - entry->second.checked) < _ttl) {
+                return entry->second.alive;
+            }
+        }
+    }
+    bool alive = ossie::corba::objectExists(obj);
+    _store(obj, alive);
+    return alive;
+}
+
+bool LivenessCache::refresh(CORBA::Object_ptr obj)
+{
+    if (CORBA::is_nil(obj)) {
+        return false;
+    }
+    bool alive = ossie::corba::objectExists(obj);
+    _store(obj, alive);
+    return alive;
+}
+
+void LivenessCache::markAlive(CORBA::Object_ptr obj)
+{
+    if (CORBA::is_nil(obj)) {
+        return;
+    }
+    _store(obj, true);
+}
+
+void LivenessCache::remove(CORBA::Object_ptr obj)
+{
+    if (CORBA::is_nil(obj)) {
+        return;
+    }
+    boost::mutex::scoped_lock lock(_mutex);
+    EntryMap::iterator entry = _find(obj, _hash(obj));
+    if (entry != _entries.end()) {
+        _entries.erase(entry);
+    }
+}
+
+void LivenessCache::removeDead()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    EntryMap::iterator entry = _entries.begin();
+    while (entry != _entries.end()) {
+        if (!entry->second.alive) {
+            _entries.erase(entry++);
+        } else {
+            ++entry;
+        }
+    }
+}
+
+size_t LivenessCache::size()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    return _entries.size();
+}
+
+CORBA::ULong LivenessCache::_hash(CORBA::Object_ptr obj)
+{
+    // Any maximum will do, as long as it is always the same
+    return obj->_hash(0x7FFFFFFF);
+}
+
+LivenessCache::EntryMap::iterator LivenessCache::_find(CORBA::Object_ptr obj, CORBA::ULong hash)
+{
+    std::pair<EntryMap::iterator,EntryMap::iterator> range = _entries.equal_range(hash);
+    for (EntryMap::iterator entry = range.first; entry != range.second; ++entry) {
+        if (obj->_is_equivalent(entry->second.object)) {
+            return entry;
+        }
+    }
+    return _entries.end();
+}
+
+void LivenessCache::_store(CORBA::Object_ptr obj, bool alive)
+{
+    const CORBA::ULong hash = _hash(obj);
+    boost::mutex::scoped_lock lock(_mutex);
+    EntryMap::iterator entry = _find(obj, hash);
+    if (entry == _entries.end()) {
+        entry = _entries.insert(std::make_pair(hash, Entry()));
+        entry->second.object = CORBA::Object::_duplicate(obj);
+    }
+    entry->second.alive = alive;
+    entry->second.checked = boost::get_system_time();
+}
+
+void LivenessCache::_run()
+{
+    boost::mutex::scoped_lock lock(_mutex);
+    while (_running) {
+        if (_ttl <= boost::posix_time::time_duration()) {
+            _cond.wait(lock);
+            continue;
+        }
+
+        // Collect the entries whose status is stale, and find out when the
+        // next one will become stale
+        const boost::system_time now = boost::get_system_time();
+        boost::system_time next = now + _ttl;
+        std::vector<CORBA::Object_var> stale;
+        for (EntryMap::iterator entry = _entries.begin(); entry != _entries.end(); ++entry) {
+            const boost::system_time expires = entry->second.checked + _ttl;
+            if (expires <= now) {
+                stale.push_back(entry->second.object);
+            } else if (expires < next) {
+                next = expires;
+            }
+        }
+
+        if (stale.empty()) {
+            _cond.timed_wait(lock, next);
+            continue;
+        }
+
+        // Ping the stale objects without holding the lock, so that callers
+        // are not blocked by unreachable objects
+        lock.unlock();
+        for (size_t index = 0; index < stale.size(); ++index) {
+            CORBA::Object_ptr object = stale[index];
+            bool alive = ossie::corba::objectExists(object);
+            const CORBA::ULong hash = _hash(object);
+
+            boost::mutex::scoped_lock update_lock(_mutex);
+            if (!_running) {
+                break;
+            }
+            // The object may have been removed while it was being checked
+            EntryMap::iterator entry = _find(object, hash);
+            if (entry == _entries.end()) {
+                continue;
+            }
+            if (entry->second.alive && !alive) {
+                RH_DEBUG(_log, "Tracked object no longer exists");
+            }
+            entry->second.alive = alive;
+            entry->second.checked = boost::get_system_time();
+        }
+        lock.lock();
+    }
+}
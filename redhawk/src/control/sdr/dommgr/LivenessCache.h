@@ -0,0 +1,146 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file 
+ * distributed with this source distribution.
+ * 
+ * This file is part of REDHAWK core.
+ * 
+ * REDHAWK core is free software: you can redistribute it and/or modify it 
+ * under the terms of the GNU Lesser General Public License as published by the 
+ * Free Software Foundation, either version 3 of the License, or (at your 
+ * option) any later version.
+ * 
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT 
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or 
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License 
+ * for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License 
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef LIVENESSCACHE_H
+#define LIVENESSCACHE_H
+
+#include <string>
+#include <map>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <ossie/CorbaUtils.h>
+#include <ossie/debug.h>
+
+namespace redhawk {
+
+    /**
+     * @brief  Cache of object liveness for domain bookkeeping
+     *
+     * Checking whether a remote object still exists requires a round trip
+     * (_non_existent), which can block for the full CORBA timeout when the
+     * object is unreachable. LivenessCache remembers the result of those
+     * checks for a configurable time-to-live, and a background thread
+     * periodically re-checks every tracked object so that callers on hot
+     * paths can read the cached status instead of blocking.
+     *
+     * Objects are tracked when they are checked for the first time or when
+     * they are explicitly marked alive (e.g., on registration), and are
+     * forgotten when removed (e.g., on unregistration).
+     */
+    class LivenessCache
+    {
+    public:
+        /**
+         * @brief  Creates a new cache
+         * @param ttl  the time, in seconds, that a cached status is valid
+         */
+        LivenessCache(float ttl);
+        ~LivenessCache();
+
+        void setLogger(rh_logger::LoggerPtr log);
+
+        /**
+         * @brief  Starts the background thread that refreshes stale entries
+         */
+        void start();
+
+        /**
+         * @brief  Stops the background thread
+         */
+        void stop();
+
+        /**
+         * @brief  Changes the time-to-live of cached entries
+         * @param ttl  the time, in seconds, that a cached status is valid; 0
+         *            disables caching
+         */
+        void setTimeToLive(float ttl);
+
+        /**
+         * @brief  Returns whether an object exists, using the cached status
+         * @param obj  the object to check
+         *
+         * If the object is tracked and its status was checked within the
+         * time-to-live, the cached status is returned. Otherwise, the object
+         * is checked immediately and the result is cached. The background
+         * thread re-checks tracked objects as they become stale, so that
+         * callers rarely have to wait.
+         */
+        bool exists(CORBA::Object_ptr obj);
+
+        /**
+         * @brief  Checks whether an object exists, bypassing the cache
+         * @param obj  the object to check
+         *
+         * The result of the check is stored in the cache.
+         */
+        bool refresh(CORBA::Object_ptr obj);
+
+        /**
+         * @brief  Records that an object is known to be alive
+         */
+        void markAlive(CORBA::Object_ptr obj);
+
+        /**
+         * @brief  Stops tracking an object
+         */
+        void remove(CORBA::Object_ptr obj);
+
+        /**
+         * @brief  Stops tracking all objects that are known not to exist
+         */
+        void removeDead();
+
+        /**
+         * @brief  Returns the number of tracked objects
+         */
+        size_t size();
+
+    private:
+        struct Entry {
+            CORBA::Object_var object;
+            bool alive;
+            boost::system_time checked;
+        };
+        // Entries are keyed by the object's hash, which omniORB computes
+        // locally from the object key; equivalent objects always have the
+        // same hash, and collisions are resolved with _is_equivalent()
+        typedef std::multimap<CORBA::ULong,Entry> EntryMap;
+
+        static CORBA::ULong _hash(CORBA::Object_ptr obj);
+        EntryMap::iterator _find(CORBA::Object_ptr obj, CORBA::ULong hash);
+        void _store(CORBA::Object_ptr obj, bool alive);
+        void _run();
+
+        boost::mutex _mutex;
+        boost::condition_variable _cond;
+        EntryMap _entries;
+        boost::posix_time::time_duration _ttl;
+        boost::thread* _thread;
+        bool _running;
+
+        rh_logger::LoggerPtr _log;
+    };
+}
+
+#endif // LIVENESSCACHE_H
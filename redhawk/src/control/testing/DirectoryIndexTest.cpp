@@ -0,0 +1,295 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "DirectoryIndexTest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/thread.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DirectoryIndexTest);
+
+using ossie::DirectoryIndex;
+
+void DirectoryIndexTest::setUp()
+{
+    char root[] = "/tmp/DirectoryIndexTest.XXXXXX";
+    CPPUNIT_ASSERT(mkdtemp(root));
+    _root = root;
+
+    // Scratch directory that is not under the root, for symbolic links
+    char outside[] = "/tmp/DirectoryIndexTest.XXXXXX";
+    CPPUNIT_ASSERT(mkdtemp(outside));
+    _outside = outside;
+
+    _index = 0;
+}
+
+void DirectoryIndexTest::tearDown()
+{
+    delete _index;
+    boost::filesystem::remove_all(_root);
+    boost::filesystem::remove_all(_outside);
+}
+
+std::string DirectoryIndexTest::_path(const std::string& name)
+{
+    return _root + "/" + name;
+}
+
+void DirectoryIndexTest::_writeFile(const std::string& name, size_t size)
+{
+    std::ofstream file(_path(name).c_str());
+    file << std::string(size, 'x');
+}
+
+void DirectoryIndexTest::_startIndex()
+{
+    _index = new DirectoryIndex(_root);
+    CPPUNIT_ASSERT(_index->start());
+
+    // Wait up to a second for the initial scan
+    for (int retry = 0; (retry < 100) && !_index->ready(); ++retry) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+    CPPUNIT_ASSERT_MESSAGE("Initial scan did not finish", _index->ready());
+}
+
+DirectoryIndex::Kind DirectoryIndexTest::_kind(const std::string& name)
+{
+    DirectoryIndex::Entry entry;
+    CPPUNIT_ASSERT_MESSAGE("Index cannot answer for " + name, _index->lookup(_path(name), entry));
+    return entry.kind;
+}
+
+void DirectoryIndexTest::testLookup()
+{
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir").c_str(), 0755));
+    _writeFile("dir/file", 16);
+    _startIndex();
+
+    // The root itself
+    DirectoryIndex::Entry entry;
+    CPPUNIT_ASSERT(_index->lookup(_root, entry));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, entry.kind);
+
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, _kind("dir"));
+    CPPUNIT_ASSERT(_index->lookup(_path("dir/file"), entry));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, entry.kind);
+    CPPUNIT_ASSERT_EQUAL(std::string("file"), entry.name);
+    CPPUNIT_ASSERT_EQUAL(16ULL, entry.size);
+
+    // Redundant separators and "." are ignored
+    CPPUNIT_ASSERT(_index->lookup(_root + "//dir/./file", entry));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, entry.kind);
+
+    // Missing files, including under a plain file, are known to not exist
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("missing"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("dir/missing/file"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("dir/file/file"));
+}
+
+void DirectoryIndexTest::testList()
+{
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir").c_str(), 0755));
+    _writeFile("dir/a");
+    _writeFile("dir/b");
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir/c").c_str(), 0755));
+    _startIndex();
+
+    DirectoryIndex::Entry entry;
+    std::vector<DirectoryIndex::Entry> contents;
+    CPPUNIT_ASSERT(_index->list(_path("dir"), entry, contents));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, entry.kind);
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, contents.size());
+
+    // Contents are sorted by name
+    CPPUNIT_ASSERT_EQUAL(std::string("a"), contents[0].name);
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, contents[0].kind);
+    CPPUNIT_ASSERT_EQUAL(std::string("c"), contents[2].name);
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, contents[2].kind);
+
+    // A missing directory is reported as such, with no contents
+    contents.clear();
+    CPPUNIT_ASSERT(_index->list(_path("missing"), entry, contents));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, entry.kind);
+    CPPUNIT_ASSERT(contents.empty());
+}
+
+void DirectoryIndexTest::testCreate()
+{
+    _startIndex();
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("file"));
+
+    // Changes are visible as soon as the call that made them returns
+    _writeFile("file", 4);
+    DirectoryIndex::Entry entry;
+    CPPUNIT_ASSERT(_index->lookup(_path("file"), entry));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, entry.kind);
+    CPPUNIT_ASSERT_EQUAL(4ULL, entry.size);
+
+    // New directories are watched too
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir").c_str(), 0755));
+    _writeFile("dir/file");
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("dir/file"));
+
+    // Modifications update the metadata
+    _writeFile("file", 32);
+    CPPUNIT_ASSERT(_index->lookup(_path("file"), entry));
+    CPPUNIT_ASSERT_EQUAL(32ULL, entry.size);
+}
+
+void DirectoryIndexTest::testRename()
+{
+    _writeFile("old", 8);
+    _writeFile("target", 1);
+    _startIndex();
+
+    CPPUNIT_ASSERT_EQUAL(0, rename(_path("old").c_str(), _path("new").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("old"));
+    DirectoryIndex::Entry entry;
+    CPPUNIT_ASSERT(_index->lookup(_path("new"), entry));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, entry.kind);
+    CPPUNIT_ASSERT_EQUAL(8ULL, entry.size);
+
+    // Renaming over an existing file replaces it
+    CPPUNIT_ASSERT_EQUAL(0, rename(_path("new").c_str(), _path("target").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("new"));
+    CPPUNIT_ASSERT(_index->lookup(_path("target"), entry));
+    CPPUNIT_ASSERT_EQUAL(8ULL, entry.size);
+
+    // Moving a file out of the root is seen as a delete
+    CPPUNIT_ASSERT_EQUAL(0, rename(_path("target").c_str(), (_outside + "/target").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("target"));
+}
+
+void DirectoryIndexTest::testRenameDirectory()
+{
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("old").c_str(), 0755));
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("old/sub").c_str(), 0755));
+    _writeFile("old/sub/file");
+    _startIndex();
+
+    CPPUNIT_ASSERT_EQUAL(0, rename(_path("old").c_str(), _path("new").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("old"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("old/sub/file"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, _kind("new"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("new/sub/file"));
+
+    // Changes under the renamed directory are still tracked
+    _writeFile("new/sub/other");
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("new/sub/other"));
+    CPPUNIT_ASSERT_EQUAL(0, unlink(_path("new/sub/file").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("new/sub/file"));
+
+    // A directory moved in from outside the root is indexed in full
+    CPPUNIT_ASSERT_EQUAL(0, mkdir((_outside + "/moved").c_str(), 0755));
+    std::ofstream((_outside + "/moved/file").c_str());
+    CPPUNIT_ASSERT_EQUAL(0, rename((_outside + "/moved").c_str(), _path("moved").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("moved/file"));
+}
+
+void DirectoryIndexTest::testDelete()
+{
+    _writeFile("file");
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir").c_str(), 0755));
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir/sub").c_str(), 0755));
+    _writeFile("dir/sub/file");
+    _startIndex();
+
+    CPPUNIT_ASSERT_EQUAL(0, unlink(_path("file").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("file"));
+
+    boost::filesystem::remove_all(_path("dir"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("dir"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("dir/sub/file"));
+
+    // Re-creating a deleted directory starts out empty
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir").c_str(), 0755));
+    DirectoryIndex::Entry entry;
+    std::vector<DirectoryIndex::Entry> contents;
+    CPPUNIT_ASSERT(_index->list(_path("dir"), entry, contents));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, entry.kind);
+    CPPUNIT_ASSERT(contents.empty());
+}
+
+void DirectoryIndexTest::testRebuild()
+{
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir").c_str(), 0755));
+    _writeFile("dir/file");
+    _startIndex();
+
+    // Rebuilding, as happens when the inotify queue overflows, discards the
+    // existing watches; events already queued for them must be ignored
+    _writeFile("dir/pending");
+    _index->rebuild();
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("dir/file"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("dir/pending"));
+
+    // Changes after the rebuild are tracked through the new watches
+    CPPUNIT_ASSERT_EQUAL(0, unlink(_path("dir/file").c_str()));
+    _writeFile("dir/new");
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::MISSING, _kind("dir/file"));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("dir/new"));
+
+    CPPUNIT_ASSERT_EQUAL(0, mkdir(_path("dir/sub").c_str(), 0755));
+    _writeFile("dir/sub/file");
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::PLAIN, _kind("dir/sub/file"));
+}
+
+void DirectoryIndexTest::testSymlinkFallback()
+{
+    CPPUNIT_ASSERT_EQUAL(0, mkdir((_outside + "/target").c_str(), 0755));
+    std::ofstream((_outside + "/target/file").c_str());
+    CPPUNIT_ASSERT_EQUAL(0, symlink((_outside + "/target").c_str(), _path("link").c_str()));
+    _startIndex();
+
+    // The link itself is indexed as what it points to
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, _kind("link"));
+
+    // Changes made through another path are not reported for the link, so the
+    // index defers to the disk for anything under it
+    DirectoryIndex::Entry entry;
+    CPPUNIT_ASSERT(!_index->lookup(_path("link/file"), entry));
+    CPPUNIT_ASSERT(!_index->lookup(_path("link/missing"), entry));
+    std::vector<DirectoryIndex::Entry> contents;
+    CPPUNIT_ASSERT(!_index->list(_path("link"), entry, contents));
+
+    // A link created after the initial scan is treated the same way
+    CPPUNIT_ASSERT_EQUAL(0, symlink((_outside + "/target").c_str(), _path("later").c_str()));
+    CPPUNIT_ASSERT_EQUAL(DirectoryIndex::DIRECTORY, _kind("later"));
+    CPPUNIT_ASSERT(!_index->lookup(_path("later/file"), entry));
+}
+
+void DirectoryIndexTest::testOutsideRoot()
+{
+    _startIndex();
+
+    // Paths the index does not cover go to the disk
+    DirectoryIndex::Entry entry;
+    CPPUNIT_ASSERT(!_index->lookup(_outside, entry));
+    CPPUNIT_ASSERT(!_index->lookup(_path("../file"), entry));
+    CPPUNIT_ASSERT(!_index->lookup("relative/path", entry));
+}
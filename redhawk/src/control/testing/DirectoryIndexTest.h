@@ -0,0 +1,69 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef DIRECTORYINDEXTEST_H
+#define DIRECTORYINDEXTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+#include <ossie/DirectoryIndex.h>
+
+class DirectoryIndexTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(DirectoryIndexTest);
+    CPPUNIT_TEST(testLookup);
+    CPPUNIT_TEST(testList);
+    CPPUNIT_TEST(testCreate);
+    CPPUNIT_TEST(testRename);
+    CPPUNIT_TEST(testRenameDirectory);
+    CPPUNIT_TEST(testDelete);
+    CPPUNIT_TEST(testRebuild);
+    CPPUNIT_TEST(testSymlinkFallback);
+    CPPUNIT_TEST(testOutsideRoot);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testLookup();
+    void testList();
+    void testCreate();
+    void testRename();
+    void testRenameDirectory();
+    void testDelete();
+    void testRebuild();
+    void testSymlinkFallback();
+    void testOutsideRoot();
+
+private:
+    std::string _path(const std::string& name);
+    void _writeFile(const std::string& name, size_t size=0);
+    void _startIndex();
+    ossie::DirectoryIndex::Kind _kind(const std::string& name);
+
+    std::string _root;
+    std::string _outside;
+    ossie::DirectoryIndex* _index;
+};
+
+#endif // DIRECTORYINDEXTEST_H
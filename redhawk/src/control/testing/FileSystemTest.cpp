@@ -0,0 +1,98 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "FileSystemTest.h"
+
+#include <cstdlib>
+#include <fstream>
+
+#include <boost/filesystem.hpp>
+
+#include <ossie/PropertyMap.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FileSystemTest);
+
+void FileSystemTest::setUp()
+{
+    char root[] = "/tmp/FileSystemTest.XXXXXX";
+    CPPUNIT_ASSERT(mkdtemp(root));
+    _root = root;
+
+    _fileSystem = new FileSystem_impl(_root.c_str());
+}
+
+void FileSystemTest::tearDown()
+{
+    delete _fileSystem;
+    boost::filesystem::remove_all(_root);
+}
+
+void FileSystemTest::_writeFile(const std::string& name, const std::string& contents)
+{
+    std::ofstream file((_root + name).c_str());
+    file << contents;
+}
+
+void FileSystemTest::testRead()
+{
+    std::string contents;
+    for (size_t index = 0; index < 10000; ++index) {
+        contents += static_cast<char>(index % 251);
+    }
+    _writeFile("/data.bin", contents);
+
+    CF::File_var file = _fileSystem->open("/data.bin", true);
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULongLong) contents.size(), file->sizeOf());
+
+    // Read in uneven pieces, including one that runs past the end
+    std::string result;
+    const CORBA::ULong lengths[] = { 1, 4095, 4096, 4096 };
+    for (size_t index = 0; index < sizeof(lengths)/sizeof(lengths[0]); ++index) {
+        CF::OctetSequence_var data;
+        file->read(data, lengths[index]);
+        result.append(reinterpret_cast<const char*>(data->get_buffer()), data->length());
+    }
+    CPPUNIT_ASSERT_EQUAL(contents.size(), result.size());
+    CPPUNIT_ASSERT(contents == result);
+
+    // At the end of the file, reads return nothing
+    CF::OctetSequence_var data;
+    file->read(data, 1);
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 0, data->length());
+
+    file->close();
+}
+
+void FileSystemTest::testListLocalPath()
+{
+    _writeFile("/local.txt", "local");
+
+    CF::FileSystem::FileInformationSequence_var files = _fileSystem->list("/local.txt");
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULong) 1, files->length());
+    CPPUNIT_ASSERT_EQUAL(CF::FileSystem::PLAIN, files[0].kind);
+    CPPUNIT_ASSERT_EQUAL((CORBA::ULongLong) 5, files[0].size);
+
+    // Plain files report where they can be found on this host, which lets a
+    // LoadableDevice on the same host copy them without a transfer
+    const redhawk::PropertyMap& props = redhawk::PropertyMap::cast(files[0].fileProperties);
+    CPPUNIT_ASSERT(props.contains("HOSTNAME"));
+    CPPUNIT_ASSERT(props.contains("LOCAL_PATH"));
+    CPPUNIT_ASSERT_EQUAL(_root + "/local.txt", props["LOCAL_PATH"].toString());
+}
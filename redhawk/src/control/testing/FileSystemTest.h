@@ -0,0 +1,51 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef FILESYSTEMTEST_H
+#define FILESYSTEMTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+#include <ossie/FileSystem_impl.h>
+
+class FileSystemTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(FileSystemTest);
+    CPPUNIT_TEST(testRead);
+    CPPUNIT_TEST(testListLocalPath);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testRead();
+    void testListLocalPath();
+
+private:
+    void _writeFile(const std::string& name, const std::string& contents);
+
+    std::string _root;
+    FileSystem_impl* _fileSystem;
+};
+
+#endif // FILESYSTEMTEST_H
@@ -0,0 +1,168 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "LivenessCacheTest.h"
+
+#include <LivenessCache.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(LivenessCacheTest);
+
+void LivenessCacheTest::setUp()
+{
+}
+
+void LivenessCacheTest::tearDown()
+{
+    for (size_t index = 0; index < _servants.size(); ++index) {
+        if (_servants[index]) {
+            _destroyObject(_objects[index]);
+        }
+    }
+    _servants.clear();
+    _objects.clear();
+}
+
+CORBA::Object_ptr LivenessCacheTest::_createObject()
+{
+    // Any servant will do; message consumer ports are simple to create
+    MessageConsumerPort* servant = new MessageConsumerPort("object");
+    _servants.push_back(servant);
+    _objects.push_back(servant->_this());
+    return _objects.back();
+}
+
+void LivenessCacheTest::_destroyObject(CORBA::Object_ptr obj)
+{
+    for (size_t index = 0; index < _objects.size(); ++index) {
+        if (_servants[index] && obj->_is_equivalent(_objects[index])) {
+            PortableServer::POA_var poa = _servants[index]->_default_POA();
+            PortableServer::ObjectId_var oid = poa->servant_to_id(_servants[index]);
+            poa->deactivate_object(oid);
+            _servants[index]->_remove_ref();
+            _servants[index] = 0;
+            return;
+        }
+    }
+}
+
+void LivenessCacheTest::testDisabled()
+{
+    // With a time-to-live of 0, every call checks the object
+    redhawk::LivenessCache cache(0);
+    CORBA::Object_ptr obj = _createObject();
+    cache.markAlive(obj);
+    CPPUNIT_ASSERT(cache.exists(obj));
+
+    _destroyObject(obj);
+    CPPUNIT_ASSERT(!cache.exists(obj));
+
+    // Nil is never alive
+    CPPUNIT_ASSERT(!cache.exists(CORBA::Object::_nil()));
+}
+
+void LivenessCacheTest::testCached()
+{
+    redhawk::LivenessCache cache(60);
+    CORBA::Object_ptr obj = _createObject();
+    cache.markAlive(obj);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, cache.size());
+
+    // Within the time-to-live, the cached status is returned
+    _destroyObject(obj);
+    CPPUNIT_ASSERT(cache.exists(obj));
+
+    // Refreshing always checks the object, and updates the cache
+    CPPUNIT_ASSERT(!cache.refresh(obj));
+    CPPUNIT_ASSERT(!cache.exists(obj));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, cache.size());
+}
+
+void LivenessCacheTest::testStale()
+{
+    // Once the status is older than the time-to-live, exists() must check
+    // the object again rather than report the last known status
+    redhawk::LivenessCache cache(0.1);
+    CORBA::Object_ptr obj = _createObject();
+    CPPUNIT_ASSERT(cache.exists(obj));
+
+    _destroyObject(obj);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(200));
+    CPPUNIT_ASSERT(!cache.exists(obj));
+}
+
+void LivenessCacheTest::testBackground()
+{
+    redhawk::LivenessCache cache(0.1);
+    CORBA::Object_ptr alive = _createObject();
+    CORBA::Object_ptr dead = _createObject();
+    cache.markAlive(alive);
+    cache.markAlive(dead);
+    cache.start();
+
+    // The background thread should discover that the object is gone without
+    // any calls to exists(); poll with removeDead() to observe it
+    _destroyObject(dead);
+    boost::system_time end = boost::get_system_time() + boost::posix_time::seconds(2);
+    while ((cache.size() > 1) && (boost::get_system_time() < end)) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+        cache.removeDead();
+    }
+    cache.stop();
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, cache.size());
+    CPPUNIT_ASSERT(cache.exists(alive));
+}
+
+void LivenessCacheTest::testEquivalent()
+{
+    redhawk::LivenessCache cache(60);
+    CORBA::Object_ptr obj = _createObject();
+    cache.markAlive(obj);
+
+    // A separate reference to the same object shares the same entry
+    const std::string ior = ossie::corba::objectToString(obj);
+    CORBA::Object_var copy = ossie::corba::stringToObject(ior);
+    cache.markAlive(copy);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, cache.size());
+
+    // Different objects have different entries
+    CORBA::Object_ptr other = _createObject();
+    cache.markAlive(other);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, cache.size());
+
+    cache.remove(copy);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, cache.size());
+    cache.remove(other);
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, cache.size());
+}
+
+void LivenessCacheTest::testRemoveDead()
+{
+    redhawk::LivenessCache cache(60);
+    CORBA::Object_ptr alive = _createObject();
+    CORBA::Object_ptr dead = _createObject();
+    cache.markAlive(alive);
+    _destroyObject(dead);
+    CPPUNIT_ASSERT(!cache.exists(dead));
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, cache.size());
+
+    cache.removeDead();
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, cache.size());
+    CPPUNIT_ASSERT(cache.exists(alive));
+}
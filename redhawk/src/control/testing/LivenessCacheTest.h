@@ -0,0 +1,60 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef LIVENESSCACHETEST_H
+#define LIVENESSCACHETEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+#include <ossie/MessageInterface.h>
+
+class LivenessCacheTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(LivenessCacheTest);
+    CPPUNIT_TEST(testDisabled);
+    CPPUNIT_TEST(testCached);
+    CPPUNIT_TEST(testStale);
+    CPPUNIT_TEST(testBackground);
+    CPPUNIT_TEST(testEquivalent);
+    CPPUNIT_TEST(testRemoveDead);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testDisabled();
+    void testCached();
+    void testStale();
+    void testBackground();
+    void testEquivalent();
+    void testRemoveDead();
+
+private:
+    CORBA::Object_ptr _createObject();
+    void _destroyObject(CORBA::Object_ptr obj);
+
+    std::vector<MessageConsumerPort*> _servants;
+    std::vector<CORBA::Object_var> _objects;
+};
+
+#endif // LIVENESSCACHETEST_H
@@ -0,0 +1,240 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "AffinityTest.h"
+
+#include <sched.h>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include <ossie/affinity.h>
+#include <ossie/PropertyMap.h>
+#include <ossie/ThreadedComponent.h>
+
+using namespace redhawk::affinity;
+
+CPPUNIT_TEST_SUITE_REGISTRATION(AffinityTest);
+
+namespace {
+    // Records the cpus that its service thread is allowed to run on
+    class PlacedComponent : public ThreadedComponent
+    {
+    public:
+        PlacedComponent() :
+            _recorded(false)
+        {
+        }
+
+        ~PlacedComponent()
+        {
+            stopThread();
+        }
+
+        void start()
+        {
+            startThread();
+        }
+
+        int serviceFunction()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            if (!_recorded) {
+                CPU_ZERO(&_cpus);
+                sched_getaffinity(0, sizeof(_cpus), &_cpus);
+                _recorded = true;
+                _cond.notify_all();
+            }
+            return NOOP;
+        }
+
+        // Waits up to a second for the service thread to run
+        bool getCpus(cpu_set_t& cpus)
+        {
+            boost::system_time deadline = boost::get_system_time() + boost::posix_time::seconds(1);
+            boost::mutex::scoped_lock lock(_mutex);
+            while (!_recorded) {
+                if (!_cond.timed_wait(lock, deadline)) {
+                    return false;
+                }
+            }
+            cpus = _cpus;
+            return true;
+        }
+
+    private:
+        boost::mutex _mutex;
+        boost::condition_variable _cond;
+        bool _recorded;
+        cpu_set_t _cpus;
+    };
+}
+
+void AffinityTest::setUp()
+{
+}
+
+void AffinityTest::tearDown()
+{
+    // Clear all thread role directives
+    set_thread_affinity(std::string());
+}
+
+void AffinityTest::testThreadDirectives()
+{
+    set_thread_affinity("processing=cpu:2-3; transport=socket:0;processing=nic:eth0");
+
+    AffinityDirectives processing = get_thread_directives(PROCESSING_THREAD);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, processing.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("cpu"), processing[0].first);
+    CPPUNIT_ASSERT_EQUAL(std::string("2-3"), processing[0].second);
+    CPPUNIT_ASSERT_EQUAL(std::string("nic"), processing[1].first);
+    CPPUNIT_ASSERT_EQUAL(std::string("eth0"), processing[1].second);
+
+    AffinityDirectives transport = get_thread_directives(TRANSPORT_THREAD);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, transport.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("socket"), transport[0].first);
+    CPPUNIT_ASSERT_EQUAL(std::string("0"), transport[0].second);
+
+    CPPUNIT_ASSERT(get_thread_directives(ORB_THREAD).empty());
+    CPPUNIT_ASSERT(get_thread_directives(HOUSEKEEPING_THREAD).empty());
+
+    // Roles without directives are left alone
+    CPPUNIT_ASSERT_EQUAL(0, apply_thread_affinity(ORB_THREAD));
+
+    // A new specification replaces all roles
+    set_thread_affinity("orb=cpu:0");
+    CPPUNIT_ASSERT(get_thread_directives(PROCESSING_THREAD).empty());
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, get_thread_directives(ORB_THREAD).size());
+}
+
+void AffinityTest::testInvalidThreadDirectives()
+{
+    set_thread_affinity("housekeeping=cpu:1");
+
+    // Unknown role
+    CPPUNIT_ASSERT_THROW(set_thread_affinity("render=cpu:1"), AffinityFailed);
+
+    // Missing class or context
+    CPPUNIT_ASSERT_THROW(set_thread_affinity("processing"), AffinityFailed);
+    CPPUNIT_ASSERT_THROW(set_thread_affinity("processing=cpu"), AffinityFailed);
+
+    // Process-wide classes do not apply to threads
+    CPPUNIT_ASSERT_THROW(set_thread_affinity("processing=cgroup:rt"), AffinityFailed);
+    CPPUNIT_ASSERT_THROW(set_thread_affinity("processing=cpuset:rt"), AffinityFailed);
+
+    // Only the documented classes are accepted; "node" is not a directive
+    // class, even though socket contexts are NUMA nodes
+    CPPUNIT_ASSERT_THROW(set_thread_affinity("processing=node:0"), AffinityFailed);
+
+    // Failed updates leave the existing directives in place
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, get_thread_directives(HOUSEKEEPING_THREAD).size());
+}
+
+void AffinityTest::testThreadAffinityFromProperties()
+{
+    redhawk::PropertyMap affinity;
+    affinity["affinity::exec_directive_class"] = "socket";
+    affinity["affinity::exec_directive_value"] = "0";
+    affinity["affinity::thread_orb"] = "cpu:0";
+    affinity["affinity::thread_processing"] = "cpu:2-3";
+
+    redhawk::PropertyMap options;
+    CPPUNIT_ASSERT_EQUAL(std::string(), get_thread_affinity(options));
+
+    options[AFFINITY_ID] = affinity;
+    const std::string directives = get_thread_affinity(options);
+    CPPUNIT_ASSERT_EQUAL(std::string("processing=cpu:2-3;orb=cpu:0"), directives);
+
+    // The execparam value round-trips
+    set_thread_affinity(directives);
+    CPPUNIT_ASSERT_EQUAL(std::string("2-3"), get_thread_directives(PROCESSING_THREAD)[0].second);
+    CPPUNIT_ASSERT_EQUAL(std::string("0"), get_thread_directives(ORB_THREAD)[0].second);
+
+    // Thread directives do not change the process-wide directives
+    AffinityDirectives process = convert_properties(options);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, process.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("socket"), process[0].first);
+}
+
+void AffinityTest::testPlacement()
+{
+    // Objects are identified by their most-derived address
+    int first = 0;
+    int second = 0;
+    CPPUNIT_ASSERT(get_placement(&first).empty());
+    CPPUNIT_ASSERT_EQUAL(0, apply_placement(&first));
+
+    AffinityDirectives spec;
+    spec.push_back(AffinityDirective("socket", "0"));
+    set_placement(&first, spec);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, get_placement(&first).size());
+    CPPUNIT_ASSERT_EQUAL(std::string("socket"), get_placement(&first)[0].first);
+    CPPUNIT_ASSERT(get_placement(&second).empty());
+
+    clear_placement(&first);
+    CPPUNIT_ASSERT(get_placement(&first).empty());
+
+    CPPUNIT_ASSERT(get_node_count() >= 1);
+    CPPUNIT_ASSERT(get_current_node() >= 0);
+    CPPUNIT_ASSERT(get_current_node() < get_node_count());
+}
+
+void AffinityTest::testPlacementBinding()
+{
+#ifdef HAVE_LIBNUMA
+    if (is_disabled()) {
+        return;
+    }
+
+    // Place the component on the last cpu this process may use, so that the
+    // binding is visible whenever more than one is available
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    CPPUNIT_ASSERT_EQUAL(0, sched_getaffinity(0, sizeof(allowed), &allowed));
+    int target = -1;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &allowed)) {
+            target = cpu;
+        }
+    }
+    CPPUNIT_ASSERT(target >= 0);
+
+    PlacedComponent component;
+    AffinityDirectives spec;
+    spec.push_back(AffinityDirective("cpu", boost::lexical_cast<std::string>(target)));
+    set_placement(dynamic_cast<void*>(&component), spec);
+
+    // The service thread binds itself before calling serviceFunction
+    component.start();
+    cpu_set_t cpus;
+    bool recorded = component.getCpus(cpus);
+    clear_placement(dynamic_cast<void*>(&component));
+    CPPUNIT_ASSERT_MESSAGE("Service function did not run", recorded);
+    CPPUNIT_ASSERT_EQUAL(1, CPU_COUNT(&cpus));
+    CPPUNIT_ASSERT(CPU_ISSET(target, &cpus));
+
+    // The calling thread is not affected
+    cpu_set_t current;
+    CPU_ZERO(&current);
+    sched_getaffinity(0, sizeof(current), &current);
+    CPPUNIT_ASSERT(CPU_EQUAL(&allowed, &current));
+#endif
+}
@@ -109,6 +109,20 @@ void BufferManagerTest::testAllocator()
     CPPUNIT_ASSERT_EQUAL(large_buffer, vec.data());
 }
 
+void BufferManagerTest::testAlignment()
+{
+    // Check a range of sizes, including ones that are not a multiple of the
+    // alignment, both for new and cached blocks
+    const size_t SIZES[] = { 1, 100, 1000, 4097, 12345, 128*1024+1 };
+    for (size_t index = 0; index < sizeof(SIZES)/sizeof(SIZES[0]); ++index) {
+        void* buffer = _allocate(SIZES[index]);
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, reinterpret_cast<size_t>(buffer) % redhawk::BufferManager::ALIGNMENT);
+        _deallocate(buffer);
+        buffer = _allocate(SIZES[index]);
+        CPPUNIT_ASSERT_EQUAL((size_t) 0, reinterpret_cast<size_t>(buffer) % redhawk::BufferManager::ALIGNMENT);
+    }
+}
+
 void BufferManagerTest::testEnable()
 {
     // Start enabled and check that it reports true
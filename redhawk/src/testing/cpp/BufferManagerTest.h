@@ -32,6 +32,7 @@ class BufferManagerTest : public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(BufferManagerTest);
     CPPUNIT_TEST(testBasicAllocate);
     CPPUNIT_TEST(testAllocator);
+    CPPUNIT_TEST(testAlignment);
     CPPUNIT_TEST(testEnable);
     CPPUNIT_TEST(testStatistics);
     CPPUNIT_TEST(testThreading);
@@ -46,6 +47,7 @@ public:
 
     void testBasicAllocate();
     void testAllocator();
+    void testAlignment();
 
     void testEnable();
 
@@ -81,6 +81,36 @@ namespace {
 
         std::vector<std::string> _commands;
     };
+
+    // Blocks the calling thread until released, to simulate a slow task
+    class Gate
+    {
+    public:
+        Gate() :
+            _open(false)
+        {
+        }
+
+        void wait()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            while (!_open) {
+                _cond.wait(lock);
+            }
+        }
+
+        void open()
+        {
+            boost::mutex::scoped_lock lock(_mutex);
+            _open = true;
+            _cond.notify_all();
+        }
+
+    private:
+        boost::mutex _mutex;
+        boost::condition_variable _cond;
+        bool _open;
+    };
 }
 
 void ExecutorServiceTest::setUp()
@@ -220,3 +250,84 @@ void ExecutorServiceTest::testClear()
     CPPUNIT_ASSERT_EQUAL((size_t) 0, _service.pending());
     CPPUNIT_ASSERT_EQUAL(0, tracker.count());
 }
+
+void ExecutorServiceTest::testPeriodic()
+{
+    _service.start();
+
+    // Run a task every 1000us
+    CommandTracker tracker;
+    boost::system_time start = boost::get_system_time();
+    _service.schedulePeriodic("periodic", boost::posix_time::microseconds(1000), &CommandTracker::run, &tracker);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, _service.pending());
+
+    // Wait for 5 runs, which should take approximately 5000us, but allow
+    // some slack in the event of scheduler delays
+    boost::system_time timeout = start + boost::posix_time::microseconds(50000);
+    CPPUNIT_ASSERT(tracker.wait(5, timeout));
+    CPPUNIT_ASSERT(boost::get_system_time() >= (start + boost::posix_time::microseconds(5000)));
+
+    // The statistics should reflect the runs so far (the most recent run
+    // may not have been recorded yet)
+    std::vector<redhawk::ExecutorService::TaskStatistics> stats = _service.statistics();
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, stats.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("periodic"), stats[0].name);
+    CPPUNIT_ASSERT(stats[0].period == boost::posix_time::microseconds(1000));
+    CPPUNIT_ASSERT(stats[0].runs >= 4);
+    CPPUNIT_ASSERT(stats[0].maxRuntime >= stats[0].averageRuntime);
+
+    // Clearing the service removes periodic tasks
+    _service.clear();
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, _service.pending());
+    CPPUNIT_ASSERT(_service.statistics().empty());
+}
+
+void ExecutorServiceTest::testCancel()
+{
+    _service.start();
+
+    CommandTracker tracker;
+    redhawk::ExecutorService::task_id id;
+    id = _service.schedulePeriodic("cancel", boost::posix_time::microseconds(1000), &CommandTracker::run, &tracker);
+
+    // Wait for at least one run, then cancel the task
+    boost::system_time timeout = boost::get_system_time() + boost::posix_time::microseconds(10000);
+    CPPUNIT_ASSERT(tracker.wait(1, timeout));
+    CPPUNIT_ASSERT(_service.cancel(id));
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, _service.pending());
+
+    // Cancelling again should fail
+    CPPUNIT_ASSERT(!_service.cancel(id));
+
+    // Give the task time to run again, if it were still scheduled (it may
+    // already have been running when it was cancelled, so allow for one)
+    int count = tracker.count();
+    boost::this_thread::sleep(boost::posix_time::microseconds(5000));
+    CPPUNIT_ASSERT(tracker.count() <= (count + 1));
+}
+
+void ExecutorServiceTest::testThreadPool()
+{
+    // Declare the service last so that it is stopped before the objects
+    // its tasks refer to are destroyed
+    Gate gate;
+    CommandTracker tracker;
+    redhawk::ExecutorService service(2);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, service.threads());
+    service.start();
+
+    // Occupy one of the worker threads until the gate is opened
+    service.execute(&Gate::wait, &gate);
+
+    // With a second thread available, a scheduled task should still run on
+    // time despite the blocked thread
+    boost::system_time when = boost::get_system_time() + boost::posix_time::microseconds(1000);
+    service.schedule(when, &CommandTracker::run, &tracker);
+
+    boost::system_time timeout = when + boost::posix_time::microseconds(10000);
+    bool executed = tracker.wait(1, timeout);
+    gate.open();
+    CPPUNIT_ASSERT(executed);
+
+    service.stop();
+}
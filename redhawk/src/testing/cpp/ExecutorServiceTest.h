@@ -32,6 +32,9 @@ class ExecutorServiceTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testSchedule);
     CPPUNIT_TEST(testStop);
     CPPUNIT_TEST(testClear);
+    CPPUNIT_TEST(testPeriodic);
+    CPPUNIT_TEST(testCancel);
+    CPPUNIT_TEST(testThreadPool);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -42,6 +45,9 @@ public:
     void testSchedule();
     void testStop();
     void testClear();
+    void testPeriodic();
+    void testCancel();
+    void testThreadPool();
 
 private:
     redhawk::ExecutorService _service;
@@ -20,6 +20,7 @@
 
 #include "MessagingTest.h"
 
+#include <ossie/CorbaUtils.h>
 #include <ossie/PropertyMap.h>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(MessagingTest);
@@ -101,7 +102,11 @@ namespace {
         return true;
     }
 
+    // Number of times a direct_message_struct has been serialized to an Any
+    int direct_serialize_count = 0;
+
     inline void operator<<= (CORBA::Any& a, const direct_message_struct& s) {
+        ++direct_serialize_count;
         redhawk::PropertyMap props;
  
         props["value"] = s.value;
@@ -167,10 +172,104 @@ namespace {
     private:
         redhawk::PropertyMap _received;
     };
+
+    // Utility class that records which thread delivered each message
+    class ThreadReceiver
+    {
+    public:
+        void messageReceived(const std::string& messageId, const direct_message_struct& msgData)
+        {
+            _values.push_back(msgData.value);
+            _threads.push_back(boost::this_thread::get_id());
+        }
+
+        const std::vector<CORBA::Long>& values() const
+        {
+            return _values;
+        }
+
+        const std::vector<boost::thread::id>& threads() const
+        {
+            return _threads;
+        }
+
+    private:
+        std::vector<CORBA::Long> _values;
+        std::vector<boost::thread::id> _threads;
+    };
+
+    // Utility class that tries to turn off threaded dispatch from within a
+    // message callback
+    class DisablingReceiver
+    {
+    public:
+        DisablingReceiver(MessageConsumerPort* port) :
+            _port(port),
+            _refused(false)
+        {
+        }
+
+        void messageReceived(const std::string& messageId, const direct_message_struct& msgData)
+        {
+            try {
+                _port->setThreadedDispatch(false);
+            } catch (const std::logic_error&) {
+                _refused = true;
+            }
+        }
+
+        bool refused() const
+        {
+            return _refused;
+        }
+
+    private:
+        MessageConsumerPort* _port;
+        bool _refused;
+    };
+
+    // Event channel that forwards to another channel. The servant is not a
+    // MessageConsumerPort, so a supplier connected to it uses the CORBA
+    // transport even though the consumer is in the same process.
+    class ForwardingChannel : public virtual POA_CosEventChannelAdmin::EventChannel
+    {
+    public:
+        ForwardingChannel(CosEventChannelAdmin::EventChannel_ptr channel) :
+            _channel(CosEventChannelAdmin::EventChannel::_duplicate(channel))
+        {
+        }
+
+        CosEventChannelAdmin::ConsumerAdmin_ptr for_consumers()
+        {
+            return _channel->for_consumers();
+        }
+
+        CosEventChannelAdmin::SupplierAdmin_ptr for_suppliers()
+        {
+            return _channel->for_suppliers();
+        }
+
+        void destroy()
+        {
+        }
+
+    private:
+        CosEventChannelAdmin::EventChannel_var _channel;
+    };
+
+    // Waits up to a second for a receiver to have at least count messages
+    template <class Receiver>
+    void waitForValues(const Receiver& receiver, size_t count)
+    {
+        for (int retry = 0; (retry < 100) && (receiver.values().size() < count); ++retry) {
+            boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+        }
+    }
 }
 
 void MessagingTest::setUp()
 {
+    _forwarder = 0;
     _supplier = new MessageSupplierPort("supplier");
     _consumer = new MessageConsumerPort("consumer");
 
@@ -194,6 +293,30 @@ void MessagingTest::tearDown()
     // Consumer and supplier have been deleted by the port manager
     _supplier = 0;
     _consumer = 0;
+
+    if (_forwarder) {
+        try {
+            PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->servant_to_id(_forwarder);
+            ossie::corba::RootPOA()->deactivate_object(oid);
+        } catch (...) {
+            // Ignore CORBA exceptions
+        }
+        _forwarder->_remove_ref();
+        _forwarder = 0;
+    }
+}
+
+void MessagingTest::_connectRemote(const std::string& connectionId)
+{
+    // Replace the direct connection with one that goes through CORBA, which
+    // is the only kind that batches messages
+    _supplier->disconnectPort("connection_1");
+    CORBA::Object_var consumer = _consumer->_this();
+    CosEventChannelAdmin::EventChannel_var channel = CosEventChannelAdmin::EventChannel::_narrow(consumer);
+    _forwarder = new ForwardingChannel(channel);
+    PortableServer::ObjectId_var oid = ossie::corba::RootPOA()->activate_object(_forwarder);
+    CORBA::Object_var objref = ossie::corba::RootPOA()->id_to_reference(oid);
+    _supplier->connectPort(objref, connectionId.c_str());
 }
 
 void MessagingTest::testConnections()
@@ -574,3 +697,174 @@ void MessagingTest::testPushConnectionId()
     CPPUNIT_ASSERT_EQUAL((size_t) 4, receiver_1.received().size());
     CPPUNIT_ASSERT_EQUAL((size_t) 3, receiver_2.received().size());
 }
+
+void MessagingTest::testThreadedDispatch()
+{
+    ThreadReceiver receiver;
+    _consumer->registerMessage(direct_message_struct::getId(), &receiver, &ThreadReceiver::messageReceived);
+
+    // Dispatch from a separate thread, with a small queue limit so that the
+    // sender must occasionally wait
+    _consumer->setThreadedDispatch(true, 4);
+    CPPUNIT_ASSERT(_consumer->isThreadedDispatch());
+
+    std::vector<direct_message_struct> messages;
+    messages.resize(16);
+    for (size_t index = 0; index < messages.size(); ++index) {
+        messages[index].value = index;
+    }
+    const int serialize_count = direct_serialize_count;
+    _supplier->sendMessages(messages);
+
+    // The callback is compatible with the message format, so the messages
+    // should be queued as typed copies without any Any serialization
+    CPPUNIT_ASSERT_EQUAL(serialize_count, direct_serialize_count);
+
+    // Disabling threaded dispatch delivers any messages still in the queue
+    _consumer->setThreadedDispatch(false);
+    CPPUNIT_ASSERT(!_consumer->isThreadedDispatch());
+
+    // All messages should have been received in order, and none of them on
+    // this thread
+    CPPUNIT_ASSERT_EQUAL(messages.size(), receiver.values().size());
+    for (size_t index = 0; index < messages.size(); ++index) {
+        CPPUNIT_ASSERT_EQUAL(messages[index].value, receiver.values()[index]);
+        CPPUNIT_ASSERT(receiver.threads()[index] != boost::this_thread::get_id());
+    }
+
+    // With threaded dispatch off, the callback is invoked directly
+    _supplier->sendMessage(messages[0]);
+    CPPUNIT_ASSERT_EQUAL(messages.size() + 1, receiver.values().size());
+    CPPUNIT_ASSERT(receiver.threads().back() == boost::this_thread::get_id());
+}
+
+void MessagingTest::testThreadedDispatchDisableFromCallback()
+{
+    DisablingReceiver receiver(_consumer);
+    _consumer->registerMessage(direct_message_struct::getId(), &receiver, &DisablingReceiver::messageReceived);
+    _consumer->setThreadedDispatch(true);
+
+    // The dispatch thread cannot wait for itself to exit, so the request
+    // from the callback is refused and dispatch stays enabled
+    direct_message_struct message;
+    message.value = 1;
+    _supplier->sendMessage(message);
+    for (int retry = 0; (retry < 100) && !receiver.refused(); ++retry) {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+    }
+    CPPUNIT_ASSERT(receiver.refused());
+    CPPUNIT_ASSERT(_consumer->isThreadedDispatch());
+
+    _consumer->setThreadedDispatch(false);
+    CPPUNIT_ASSERT(!_consumer->isThreadedDispatch());
+}
+
+void MessagingTest::testBatching()
+{
+    ThreadReceiver receiver;
+    _consumer->registerMessage(direct_message_struct::getId(), &receiver, &ThreadReceiver::messageReceived);
+    _connectRemote("remote");
+    _supplier->setBatching(4, 0.0);
+
+    std::vector<direct_message_struct> messages;
+    messages.resize(5);
+    for (size_t index = 0; index < messages.size(); ++index) {
+        messages[index].value = index;
+    }
+
+    // Nothing is sent until there is a full batch
+    for (size_t index = 0; index < 3; ++index) {
+        _supplier->sendMessage(messages[index]);
+    }
+    CPPUNIT_ASSERT(receiver.values().empty());
+    _supplier->sendMessage(messages[3]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, receiver.values().size());
+
+    // With no delay, a partial batch is only sent by an explicit flush
+    _supplier->sendMessage(messages[4]);
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, receiver.values().size());
+    _supplier->flush();
+    CPPUNIT_ASSERT_EQUAL(messages.size(), receiver.values().size());
+    for (size_t index = 0; index < messages.size(); ++index) {
+        CPPUNIT_ASSERT_EQUAL(messages[index].value, receiver.values()[index]);
+    }
+}
+
+void MessagingTest::testBatchingDelay()
+{
+    ThreadReceiver receiver;
+    _consumer->registerMessage(direct_message_struct::getId(), &receiver, &ThreadReceiver::messageReceived);
+    _connectRemote("remote");
+    _supplier->setBatching(4, 0.1);
+
+    // A partial batch is sent after the delay
+    direct_message_struct message;
+    message.value = 0;
+    _supplier->sendMessage(message);
+    CPPUNIT_ASSERT(receiver.values().empty());
+    waitForValues(receiver, 1);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, receiver.values().size());
+
+    // Complete a batch that had a flush scheduled, then start a new partial
+    // batch; the new batch must still be sent after the delay
+    for (int index = 1; index <= 4; ++index) {
+        message.value = index;
+        _supplier->sendMessage(message);
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, receiver.values().size());
+    message.value = 5;
+    _supplier->sendMessage(message);
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, receiver.values().size());
+    waitForValues(receiver, 6);
+    CPPUNIT_ASSERT_EQUAL((size_t) 6, receiver.values().size());
+    CPPUNIT_ASSERT_EQUAL((CORBA::Long) 5, receiver.values().back());
+}
+
+void MessagingTest::testBatchingPush()
+{
+    ThreadReceiver receiver;
+    _consumer->registerMessage(direct_message_struct::getId(), &receiver, &ThreadReceiver::messageReceived);
+    _connectRemote("remote");
+    _supplier->setBatching(4, 0.0);
+
+    direct_message_struct message;
+    message.value = 0;
+    _supplier->sendMessage(message);
+    message.value = 1;
+    _supplier->sendMessage(message);
+    CPPUNIT_ASSERT(receiver.values().empty());
+
+    // A raw push sends the partial batch first, so that ordering is kept
+    message.value = 2;
+    CORBA::Any value;
+    value <<= message;
+    redhawk::PropertyMap messages;
+    messages[direct_message_struct::getId()] = value;
+    CORBA::Any any;
+    any <<= messages;
+    _supplier->push(any);
+
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, receiver.values().size());
+    for (size_t index = 0; index < receiver.values().size(); ++index) {
+        CPPUNIT_ASSERT_EQUAL((CORBA::Long) index, receiver.values()[index]);
+    }
+}
+
+void MessagingTest::testBatchingDisconnect()
+{
+    ThreadReceiver receiver;
+    _consumer->registerMessage(direct_message_struct::getId(), &receiver, &ThreadReceiver::messageReceived);
+    _connectRemote("remote");
+    _supplier->setBatching(4, 0.0);
+
+    direct_message_struct message;
+    message.value = 0;
+    _supplier->sendMessage(message);
+    message.value = 1;
+    _supplier->sendMessage(message);
+    CPPUNIT_ASSERT(receiver.values().empty());
+
+    // Disconnecting sends the partial batch
+    _supplier->disconnectPort("remote");
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, receiver.values().size());
+}
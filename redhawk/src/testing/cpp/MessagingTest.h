@@ -40,6 +40,12 @@ class MessagingTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testGenericCallback);
     CPPUNIT_TEST(testPush);
     CPPUNIT_TEST(testPushConnectionId);
+    CPPUNIT_TEST(testThreadedDispatch);
+    CPPUNIT_TEST(testThreadedDispatchDisableFromCallback);
+    CPPUNIT_TEST(testBatching);
+    CPPUNIT_TEST(testBatchingDelay);
+    CPPUNIT_TEST(testBatchingPush);
+    CPPUNIT_TEST(testBatchingDisconnect);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -61,8 +67,19 @@ public:
     void testPush();
     void testPushConnectionId();
 
+    void testThreadedDispatch();
+    void testThreadedDispatchDisableFromCallback();
+
+    void testBatching();
+    void testBatchingDelay();
+    void testBatchingPush();
+    void testBatchingDisconnect();
+
 private:
+    void _connectRemote(const std::string& connectionId);
+
     PortManager _portManager;
+    PortableServer::ServantBase* _forwarder;
 
     MessageSupplierPort* _supplier;
     MessageConsumerPort* _consumer;
@@ -0,0 +1,158 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "PropertyTableTest.h"
+
+#include <ossie/PropertySet_impl.h>
+#include <ossie/PropertyTable.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PropertyTableTest);
+
+using redhawk::PropertyTable;
+
+namespace {
+    // Table as emitted by the code generator (redhawk.codegen.lang.cpp's
+    // propertyTable()) for these identifiers
+    const redhawk::PropertyDescriptor DESCRIPTORS[] = {
+        { "DCE:cdc5ee18-7ceb-4ae6-bf4c-31f983179b4d", "device_kind_dce", "readonly", "", "eq", "allocation" },
+        { "bandwidth", "bandwidth", "readwrite", "Hz", "external", "property" },
+        { "device_kind", "device_kind", "readonly", "", "eq", "allocation" },
+        { "device_model", "device_model", "readonly", "", "eq", "allocation" },
+        { "frequency", "frequency", "readwrite", "Hz", "external", "property,configure" },
+        { "frontend_tuner_status", "frontend_tuner_status", "readonly", "", "external", "property" },
+        { "gain", "gain", "readwrite", "dB", "external", "property" },
+        { "sample_rate", "sample_rate", "readwrite", "sps", "external", "property" }
+    };
+
+    const unsigned int DISPLACEMENTS[] = {
+        1, 1, 5, 1
+    };
+
+    const short SLOTS[] = {
+        1, -1, 2, 0, -1, 3, 6, -1, 5, 4, 7
+    };
+
+    const PropertyTable TABLE = {
+        DESCRIPTORS, 8,
+        DISPLACEMENTS, 4,
+        SLOTS, 11
+    };
+
+    class TablePropertySet : public PropertySet_impl
+    {
+    public:
+        TablePropertySet() :
+            frequency(0.0),
+            gain(0.0)
+        {
+            addProperty(frequency, 100.0e6, TABLE, 4);
+            addProperty(gain, TABLE, 6);
+            addProperty(device_kind, std::string("RX_DIGITIZER"), std::string("device_kind"), "",
+                        "readonly", "", "eq", "allocation");
+        }
+
+        using PropertySet_impl::replaceProperty;
+
+        double frequency;
+        double gain;
+        std::string device_kind;
+    };
+}
+
+void PropertyTableTest::testHash()
+{
+    // Known values from redhawk.codegen.lang.cpp's propertyHash(); if these
+    // disagree, generated tables will never find their properties
+    CPPUNIT_ASSERT_EQUAL(2872998923u, PropertyTable::hash("", 0));
+    CPPUNIT_ASSERT_EQUAL(444641715u, PropertyTable::hash("a", 0));
+    CPPUNIT_ASSERT_EQUAL(2731968032u, PropertyTable::hash("frequency", 0));
+    CPPUNIT_ASSERT_EQUAL(359568086u, PropertyTable::hash("frequency", 1));
+    CPPUNIT_ASSERT_EQUAL(721965050u, PropertyTable::hash("frontend_tuner_status", 12345));
+    CPPUNIT_ASSERT_EQUAL(1214782043u, PropertyTable::hash("DCE:a4e7b230-1d17-4a86-aeff-ddc6ea3df26e", 1));
+}
+
+void PropertyTableTest::testFind()
+{
+    for (size_t index = 0; index < TABLE.count; ++index) {
+        CPPUNIT_ASSERT_EQUAL((int) index, TABLE.find(DESCRIPTORS[index].id));
+    }
+}
+
+void PropertyTableTest::testFindMissing()
+{
+    CPPUNIT_ASSERT_EQUAL(-1, TABLE.find(""));
+    CPPUNIT_ASSERT_EQUAL(-1, TABLE.find("freq"));
+    CPPUNIT_ASSERT_EQUAL(-1, TABLE.find("frequency "));
+    CPPUNIT_ASSERT_EQUAL(-1, TABLE.find("FREQUENCY"));
+    CPPUNIT_ASSERT_EQUAL(-1, TABLE.find("DCE:a4e7b230-1d17-4a86-aeff-ddc6ea3df26e"));
+}
+
+void PropertyTableTest::testEmpty()
+{
+    const PropertyTable empty = { 0, 0, 0, 0, 0, 0 };
+    CPPUNIT_ASSERT_EQUAL(-1, empty.find("frequency"));
+}
+
+void PropertyTableTest::testAddProperty()
+{
+    TablePropertySet properties;
+
+    // The descriptor is applied to the wrapper, with the kinds split
+    PropertyInterface* frequency = properties.getPropertyFromId("frequency");
+    CPPUNIT_ASSERT(frequency);
+    CPPUNIT_ASSERT_EQUAL(std::string("frequency"), frequency->id);
+    CPPUNIT_ASSERT_EQUAL(std::string("readwrite"), frequency->mode);
+    CPPUNIT_ASSERT_EQUAL(std::string("Hz"), frequency->units);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, frequency->kinds.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("property"), frequency->kinds[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("configure"), frequency->kinds[1]);
+    CPPUNIT_ASSERT(!frequency->isNil());
+    CPPUNIT_ASSERT_EQUAL(100.0e6, properties.frequency);
+
+    // No initial value
+    PropertyInterface* gain = properties.getPropertyFromId("gain");
+    CPPUNIT_ASSERT(gain);
+    CPPUNIT_ASSERT(gain->isNil());
+
+    // Properties added without the table are found through the map, and
+    // entries in the table that were never added are not found at all
+    CPPUNIT_ASSERT(properties.getPropertyFromId("device_kind"));
+    CPPUNIT_ASSERT(!properties.getPropertyFromId("bandwidth"));
+    CPPUNIT_ASSERT(!properties.getPropertyFromId("nonexistent"));
+
+    // The table-based properties are still visible to query
+    CF::Properties results;
+    properties.query(results);
+    redhawk::PropertyMap& values = redhawk::PropertyMap::cast(results);
+    CPPUNIT_ASSERT(values.contains("frequency"));
+    CPPUNIT_ASSERT_EQUAL(100.0e6, values["frequency"].toDouble());
+}
+
+void PropertyTableTest::testReplaceProperty()
+{
+    TablePropertySet properties;
+
+    // Replacing a table-based property must update the table's entry, or
+    // lookups would return the deleted wrapper
+    PropertyInterface* wrapper = PropertyWrapperFactory::Create(properties.frequency);
+    CPPUNIT_ASSERT(properties.replaceProperty("frequency", wrapper) == wrapper);
+    CPPUNIT_ASSERT(properties.getPropertyFromId("frequency") == wrapper);
+    CPPUNIT_ASSERT_EQUAL(std::string("Hz"), wrapper->units);
+}
@@ -0,0 +1,428 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "PublisherTest.h"
+
+#include <vector>
+
+#include <boost/thread.hpp>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PublisherTest);
+
+// Minimal event channel that records the events pushed to it. While held,
+// push blocks, so that tests can control when the publisher's queue drains.
+class RecordingConsumer : public virtual POA_CosEventChannelAdmin::ProxyPushConsumer
+{
+public:
+    RecordingConsumer() :
+        _held(false),
+        _pushing(0)
+    {
+    }
+
+    void push(const CORBA::Any& data)
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        ++_pushing;
+        _cond.notify_all();
+        while (_held) {
+            _cond.wait(lock);
+        }
+        --_pushing;
+        _events.push_back(data);
+    }
+
+    void disconnect_push_consumer()
+    {
+    }
+
+    void connect_push_supplier(CosEventComm::PushSupplier_ptr)
+    {
+    }
+
+    void hold()
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _held = true;
+    }
+
+    void release()
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        _held = false;
+        _cond.notify_all();
+    }
+
+    // Waits up to a second for a push to block on the hold
+    bool waitForPush()
+    {
+        boost::system_time deadline = boost::get_system_time() + boost::posix_time::seconds(1);
+        boost::mutex::scoped_lock lock(_mutex);
+        while (_pushing == 0) {
+            if (!_cond.timed_wait(lock, deadline)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<CORBA::Any> events()
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        return _events;
+    }
+
+    std::vector<CORBA::Long> values()
+    {
+        boost::mutex::scoped_lock lock(_mutex);
+        std::vector<CORBA::Long> result;
+        for (size_t index = 0; index < _events.size(); ++index) {
+            CORBA::Long value;
+            if (_events[index] >>= value) {
+                result.push_back(value);
+            }
+        }
+        return result;
+    }
+
+private:
+    boost::mutex _mutex;
+    boost::condition_variable _cond;
+    bool _held;
+    int _pushing;
+    std::vector<CORBA::Any> _events;
+};
+
+class RecordingSupplierAdmin : public virtual POA_CosEventChannelAdmin::SupplierAdmin
+{
+public:
+    RecordingSupplierAdmin(CosEventChannelAdmin::ProxyPushConsumer_ptr consumer) :
+        _consumer(CosEventChannelAdmin::ProxyPushConsumer::_duplicate(consumer))
+    {
+    }
+
+    CosEventChannelAdmin::ProxyPushConsumer_ptr obtain_push_consumer()
+    {
+        return CosEventChannelAdmin::ProxyPushConsumer::_duplicate(_consumer);
+    }
+
+    CosEventChannelAdmin::ProxyPullConsumer_ptr obtain_pull_consumer()
+    {
+        return CosEventChannelAdmin::ProxyPullConsumer::_nil();
+    }
+
+private:
+    CosEventChannelAdmin::ProxyPushConsumer_var _consumer;
+};
+
+class RecordingChannel : public virtual POA_CosEventChannelAdmin::EventChannel
+{
+public:
+    RecordingChannel(CosEventChannelAdmin::SupplierAdmin_ptr admin) :
+        _admin(CosEventChannelAdmin::SupplierAdmin::_duplicate(admin))
+    {
+    }
+
+    CosEventChannelAdmin::ConsumerAdmin_ptr for_consumers()
+    {
+        return CosEventChannelAdmin::ConsumerAdmin::_nil();
+    }
+
+    CosEventChannelAdmin::SupplierAdmin_ptr for_suppliers()
+    {
+        return CosEventChannelAdmin::SupplierAdmin::_duplicate(_admin);
+    }
+
+    void destroy()
+    {
+    }
+
+private:
+    CosEventChannelAdmin::SupplierAdmin_var _admin;
+};
+
+namespace {
+    void deactivate(PortableServer::ServantBase* servant)
+    {
+        PortableServer::POA_var poa = servant->_default_POA();
+        PortableServer::ObjectId_var oid = poa->servant_to_id(servant);
+        poa->deactivate_object(oid);
+        servant->_remove_ref();
+    }
+
+    void releaseAfter(RecordingConsumer* consumer, int milliseconds)
+    {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(milliseconds));
+        consumer->release();
+    }
+}
+
+void PublisherTest::setUp()
+{
+    _consumer = new RecordingConsumer();
+    CosEventChannelAdmin::ProxyPushConsumer_var consumer = _consumer->_this();
+    _admin = new RecordingSupplierAdmin(consumer);
+    CosEventChannelAdmin::SupplierAdmin_var admin = _admin->_this();
+    _channel = new RecordingChannel(admin);
+    CosEventChannelAdmin::EventChannel_var channel = _channel->_this();
+
+    _publisher = new redhawk::events::Publisher(channel);
+}
+
+void PublisherTest::tearDown()
+{
+    // Never leave the sender blocked on the consumer
+    _consumer->release();
+    delete _publisher;
+
+    deactivate(_channel);
+    deactivate(_admin);
+    deactivate(_consumer);
+}
+
+int PublisherTest::_push(CORBA::Long value)
+{
+    CORBA::Any data;
+    data <<= value;
+    return _publisher->push(data);
+}
+
+int PublisherTest::_pushStateChange(const std::string& sourceId,
+                                    StandardEvent::StateChangeType stateChangeFrom,
+                                    StandardEvent::StateChangeType stateChangeTo)
+{
+    StandardEvent::StateChangeEventType event;
+    event.producerId = "producer";
+    event.sourceId = sourceId.c_str();
+    event.stateChangeCategory = StandardEvent::USAGE_STATE_EVENT;
+    event.stateChangeFrom = stateChangeFrom;
+    event.stateChangeTo = stateChangeTo;
+    CORBA::Any data;
+    data <<= event;
+    return _publisher->push(data);
+}
+
+void PublisherTest::testSynchronous()
+{
+    // By default, the event is sent before push returns
+    CPPUNIT_ASSERT(!_publisher->isAsync());
+    CPPUNIT_ASSERT_EQUAL(0, _push(1));
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, _consumer->values().size());
+
+    // Asynchronous statistics are not updated
+    redhawk::events::Publisher::AsyncStatistics stats = _publisher->asyncStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, stats.queued);
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, stats.sent);
+}
+
+void PublisherTest::testAsync()
+{
+    _publisher->setAsync(10);
+    CPPUNIT_ASSERT(_publisher->isAsync());
+
+    // With the consumer held, push still returns right away
+    _consumer->hold();
+    for (CORBA::Long value = 0; value < 5; ++value) {
+        CPPUNIT_ASSERT_EQUAL(0, _push(value));
+    }
+    CPPUNIT_ASSERT(_consumer->waitForPush());
+    CPPUNIT_ASSERT(_consumer->values().empty());
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, _publisher->asyncStatistics().queueDepth);
+
+    // Once released, the events arrive in order
+    _consumer->release();
+    _publisher->flush();
+    std::vector<CORBA::Long> values = _consumer->values();
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, values.size());
+    for (size_t index = 0; index < values.size(); ++index) {
+        CPPUNIT_ASSERT_EQUAL((CORBA::Long) index, values[index]);
+    }
+
+    redhawk::events::Publisher::AsyncStatistics stats = _publisher->asyncStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, stats.queueDepth);
+    CPPUNIT_ASSERT_EQUAL((size_t) 10, stats.maxQueue);
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, stats.queued);
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, stats.sent);
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, stats.dropped);
+
+    // Returning to synchronous mode sends on the caller's thread again
+    _publisher->setAsync(0);
+    CPPUNIT_ASSERT(!_publisher->isAsync());
+    CPPUNIT_ASSERT_EQUAL(0, _push(5));
+    CPPUNIT_ASSERT_EQUAL((size_t) 6, _consumer->values().size());
+}
+
+void PublisherTest::testBatching()
+{
+    _publisher->setAsync(10, 4);
+
+    // Hold the first event in flight, so that the rest back up and are sent
+    // as batches
+    _consumer->hold();
+    CPPUNIT_ASSERT_EQUAL(0, _push(0));
+    CPPUNIT_ASSERT(_consumer->waitForPush());
+    for (CORBA::Long value = 1; value < 10; ++value) {
+        CPPUNIT_ASSERT_EQUAL(0, _push(value));
+    }
+    _consumer->release();
+    _publisher->flush();
+
+    std::vector<CORBA::Long> values = _consumer->values();
+    CPPUNIT_ASSERT_EQUAL((size_t) 10, values.size());
+    for (size_t index = 0; index < values.size(); ++index) {
+        CPPUNIT_ASSERT_EQUAL((CORBA::Long) index, values[index]);
+    }
+    CPPUNIT_ASSERT_EQUAL((size_t) 10, _publisher->asyncStatistics().sent);
+}
+
+void PublisherTest::testDrops()
+{
+    _publisher->setAsync(2);
+
+    // The first event is taken off of the queue by the sender, leaving room
+    // for two more
+    _consumer->hold();
+    CPPUNIT_ASSERT_EQUAL(0, _push(0));
+    CPPUNIT_ASSERT(_consumer->waitForPush());
+    CPPUNIT_ASSERT_EQUAL(0, _push(1));
+    CPPUNIT_ASSERT_EQUAL(0, _push(2));
+
+    // The queue is full, so further events are rejected
+    CPPUNIT_ASSERT_EQUAL(-1, _push(3));
+    CPPUNIT_ASSERT_EQUAL(-1, _push(4));
+
+    redhawk::events::Publisher::AsyncStatistics stats = _publisher->asyncStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, stats.queueDepth);
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, stats.queued);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, stats.dropped);
+
+    // Only the accepted events are delivered
+    _consumer->release();
+    _publisher->flush();
+    std::vector<CORBA::Long> values = _consumer->values();
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, values.size());
+    CPPUNIT_ASSERT_EQUAL((CORBA::Long) 0, values[0]);
+    CPPUNIT_ASSERT_EQUAL((CORBA::Long) 1, values[1]);
+    CPPUNIT_ASSERT_EQUAL((CORBA::Long) 2, values[2]);
+
+    // Once drained, the queue accepts events again
+    CPPUNIT_ASSERT_EQUAL(0, _push(5));
+    _publisher->flush();
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, _consumer->values().size());
+}
+
+void PublisherTest::testCoalescing()
+{
+    _publisher->setAsync(10);
+    _publisher->setCoalescing(true);
+
+    // Hold an unrelated event in flight so that state changes queue up
+    _consumer->hold();
+    CPPUNIT_ASSERT_EQUAL(0, _push(0));
+    CPPUNIT_ASSERT(_consumer->waitForPush());
+
+    // Successive changes for the same source fold into one event, while a
+    // change for another source is queued separately
+    CPPUNIT_ASSERT_EQUAL(0, _pushStateChange("source_1", StandardEvent::IDLE, StandardEvent::ACTIVE));
+    CPPUNIT_ASSERT_EQUAL(0, _pushStateChange("source_2", StandardEvent::IDLE, StandardEvent::BUSY));
+    CPPUNIT_ASSERT_EQUAL(0, _pushStateChange("source_1", StandardEvent::ACTIVE, StandardEvent::BUSY));
+    CPPUNIT_ASSERT_EQUAL(0, _pushStateChange("source_1", StandardEvent::BUSY, StandardEvent::ACTIVE));
+
+    redhawk::events::Publisher::AsyncStatistics stats = _publisher->asyncStatistics();
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, stats.queued);
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, stats.coalesced);
+
+    _consumer->release();
+    _publisher->flush();
+    std::vector<CORBA::Any> events = _consumer->events();
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, events.size());
+
+    // The merged event keeps its place in the queue, and goes from the first
+    // event's starting state to the last event's final state
+    const StandardEvent::StateChangeEventType* event;
+    CPPUNIT_ASSERT(events[1] >>= event);
+    CPPUNIT_ASSERT_EQUAL(std::string("source_1"), std::string(event->sourceId));
+    CPPUNIT_ASSERT_EQUAL(StandardEvent::IDLE, event->stateChangeFrom);
+    CPPUNIT_ASSERT_EQUAL(StandardEvent::ACTIVE, event->stateChangeTo);
+
+    CPPUNIT_ASSERT(events[2] >>= event);
+    CPPUNIT_ASSERT_EQUAL(std::string("source_2"), std::string(event->sourceId));
+    CPPUNIT_ASSERT_EQUAL(StandardEvent::IDLE, event->stateChangeFrom);
+    CPPUNIT_ASSERT_EQUAL(StandardEvent::BUSY, event->stateChangeTo);
+
+    // After the event has been sent, a new change is queued on its own
+    _consumer->hold();
+    CPPUNIT_ASSERT_EQUAL(0, _pushStateChange("source_1", StandardEvent::ACTIVE, StandardEvent::IDLE));
+    CPPUNIT_ASSERT(_consumer->waitForPush());
+    CPPUNIT_ASSERT_EQUAL(0, _pushStateChange("source_1", StandardEvent::IDLE, StandardEvent::BUSY));
+    _consumer->release();
+    _publisher->flush();
+    CPPUNIT_ASSERT_EQUAL((size_t) 5, _consumer->events().size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, _publisher->asyncStatistics().coalesced);
+}
+
+void PublisherTest::testFlush()
+{
+    _publisher->setAsync(10);
+
+    // Flush with nothing queued returns immediately
+    _publisher->flush();
+
+    _consumer->hold();
+    for (CORBA::Long value = 0; value < 3; ++value) {
+        CPPUNIT_ASSERT_EQUAL(0, _push(value));
+    }
+    CPPUNIT_ASSERT(_consumer->waitForPush());
+
+    // Release the consumer from another thread while this one waits; flush
+    // must not return until the last event has been delivered
+    boost::thread releaser(&releaseAfter, _consumer, 100);
+    _publisher->flush();
+    releaser.join();
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, _consumer->values().size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, _publisher->asyncStatistics().queueDepth);
+}
+
+void PublisherTest::testStopOrdering()
+{
+    _publisher->setAsync(10);
+
+    // Leave events queued behind one that is in flight
+    _consumer->hold();
+    CPPUNIT_ASSERT_EQUAL(0, _push(0));
+    CPPUNIT_ASSERT(_consumer->waitForPush());
+    CPPUNIT_ASSERT_EQUAL(0, _push(1));
+    CPPUNIT_ASSERT_EQUAL(0, _push(2));
+
+    // Returning to synchronous mode drains the queue; events pushed while it
+    // does so must go behind the queued ones rather than around them
+    boost::thread stopper(&redhawk::events::Publisher::setAsync, _publisher, 0, 1);
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    CPPUNIT_ASSERT_EQUAL(0, _push(3));
+    _consumer->release();
+    stopper.join();
+    CPPUNIT_ASSERT(!_publisher->isAsync());
+
+    std::vector<CORBA::Long> values = _consumer->values();
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, values.size());
+    for (size_t index = 0; index < values.size(); ++index) {
+        CPPUNIT_ASSERT_EQUAL((CORBA::Long) index, values[index]);
+    }
+}
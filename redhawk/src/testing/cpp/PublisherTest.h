@@ -0,0 +1,69 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef PUBLISHERTEST_H
+#define PUBLISHERTEST_H
+
+#include "CFTest.h"
+
+#include <ossie/Events.h>
+#include <ossie/CF/StandardEvent.h>
+
+class RecordingChannel;
+class RecordingSupplierAdmin;
+class RecordingConsumer;
+
+class PublisherTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(PublisherTest);
+    CPPUNIT_TEST(testSynchronous);
+    CPPUNIT_TEST(testAsync);
+    CPPUNIT_TEST(testBatching);
+    CPPUNIT_TEST(testDrops);
+    CPPUNIT_TEST(testCoalescing);
+    CPPUNIT_TEST(testFlush);
+    CPPUNIT_TEST(testStopOrdering);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testSynchronous();
+    void testAsync();
+    void testBatching();
+    void testDrops();
+    void testCoalescing();
+    void testFlush();
+    void testStopOrdering();
+
+private:
+    int _push(CORBA::Long value);
+    int _pushStateChange(const std::string& sourceId,
+                         StandardEvent::StateChangeType stateChangeFrom,
+                         StandardEvent::StateChangeType stateChangeTo);
+
+    RecordingConsumer* _consumer;
+    RecordingSupplierAdmin* _admin;
+    RecordingChannel* _channel;
+    redhawk::events::Publisher* _publisher;
+};
+
+#endif // PUBLISHERTEST_H
@@ -529,3 +529,41 @@ void SharedBufferTest::testGetMemory()
     redhawk::shared_buffer<float> transient = redhawk::shared_buffer<float>::make_transient(data, BUFFER_SIZE);
     CPPUNIT_ASSERT_EQUAL((const void*) 0, transient.get_memory().address());
 }
+
+void SharedBufferTest::testReclaim()
+{
+    // A newly-created buffer is the only reference to its memory (use a
+    // process-local allocator so that the result does not depend on whether
+    // shared memory is available)
+    redhawk::buffer<short> original(16, std::allocator<short>());
+    std::fill(original.begin(), original.end(), 5);
+    const short* data = original.data();
+    redhawk::shared_buffer<short> shared = original;
+    CPPUNIT_ASSERT(!shared.unique());
+    original = redhawk::buffer<short>();
+    CPPUNIT_ASSERT(shared.unique());
+
+    // Reclaiming a unique buffer should transfer the memory without a copy,
+    // leaving the source empty
+    redhawk::buffer<short> reclaimed = redhawk::buffer<short>::reclaim(shared);
+    CPPUNIT_ASSERT(shared.empty());
+    CPPUNIT_ASSERT(!shared.unique());
+    CPPUNIT_ASSERT(reclaimed.unique());
+    CPPUNIT_ASSERT(reclaimed.data() == data);
+    CPPUNIT_ASSERT_EQUAL((size_t) 16, reclaimed.size());
+
+    // With another reference, reclaiming must make a copy
+    shared = reclaimed;
+    redhawk::buffer<short> copied = redhawk::buffer<short>::reclaim(shared);
+    CPPUNIT_ASSERT(shared.empty());
+    CPPUNIT_ASSERT(copied.data() != reclaimed.data());
+    CPPUNIT_ASSERT(copied == reclaimed);
+
+    // Transient buffers are never unique
+    short values[] = { 1, 2, 3, 4 };
+    shared = redhawk::shared_buffer<short>::make_transient(values, 4);
+    CPPUNIT_ASSERT(!shared.unique());
+    copied = redhawk::buffer<short>::reclaim(shared);
+    CPPUNIT_ASSERT(copied.data() != values);
+    CPPUNIT_ASSERT(std::equal(copied.begin(), copied.end(), values));
+}
@@ -45,6 +45,7 @@ class SharedBufferTest : public CppUnit::TestFixture
     CPPUNIT_TEST(testCustomDeleter);
     CPPUNIT_TEST(testTransient);
     CPPUNIT_TEST(testGetMemory);
+    CPPUNIT_TEST(testReclaim);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -77,6 +78,7 @@ public:
     void testCustomDeleter();
     void testTransient();
     void testGetMemory();
+    void testReclaim();
 
 private:
     template <class Buffer>
@@ -0,0 +1,242 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "ShmHeapTest.h"
+
+#include <sstream>
+#include <vector>
+#include <unistd.h>
+
+#include <ossie/shm/Allocator.h>
+#include <ossie/shm/Heap.h>
+#include <ossie/shm/SuperblockFile.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ShmHeapTest);
+
+using redhawk::shm::Heap;
+using redhawk::shm::SuperblockFile;
+
+void ShmHeapTest::setUp()
+{
+    std::ostringstream oss;
+    oss << "ShmHeapTest-" << getpid();
+    _name = oss.str();
+}
+
+void ShmHeapTest::tearDown()
+{
+}
+
+void ShmHeapTest::testInternTag()
+{
+    SuperblockFile file(_name);
+    file.create();
+
+    // The empty tag is always index 0
+    CPPUNIT_ASSERT_EQUAL((uint32_t) 0, file.internTag(""));
+    CPPUNIT_ASSERT_EQUAL(std::string(), file.getTag(0));
+
+    const uint32_t first = file.internTag("port/connection_1");
+    CPPUNIT_ASSERT(first != 0);
+    CPPUNIT_ASSERT_EQUAL(std::string("port/connection_1"), file.getTag(first));
+
+    // Interning the same name again returns the same index
+    CPPUNIT_ASSERT_EQUAL(first, file.internTag("port/connection_1"));
+
+    const uint32_t second = file.internTag("port/connection_2");
+    CPPUNIT_ASSERT(second != first);
+    CPPUNIT_ASSERT_EQUAL(std::string("port/connection_2"), file.getTag(second));
+
+    // Long names are truncated, and still match
+    const std::string long_name(100, 'x');
+    const uint32_t third = file.internTag(long_name);
+    CPPUNIT_ASSERT(third != 0);
+    CPPUNIT_ASSERT_EQUAL(third, file.internTag(long_name));
+    CPPUNIT_ASSERT(file.getTag(third).size() < long_name.size());
+    CPPUNIT_ASSERT_EQUAL(0, long_name.compare(0, file.getTag(third).size(), file.getTag(third)));
+}
+
+void ShmHeapTest::testReleaseTag()
+{
+    SuperblockFile file(_name);
+    file.create();
+
+    // Take two references to the first tag
+    const uint32_t first = file.internTag("first");
+    CPPUNIT_ASSERT_EQUAL(first, file.internTag("first"));
+    const uint32_t second = file.internTag("second");
+
+    // With one reference remaining, the entry is not reused
+    file.releaseTag(first);
+    CPPUNIT_ASSERT(file.internTag("third") != first);
+
+    // Once it is no longer referenced, its name is kept until the entry is
+    // reused for another tag
+    file.releaseTag(first);
+    CPPUNIT_ASSERT_EQUAL(std::string("first"), file.getTag(first));
+    CPPUNIT_ASSERT_EQUAL(first, file.internTag("fourth"));
+    CPPUNIT_ASSERT_EQUAL(std::string("fourth"), file.getTag(first));
+    CPPUNIT_ASSERT_EQUAL(std::string("second"), file.getTag(second));
+
+    // Releasing the untagged index or an unknown index is harmless
+    file.releaseTag(0);
+    file.releaseTag(1000);
+}
+
+void ShmHeapTest::testTagTableFull()
+{
+    SuperblockFile file(_name);
+    file.create();
+
+    // Fill the table, then check that further tags are untagged
+    std::vector<uint32_t> tags;
+    for (int index = 0; ; ++index) {
+        std::ostringstream oss;
+        oss << "tag" << index;
+        uint32_t tag = file.internTag(oss.str());
+        if (tag == 0) {
+            break;
+        }
+        tags.push_back(tag);
+        CPPUNIT_ASSERT_MESSAGE("tag table never filled", index < 1000);
+    }
+    CPPUNIT_ASSERT(!tags.empty());
+    CPPUNIT_ASSERT_EQUAL((uint32_t) 0, file.internTag("overflow"));
+
+    // Releasing a tag makes room for another one
+    file.releaseTag(tags[5]);
+    CPPUNIT_ASSERT_EQUAL(tags[5], file.internTag("overflow"));
+    CPPUNIT_ASSERT_EQUAL((uint32_t) 0, file.internTag("overflow2"));
+}
+
+void ShmHeapTest::testUsage()
+{
+    Heap heap(_name);
+
+    SuperblockFile::Usage initial = heap.getUsage();
+    CPPUNIT_ASSERT(initial.complete);
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, initial.blocks);
+
+    std::vector<void*> ptrs;
+    for (int ii = 0; ii < 4; ++ii) {
+        void* ptr = heap.allocate(1000);
+        CPPUNIT_ASSERT(ptr);
+        ptrs.push_back(ptr);
+    }
+
+    SuperblockFile::Usage usage = heap.getUsage();
+    CPPUNIT_ASSERT(usage.complete);
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, usage.blocks);
+    CPPUNIT_ASSERT(usage.bytes >= 4000);
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, usage.sharedBlocks);
+    CPPUNIT_ASSERT(usage.freeBytes > 0);
+    CPPUNIT_ASSERT(usage.largestFree <= usage.freeBytes);
+
+    // Everything was just allocated, so it is all in the youngest buckets
+    size_t aged = 0;
+    for (size_t bucket = 0; bucket < SuperblockFile::AGE_BUCKETS; ++bucket) {
+        aged += usage.ages[bucket];
+    }
+    CPPUNIT_ASSERT_EQUAL(usage.blocks, aged);
+    CPPUNIT_ASSERT_EQUAL(usage.blocks, usage.ages[0] + usage.ages[1]);
+
+    // The untagged allocations are reported under the empty tag
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, usage.tags.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, usage.tags[""].blocks);
+
+    heap.deallocate(ptrs.back());
+    ptrs.pop_back();
+    usage = heap.getUsage();
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, usage.blocks);
+
+    for (size_t ii = 0; ii < ptrs.size(); ++ii) {
+        heap.deallocate(ptrs[ii]);
+    }
+    usage = heap.getUsage();
+    CPPUNIT_ASSERT_EQUAL((size_t) 0, usage.blocks);
+    CPPUNIT_ASSERT(usage.tags.empty());
+}
+
+void ShmHeapTest::testUsageByTag()
+{
+    Heap heap(_name);
+
+    const uint32_t input = heap.internTag("dataFloat_in/connection_1");
+    const uint32_t output = heap.internTag("dataFloat_out/connection_2");
+
+    std::vector<void*> ptrs;
+    ptrs.push_back(heap.allocate(100, input));
+    ptrs.push_back(heap.allocate(100, input));
+    ptrs.push_back(heap.allocate(5000, output));
+    ptrs.push_back(heap.allocate(100));
+
+    SuperblockFile::Usage usage = heap.getUsage();
+    CPPUNIT_ASSERT_EQUAL((size_t) 4, usage.blocks);
+    CPPUNIT_ASSERT_EQUAL((size_t) 3, usage.tags.size());
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, usage.tags["dataFloat_in/connection_1"].blocks);
+    CPPUNIT_ASSERT(usage.tags["dataFloat_in/connection_1"].bytes >= 200);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, usage.tags["dataFloat_out/connection_2"].blocks);
+    CPPUNIT_ASSERT(usage.tags["dataFloat_out/connection_2"].bytes >= 5000);
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, usage.tags[""].blocks);
+
+    // A released tag still names the blocks allocated under it
+    heap.releaseTag(output);
+    usage = heap.getUsage();
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, usage.tags["dataFloat_out/connection_2"].blocks);
+
+    for (size_t ii = 0; ii < ptrs.size(); ++ii) {
+        heap.deallocate(ptrs[ii]);
+    }
+    heap.releaseTag(input);
+}
+
+void ShmHeapTest::testScopedAllocationTag()
+{
+    CPPUNIT_ASSERT_EQUAL((uint32_t) 0, redhawk::shm::getAllocationTag());
+    {
+        redhawk::shm::ScopedAllocationTag outer(3);
+        CPPUNIT_ASSERT_EQUAL((uint32_t) 3, redhawk::shm::getAllocationTag());
+        {
+            redhawk::shm::ScopedAllocationTag inner(5);
+            CPPUNIT_ASSERT_EQUAL((uint32_t) 5, redhawk::shm::getAllocationTag());
+        }
+        CPPUNIT_ASSERT_EQUAL((uint32_t) 3, redhawk::shm::getAllocationTag());
+    }
+    CPPUNIT_ASSERT_EQUAL((uint32_t) 0, redhawk::shm::getAllocationTag());
+
+    // With the process heap, allocations are recorded under the thread's tag
+    Heap* heap = redhawk::shm::getProcessHeap();
+    if (!heap) {
+        return;
+    }
+    const uint32_t tag = redhawk::shm::internAllocationTag("ShmHeapTest/scoped");
+    CPPUNIT_ASSERT(tag != 0);
+    void* ptr;
+    {
+        redhawk::shm::ScopedAllocationTag scoped(tag);
+        ptr = redhawk::shm::allocate(1024);
+    }
+    CPPUNIT_ASSERT(ptr);
+    SuperblockFile::Usage usage = heap->getUsage();
+    CPPUNIT_ASSERT_EQUAL((size_t) 1, usage.tags["ShmHeapTest/scoped"].blocks);
+
+    redhawk::shm::deallocate(ptr);
+    redhawk::shm::releaseAllocationTag(tag);
+}
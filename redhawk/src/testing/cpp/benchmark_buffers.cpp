@@ -0,0 +1,289 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <new>
+
+#include <unistd.h>
+#include <getopt.h>
+
+#include <ossie/shared_buffer.h>
+#include <ossie/BufferManager.h>
+#include <ossie/shm/Heap.h>
+
+/*
+ * Microbenchmarks for the buffer primitives on the data path.
+ *
+ * Each benchmark runs a fixed number of iterations several times (after a
+ * warm-up pass), and reports the fastest and median time per operation
+ * along with the number of heap allocations per operation, as CSV on
+ * standard output. Reporting the fastest pass makes the results repeatable
+ * enough to compare across releases on the same host.
+ */
+
+#if __cplusplus >= 201103L
+#  define BENCHMARK_THROW_BAD_ALLOC
+#  define BENCHMARK_NOTHROW noexcept
+#else
+#  define BENCHMARK_THROW_BAD_ALLOC throw(std::bad_alloc)
+#  define BENCHMARK_NOTHROW throw()
+#endif
+
+// Replace the global allocation functions to count heap allocations
+static volatile size_t allocation_count = 0;
+
+void* operator new(size_t size) BENCHMARK_THROW_BAD_ALLOC
+{
+    ++allocation_count;
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[](size_t size) BENCHMARK_THROW_BAD_ALLOC
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) BENCHMARK_NOTHROW
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) BENCHMARK_NOTHROW
+{
+    std::free(ptr);
+}
+
+// Prevents the compiler from optimizing away the results of an operation
+static volatile size_t sink = 0;
+
+static double get_time()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + 1e-9*now.tv_nsec;
+}
+
+typedef void (*benchmark_func)(size_t);
+
+struct benchmark {
+    const char* name;
+    benchmark_func func;
+    size_t iterations;
+};
+
+static void run_benchmark(const benchmark& bench, int repeat)
+{
+    // Warm up caches (including BufferManager and shared memory heaps)
+    bench.func(bench.iterations / 10 + 1);
+
+    std::vector<double> times;
+    size_t allocations = 0;
+    for (int pass = 0; pass < repeat; ++pass) {
+        size_t start_count = allocation_count;
+        double start = get_time();
+        bench.func(bench.iterations);
+        double elapsed = get_time() - start;
+        allocations = allocation_count - start_count;
+        times.push_back(elapsed);
+    }
+    std::sort(times.begin(), times.end());
+
+    const double scale = 1e9 / bench.iterations;
+    std::ostringstream line;
+    line.setf(std::ios::fixed);
+    line.precision(2);
+    line << bench.name << "," << bench.iterations << ","
+         << times.front() * scale << "," << times[times.size() / 2] * scale << ","
+         << static_cast<double>(allocations) / bench.iterations;
+    std::cout << line.str() << std::endl;
+}
+
+// shared_buffer benchmarks; 1K floats is a typical packet size
+static const size_t BUFFER_SIZE = 1024;
+
+static void test_buffer_create(size_t iterations)
+{
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        redhawk::buffer<float> buffer(BUFFER_SIZE);
+        sink += buffer.size();
+    }
+}
+
+static void test_buffer_share(size_t iterations)
+{
+    redhawk::buffer<float> buffer(BUFFER_SIZE);
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        redhawk::shared_buffer<float> shared = buffer;
+        sink += shared.size();
+    }
+}
+
+static void test_buffer_slice(size_t iterations)
+{
+    const redhawk::shared_buffer<float> buffer = redhawk::buffer<float>(BUFFER_SIZE);
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        redhawk::shared_buffer<float> slice = buffer.slice(ii % 256, BUFFER_SIZE - 256);
+        sink += slice.size();
+    }
+}
+
+static void test_buffer_copy(size_t iterations)
+{
+    redhawk::buffer<float> buffer(BUFFER_SIZE);
+    std::fill(buffer.begin(), buffer.end(), 0.0);
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        redhawk::buffer<float> copy = buffer.copy();
+        sink += copy.size();
+    }
+}
+
+static void test_buffer_recast(size_t iterations)
+{
+    const redhawk::shared_buffer<float> buffer = redhawk::buffer<float>(BUFFER_SIZE);
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        redhawk::shared_buffer<short> recast = redhawk::shared_buffer<short>::recast(buffer);
+        sink += recast.size();
+    }
+}
+
+// BufferManager benchmarks; repeated allocations of the same size should be
+// satisfied from the thread's cache
+static void test_buffer_manager_small(size_t iterations)
+{
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        void* ptr = redhawk::BufferManager::Allocate(4096);
+        sink += reinterpret_cast<size_t>(ptr);
+        redhawk::BufferManager::Deallocate(ptr);
+    }
+}
+
+static void test_buffer_manager_large(size_t iterations)
+{
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        void* ptr = redhawk::BufferManager::Allocate(1048576);
+        sink += reinterpret_cast<size_t>(ptr);
+        redhawk::BufferManager::Deallocate(ptr);
+    }
+}
+
+// Shared memory heap benchmarks
+static std::string get_heap_name()
+{
+    std::ostringstream name;
+    name << "benchmark-" << getpid();
+    return name.str();
+}
+
+static redhawk::shm::Heap& get_heap()
+{
+    // Created on first use and destroyed at exit, which removes the heap's
+    // file from /dev/shm
+    static redhawk::shm::Heap heap(get_heap_name());
+    return heap;
+}
+
+static void heap_allocate(size_t iterations, size_t bytes)
+{
+    redhawk::shm::Heap& heap = get_heap();
+    for (size_t ii = 0; ii < iterations; ++ii) {
+        void* ptr = heap.allocate(bytes);
+        sink += reinterpret_cast<size_t>(ptr);
+        heap.deallocate(ptr);
+    }
+}
+
+static void test_heap_small(size_t iterations)
+{
+    heap_allocate(iterations, 4096);
+}
+
+static void test_heap_large(size_t iterations)
+{
+    heap_allocate(iterations, 262144);
+}
+
+static const benchmark benchmarks[] = {
+    { "buffer-create", &test_buffer_create, 100000 },
+    { "buffer-share", &test_buffer_share, 1000000 },
+    { "buffer-slice", &test_buffer_slice, 1000000 },
+    { "buffer-copy", &test_buffer_copy, 100000 },
+    { "buffer-recast", &test_buffer_recast, 1000000 },
+    { "buffermanager-4K", &test_buffer_manager_small, 1000000 },
+    { "buffermanager-1M", &test_buffer_manager_large, 100000 },
+    { "shm-heap-4K", &test_heap_small, 1000000 },
+    { "shm-heap-256K", &test_heap_large, 100000 },
+};
+
+#define ARRAY_ELEMENTS(x) (sizeof(x) / sizeof(x[0]))
+
+int main(int argc, char* argv[])
+{
+    int repeat = 5;
+
+    struct option long_options[] = {
+        { "repeat", required_argument, 0, 0 },
+        { 0, 0, 0, 0 }
+    };
+
+    int option_index;
+    while (true) {
+        int status = getopt_long(argc, argv, "", long_options, &option_index);
+        if (status == '?') {
+            // Invalid option
+            return -1;
+        } else if (status == 0) {
+            if (option_index == 0) {
+                repeat = std::max(atoi(optarg), 1);
+            }
+        } else {
+            // End of arguments
+            break;
+        }
+    }
+
+    std::cout << "name,iterations,min(nsec/op),median(nsec/op),allocations/op" << std::endl;
+    for (size_t ii = 0; ii < ARRAY_ELEMENTS(benchmarks); ++ii) {
+        const benchmark& bench = benchmarks[ii];
+        // With no arguments run everything; otherwise, only run benchmarks
+        // whose name starts with one of the arguments
+        bool selected = (optind >= argc);
+        for (int arg = optind; arg < argc; ++arg) {
+            if (std::string(bench.name).compare(0, strlen(argv[arg]), argv[arg]) == 0) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            run_benchmark(bench, repeat);
+        }
+    }
+
+    return 0;
+}
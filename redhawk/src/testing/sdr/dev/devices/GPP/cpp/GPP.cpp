@@ -1319,6 +1319,17 @@ CF::ExecutableDevice::ProcessID_Type GPP_i::do_execute (const char* name, const
         args.push_back(ossie::any_to_string(parameters[i].value));
     }
 
+    // Thread role affinity is applied by the resource as its threads start
+    try {
+        std::string thread_affinity = redhawk::affinity::get_thread_affinity(options);
+        if (!thread_affinity.empty()) {
+            args.push_back(redhawk::affinity::THREAD_AFFINITY_ID);
+            args.push_back(thread_affinity);
+        }
+    } catch (...) {
+        LOG_WARN(GPP_i, "Unable to read thread affinity directives");
+    }
+
     LOG_DEBUG(GPP_i, "Forking process " << path);
 
     std::vector<char*> argv(args.size() + 1, NULL);
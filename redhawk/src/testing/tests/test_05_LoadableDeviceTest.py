@@ -567,6 +567,47 @@ class LoadableDeviceTest(scatest.CorbaTestCase):
     def test_py_FileChanged(self):
         self._test_FileChanged("BasicTestDevice_node", "BasicTestDevice1")
 
+    def test_cpp_LocalCopy(self):
+        # Files served from the same host are copied from their local path;
+        # check the cached contents both with and without the local copy
+        deviceCacheDir = os.path.join(scatest.getSdrCache(), ".ExecutableDevice_node", "ExecutableDevice1")
+        if os.path.exists(deviceCacheDir):
+            os.system("rm -rf %s" % deviceCacheDir)
+
+        fileMgr = self._domMgr._get_fileMgr()
+        devBooter, devMgr = self.launchDeviceManager(dcdFile="/nodes/test_ExecutableDevice_node/DeviceManager.dcd.xml")
+        self.assertNotEqual(devMgr, None)
+        scatest.verifyDeviceLaunch(self, devMgr, 1)
+        device = devMgr._get_registeredDevices()[0]
+
+        # The local copy is enabled by default
+        props = device.query([CF.DataType(id='LoadableDevice::local_copy', value=any.to_any(None))])
+        self.assertEqual(props[0].value._v, True)
+
+        testFile = 'local_copy.out'
+        srcFile = os.path.join(os.environ['SDRROOT'], 'dom', testFile)
+        self._testFiles.append(srcFile)
+        cacheFile = os.path.join(deviceCacheDir, testFile)
+
+        contents = ''.join(chr(x % 256) for x in xrange(100000))
+        f = open(srcFile, 'w')
+        f.write(contents)
+        f.close()
+        device.load(fileMgr, '/' + testFile, CF.LoadableDevice.EXECUTABLE)
+        self.assertEqual(open(cacheFile, 'r').read(), contents)
+
+        # Disable the local copy, change the file and force a transfer
+        device.configure([CF.DataType(id='LoadableDevice::local_copy', value=any.to_any(False))])
+        contents = contents[::-1]
+        f = open(srcFile, 'w')
+        f.write(contents)
+        f.close()
+        os.utime(srcFile, (os.path.getatime(cacheFile), os.path.getmtime(cacheFile)+1))
+        device.load(fileMgr, '/' + testFile, CF.LoadableDevice.EXECUTABLE)
+        self.assertEqual(open(cacheFile, 'r').read(), contents)
+        device.unload('/' + testFile)
+        device.unload('/' + testFile)
+
     def test_cpp_SharedLibraryLoad(self):
         # Ensure the expected device is available
         devBooter, devMgr = self.launchDeviceManager(dcdFile="/nodes/test_ExecutableDevice_node/DeviceManager.dcd.xml")
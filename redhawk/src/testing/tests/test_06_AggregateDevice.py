@@ -161,6 +161,11 @@ class DeviceManagerTest(scatest.CorbaTestCase):
     def test_CppBasicAggregateDevice(self):
         self._test_BasicAggregateDevice("BasicChildDevice_cpp")
 
+    def test_CppBasicAggregateDeviceParallelStartup(self):
+        # The child is deferred until the parent registers
+        self._execparams = "PARALLEL_STARTUP true"
+        self._test_BasicAggregateDevice("BasicChildDevice_cpp")
+
     def test_CppBasicAggregateDeviceShutdownParent(self):
         self._test_ShutdownParent("BasicChildDevice_cpp")
 
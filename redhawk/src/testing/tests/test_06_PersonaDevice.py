@@ -22,6 +22,8 @@ import re
 import time
 
 from _unitTestHelpers import scatest
+from omniORB import any
+from ossie.cf import CF
 
 def is_regexp_in_file_lines(fpath, regexp):
     lines = open(fpath).readlines()  # let it raise
@@ -97,6 +99,16 @@ class PersonaTest(scatest.CorbaTestCase):
         self.checkRegisteredDevices(4)
         self.allocate()
 
+    def test_CPP_Persona_ParallelStartup(self):
+        # The personas are loaded into the programmable device from a separate
+        # thread once it registers
+        self._execparams = "PARALLEL_STARTUP true DEVICE_REGISTRATION_TIMEOUT 30"
+        self.launchNode("PersonaNode")
+        self.checkRegisteredDevices(4)
+        props = self._devMgr.query([CF.DataType(id="PARALLEL_STARTUP", value=any.to_any(None))])
+        self.assertEquals(any.from_any(props[0].value), True)
+        self.allocate()
+
     def _test_Persona_log(self, fpath_log, log_level):
         """
         These checks are simplified by knowing what log messages will occur, and their order.
@@ -0,0 +1,279 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "LogDecoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+#include <time.h>
+
+namespace format = rh_logger::binary::format;
+
+namespace {
+    static std::string levelName(int level)
+    {
+        switch (level) {
+        case rh_logger::Level::FATAL_INT: return "FATAL";
+        case rh_logger::Level::ERROR_INT: return "ERROR";
+        case rh_logger::Level::WARN_INT:  return "WARN";
+        case rh_logger::Level::INFO_INT:  return "INFO";
+        case rh_logger::Level::DEBUG_INT: return "DEBUG";
+        case rh_logger::Level::TRACE_INT: return "TRACE";
+        default:
+            break;
+        }
+        std::ostringstream oss;
+        oss << level;
+        return oss.str();
+    }
+
+    static std::string formatTime(uint64_t time)
+    {
+        time_t seconds = time / 1000000000ULL;
+        struct tm local;
+        localtime_r(&seconds, &local);
+        char buffer[32];
+        strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &local);
+        std::ostringstream oss;
+        oss << buffer << "." << std::setw(6) << std::setfill('0') << ((time % 1000000000ULL) / 1000);
+        return oss.str();
+    }
+
+    template <typename T>
+    static bool readValue(const std::vector<char>& record, size_t& pos, T& value)
+    {
+        if ((pos + sizeof(T)) > record.size()) {
+            return false;
+        }
+        std::memcpy(&value, &record[pos], sizeof(T));
+        pos += sizeof(T);
+        return true;
+    }
+}
+
+LogDecoder::LogDecoder() :
+    _location(false)
+{
+}
+
+void LogDecoder::setShowLocation(bool show)
+{
+    _location = show;
+}
+
+void LogDecoder::load(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("cannot open " + filename);
+    }
+    _data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    if (_data.size() < sizeof(format::FileHeader)) {
+        throw std::runtime_error(filename + " is not a binary log file");
+    }
+    std::memcpy(&_header, &_data[0], sizeof(_header));
+    if (std::memcmp(_header.magic, format::MAGIC, sizeof(_header.magic)) != 0) {
+        throw std::runtime_error(filename + " is not a binary log file");
+    } else if (_header.version != format::FORMAT_VERSION) {
+        throw std::runtime_error(filename + " has an unsupported version");
+    }
+
+    // Check each section against the file size, taking care that corrupt
+    // offsets cannot overflow
+    const uint64_t size = _data.size();
+    if ((_header.siteOffset > size) || (_header.siteBytes > (size - _header.siteOffset)) ||
+        (_header.siteBytes > _header.siteCapacity)) {
+        throw std::runtime_error(filename + " has an invalid site table");
+    } else if ((_header.ringCapacity == 0) || (_header.ringOffset > size) ||
+               (_header.ringCapacity > (size - _header.ringOffset))) {
+        throw std::runtime_error(filename + " is truncated");
+    }
+    _loadSites();
+}
+
+void LogDecoder::listSites(std::ostream& out)
+{
+    for (SiteMap::const_iterator site = _sites.begin(); site != _sites.end(); ++site) {
+        out << std::setw(5) << site->first << " " << std::left << std::setw(5)
+            << levelName(site->second.level) << std::right << " " << site->second.file
+            << ":" << site->second.line << " " << site->second.function << std::endl;
+    }
+}
+
+void LogDecoder::listEvents(std::ostream& out)
+{
+    const uint64_t capacity = _header.ringCapacity;
+    const uint64_t cursor = _header.cursor;
+    uint64_t offset = 0;
+    if (cursor > capacity) {
+        offset = cursor - capacity;
+    }
+
+    // The oldest data is likely to be in the middle of a record that was
+    // partially overwritten; records are only accepted if they claim the
+    // offset they were found at, so skip ahead until one does
+    while ((offset + sizeof(format::RecordHeader)) <= cursor) {
+        format::RecordHeader header;
+        _readRing(offset, &header, sizeof(header));
+        if ((header.offset != offset) || (header.size < sizeof(header)) ||
+            ((offset + header.size) > cursor) || (header.size > capacity)) {
+            offset += 8;
+            continue;
+        }
+        std::vector<char> record(header.size);
+        _readRing(offset, &record[0], header.size);
+        _printEvent(out, header, record);
+        offset += format::align(header.size);
+    }
+}
+
+void LogDecoder::_loadSites()
+{
+    // The site table has already been checked against the file size
+    _sites.clear();
+    const char* table = &_data[_header.siteOffset];
+    uint64_t offset = 0;
+    while ((offset + sizeof(format::SiteHeader)) <= _header.siteBytes) {
+        format::SiteHeader header;
+        std::memcpy(&header, table + offset, sizeof(header));
+        const uint64_t strings_size = static_cast<uint64_t>(header.fileLength) + header.functionLength;
+        if ((header.size < sizeof(header)) || (header.size > (_header.siteBytes - offset)) ||
+            (strings_size > (header.size - sizeof(header)))) {
+            break;
+        }
+        const char* strings = table + offset + sizeof(header);
+        Site& site = _sites[header.id];
+        site.level = header.level;
+        site.line = header.line;
+        site.file.assign(strings, header.fileLength);
+        site.function.assign(strings + header.fileLength, header.functionLength);
+        offset += format::align(header.size);
+    }
+}
+
+void LogDecoder::_readRing(uint64_t offset, void* dest, size_t bytes)
+{
+    const char* ring = &_data[_header.ringOffset];
+    size_t start = offset % _header.ringCapacity;
+    size_t first = std::min(bytes, static_cast<size_t>(_header.ringCapacity - start));
+    std::memcpy(dest, ring + start, first);
+    if (first < bytes) {
+        std::memcpy(static_cast<char*>(dest) + first, ring, bytes - first);
+    }
+}
+
+void LogDecoder::_printEvent(std::ostream& out, const format::RecordHeader& header,
+                             const std::vector<char>& record)
+{
+    size_t pos = sizeof(header);
+    std::string logger(&record[pos], std::min(static_cast<size_t>(header.loggerLength), record.size() - pos));
+    pos += logger.size();
+
+    // Render the arguments the same way an ostream would have
+    std::ostringstream message;
+    bool valid = true;
+    while (valid && (pos < record.size())) {
+        uint8_t type = record[pos++];
+        switch (type) {
+        case format::ARG_SIGNED:
+            {
+                int64_t value;
+                if ((valid = readValue(record, pos, value))) {
+                    message << value;
+                }
+            }
+            break;
+        case format::ARG_UNSIGNED:
+            {
+                uint64_t value;
+                if ((valid = readValue(record, pos, value))) {
+                    message << value;
+                }
+            }
+            break;
+        case format::ARG_DOUBLE:
+            {
+                double value;
+                if ((valid = readValue(record, pos, value))) {
+                    message << value;
+                }
+            }
+            break;
+        case format::ARG_CHAR:
+            {
+                char value;
+                if ((valid = readValue(record, pos, value))) {
+                    message << value;
+                }
+            }
+            break;
+        case format::ARG_POINTER:
+            {
+                uint64_t value;
+                if ((valid = readValue(record, pos, value))) {
+                    message << reinterpret_cast<const void*>(value);
+                }
+            }
+            break;
+        case format::ARG_TEXT:
+            {
+                uint32_t length;
+                if ((valid = readValue(record, pos, length) && ((pos + length) <= record.size()))) {
+                    message.write(&record[pos], length);
+                    pos += length;
+                }
+            }
+            break;
+        default:
+            valid = false;
+            break;
+        }
+    }
+    if (!valid) {
+        message << "<invalid argument data>";
+    } else if (header.flags & format::RECORD_TRUNCATED) {
+        message << "...";
+    }
+
+    int level = 0;
+    const Site* site = 0;
+    SiteMap::const_iterator found = _sites.find(header.site);
+    if (found != _sites.end()) {
+        site = &(found->second);
+        level = site->level;
+    }
+
+    out << formatTime(header.time) << " " << std::left << std::setw(5) << levelName(level)
+        << std::right << " " << logger << " [" << header.thread << "]";
+    if (_location) {
+        if (site) {
+            out << " (" << site->file << ":" << site->line << ")";
+        } else {
+            out << " (unknown)";
+        }
+    }
+    out << " - " << message.str() << std::endl;
+}
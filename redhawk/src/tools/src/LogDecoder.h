@@ -0,0 +1,77 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef LOGDECODER_H
+#define LOGDECODER_H
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ossie/logging/rh_binlog.h>
+
+//
+// Reads a REDHAWK binary log file and renders its contents as text
+//
+class LogDecoder {
+public:
+    struct Site {
+        int level;
+        unsigned int line;
+        std::string file;
+        std::string function;
+    };
+
+    LogDecoder();
+
+    void setShowLocation(bool show);
+
+    //
+    // Reads the file into memory; throws std::runtime_error if it is not a
+    // valid binary log file
+    //
+    void load(const std::string& filename);
+
+    void listSites(std::ostream& out);
+
+    //
+    // Writes one line per event, oldest first, in the form:
+    //   <time> <level> <logger> [<thread>] - <message>
+    //
+    void listEvents(std::ostream& out);
+
+private:
+    typedef std::map<uint32_t,Site> SiteMap;
+
+    void _loadSites();
+
+    void _readRing(uint64_t offset, void* dest, size_t bytes);
+
+    void _printEvent(std::ostream& out, const rh_logger::binary::format::RecordHeader& header,
+                     const std::vector<char>& record);
+
+    bool _location;
+    std::vector<char> _data;
+    rh_logger::binary::format::FileHeader _header;
+    SiteMap _sites;
+};
+
+#endif // LOGDECODER_H
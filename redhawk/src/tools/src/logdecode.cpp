@@ -0,0 +1,113 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include <iostream>
+#include <string>
+
+#include <getopt.h>
+
+#include "LogDecoder.h"
+
+namespace {
+    static std::string executable;
+
+    static void usage()
+    {
+        std::cout << "Usage: " << executable << " [OPTION]... FILE..." << std::endl;
+        std::cout << "Render REDHAWK binary log files as text." << std::endl;
+        std::cout << std::endl;
+        std::cout << "  -h, --help           display this help and exit" << std::endl;
+        std::cout << "  -l, --location       include the source location of each event" << std::endl;
+        std::cout << "  -s, --sites          list the logging statements instead of events" << std::endl;
+        std::cout << "      --version        output version information and exit" << std::endl;
+        std::cout << std::endl;
+        std::cout << "Binary log files are created by REDHAWK processes started with the" << std::endl;
+        std::cout << "RH_LOG_BINARY environment variable set to a directory. Events are listed" << std::endl;
+        std::cout << "oldest first; once the ring is full, the oldest events are overwritten." << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Save the executable name for output, removing any paths
+    executable = argv[0];
+    std::string::size_type pos = executable.rfind('/');
+    if (pos != std::string::npos) {
+        executable.erase(0, pos + 1);
+    }
+
+    struct option long_options[] = {
+        { "help", no_argument, 0, 'h' },
+        { "location", no_argument, 0, 'l' },
+        { "sites", no_argument, 0, 's' },
+        { "version", no_argument, 0, 'V' },
+        { 0, 0, 0, 0 }
+    };
+
+    LogDecoder decoder;
+    bool sites = false;
+
+    int opt;
+    while ((opt = getopt_long(argc, argv, "hls", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'h':
+            usage();
+            return 0;
+        case 'l':
+            decoder.setShowLocation(true);
+            break;
+        case 's':
+            sites = true;
+            break;
+        case 'V':
+            std::cout << executable << " version " << VERSION << std::endl;
+            return 0;
+        default:
+            std::cerr << "Try `" << executable << " --help` for more information." << std::endl;
+            return -1;
+        }
+    }
+
+    if (optind >= argc) {
+        std::cerr << executable << ": no file given" << std::endl;
+        std::cerr << "Try `" << executable << " --help` for more information." << std::endl;
+        return -1;
+    }
+
+    int status = 0;
+    for (int index = optind; index < argc; ++index) {
+        try {
+            decoder.load(argv[index]);
+        } catch (const std::exception& exc) {
+            std::cerr << executable << ": " << exc.what() << std::endl;
+            status = -1;
+            continue;
+        }
+        if ((argc - optind) > 1) {
+            std::cout << "==> " << argv[index] << " <==" << std::endl;
+        }
+        if (sites) {
+            decoder.listSites(std::cout);
+        } else {
+            decoder.listEvents(std::cout);
+        }
+    }
+    return status;
+}
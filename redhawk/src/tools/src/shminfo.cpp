@@ -23,6 +23,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <algorithm>
+#include <vector>
 #include <cmath>
 
 #include <sys/types.h>
@@ -48,6 +49,7 @@ namespace {
         std::cout << "  -h, --help           display this help and exit" << std::endl;
         std::cout << "  -a, --all            include non-REDHAWK heap shared memory files" << std::endl;
         std::cout << "  -l                   do not look up user and group names" << std::endl;
+        std::cout << "      --live           include live allocation accounting for heaps" << std::endl;
         std::cout << "      --format=FORMAT  display sizes in FORMAT (default 'auto')" << std::endl;
         std::cout << "      --version        output version information and exit" << std::endl;
         std::cout << std::endl;
@@ -63,6 +65,36 @@ namespace {
         oss << std::fixed << std::setprecision(1) << percent << "%";
         return oss.str();
     }
+
+    static std::string duration(unsigned int seconds)
+    {
+        std::ostringstream oss;
+        if (seconds >= 3600) {
+            oss << (seconds / 3600) << "h";
+        } else if (seconds >= 60) {
+            oss << (seconds / 60) << "m";
+        } else {
+            oss << seconds << "s";
+        }
+        return oss.str();
+    }
+
+    static std::string ageLabel(size_t bucket)
+    {
+        unsigned int limit = SuperblockFile::AgeLimit(bucket);
+        if (limit) {
+            return "<" + duration(limit);
+        } else {
+            return ">=" + duration(SuperblockFile::AgeLimit(bucket - 1));
+        }
+    }
+
+    typedef std::pair<std::string,SuperblockFile::TagUsage> TagEntry;
+
+    static bool compareTagBytes(const TagEntry& lhs, const TagEntry& rhs)
+    {
+        return lhs.second.bytes > rhs.second.bytes;
+    }
 }
 
 class SizeFormatter
@@ -148,6 +180,7 @@ public:
     Info() :
         _all(false),
         _showNames(true),
+        _live(false),
         _format()
     {
     }
@@ -157,6 +190,11 @@ public:
         _all = all;
     }
 
+    void setDisplayLive(bool live)
+    {
+        _live = live;
+    }
+
     void setDisplayUserNames(bool display)
     {
         _showNames = display;
@@ -185,6 +223,10 @@ public:
         std::cout << "  refcount:    " << heap.refcount() << std::endl;
 
         displayFileStats(heap.name(), false);
+
+        if (_live) {
+            displayUsage(heap);
+        }
     }
 
     virtual void visitFile(const std::string& name)
@@ -210,6 +252,45 @@ public:
     }
 
 protected:
+    void displayUsage(SuperblockFile& heap)
+    {
+        SuperblockFile::Usage usage = heap.getUsage();
+        std::cout << "  allocated:   " << usage.blocks << " block(s), " << _format(usage.bytes) << std::endl;
+        std::cout << "  shared:      " << usage.sharedBlocks << " block(s)" << std::endl;
+        std::cout << "  free:        " << usage.freeBlocks << " block(s), " << _format(usage.freeBytes) << std::endl;
+        std::cout << "  largest:     " << _format(usage.largestFree) << std::endl;
+        // Fragmentation is the fraction of free memory that is not in the
+        // largest free block, i.e., unavailable for the largest request
+        float fragmentation = 0.0;
+        if (usage.freeBytes) {
+            fragmentation = (usage.freeBytes - usage.largestFree) * 100.0 / usage.freeBytes;
+        }
+        std::cout << "  fragmented:  " << percent(fragmentation) << std::endl;
+
+        std::cout << "  ages:       ";
+        for (size_t bucket = 0; bucket < SuperblockFile::AGE_BUCKETS; ++bucket) {
+            std::cout << " " << ageLabel(bucket) << ":" << usage.ages[bucket];
+        }
+        std::cout << std::endl;
+
+        std::vector<TagEntry> tags(usage.tags.begin(), usage.tags.end());
+        std::sort(tags.begin(), tags.end(), &compareTagBytes);
+        std::cout << "  owners:" << std::endl;
+        for (size_t index = 0; index < tags.size(); ++index) {
+            std::string tag = tags[index].first;
+            if (tag.empty()) {
+                tag = "(untagged)";
+            }
+            std::cout << "    " << std::left << std::setw(40) << tag << std::right
+                      << " " << tags[index].second.blocks << " block(s), "
+                      << _format(tags[index].second.bytes) << std::endl;
+        }
+
+        if (!usage.complete) {
+            std::cout << "  (heap changed during scan; usage is approximate)" << std::endl;
+        }
+    }
+
     void displayFileStats(const std::string& name, bool showSize)
     {
         const std::string shm_path = redhawk::shm::getSystemPath();
@@ -286,6 +367,7 @@ protected:
 
     bool _all;
     bool _showNames;
+    bool _live;
     SizeFormatter _format;
 
     typedef std::map<uid_t,std::string> UserTable;
@@ -309,6 +391,7 @@ int main(int argc, char* argv[])
         { "help", no_argument, 0, 'h' },
         { "all", no_argument, 0, 'a' },
         { "version", no_argument, 0, 'V' },
+        { "live", no_argument, 0, 'L' },
         { 0, 0, 0, 0 }
     };
 
@@ -332,6 +415,9 @@ int main(int argc, char* argv[])
         case 'l':
             info.setDisplayUserNames(false);
             break;
+        case 'L':
+            info.setDisplayLive(true);
+            break;
         case 'h':
             usage();
             return 0;
@@ -0,0 +1,208 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#include "BinaryLogTest.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#include <unistd.h>
+
+#include <ossie/logging/rh_binlog.h>
+
+#include "LogDecoder.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BinaryLogTest);
+
+namespace binary = rh_logger::binary;
+
+namespace {
+    // Smallest ring that the binary log supports
+    static const size_t RING_SIZE = 64*1024;
+
+    struct Coordinate {
+        int x;
+        int y;
+    };
+
+    std::ostream& operator<<(std::ostream& out, const Coordinate& coord)
+    {
+        return out << "(" << coord.x << ", " << coord.y << ")";
+    }
+}
+
+// Logs a message at the DEBUG level, and formats the same message with an
+// ostringstream as the expected output of the decoder
+#define LOG_EXPECT(expected, msg)               \
+    do {                                        \
+        RH_DEBUG(_logger, msg);                 \
+        std::ostringstream _oss;                \
+        _oss << msg;                            \
+        expected.push_back(_oss.str());         \
+    } while (0)
+
+void BinaryLogTest::setUp()
+{
+    char directory[] = "/tmp/binlogtest-XXXXXX";
+    CPPUNIT_ASSERT_MESSAGE("Unable to create temporary directory", mkdtemp(directory));
+    _directory = directory;
+
+    _logger = rh_logger::Logger::getLogger("BinaryLogTest");
+    _logger->setLevel(rh_logger::Level::getTrace());
+
+    CPPUNIT_ASSERT(binary::open(_directory, RING_SIZE, rh_logger::Level::DEBUG_INT));
+}
+
+void BinaryLogTest::tearDown()
+{
+    std::string filename = binary::filename();
+    binary::close();
+    if (!filename.empty()) {
+        unlink(filename.c_str());
+    }
+    rmdir(_directory.c_str());
+}
+
+void BinaryLogTest::testRawTypes()
+{
+    std::vector<std::string> expected;
+    LOG_EXPECT(expected, "int " << -5 << " unsigned " << 7u << " short " << (short)-3);
+    LOG_EXPECT(expected, "long long " << -123456789012LL << " unsigned long long " << 123456789012ULL);
+    LOG_EXPECT(expected, "double " << 2.5 << " float " << 0.25f << " small " << 1.0e-9);
+    LOG_EXPECT(expected, "char " << 'x' << " bool " << true << " " << false);
+    LOG_EXPECT(expected, "string " << std::string("text") << " pointer " << (const void*)0x1234);
+
+    // A null C string sets badbit, which suppresses the rest of the message
+    const char* null_string = 0;
+    LOG_EXPECT(expected, "before " << null_string << " after " << 1);
+
+    CPPUNIT_ASSERT(expected == _decode());
+}
+
+void BinaryLogTest::testTextFallback()
+{
+    std::vector<std::string> expected;
+    Coordinate coord = { 3, -4 };
+    LOG_EXPECT(expected, "coordinate " << coord << " count " << 2);
+    LOG_EXPECT(expected, coord << coord);
+
+    CPPUNIT_ASSERT(expected == _decode());
+}
+
+void BinaryLogTest::testManipulators()
+{
+    std::vector<std::string> expected;
+    LOG_EXPECT(expected, std::hex << 255 << " " << std::dec << 255);
+    LOG_EXPECT(expected, "[" << std::setw(6) << std::setfill('*') << 42 << "]");
+    LOG_EXPECT(expected, std::fixed << std::setprecision(3) << 3.14159 << " " << 2.0f);
+    LOG_EXPECT(expected, std::showpos << 5 << " " << std::noshowpos << 5);
+    LOG_EXPECT(expected, std::boolalpha << true << " " << std::string("text"));
+
+    // Formatting state does not carry over to the next event
+    LOG_EXPECT(expected, 255 << " " << 3.14159 << " " << true);
+
+    CPPUNIT_ASSERT(expected == _decode());
+}
+
+void BinaryLogTest::testTruncation()
+{
+    const std::string text(2000, 'a');
+    RH_DEBUG(_logger, text << " " << 1);
+    RH_DEBUG(_logger, "short " << 2);
+
+    std::vector<std::string> messages = _decode();
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, messages.size());
+
+    // The text is cut off at the record capacity, the value after it is
+    // dropped, and the message is marked as truncated
+    const std::string& truncated = messages[0];
+    CPPUNIT_ASSERT(truncated.size() < text.size());
+    CPPUNIT_ASSERT(truncated.size() > 900);
+    CPPUNIT_ASSERT_EQUAL(std::string("..."), truncated.substr(truncated.size() - 3));
+    CPPUNIT_ASSERT_EQUAL(text.substr(0, truncated.size() - 3), truncated.substr(0, truncated.size() - 3));
+
+    // The next event is unaffected
+    CPPUNIT_ASSERT_EQUAL(std::string("short 2"), messages[1]);
+}
+
+void BinaryLogTest::testRingWrap()
+{
+    // Write several times the ring size; each record is well under 100
+    // bytes
+    const int count = (4 * RING_SIZE) / 64;
+    for (int index = 0; index < count; ++index) {
+        RH_DEBUG(_logger, "event " << index);
+    }
+
+    // The oldest events have been overwritten, but the rest are intact and
+    // in order, up to and including the last one
+    std::vector<std::string> messages = _decode();
+    CPPUNIT_ASSERT(!messages.empty());
+    CPPUNIT_ASSERT(messages.size() < (size_t) count);
+    CPPUNIT_ASSERT(messages.size() > (RING_SIZE / 128));
+    const int first = count - messages.size();
+    for (size_t index = 0; index < messages.size(); ++index) {
+        std::ostringstream expected;
+        expected << "event " << (first + index);
+        CPPUNIT_ASSERT_EQUAL(expected.str(), messages[index]);
+    }
+}
+
+void BinaryLogTest::testThresholdAll()
+{
+    // Only DEBUG and below are captured by default
+    CPPUNIT_ASSERT(binary::capturing(rh_logger::Level::TRACE_INT));
+    CPPUNIT_ASSERT(!binary::capturing(rh_logger::Level::INFO_INT));
+
+    // ALL has the same value as the disabled threshold, but must capture
+    // every level
+    binary::close();
+    CPPUNIT_ASSERT(!binary::capturing(rh_logger::Level::TRACE_INT));
+    CPPUNIT_ASSERT(binary::open(_directory, RING_SIZE, rh_logger::Level::ALL_INT));
+    CPPUNIT_ASSERT(binary::capturing(rh_logger::Level::TRACE_INT));
+    CPPUNIT_ASSERT(binary::capturing(rh_logger::Level::FATAL_INT));
+
+    RH_TRACE(_logger, "trace " << 1);
+    RH_FATAL(_logger, "fatal " << 2);
+    std::vector<std::string> messages = _decode();
+    CPPUNIT_ASSERT_EQUAL((size_t) 2, messages.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("trace 1"), messages[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("fatal 2"), messages[1]);
+}
+
+std::vector<std::string> BinaryLogTest::_decode()
+{
+    LogDecoder decoder;
+    decoder.load(binary::filename());
+    std::ostringstream output;
+    decoder.listEvents(output);
+
+    // Each event is one line; keep only the message
+    std::vector<std::string> messages;
+    std::istringstream input(output.str());
+    std::string line;
+    while (std::getline(input, line)) {
+        std::string::size_type pos = line.find("] - ");
+        CPPUNIT_ASSERT_MESSAGE("Invalid event line '" + line + "'", pos != std::string::npos);
+        messages.push_back(line.substr(pos + 4));
+    }
+    return messages;
+}
@@ -0,0 +1,60 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK core.
+ *
+ * REDHAWK core is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK core is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+
+#ifndef BINARYLOGTEST_H
+#define BINARYLOGTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+#include <vector>
+
+#include <ossie/debug.h>
+
+class BinaryLogTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(BinaryLogTest);
+    CPPUNIT_TEST(testRawTypes);
+    CPPUNIT_TEST(testTextFallback);
+    CPPUNIT_TEST(testManipulators);
+    CPPUNIT_TEST(testTruncation);
+    CPPUNIT_TEST(testRingWrap);
+    CPPUNIT_TEST(testThresholdAll);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp();
+    void tearDown();
+
+    void testRawTypes();
+    void testTextFallback();
+    void testManipulators();
+    void testTruncation();
+    void testRingWrap();
+    void testThresholdAll();
+
+private:
+    std::vector<std::string> _decode();
+
+    std::string _directory;
+    rh_logger::LoggerPtr _logger;
+};
+
+#endif // BINARYLOGTEST_H
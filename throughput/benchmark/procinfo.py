@@ -17,9 +17,10 @@
 # You should have received a copy of the GNU Lesser General Public License
 # along with this program.  If not, see http://www.gnu.org/licenses/.
 #
+import os
 import itertools
 
-__all__ = ('CpuInfo', 'ProcessInfo')
+__all__ = ('CpuInfo', 'ProcessInfo', 'ThreadInfo')
 
 class ProcFile(object):
     def __init__(self, filename):
@@ -141,3 +142,41 @@ class ProcessInfo(ProcFile):
         }
 
         return results
+
+
+class ThreadInfo(object):
+    """
+    CPU usage of the threads in a process, grouped by thread name. Component
+    processing threads are named after the component instance, which allows
+    measuring the CPU usage of individual components in a ComponentHost.
+    """
+    def __init__(self, pid):
+        self.__path = '/proc/%d/task' % (pid,)
+        self.__last = self.scan()
+
+    def scan(self):
+        result = {}
+        for tid in os.listdir(self.__path):
+            try:
+                with open(os.path.join(self.__path, tid, 'stat')) as f:
+                    line = f.readline()
+            except IOError:
+                # Thread exited
+                continue
+            # The thread name is in parentheses and may contain spaces; the
+            # remaining fields start with the state (field 3), so utime and
+            # stime (fields 14 and 15) are at offsets 11 and 12
+            start = line.index('(')
+            end = line.rindex(')')
+            fields = line[end+2:].split()
+            result[tid] = (line[start+1:end], int(fields[11]) + int(fields[12]))
+        return result
+
+    def poll(self):
+        current = self.scan()
+        results = {}
+        for tid, (name, ticks) in current.iteritems():
+            last = self.__last.get(tid, (name, 0))[1]
+            results[name] = results.get(name, 0) + ticks - last
+        self.__last = current
+        return results
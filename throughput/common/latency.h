@@ -0,0 +1,121 @@
+/*
+ * This file is protected by Copyright. Please refer to the COPYRIGHT file
+ * distributed with this source distribution.
+ *
+ * This file is part of REDHAWK throughput.
+ *
+ * REDHAWK throughput is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * REDHAWK throughput is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see http://www.gnu.org/licenses/.
+ */
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <algorithm>
+#include <inttypes.h>
+
+// Records latency values in a fixed set of logarithmic buckets, to estimate
+// percentiles without keeping every sample. Each power of two is split into
+// 32 linear sub-buckets, so reported values are within ~3% of the actual
+// value, from nanoseconds up to several minutes.
+class latency_histogram {
+public:
+    latency_histogram()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        std::fill(_counts, _counts + BUCKETS, 0);
+        _count = 0;
+        _max = 0;
+    }
+
+    void record(double seconds)
+    {
+        uint64_t nsec = 0;
+        if (seconds >= (MAX_VALUE * 1e-9)) {
+            nsec = MAX_VALUE;
+        } else if (seconds > 0.0) {
+            nsec = static_cast<uint64_t>(seconds * 1e9);
+        }
+        _counts[bucket_index(nsec)]++;
+        _count++;
+        _max = std::max(_max, nsec);
+    }
+
+    uint64_t count() const
+    {
+        return _count;
+    }
+
+    double maximum() const
+    {
+        return _max * 1e-9;
+    }
+
+    // Returns the value, in seconds, below which the given fraction (0.0 to
+    // 1.0) of the recorded values fall
+    double percentile(double fraction) const
+    {
+        if (_count == 0) {
+            return 0.0;
+        }
+        uint64_t target = static_cast<uint64_t>(fraction * _count + 0.5);
+        target = std::max(target, static_cast<uint64_t>(1));
+        uint64_t total = 0;
+        for (int index = 0; index < BUCKETS; ++index) {
+            total += _counts[index];
+            if (total >= target) {
+                return std::min(bucket_limit(index), _max) * 1e-9;
+            }
+        }
+        return maximum();
+    }
+
+private:
+    static const int SUB_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BITS;
+    static const int MAX_MAGNITUDE = 40;
+    static const int BUCKETS = (MAX_MAGNITUDE - SUB_BITS + 2) * SUB_BUCKETS;
+    static const uint64_t MAX_VALUE = (2ULL << MAX_MAGNITUDE) - 1;
+
+    // Values below SUB_BUCKETS get a bucket each; above that, each group of
+    // SUB_BUCKETS buckets covers one power of two
+    static int bucket_index(uint64_t value)
+    {
+        if (value < static_cast<uint64_t>(SUB_BUCKETS)) {
+            return value;
+        }
+        int magnitude = 63 - __builtin_clzll(value);
+        int shift = magnitude - SUB_BITS;
+        return ((shift + 1) * SUB_BUCKETS) + ((value >> shift) - SUB_BUCKETS);
+    }
+
+    // Returns the largest value that falls in the given bucket
+    static uint64_t bucket_limit(int index)
+    {
+        if (index < SUB_BUCKETS) {
+            return index;
+        }
+        int shift = (index / SUB_BUCKETS) - 1;
+        uint64_t base = SUB_BUCKETS + (index % SUB_BUCKETS);
+        return ((base + 1) << shift) - 1;
+    }
+
+    uint64_t _counts[BUCKETS];
+    uint64_t _count;
+    uint64_t _max;
+};
+
+#endif // LATENCY_H
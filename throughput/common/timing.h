@@ -2,6 +2,8 @@
 #define TIMING_H
 
 #include <time.h>
+#include <errno.h>
+#include <string.h>
 
 inline double get_time()
 {
@@ -10,4 +12,31 @@ inline double get_time()
     return now.tv_sec + now.tv_nsec*1e-9;
 }
 
+// Sleeps until the given time, as returned by get_time()
+inline void sleep_until(double deadline)
+{
+    struct timespec when;
+    when.tv_sec = static_cast<time_t>(deadline);
+    when.tv_nsec = static_cast<long>((deadline - when.tv_sec) * 1e9);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &when, NULL) == EINTR);
+}
+
+// Stores the current time at the start of a packet (which must be at least
+// sizeof(double) bytes long) so the receiver can compute one-way latency.
+// The monotonic clock is shared by all processes on the host, so the writer
+// and reader may be in different processes, but not on different hosts.
+inline void stamp_packet(void* data)
+{
+    double now = get_time();
+    memcpy(data, &now, sizeof(now));
+}
+
+// Returns the elapsed time since a packet was stamped with stamp_packet()
+inline double packet_latency(const void* data)
+{
+    double sent;
+    memcpy(&sent, data, sizeof(sent));
+    return get_time() - sent;
+}
+
 #endif
@@ -52,12 +52,20 @@ class NumaLauncher(Debugger):
 
 
 class BulkioStream(object):
-    def __init__(self, format, numa_policy, shared):
+    def __init__(self, format, numa_policy, shared, chain_length):
         launcher = NumaLauncher(numa_policy)
         self.shared = shared
         self.writer = sb.launch(os.path.join(PATH, 'writer/writer.spd.xml'), debugger=launcher, shared=self.shared)
-        self.reader = sb.launch(os.path.join(PATH, 'reader/reader.spd.xml'), debugger=launcher, shared=self.shared)
-        self.writer.connect(self.reader)
+
+        # For chains, all but the last reader forward the data to the next
+        # reader; the last reader in the chain does the measurement
+        source = self.writer
+        for index in xrange(chain_length):
+            self.reader = sb.launch(os.path.join(PATH, 'reader/reader.spd.xml'), debugger=launcher, shared=self.shared)
+            source.connect(self.reader, usesPortName='dataOctet_out')
+            if source is not self.writer:
+                source.forward = True
+            source = self.reader
         self.container = sb.domainless._getSandbox()._getComponentHost()
 
     def start(self):
@@ -90,6 +98,84 @@ class BulkioStream(object):
     def recv_time(self):
         return float(self.reader.average_time)
 
+    def send_interval(self, interval):
+        self.writer.send_interval = interval
+
+    def latency(self):
+        return {'count': int(self.reader.latency_count),
+                'p50': float(self.reader.latency_p50),
+                'p99': float(self.reader.latency_p99),
+                'p999': float(self.reader.latency_p999),
+                'max': float(self.reader.latency_max)}
+
+    def terminate(self):
+        sb.release()
+
+class BulkioPipeline(object):
+    """
+    A writer followed by a chain of forwarding stages, with the last stage
+    (or the writer, if there are no stages) fanning out to one or more sinks.
+    Components are given predictable instance names ("writer", "stage_N",
+    "sink_N"), which are also used as their processing thread names.
+    """
+    def __init__(self, numa_policy, shared, stages, fanout):
+        launcher = NumaLauncher(numa_policy)
+        self.shared = shared
+
+        self.writer = self._launch('writer', 'writer', launcher)
+        source = self.writer
+
+        self.stages = []
+        for index in xrange(stages):
+            stage = self._launch('reader', 'stage_%d' % (index+1), launcher)
+            stage.forward = True
+            source.connect(stage, usesPortName='dataOctet_out')
+            self.stages.append(stage)
+            source = stage
+
+        self.sinks = []
+        for index in xrange(fanout):
+            sink = self._launch('reader', 'sink_%d' % (index+1), launcher)
+            source.connect(sink, usesPortName='dataOctet_out')
+            self.sinks.append(sink)
+
+        self.container = sb.domainless._getSandbox()._getComponentHost()
+
+    def _launch(self, component, name, launcher):
+        spd = os.path.join(PATH, '%s/%s.spd.xml' % (component, component))
+        return sb.launch(spd, instanceName=name, debugger=launcher, shared=self.shared)
+
+    def start(self):
+        sb.start()
+
+    def stop(self):
+        sb.stop()
+
+    def components(self):
+        return [self.writer] + self.stages + self.sinks
+
+    def consumers(self):
+        return self.stages + self.sinks
+
+    def name(self, component):
+        return component._instanceName
+
+    def get_pid(self, component):
+        if self.shared:
+            return self.container._process.pid()
+        else:
+            return component._process.pid()
+
+    def transfer_size(self, size):
+        self.writer.transfer_length = int(size)
+
+    def received(self):
+        # Every sink receives the full stream; report the per-sink total
+        return sum(int(sink.received) for sink in self.sinks) / len(self.sinks)
+
+    def queue_depth(self, component):
+        return int(component.queue_depth)
+
     def terminate(self):
         sb.release()
 
@@ -98,15 +184,21 @@ class BulkioCorbaFactory(object):
         configfile = 'config/omniORB-%s.cfg' % transport
         os.environ['OMNIORB_CONFIG'] = os.path.join(PATH, configfile)
 
-    def create(self, format, numa_policy):
-        return BulkioStream(format, numa_policy, False)
+    def create(self, format, numa_policy, chain_length=1):
+        return BulkioStream(format, numa_policy, False, chain_length)
+
+    def create_pipeline(self, numa_policy, stages, fanout):
+        return BulkioPipeline(numa_policy, False, stages, fanout)
 
     def cleanup(self):
         pass
 
 class BulkioLocalFactory(object):
-    def create(self, format, numa_policy):
-        return BulkioStream(format, numa_policy, True)
+    def create(self, format, numa_policy, chain_length=1):
+        return BulkioStream(format, numa_policy, True, chain_length)
+
+    def create_pipeline(self, numa_policy, stages, fanout):
+        return BulkioPipeline(numa_policy, True, stages, fanout)
 
 def factory(transport, local):
     if sb is None:
@@ -75,7 +75,8 @@ private:
 PREPARE_LOGGING(reader_i)
 
 reader_i::reader_i(const char *uuid, const char *label) :
-    reader_base(uuid, label)
+    reader_base(uuid, label),
+    lastLatencySize(0)
 {
     // Avoid placing constructor code here. Instead, use the "constructor" function.
     dataOctet_in = new OctetPort("dataOctet_in");
@@ -93,6 +94,12 @@ void reader_i::constructor()
      This is the RH constructor. All properties are properly initialized before this function is called 
     ***********************************************************************************/
     setPropertyQueryImpl(average_time, this, &reader_i::get_average_time);
+    setPropertyQueryImpl(queue_depth, this, &reader_i::get_queue_depth);
+    setPropertyQueryImpl(latency_count, this, &reader_i::get_latency_count);
+    setPropertyQueryImpl(latency_p50, this, &reader_i::get_latency_p50);
+    setPropertyQueryImpl(latency_p99, this, &reader_i::get_latency_p99);
+    setPropertyQueryImpl(latency_p999, this, &reader_i::get_latency_p999);
+    setPropertyQueryImpl(latency_max, this, &reader_i::get_latency_max);
 }
 
 double reader_i::get_average_time()
@@ -100,6 +107,41 @@ double reader_i::get_average_time()
     return dataOctet_in->getAverageTime();
 }
 
+CORBA::ULong reader_i::get_queue_depth()
+{
+    return dataOctet_in->getCurrentQueueDepth();
+}
+
+CORBA::ULongLong reader_i::get_latency_count()
+{
+    boost::mutex::scoped_lock lock(latencyMutex);
+    return latency.count();
+}
+
+double reader_i::get_latency_p50()
+{
+    boost::mutex::scoped_lock lock(latencyMutex);
+    return latency.percentile(0.5);
+}
+
+double reader_i::get_latency_p99()
+{
+    boost::mutex::scoped_lock lock(latencyMutex);
+    return latency.percentile(0.99);
+}
+
+double reader_i::get_latency_p999()
+{
+    boost::mutex::scoped_lock lock(latencyMutex);
+    return latency.percentile(0.999);
+}
+
+double reader_i::get_latency_max()
+{
+    boost::mutex::scoped_lock lock(latencyMutex);
+    return latency.maximum();
+}
+
 /***********************************************************************************************
 
     Basic functionality:
@@ -279,5 +321,22 @@ int reader_i::serviceFunction()
         return NOOP;
     }
     received += block.size();
+
+    if (forward) {
+        // Intermediate link in a chain: pass the data along unmodified so the
+        // last reader measures the latency of the entire chain
+        if (!outputStream) {
+            outputStream = dataOctet_out->createStream(stream.sri());
+        }
+        outputStream.write(block.buffer(), block.getStartTime());
+    } else if (block.size() >= sizeof(double)) {
+        double elapsed = packet_latency(block.buffer().data());
+        boost::mutex::scoped_lock lock(latencyMutex);
+        if (block.size() != lastLatencySize) {
+            lastLatencySize = block.size();
+            latency.reset();
+        }
+        latency.record(elapsed);
+    }
     return NORMAL;
 }
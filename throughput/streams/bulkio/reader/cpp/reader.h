@@ -20,6 +20,8 @@
 #ifndef READER_I_IMPL_H
 #define READER_I_IMPL_H
 
+#include <latency.h>
+
 #include "reader_base.h"
 
 class OctetPort;
@@ -37,8 +39,19 @@ class reader_i : public reader_base
 
     private:
         OctetPort* dataOctet_in;
+        bulkio::OutOctetStream outputStream;
+
+        boost::mutex latencyMutex;
+        latency_histogram latency;
+        size_t lastLatencySize;
 
     double get_average_time();
+    CORBA::ULong get_queue_depth();
+    CORBA::ULongLong get_latency_count();
+    double get_latency_p50();
+    double get_latency_p99();
+    double get_latency_p999();
+    double get_latency_max();
 };
 
 #endif // READER_I_IMPL_H
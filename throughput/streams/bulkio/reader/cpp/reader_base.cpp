@@ -39,12 +39,16 @@ reader_base::reader_base(const char *uuid, const char *label) :
 
     dataOctet_in = new bulkio::InOctetPort("dataOctet_in");
     addPort("dataOctet_in", dataOctet_in);
+    dataOctet_out = new bulkio::OutOctetPort("dataOctet_out");
+    addPort("dataOctet_out", dataOctet_out);
 }
 
 reader_base::~reader_base()
 {
     delete dataOctet_in;
     dataOctet_in = 0;
+    delete dataOctet_out;
+    dataOctet_out = 0;
 }
 
 /*******************************************************************************************
@@ -97,6 +101,69 @@ void reader_base::loadProperties()
                 "external",
                 "property");
 
+    addProperty(forward,
+                false,
+                "forward",
+                "",
+                "readwrite",
+                "",
+                "external",
+                "property");
+
+    addProperty(queue_depth,
+                0,
+                "queue_depth",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(latency_count,
+                0LL,
+                "latency_count",
+                "",
+                "readonly",
+                "",
+                "external",
+                "property");
+
+    addProperty(latency_p50,
+                0.0,
+                "latency_p50",
+                "",
+                "readonly",
+                "s",
+                "external",
+                "property");
+
+    addProperty(latency_p99,
+                0.0,
+                "latency_p99",
+                "",
+                "readonly",
+                "s",
+                "external",
+                "property");
+
+    addProperty(latency_p999,
+                0.0,
+                "latency_p999",
+                "",
+                "readonly",
+                "s",
+                "external",
+                "property");
+
+    addProperty(latency_max,
+                0.0,
+                "latency_max",
+                "",
+                "readonly",
+                "s",
+                "external",
+                "property");
+
 }
 
 
@@ -46,10 +46,26 @@ class reader_base : public Component, protected ThreadedComponent
         CORBA::ULongLong received;
         /// Property: average_time
         double average_time;
+        /// Property: forward
+        bool forward;
+        /// Property: queue_depth
+        CORBA::ULong queue_depth;
+        /// Property: latency_count
+        CORBA::ULongLong latency_count;
+        /// Property: latency_p50
+        double latency_p50;
+        /// Property: latency_p99
+        double latency_p99;
+        /// Property: latency_p999
+        double latency_p999;
+        /// Property: latency_max
+        double latency_max;
 
         // Ports
         /// Port: dataOctet_in
         bulkio::InOctetPort *dataOctet_in;
+        /// Port: dataOctet_out
+        bulkio::OutOctetPort *dataOctet_out;
 
     private:
 };
@@ -26,6 +26,8 @@
 
 **************************************************************************/
 
+#include <algorithm>
+
 #include <timing.h>
 
 #include "writer.h"
@@ -35,7 +37,8 @@ PREPARE_LOGGING(writer_i);
 writer_i::writer_i(const char *uuid, const char *label) :
     writer_base(uuid, label),
     lastSize(0),
-    totalSeconds(0.0)
+    totalSeconds(0.0),
+    nextSend(0.0)
 {
     // Avoid placing constructor code here. Instead, use the "constructor" function.
 
@@ -231,6 +234,16 @@ int writer_i::serviceFunction()
         lastSize = buffer.size();
     }
 
+    // In latency mode, pace the writes and stamp each packet with its send
+    // time so that the reader can measure the one-way latency
+    if (send_interval > 0.0) {
+        nextSend = std::max(nextSend + send_interval, get_time());
+        sleep_until(nextSend);
+    }
+    if (buffer.size() >= sizeof(double)) {
+        stamp_packet(buffer.data());
+    }
+
     double start = get_time();
     stream.write(buffer, bulkio::time::utils::now());
     double end = get_time();
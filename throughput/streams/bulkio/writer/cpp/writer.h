@@ -39,6 +39,7 @@ class writer_i : public writer_base
 
         size_t lastSize;
         double totalSeconds;
+        double nextSend;
 };
 
 #endif // WRITER_I_IMPL_H
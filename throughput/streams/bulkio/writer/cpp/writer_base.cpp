@@ -88,6 +88,15 @@ void writer_base::loadProperties()
                 "external",
                 "property");
 
+    addProperty(send_interval,
+                0.0,
+                "send_interval",
+                "",
+                "readwrite",
+                "s",
+                "external",
+                "property");
+
     addProperty(total_packets,
                 0,
                 "total_packets",
@@ -44,6 +44,8 @@ class writer_base : public Component, protected ThreadedComponent
         // Member variables exposed as properties
         /// Property: transfer_length
         CORBA::ULong transfer_length;
+        /// Property: send_interval
+        double send_interval;
         /// Property: total_packets
         CORBA::ULong total_packets;
         /// Property: average_time
@@ -62,6 +62,17 @@ class CorbaStream(object):
     def recv_time(self):
         return self.reader._get_average_time()
 
+    def send_interval(self, interval):
+        self.writer.send_interval(interval)
+
+    def latency(self):
+        stats = self.reader.latency()
+        return {'count': stats.count,
+                'p50': stats.p50,
+                'p99': stats.p99,
+                'p999': stats.p999,
+                'max': stats.max}
+
     def terminate(self):
         self.reader_proc.terminate()
         self.writer_proc.terminate()
@@ -79,7 +90,9 @@ class CorbaStreamFactory(object):
         self.orbargs += [ '-ORBgiopMaxMsgSize', str(50*1024*1024)]
         self.orb = omniORB.CORBA.ORB_init()
 
-    def create(self, data_format, numa_policy):
+    def create(self, data_format, numa_policy, chain_length=1):
+        if chain_length != 1:
+            raise NotImplementedError('CORBA streams do not support chains')
         return CorbaStream(self.orbargs, self.orb, data_format, numa_policy)
 
     def cleanup(self):
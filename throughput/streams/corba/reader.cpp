@@ -23,6 +23,7 @@
 #include <omniORB4/CORBA.h>
 
 #include <timing.h>
+#include <latency.h>
 #include <threaded_deleter.h>
 
 #include "rawdata.h"
@@ -34,12 +35,17 @@ public:
         _lastPacketSize(0),
         _packetCount(0),
         _totalTime(0.0),
-        _averageTime(0.0)
+        _averageTime(0.0),
+        _lastLatencySize(0)
     {
     }
 
     void push_octet(const rawdata::octet_sequence& data)
     {
+        if (data.length() >= sizeof(double)) {
+            record_latency(packet_latency(data.get_buffer()), data.length());
+        }
+
         double start = get_time();
         _received += data.length();
         _deleter.deallocate_array(const_cast<rawdata::octet_sequence&>(data).get_buffer(1));
@@ -64,11 +70,33 @@ public:
         return _received;
     }
 
+    rawdata::latency_stats latency()
+    {
+        omni_mutex_lock lock(_latencyMutex);
+        rawdata::latency_stats stats;
+        stats.count = _latency.count();
+        stats.p50 = _latency.percentile(0.5);
+        stats.p99 = _latency.percentile(0.99);
+        stats.p999 = _latency.percentile(0.999);
+        stats.max = _latency.maximum();
+        return stats;
+    }
+
     double average_time()
     {
         return _averageTime;
     }
 
+    void record_latency(double latency, size_t length)
+    {
+        omni_mutex_lock lock(_latencyMutex);
+        if (_lastLatencySize != length) {
+            _lastLatencySize = length;
+            _latency.reset();
+        }
+        _latency.record(latency);
+    }
+
     void record_time(double elapsed, size_t length) {
         if (_lastPacketSize != length) {
             _lastPacketSize = length;
@@ -90,6 +118,10 @@ private:
     size_t _packetCount;
     double _totalTime;
     double _averageTime;
+
+    omni_mutex _latencyMutex;
+    latency_histogram _latency;
+    size_t _lastLatencySize;
 };
 
 int main (int argc, char* argv[])
@@ -18,6 +18,7 @@
  * along with this program.  If not, see http://www.gnu.org/licenses/.
  */
 #include <iostream>
+#include <algorithm>
 
 #include <omniORB4/CORBA.h>
 
@@ -31,6 +32,7 @@ public:
         _thread(0),
         _running(true),
         _length(1024),
+        _interval(0.0),
         _totalPackets(0),
         _totalSeconds(0.0),
         _averageTime(0.0)
@@ -52,6 +54,11 @@ public:
         _averageTime = 0.0;
     }
 
+    void send_interval(CORBA::Double interval)
+    {
+        _interval = interval;
+    }
+
     void start()
     {
         _thread->start();
@@ -91,11 +98,22 @@ private:
         } else {
             rawdata::octet_sequence data;
             data.length(_length);
+            double next_send = get_time();
             while (_running) {
                 if (data.length() != _length) {
                     data.length(_length);
                 }
 
+                // In latency mode, pace the pushes and stamp each packet with
+                // its send time
+                if (_interval > 0.0) {
+                    next_send = std::max(next_send + _interval, get_time());
+                    sleep_until(next_send);
+                }
+                if (data.length() >= sizeof(double)) {
+                    stamp_packet(data.get_buffer());
+                }
+
                 double start = get_time();
                 _reader->push_octet(data);
                 double end = get_time();
@@ -120,6 +138,7 @@ private:
     volatile bool _running;
     std::string _format;
     int _length;
+    volatile double _interval;
 
     size_t _totalPackets;
     double _totalSeconds;
@@ -27,10 +27,13 @@ import ctypes
 __all__ = ('factory')
 
 class control(object):
+    # Size of the control struct in control.h
+    SIZE = 72
+
     def __init__(self, transfer_size):
         fd, self.filename = tempfile.mkstemp()
-        os.ftruncate(fd, 20)
-        self.buf = mmap.mmap(fd, 20, mmap.MAP_SHARED, mmap.PROT_WRITE)
+        os.ftruncate(fd, control.SIZE)
+        self.buf = mmap.mmap(fd, control.SIZE, mmap.MAP_SHARED, mmap.PROT_WRITE)
         os.close(fd)
         self.total_bytes = ctypes.c_uint64.from_buffer(self.buf)
         self.total_bytes.value = 0
@@ -38,6 +41,13 @@ class control(object):
         self.average_time.value = 0.0
         self.transfer_size = ctypes.c_uint32.from_buffer(self.buf, 16)
         self.transfer_size.value = transfer_size
+        self.send_interval = ctypes.c_double.from_buffer(self.buf, 24)
+        self.send_interval.value = 0.0
+        self.latency_count = ctypes.c_uint64.from_buffer(self.buf, 32)
+        self.latency_p50 = ctypes.c_double.from_buffer(self.buf, 40)
+        self.latency_p99 = ctypes.c_double.from_buffer(self.buf, 48)
+        self.latency_p999 = ctypes.c_double.from_buffer(self.buf, 56)
+        self.latency_max = ctypes.c_double.from_buffer(self.buf, 64)
 
     def __del__(self):
         os.unlink(self.filename)
@@ -79,6 +89,16 @@ class RawStream(object):
     def recv_time(self):
         return self.reader_control.average_time.value
 
+    def send_interval(self, interval):
+        self.writer_control.send_interval.value = interval
+
+    def latency(self):
+        return {'count': self.reader_control.latency_count.value,
+                'p50': self.reader_control.latency_p50.value,
+                'p99': self.reader_control.latency_p99.value,
+                'p999': self.reader_control.latency_p999.value,
+                'max': self.reader_control.latency_max.value}
+
     def terminate(self):
         # Assuming stop() was already called, the reader and writer should have
         # already exited
@@ -91,7 +111,9 @@ class RawStreamFactory(object):
     def __init__(self, transport):
         self.transport = transport
 
-    def create(self, format, numa_policy):
+    def create(self, format, numa_policy, chain_length=1):
+        if chain_length != 1:
+            raise NotImplementedError('raw streams do not support chains')
         return RawStream(self.transport, numa_policy)
 
     def cleanup(self):
@@ -28,6 +28,12 @@ struct control {
     volatile uint64_t total_bytes;
     volatile double average_time;
     volatile uint32_t transfer_size;
+    volatile double send_interval;
+    volatile uint64_t latency_count;
+    volatile double latency_p50;
+    volatile double latency_p99;
+    volatile double latency_p999;
+    volatile double latency_max;
 };
 
 control* open_control(const std::string& filename);
@@ -34,6 +34,7 @@
 #include <omnithread.h>
 
 #include <timing.h>
+#include <latency.h>
 #include <threaded_deleter.h>
 
 #include "control.h"
@@ -111,6 +112,15 @@ size_t read_buffer(int fd, char* buffer, size_t count)
     return bytes_read;
 }
 
+void publish_latency(control* state, const latency_histogram& latency)
+{
+    state->latency_p50 = latency.percentile(0.5);
+    state->latency_p99 = latency.percentile(0.99);
+    state->latency_p999 = latency.percentile(0.999);
+    state->latency_max = latency.maximum();
+    state->latency_count = latency.count();
+}
+
 int main(int argc, const char* argv[])
 {
     if (argc < 4) {
@@ -130,6 +140,9 @@ int main(int argc, const char* argv[])
     double total_seconds = 0.0;
     size_t last_size = 0;
 
+    latency_histogram latency;
+    double last_update = get_time();
+
     ssize_t count = 0;
     while (true) {
         double start = get_time();
@@ -144,16 +157,28 @@ int main(int argc, const char* argv[])
             total_packets = 0;
             total_seconds = 0.0;
             state->average_time = 0.0;
+            latency.reset();
+            publish_latency(state, latency);
         }
 
         char* buffer = new char[buffer_size];
         size_t pass = read_buffer(fd, buffer, buffer_size);
+        if (pass >= sizeof(double)) {
+            latency.record(packet_latency(buffer));
+        }
         deleter.deallocate_array(buffer);
         if (pass == 0) {
             break;
         }
         double end = get_time();
 
+        // Computing the percentiles is not free; only update the shared state
+        // a few times per second
+        if ((end - last_update) >= 0.1) {
+            publish_latency(state, latency);
+            last_update = end;
+        }
+
         total_packets++;
         total_seconds += end - start;
         state->average_time = total_seconds / total_packets;
@@ -19,6 +19,7 @@
  */
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <cstdlib>
 #include <cstdio>
 
@@ -113,6 +114,7 @@ int main(int argc, const char* argv[])
 
     size_t total_packets = 0;
     double total_seconds = 0.0;
+    double next_send = get_time();
 
     while (running) {
         size_t buffer_size = state->transfer_size;
@@ -122,6 +124,16 @@ int main(int argc, const char* argv[])
             total_seconds = 0.0;
             state->average_time = 0.0;
         }
+        // In latency mode, pace the writes so that the reader measures the
+        // transfer time rather than the time spent in a full socket buffer
+        if (state->send_interval > 0.0) {
+            next_send = std::max(next_send + state->send_interval, get_time());
+            sleep_until(next_send);
+        }
+        if (buffer.size() >= sizeof(double)) {
+            stamp_packet(&buffer[0]);
+        }
+
         double start = get_time();
         write(fd, &buffer_size, sizeof(buffer_size));
         ssize_t pass = write(fd, &buffer[0], buffer.size());